@@ -0,0 +1,100 @@
+#pragma once
+#include "Bounds.hpp"
+#include "Frustum.hpp"
+#include "TaskScheduler.hpp"
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace MEngine
+{
+/**
+ * @brief 包围体层次结构
+ * 按 SAH（分桶）自顶向下构建，大子树在 TaskScheduler 上并行构建；
+ * 图元包围盒变化时通过 Update + Refit 只重算受影响的祖先节点。
+ * 每个图元携带一个 32 位 id（通常为 entt::entity），查询结果返回 id。
+ */
+class BVH final
+{
+  public:
+    struct Node
+    {
+        AABB bounds;
+        // 内部节点：左子节点下标（右子节点为 +1）；叶节点：mIndices 中的起始位置
+        uint32_t leftFirst = 0;
+        // 叶节点的图元数量，0 表示内部节点
+        uint32_t count = 0;
+        uint32_t parent = InvalidIndex;
+
+        bool IsLeaf() const noexcept
+        {
+            return count > 0;
+        }
+    };
+    struct RayHit
+    {
+        uint32_t id;
+        float distance;
+    };
+    static constexpr uint32_t InvalidIndex = std::numeric_limits<uint32_t>::max();
+
+  private:
+    static constexpr uint32_t mBinCount = 16;
+    static constexpr uint32_t mMaxLeafSize = 4;
+    // 图元数超过该值的子树交给其他线程构建
+    static constexpr uint32_t mParallelThreshold = 4096;
+
+    std::vector<Node> mNodes;
+    uint32_t mNodeCount = 0;
+    // 以下按图元下标（Build 时的输入顺序）存储
+    std::vector<AABB> mPrimitiveBounds;
+    std::vector<glm::vec3> mCentroids;
+    std::vector<uint32_t> mPrimitiveIds;
+    std::vector<uint32_t> mPrimitiveLeaves;
+    // 叶节点引用的图元下标，按叶节点连续排列
+    std::vector<uint32_t> mIndices;
+    // 等待 Refit 的叶节点
+    std::vector<uint32_t> mDirtyLeaves;
+    float mBuildSurfaceArea = 0.0f;
+
+  private:
+    void Subdivide(uint32_t nodeIndex, std::atomic<uint32_t> &nodeCount);
+    void UpdateLeafBounds(uint32_t nodeIndex);
+    void CollectSubtree(uint32_t nodeIndex, std::vector<uint32_t> &ids) const;
+
+  public:
+    /**
+     * @brief 重新构建，bounds 与 ids 一一对应
+     */
+    void Build(const std::vector<AABB> &bounds, const std::vector<uint32_t> &ids);
+    void Clear();
+    /**
+     * @brief 修改图元包围盒，调用 Refit 后生效
+     * @param primitive Build 时的图元下标
+     */
+    void Update(uint32_t primitive, const AABB &bounds);
+    /**
+     * @brief 自底向上重算被修改叶节点的所有祖先
+     */
+    void Refit();
+
+    void QueryFrustum(const Frustum &frustum, std::vector<uint32_t> &ids) const;
+    void QueryOverlap(const AABB &bounds, std::vector<uint32_t> &ids) const;
+    /**
+     * @brief 返回与射线最近相交的图元包围盒
+     */
+    std::optional<RayHit> Raycast(const Ray &ray,
+                                  float maxDistance = std::numeric_limits<float>::max()) const;
+
+    bool Empty() const noexcept;
+    uint32_t GetNodeCount() const noexcept;
+    uint32_t GetPrimitiveCount() const noexcept;
+    const std::vector<Node> &GetNodes() const noexcept;
+    /**
+     * @brief 根节点表面积相对构建时的比例，Refit 导致质量下降时可据此决定重建
+     */
+    float GetDegradation() const noexcept;
+};
+} // namespace MEngine
@@ -0,0 +1,110 @@
+#pragma once
+#include "Math.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace MEngine
+{
+/**
+ * @brief 射线，direction 不要求归一化，求交得到的距离以 direction 长度为单位
+ */
+struct Ray
+{
+    glm::vec3 origin{0.0f};
+    glm::vec3 direction{0.0f, 0.0f, -1.0f};
+};
+
+/**
+ * @brief 轴对齐包围盒
+ */
+struct AABB
+{
+    glm::vec3 min{std::numeric_limits<float>::max()};
+    glm::vec3 max{std::numeric_limits<float>::lowest()};
+
+    bool IsValid() const noexcept
+    {
+        return min.x <= max.x && min.y <= max.y && min.z <= max.z;
+    }
+    glm::vec3 GetCenter() const noexcept
+    {
+        return (min + max) * 0.5f;
+    }
+    glm::vec3 GetExtents() const noexcept
+    {
+        return (max - min) * 0.5f;
+    }
+    void Expand(const glm::vec3 &point) noexcept
+    {
+        min = glm::min(min, point);
+        max = glm::max(max, point);
+    }
+    void Merge(const AABB &other) noexcept
+    {
+        min = glm::min(min, other.min);
+        max = glm::max(max, other.max);
+    }
+    float SurfaceArea() const noexcept
+    {
+        glm::vec3 size = max - min;
+        return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+    }
+    bool Intersects(const AABB &other) const noexcept
+    {
+        return min.x <= other.max.x && max.x >= other.min.x && min.y <= other.max.y && max.y >= other.min.y &&
+               min.z <= other.max.z && max.z >= other.min.z;
+    }
+    /**
+     * @brief slab 法求交，inverseDirection 为 1 / ray.direction
+     * 方向分量为 0 且起点恰在该轴的 slab 平面上时 0 * inf 为 NaN，此时射线在该轴上不受约束（如厚度为 0 的地面）
+     * @return 命中时返回进入距离（起点在盒内时为 0），未命中返回负数
+     */
+    float IntersectRay(const Ray &ray, const glm::vec3 &inverseDirection, float maxDistance) const noexcept
+    {
+        float enter = 0.0f;
+        float exit = maxDistance;
+        for (int axis = 0; axis < 3; axis++)
+        {
+            float t0 = (min[axis] - ray.origin[axis]) * inverseDirection[axis];
+            float t1 = (max[axis] - ray.origin[axis]) * inverseDirection[axis];
+            if (std::isnan(t0) || std::isnan(t1))
+            {
+                continue;
+            }
+            enter = std::max(enter, std::min(t0, t1));
+            exit = std::min(exit, std::max(t0, t1));
+        }
+        return enter <= exit ? enter : -1.0f;
+    }
+    /**
+     * @brief 变换后的包围盒（Arvo 方法），结果仍为轴对齐
+     */
+    AABB Transform(const glm::mat4 &matrix) const noexcept
+    {
+        glm::vec3 center = glm::vec3(matrix * glm::vec4(GetCenter(), 1.0f));
+        glm::vec3 extents = GetExtents();
+        glm::vec3 worldExtents = glm::abs(glm::vec3(matrix[0])) * extents.x +
+                                 glm::abs(glm::vec3(matrix[1])) * extents.y +
+                                 glm::abs(glm::vec3(matrix[2])) * extents.z;
+        return AABB{center - worldExtents, center + worldExtents};
+    }
+};
+
+/**
+ * @brief 包围球
+ */
+struct BoundingSphere
+{
+    glm::vec3 center{0.0f};
+    float radius = 0.0f;
+
+    BoundingSphere Transform(const glm::mat4 &matrix) const noexcept
+    {
+        float maxScale = std::sqrt(std::max({glm::dot(glm::vec3(matrix[0]), glm::vec3(matrix[0])),
+                                             glm::dot(glm::vec3(matrix[1]), glm::vec3(matrix[1])),
+                                             glm::dot(glm::vec3(matrix[2]), glm::vec3(matrix[2]))}));
+        return BoundingSphere{glm::vec3(matrix * glm::vec4(center, 1.0f)), radius * maxScale};
+    }
+};
+} // namespace MEngine
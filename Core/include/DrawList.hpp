@@ -0,0 +1,56 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace MEngine
+{
+/**
+ * @brief 绘制包，key 决定绘制顺序，index 指向调用方的实体/数据数组
+ */
+struct DrawPacket
+{
+    uint64_t key;
+    uint32_t index;
+};
+
+/**
+ * @brief 64 位排序键
+ * 不透明：pipeline(8) | material(16) | mesh(16) | depth(24)，先合并状态，同状态内由近到远
+ * 透明：  pipeline(8) | ~depth(24) | material(16) | mesh(16)，由远到近
+ * depth 为 [0, 1] 的归一化视图深度
+ */
+namespace SortKey
+{
+constexpr uint32_t DepthBits = 24;
+constexpr uint32_t DepthMax = (1u << DepthBits) - 1;
+
+uint32_t QuantizeDepth(float depth) noexcept;
+uint64_t MakeOpaque(uint8_t pipeline, uint16_t material, uint16_t mesh, float depth) noexcept;
+uint64_t MakeTransparent(uint8_t pipeline, uint16_t material, uint16_t mesh, float depth) noexcept;
+uint8_t GetPipeline(uint64_t key) noexcept;
+/**
+ * @brief 不透明键去掉深度后的状态部分，相同即可合批
+ */
+uint64_t GetOpaqueState(uint64_t key) noexcept;
+} // namespace SortKey
+
+/**
+ * @brief 按排序键进行 LSD 基数排序的绘制列表（每轮 8 位，所有键该字节相同的轮次会被跳过）
+ */
+class DrawList final
+{
+  private:
+    std::vector<DrawPacket> mPackets;
+    std::vector<DrawPacket> mScratch;
+
+  public:
+    void Clear() noexcept;
+    void Reserve(size_t count);
+    void Add(uint64_t key, uint32_t index);
+    void Sort();
+    const std::vector<DrawPacket> &GetPackets() const noexcept;
+    size_t Size() const noexcept;
+    bool Empty() const noexcept;
+};
+} // namespace MEngine
@@ -28,22 +28,33 @@ class Texture2D final : public Entity<UUID>, public ITexture
     // Vulkan Resources
     UniqueImage mImage{};             // Vulkan 纹理图像
     vk::UniqueImageView mImageView{}; // Vulkan 纹理图像视图
-    vk::UniqueSampler mSampler{};     // Vulkan 纹理采样器
+    SharedSampler mSampler{};         // Vulkan 纹理采样器，由 SamplerManager 缓存共享
+    // 真实数据解码、上传完成前采样占位纹理
+    vk::ImageView mPlaceholderImageView{};
+    vk::Sampler mPlaceholderSampler{};
+    bool mLoading = false;
 
   public:
     Texture2D();
     // Getters
     inline vk::Image GetImage() const override
     {
-        return mImage->GetHandle();
+        return mImage ? mImage->GetHandle() : vk::Image{};
     }
     inline vk::ImageView GetImageView() const override
     {
-        return mImageView.get();
+        return mImageView ? mImageView.get() : mPlaceholderImageView;
     }
     inline vk::Sampler GetSampler() const override
     {
-        return mSampler.get();
+        return mSampler ? mSampler->get() : mPlaceholderSampler;
+    }
+    /**
+     * @brief 纹理自身的数据是否已可采样，为 false 时 GetImageView/GetSampler 返回占位纹理
+     */
+    inline bool IsResident() const
+    {
+        return mImage != nullptr && !mLoading;
     }
     inline const std::filesystem::path &GetImagePath() const override
     {
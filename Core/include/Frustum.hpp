@@ -0,0 +1,58 @@
+#pragma once
+#include "Bounds.hpp"
+#include "Math.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace MEngine
+{
+/**
+ * @brief 批量剔除用的 SoA 包围体数据，AABB 以中心和半长表示
+ */
+struct BoundsSoA
+{
+    std::vector<float> centerX, centerY, centerZ;
+    std::vector<float> extentX, extentY, extentZ;
+    std::vector<float> sphereX, sphereY, sphereZ, radius;
+
+    void Resize(size_t count);
+    void Set(size_t index, const AABB &box, const BoundingSphere &sphere);
+    size_t Size() const noexcept;
+};
+
+/**
+ * @brief 包围盒相对视锥的位置
+ */
+enum class Containment
+{
+    Outside,
+    Intersect,
+    Inside,
+};
+
+/**
+ * @brief 视锥体，平面由视图投影矩阵提取（深度范围 [0, 1]），法线指向内部
+ */
+class Frustum final
+{
+  private:
+    // (normal, distance)，点在内侧时 dot(normal, p) + distance >= 0
+    std::array<glm::vec4, 6> mPlanes;
+
+  public:
+    explicit Frustum(const glm::mat4 &viewProjection);
+    const std::array<glm::vec4, 6> &GetPlanes() const noexcept;
+    bool IsVisible(const AABB &box) const noexcept;
+    bool IsVisible(const BoundingSphere &sphere) const noexcept;
+    /**
+     * @brief 区分完全在内和相交，BVH 遍历时完全在内的子树无需继续测试
+     */
+    Containment Classify(const AABB &box) const noexcept;
+    /**
+     * @brief 批量测试 [begin, end)，先包围球后 AABB，visible[i] 为 1 表示可见
+     */
+    void Cull(const BoundsSoA &bounds, size_t begin, size_t end, uint8_t *visible) const;
+};
+} // namespace MEngine
@@ -10,4 +10,256 @@
 #include "glm/gtx/matrix_decompose.hpp"
 #include "glm/matrix.hpp"
 #include "glm/trigonometric.hpp"
+#include "glm/gtc/quaternion.hpp"
+#include "glm/gtx/euler_angles.hpp"
+#include <cstddef>
 
+#if defined(__AVX2__)
+#define MENGINE_SIMD_AVX2 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MENGINE_SIMD_SSE 1
+#endif
+#if defined(MENGINE_SIMD_AVX2)
+#include <immintrin.h>
+#elif defined(MENGINE_SIMD_SSE)
+#include <emmintrin.h>
+#include <xmmintrin.h>
+#endif
+
+namespace MEngine::Math
+{
+static_assert(sizeof(glm::vec3) == 3 * sizeof(float), "glm::vec3 must be tightly packed");
+static_assert(sizeof(glm::quat) == 4 * sizeof(float) && offsetof(glm::quat, x) == 0 &&
+                  offsetof(glm::quat, w) == 3 * sizeof(float),
+              "SIMD math expects glm::quat stored as x, y, z, w");
+static_assert(sizeof(glm::mat4) == 16 * sizeof(float), "glm::mat4 must be 16 column-major floats");
+
+/**
+ * @brief 标量版本，等价于 translate * mat4_cast * scale，作为 SIMD 路径的参考实现
+ */
+inline glm::mat4 ComposeTRSScalar(const glm::vec3 &translation, const glm::quat &rotation, const glm::vec3 &scale)
+{
+    const float xx = rotation.x * rotation.x;
+    const float yy = rotation.y * rotation.y;
+    const float zz = rotation.z * rotation.z;
+    const float xy = rotation.x * rotation.y;
+    const float xz = rotation.x * rotation.z;
+    const float yz = rotation.y * rotation.z;
+    const float wx = rotation.w * rotation.x;
+    const float wy = rotation.w * rotation.y;
+    const float wz = rotation.w * rotation.z;
+
+    glm::mat4 result;
+    result[0] = glm::vec4((1.0f - 2.0f * (yy + zz)) * scale.x, 2.0f * (xy + wz) * scale.x, 2.0f * (xz - wy) * scale.x,
+                          0.0f);
+    result[1] = glm::vec4(2.0f * (xy - wz) * scale.y, (1.0f - 2.0f * (xx + zz)) * scale.y, 2.0f * (yz + wx) * scale.y,
+                          0.0f);
+    result[2] = glm::vec4(2.0f * (xz + wy) * scale.z, 2.0f * (yz - wx) * scale.z, (1.0f - 2.0f * (xx + yy)) * scale.z,
+                          0.0f);
+    result[3] = glm::vec4(translation, 1.0f);
+    return result;
+}
+
+namespace Detail
+{
+#if defined(MENGINE_SIMD_SSE) || defined(MENGINE_SIMD_AVX2)
+// 旋转矩阵每一列写成 base + sign0 * (a * b) + sign1 * (c * d)，a/b/c/d 均为四元数分量的重排
+inline void ComposeTRSSSE(const float *translation, const float *rotation, const float *scale, float *out)
+{
+    const __m128 q = _mm_loadu_ps(rotation);
+    const __m128 q2 = _mm_add_ps(q, q);
+    // _MM_SHUFFLE 参数顺序为 (w, z, y, x)
+    // col0 = (1 - 2yy - 2zz, 2xy + 2wz, 2xz - 2wy)
+    __m128 ab0 = _mm_mul_ps(_mm_shuffle_ps(q, q, _MM_SHUFFLE(3, 0, 0, 1)), _mm_shuffle_ps(q2, q2, _MM_SHUFFLE(3, 2, 1, 1)));
+    __m128 cd0 = _mm_mul_ps(_mm_shuffle_ps(q, q, _MM_SHUFFLE(3, 3, 3, 2)), _mm_shuffle_ps(q2, q2, _MM_SHUFFLE(3, 1, 2, 2)));
+    ab0 = _mm_xor_ps(ab0, _mm_set_ps(0.0f, 0.0f, 0.0f, -0.0f));
+    cd0 = _mm_xor_ps(cd0, _mm_set_ps(0.0f, -0.0f, 0.0f, -0.0f));
+    __m128 col0 = _mm_add_ps(_mm_add_ps(_mm_set_ps(0.0f, 0.0f, 0.0f, 1.0f), ab0), cd0);
+    // col1 = (2xy - 2wz, 1 - 2xx - 2zz, 2yz + 2wx)
+    __m128 ab1 = _mm_mul_ps(_mm_shuffle_ps(q, q, _MM_SHUFFLE(3, 1, 0, 0)), _mm_shuffle_ps(q2, q2, _MM_SHUFFLE(3, 2, 0, 1)));
+    __m128 cd1 = _mm_mul_ps(_mm_shuffle_ps(q, q, _MM_SHUFFLE(3, 3, 2, 3)), _mm_shuffle_ps(q2, q2, _MM_SHUFFLE(3, 0, 2, 2)));
+    ab1 = _mm_xor_ps(ab1, _mm_set_ps(0.0f, 0.0f, -0.0f, 0.0f));
+    cd1 = _mm_xor_ps(cd1, _mm_set_ps(0.0f, 0.0f, -0.0f, -0.0f));
+    __m128 col1 = _mm_add_ps(_mm_add_ps(_mm_set_ps(0.0f, 0.0f, 1.0f, 0.0f), ab1), cd1);
+    // col2 = (2xz + 2wy, 2yz - 2wx, 1 - 2xx - 2yy)
+    __m128 ab2 = _mm_mul_ps(_mm_shuffle_ps(q, q, _MM_SHUFFLE(3, 0, 1, 0)), _mm_shuffle_ps(q2, q2, _MM_SHUFFLE(3, 0, 2, 2)));
+    __m128 cd2 = _mm_mul_ps(_mm_shuffle_ps(q, q, _MM_SHUFFLE(3, 1, 3, 3)), _mm_shuffle_ps(q2, q2, _MM_SHUFFLE(3, 1, 0, 1)));
+    ab2 = _mm_xor_ps(ab2, _mm_set_ps(0.0f, -0.0f, 0.0f, 0.0f));
+    cd2 = _mm_xor_ps(cd2, _mm_set_ps(0.0f, -0.0f, -0.0f, 0.0f));
+    __m128 col2 = _mm_add_ps(_mm_add_ps(_mm_set_ps(0.0f, 1.0f, 0.0f, 0.0f), ab2), cd2);
+    // 缩放同时把第四个分量清零
+    _mm_storeu_ps(out + 0, _mm_mul_ps(col0, _mm_set_ps(0.0f, scale[0], scale[0], scale[0])));
+    _mm_storeu_ps(out + 4, _mm_mul_ps(col1, _mm_set_ps(0.0f, scale[1], scale[1], scale[1])));
+    _mm_storeu_ps(out + 8, _mm_mul_ps(col2, _mm_set_ps(0.0f, scale[2], scale[2], scale[2])));
+    _mm_storeu_ps(out + 12, _mm_set_ps(1.0f, translation[2], translation[1], translation[0]));
+}
+
+// out = lhs * rhs，列主序
+inline void MultiplySSE(const float *lhs, const float *rhs, float *out)
+{
+    const __m128 l0 = _mm_loadu_ps(lhs + 0);
+    const __m128 l1 = _mm_loadu_ps(lhs + 4);
+    const __m128 l2 = _mm_loadu_ps(lhs + 8);
+    const __m128 l3 = _mm_loadu_ps(lhs + 12);
+    for (int column = 0; column < 4; column++)
+    {
+        const __m128 r = _mm_loadu_ps(rhs + column * 4);
+        __m128 result = _mm_mul_ps(l0, _mm_shuffle_ps(r, r, _MM_SHUFFLE(0, 0, 0, 0)));
+        result = _mm_add_ps(result, _mm_mul_ps(l1, _mm_shuffle_ps(r, r, _MM_SHUFFLE(1, 1, 1, 1))));
+        result = _mm_add_ps(result, _mm_mul_ps(l2, _mm_shuffle_ps(r, r, _MM_SHUFFLE(2, 2, 2, 2))));
+        result = _mm_add_ps(result, _mm_mul_ps(l3, _mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 3, 3, 3))));
+        _mm_storeu_ps(out + column * 4, result);
+    }
+}
+#endif
+
+#if defined(MENGINE_SIMD_AVX2)
+// 8 个变换一组按 SoA 计算，translations/scales 步长 3，rotations 步长 4
+inline void ComposeTRS8AVX2(const float *translations, const float *rotations, const float *scales, float *out)
+{
+    // 8 个四元数正好是两个 4x4 块，转置后得到 x/y/z/w 分量
+    __m128 q0 = _mm_loadu_ps(rotations + 0), q1 = _mm_loadu_ps(rotations + 4);
+    __m128 q2 = _mm_loadu_ps(rotations + 8), q3 = _mm_loadu_ps(rotations + 12);
+    __m128 q4 = _mm_loadu_ps(rotations + 16), q5 = _mm_loadu_ps(rotations + 20);
+    __m128 q6 = _mm_loadu_ps(rotations + 24), q7 = _mm_loadu_ps(rotations + 28);
+    _MM_TRANSPOSE4_PS(q0, q1, q2, q3);
+    _MM_TRANSPOSE4_PS(q4, q5, q6, q7);
+    const __m256 x = _mm256_set_m128(q4, q0);
+    const __m256 y = _mm256_set_m128(q5, q1);
+    const __m256 z = _mm256_set_m128(q6, q2);
+    const __m256 w = _mm256_set_m128(q7, q3);
+    const __m256 sx = _mm256_setr_ps(scales[0], scales[3], scales[6], scales[9], scales[12], scales[15], scales[18],
+                                     scales[21]);
+    const __m256 sy = _mm256_setr_ps(scales[1], scales[4], scales[7], scales[10], scales[13], scales[16], scales[19],
+                                     scales[22]);
+    const __m256 sz = _mm256_setr_ps(scales[2], scales[5], scales[8], scales[11], scales[14], scales[17], scales[20],
+                                     scales[23]);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 two = _mm256_set1_ps(2.0f);
+    const __m256 x2 = _mm256_mul_ps(x, two);
+    const __m256 y2 = _mm256_mul_ps(y, two);
+    const __m256 z2 = _mm256_mul_ps(z, two);
+    const __m256 xx = _mm256_mul_ps(x, x2);
+    const __m256 yy = _mm256_mul_ps(y, y2);
+    const __m256 zz = _mm256_mul_ps(z, z2);
+    const __m256 xy = _mm256_mul_ps(x, y2);
+    const __m256 xz = _mm256_mul_ps(x, z2);
+    const __m256 yz = _mm256_mul_ps(y, z2);
+    const __m256 wx = _mm256_mul_ps(w, x2);
+    const __m256 wy = _mm256_mul_ps(w, y2);
+    const __m256 wz = _mm256_mul_ps(w, z2);
+    // 3x3 旋转缩放部分，列主序
+    alignas(32) float m[9][8];
+    _mm256_store_ps(m[0], _mm256_mul_ps(_mm256_sub_ps(one, _mm256_add_ps(yy, zz)), sx));
+    _mm256_store_ps(m[1], _mm256_mul_ps(_mm256_add_ps(xy, wz), sx));
+    _mm256_store_ps(m[2], _mm256_mul_ps(_mm256_sub_ps(xz, wy), sx));
+    _mm256_store_ps(m[3], _mm256_mul_ps(_mm256_sub_ps(xy, wz), sy));
+    _mm256_store_ps(m[4], _mm256_mul_ps(_mm256_sub_ps(one, _mm256_add_ps(xx, zz)), sy));
+    _mm256_store_ps(m[5], _mm256_mul_ps(_mm256_add_ps(yz, wx), sy));
+    _mm256_store_ps(m[6], _mm256_mul_ps(_mm256_add_ps(xz, wy), sz));
+    _mm256_store_ps(m[7], _mm256_mul_ps(_mm256_sub_ps(yz, wx), sz));
+    _mm256_store_ps(m[8], _mm256_mul_ps(_mm256_sub_ps(one, _mm256_add_ps(xx, yy)), sz));
+    for (int i = 0; i < 8; i++)
+    {
+        float *matrix = out + i * 16;
+        const float *translation = translations + i * 3;
+        _mm_storeu_ps(matrix + 0, _mm_setr_ps(m[0][i], m[1][i], m[2][i], 0.0f));
+        _mm_storeu_ps(matrix + 4, _mm_setr_ps(m[3][i], m[4][i], m[5][i], 0.0f));
+        _mm_storeu_ps(matrix + 8, _mm_setr_ps(m[6][i], m[7][i], m[8][i], 0.0f));
+        _mm_storeu_ps(matrix + 12, _mm_setr_ps(translation[0], translation[1], translation[2], 1.0f));
+    }
+}
+
+// 每次处理右矩阵的两列：左矩阵的列广播到两个 128 位通道
+inline void MultiplyAVX2(const __m256 l0, const __m256 l1, const __m256 l2, const __m256 l3, const float *rhs,
+                         float *out)
+{
+    for (int column = 0; column < 4; column += 2)
+    {
+        const __m256 r = _mm256_loadu_ps(rhs + column * 4);
+        __m256 result = _mm256_mul_ps(l0, _mm256_permute_ps(r, _MM_SHUFFLE(0, 0, 0, 0)));
+        result = _mm256_add_ps(result, _mm256_mul_ps(l1, _mm256_permute_ps(r, _MM_SHUFFLE(1, 1, 1, 1))));
+        result = _mm256_add_ps(result, _mm256_mul_ps(l2, _mm256_permute_ps(r, _MM_SHUFFLE(2, 2, 2, 2))));
+        result = _mm256_add_ps(result, _mm256_mul_ps(l3, _mm256_permute_ps(r, _MM_SHUFFLE(3, 3, 3, 3))));
+        _mm256_storeu_ps(out + column * 4, result);
+    }
+}
+#endif
+} // namespace Detail
+
+/**
+ * @brief 由平移、旋转、缩放构建模型矩阵，等价于 translate * mat4_cast * scale
+ */
+inline glm::mat4 ComposeTRS(const glm::vec3 &translation, const glm::quat &rotation, const glm::vec3 &scale)
+{
+#if defined(MENGINE_SIMD_SSE) || defined(MENGINE_SIMD_AVX2)
+    glm::mat4 result;
+    Detail::ComposeTRSSSE(&translation.x, &rotation.x, &scale.x, &result[0][0]);
+    return result;
+#else
+    return ComposeTRSScalar(translation, rotation, scale);
+#endif
+}
+
+/**
+ * @brief 矩阵乘法 lhs * rhs
+ */
+inline glm::mat4 Multiply(const glm::mat4 &lhs, const glm::mat4 &rhs)
+{
+#if defined(MENGINE_SIMD_SSE) || defined(MENGINE_SIMD_AVX2)
+    glm::mat4 result;
+    Detail::MultiplySSE(&lhs[0][0], &rhs[0][0], &result[0][0]);
+    return result;
+#else
+    return lhs * rhs;
+#endif
+}
+
+/**
+ * @brief 批量构建模型矩阵，out 可容纳 count 个矩阵
+ */
+inline void ComposeTRSBatch(const glm::vec3 *translations, const glm::quat *rotations, const glm::vec3 *scales,
+                            glm::mat4 *out, size_t count)
+{
+    size_t i = 0;
+#if defined(MENGINE_SIMD_AVX2)
+    for (; i + 8 <= count; i += 8)
+    {
+        Detail::ComposeTRS8AVX2(&translations[i].x, &rotations[i].x, &scales[i].x, &out[i][0][0]);
+    }
+#endif
+    for (; i < count; i++)
+    {
+        out[i] = ComposeTRS(translations[i], rotations[i], scales[i]);
+    }
+}
+
+/**
+ * @brief 批量左乘视图投影矩阵：out[i] = viewProjection * models[i]，out 可与 models 相同
+ */
+inline void PremultiplyBatch(const glm::mat4 &viewProjection, const glm::mat4 *models, glm::mat4 *out, size_t count)
+{
+#if defined(MENGINE_SIMD_AVX2)
+    const float *vp = &viewProjection[0][0];
+    const __m256 l0 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(vp + 0));
+    const __m256 l1 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(vp + 4));
+    const __m256 l2 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(vp + 8));
+    const __m256 l3 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(vp + 12));
+    for (size_t i = 0; i < count; i++)
+    {
+        Detail::MultiplyAVX2(l0, l1, l2, l3, &models[i][0][0], &out[i][0][0]);
+    }
+#elif defined(MENGINE_SIMD_SSE)
+    for (size_t i = 0; i < count; i++)
+    {
+        Detail::MultiplySSE(&viewProjection[0][0], &models[i][0][0], &out[i][0][0]);
+    }
+#else
+    for (size_t i = 0; i < count; i++)
+    {
+        out[i] = viewProjection * models[i];
+    }
+#endif
+}
+} // namespace MEngine::Math
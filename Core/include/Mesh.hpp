@@ -1,25 +1,146 @@
 #pragma once
-#include "Buffer.hpp"
-#include "BufferFactory.hpp"
+#include "Bounds.hpp"
+#include "GeometryArena.hpp"
 #include "MEngine.hpp"
+#include "NoCopyable.hpp"
 #include "Vertex.hpp"
+#include "VertexQuantization.hpp"
+#include "glm/glm.hpp"
+#include <algorithm>
+#include <span>
+#include <vector>
 
 namespace MEngine
 {
-class Mesh
+/**
+ * @brief 网格数据上传后是否在 CPU 端保留一份
+ */
+enum class MeshResidency
+{
+    GPUOnly,  // 上传后不保留 CPU 数据，只保留索引数量与包围体
+    Retained, // 保留顶点与索引，供拾取、物理、BVH 构建等 CPU 端使用
+};
+/**
+ * @brief 所有存活网格的内存占用
+ */
+struct MeshMemoryStats
+{
+    uint32_t meshes = 0;
+    uint32_t retainedMeshes = 0;
+    uint64_t gpuBytes = 0;
+    uint64_t cpuBytes = 0;
+    // GPUOnly 网格如果保留 CPU 数据需要额外占用的字节数
+    uint64_t savedCPUBytes = 0;
+};
+/**
+ * @brief 一级 LOD 在共享索引缓冲区中的区间，所有 LOD 共用同一组顶点
+ */
+struct MeshLOD
+{
+    uint32_t firstIndex = 0;
+    uint32_t indexCount = 0;
+    float error = 0.0f; // 模型空间几何误差，LOD0 为 0
+};
+/**
+ * @brief 构造时传入的较粗 LOD，索引指向与 LOD0 相同的顶点数组（GenerateLODChain 的结果）
+ */
+struct MeshLODSource
+{
+    std::span<const uint32_t> indices;
+    float error = 0.0f;
+};
+/**
+ * @brief 网格数据位于 GeometryArena 的共享缓冲区中，绘制时使用 GetVertexOffset/GetFirstIndex 定位
+ * Quantized 格式的顶点位于 snorm 空间，绘制时模型矩阵需要右乘 GetDequantizeMatrix()。
+ */
+class Mesh final : public NoCopyable
 {
   private:
+    // 仅 Retained 模式非空
     std::vector<Vertex> mVertices;
     std::vector<uint32_t> mIndices;
-    UniqueBuffer mVertexBuffer; // Vulkan 顶点缓冲区（由资源管理器填充）
-    UniqueBuffer mIndexBuffer;  // Vulkan 索引缓冲区
-    std::shared_ptr<BufferFactory> mBufferFactory;
+    MeshResidency mResidency;
+    VertexFormat mVertexFormat;
+    VertexQuantization mQuantization; // 仅 Quantized 格式有效
+    std::shared_ptr<GeometryArena> mGeometryArena;
+    GeometryAllocation mAllocation;
+    std::vector<MeshLOD> mLODs; // 至少包含 LOD0，由细到粗
+    vk::Buffer mVertexBuffer; // 所在页的顶点缓冲区，与其他网格共享
+    vk::Buffer mIndexBuffer;  // 所在页的索引缓冲区
+    AABB mBoundingBox;              // 模型空间包围盒
+    BoundingSphere mBoundingSphere; // 模型空间包围球
+
+  private:
+    /**
+     * @brief Retained 模式在 CPU 端保留的字节数（Vertex 顶点与 LOD0 索引），与实际 GPU 布局无关
+     */
+    uint64_t GetRetainedMemorySize() const;
 
   public:
-    Mesh(std::shared_ptr<BufferFactory> bufferFactory, const std::vector<Vertex> &vertices,
-         const std::vector<uint32_t> &indices);
+    /**
+     * @brief vertices/indices 只在构造期间读取，可以直接指向 ParseMeshContainer 返回的映射内存
+     * indices 为 LOD0，lods 为按由细到粗排列的其余 LOD，所有索引与 LOD0 放在同一段索引区间中
+     */
+    Mesh(std::shared_ptr<GeometryArena> geometryArena, std::span<const Vertex> vertices,
+         std::span<const uint32_t> indices, MeshResidency residency = MeshResidency::GPUOnly,
+         VertexFormat format = VertexFormat::Standard, std::span<const MeshLODSource> lods = {});
+    ~Mesh();
+    /**
+     * @brief CPU 端的顶点与 LOD0 索引，GPUOnly 网格返回空数组
+     */
+    inline const std::vector<Vertex> &GetVertices() const
+    {
+        return mVertices;
+    }
+    inline const std::vector<uint32_t> &GetIndices() const
+    {
+        return mIndices;
+    }
+    inline MeshResidency GetResidency() const
+    {
+        return mResidency;
+    }
+    inline VertexFormat GetVertexFormat() const
+    {
+        return mVertexFormat;
+    }
+    /**
+     * @brief 顶点缓冲区坐标到网格局部空间的变换，Standard 格式为单位矩阵
+     */
+    glm::mat4 GetDequantizeMatrix() const;
+    uint64_t GetGPUMemorySize() const;
+    uint64_t GetCPUMemorySize() const;
+    static MeshMemoryStats GetMemoryStats();
     vk::Buffer GetVertexBuffer() const;
     vk::Buffer GetIndexBuffer() const;
+    /**
+     * @brief LOD0 的索引数量
+     */
     uint32_t GetIndexCount() const;
+    /**
+     * @brief drawIndexed 的 vertexOffset，加到网格局部的索引值上
+     */
+    int32_t GetVertexOffset() const;
+    /**
+     * @brief LOD0 在 drawIndexed 中的 firstIndex
+     */
+    uint32_t GetFirstIndex() const;
+    inline uint32_t GetLODCount() const
+    {
+        return static_cast<uint32_t>(mLODs.size());
+    }
+    /**
+     * @brief level 超出范围时返回最粗的一级
+     */
+    inline const MeshLOD &GetLOD(uint32_t level) const
+    {
+        return mLODs[std::min<size_t>(level, mLODs.size() - 1)];
+    }
+    inline const GeometryAllocation &GetAllocation() const
+    {
+        return mAllocation;
+    }
+    const AABB &GetBoundingBox() const;
+    const BoundingSphere &GetBoundingSphere() const;
 };
 } // namespace MEngine
\ No newline at end of file
@@ -36,6 +36,10 @@ class PBRMaterialRepository : public Repository<PBRMaterial>
                           std::shared_ptr<Texture2DRepository> texture2DRepository,
                           std::shared_ptr<BufferFactory> bufferFactory);
     bool Update(const UUID &id, const PBRMaterial &delta) override;
+    /**
+     * @brief 取出材质当前的描述符集，下一次 Update 会分配新的集合而不是改写仍可能被在途帧使用的旧集合
+     */
+    vk::UniqueDescriptorSet DetachDescriptorSet(const UUID &id);
     bool CheckValidate(const std::filesystem::path &filePath) const override;
     bool CheckValidate(const PBRMaterial &delta) const override;
 };
@@ -4,31 +4,131 @@
 #include "Entity/Texture2D.hpp"
 #include "Interface/IConfigure.hpp"
 #include "Interface/ILogger.hpp"
+#include "MappedFile.hpp"
 #include "Repository/Repository.hpp"
+#include "TaskScheduler.hpp"
+#include "TextureContainer.hpp"
 #include "stb_image.h"
+#include <array>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
 #include <vector>
 
 namespace MEngine
 {
+/**
+ * @brief 所有纹理共享的默认纹理，真实数据就绪前或缺少贴图时采样
+ */
+enum class FallbackTexture
+{
+    Checker,    // 缺失/加载中的颜色纹理
+    White,      // 乘法类贴图（颜色、AO、金属度粗糙度）的单位值
+    Black,      // 加法类贴图（自发光）的零值
+    FlatNormal, // 切线空间 (0, 0, 1)，线性格式
+    Count
+};
 class Texture2DRepository final : public Repository<Texture2D>
 {
+  public:
+    /**
+     * @brief 被新图像替换下来的资源，可能仍被在途的帧引用
+     */
+    struct RetiredTexture
+    {
+        UniqueImage image;
+        vk::UniqueImageView imageView;
+        SharedSampler sampler;
+    };
+
   private:
     // DI
     std::shared_ptr<ImageFactory> mImageFactory;
     std::shared_ptr<SamplerManager> mSamplerManager;
 
   private:
-    std::vector<unsigned char> mCheckBoardData;
+    struct StbiDeleter
+    {
+        void operator()(stbi_uc *data) const
+        {
+            stbi_image_free(data);
+        }
+    };
+    struct DecodedTexture
+    {
+        UUID id;
+        uint64_t request;
+        std::filesystem::path path;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        std::unique_ptr<stbi_uc, StbiDeleter> pixels;
+        // .mtex 烘焙纹理：映射保持到拷贝进暂存缓冲区为止，container 指向映射内存
+        std::unique_ptr<MappedFile> mapping;
+        std::optional<TextureContainerView> container;
+    };
+    // 工作线程解码完成后放入，主线程在 ProcessDecodedTextures 中取出上传；
+    // 由解码任务共同持有，仓库先于任务销毁时结果被丢弃
+    struct DecodeQueue
+    {
+        std::mutex mutex;
+        std::vector<DecodedTexture> decoded;
+    };
+
+    struct SharedTexture
+    {
+        UniqueImage image;
+        vk::UniqueImageView imageView;
+        SharedSampler sampler;
+    };
+    // 构造时创建一次，新纹理在真实数据加载前引用这些图像，不再各自分配
+    std::array<SharedTexture, static_cast<size_t>(FallbackTexture::Count)> mFallbackTextures;
+    std::shared_ptr<DecodeQueue> mDecodeQueue = std::make_shared<DecodeQueue>();
+    // 每个纹理最近一次解码请求的序号，重复 Update 时丢弃过期结果
+    std::unordered_map<UUID, uint64_t> mDecodeRequests;
+    uint64_t mNextDecodeRequest = 0;
 
   public:
     Texture2DRepository(std::shared_ptr<ILogger> logger, std::shared_ptr<Context> context,
                         std::shared_ptr<IConfigure> configure, std::shared_ptr<ImageFactory> imageFactory,
                         std::shared_ptr<SamplerManager> samplerManager);
     Texture2D *Create() override;
+    /**
+     * @brief 创建不持有图像的纹理，Update 加载完成前采样 fallback
+     */
+    Texture2D *Create(FallbackTexture fallback);
+    /**
+     * @brief 更新纹理路径并在 TaskScheduler 上异步解码，完成前纹理采样占位图
+     * .png 在工作线程解压；.mtex 在工作线程映射并校验，上传时各级 mip 直接从映射拷贝到暂存缓冲区
+     */
     bool Update(const UUID &id, const Texture2D &delta) override;
+    /**
+     * @brief 在主线程取出已解码的纹理，合并为一次上传并替换图像，返回本次完成的纹理
+     * 新图像的上传由渲染提交在时间线信号量上等待；被替换的旧资源移入 retired，由调用方在 GPU 不再使用后释放
+     */
+    std::vector<UUID> ProcessDecodedTextures(std::vector<RetiredTexture> &retired);
+    inline bool HasPendingDecodes() const
+    {
+        return !mDecodeRequests.empty();
+    }
+    /**
+     * @brief 是否有解码完成、等待 ProcessDecodedTextures 处理的结果
+     */
+    bool HasDecodedTextures() const;
     bool CheckValidate(const std::filesystem::path &filePath) const override;
     bool CheckValidate(const Texture2D &delta) const override;
-    std::vector<unsigned char> CheckBoard();
+    inline vk::ImageView GetFallbackImageView(FallbackTexture fallback) const
+    {
+        return mFallbackTextures[static_cast<size_t>(fallback)].imageView.get();
+    }
+    inline vk::Sampler GetFallbackSampler(FallbackTexture fallback) const
+    {
+        return mFallbackTextures[static_cast<size_t>(fallback)].sampler->get();
+    }
+    static std::vector<unsigned char> CheckBoard(uint32_t size = 256, uint32_t grid = 8);
+
+  private:
+    void CreateFallbackTextures();
 };
 } // namespace MEngine
\ No newline at end of file
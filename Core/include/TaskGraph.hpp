@@ -0,0 +1,100 @@
+#pragma once
+#include "MEngine.hpp"
+#include "TaskScheduler.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <typeindex>
+#include <vector>
+
+namespace MEngine
+{
+/**
+ * @brief 节点访问的数据集合，用于推导依赖
+ */
+struct TaskAccess
+{
+    std::vector<std::type_index> reads;
+    std::vector<std::type_index> writes;
+    // 需要在调用 Execute 的线程上执行（SDL、ImGui、交换链等）
+    bool mainThread = false;
+
+    template <typename... T> TaskAccess &Read()
+    {
+        (reads.emplace_back(typeid(T)), ...);
+        return *this;
+    }
+    template <typename... T> TaskAccess &Write()
+    {
+        (writes.emplace_back(typeid(T)), ...);
+        return *this;
+    }
+    TaskAccess &MainThread()
+    {
+        mainThread = true;
+        return *this;
+    }
+};
+
+/**
+ * @brief 帧任务图
+ * 按添加顺序根据读写集合推导依赖（写后读、读后写、写后写），
+ * 无冲突的节点在 TaskScheduler 上并行执行，节点完成时以延续方式派发后继节点。
+ */
+class TaskGraph final
+{
+  public:
+    using NodeHandle = uint32_t;
+
+  private:
+    struct Node
+    {
+        std::string name;
+        std::function<void()> work;
+        TaskAccess access;
+        std::vector<NodeHandle> successors;
+        uint32_t predecessorCount = 0;
+        std::atomic<uint32_t> pending{0};
+    };
+    std::vector<std::unique_ptr<Node>> mNodes;
+    std::vector<std::pair<NodeHandle, NodeHandle>> mExplicitDependencies;
+    bool mIsBuilt = false;
+
+    // 每次 Execute 的运行状态
+    std::atomic<uint32_t> mRemaining{0};
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    std::queue<NodeHandle> mMainThreadQueue;
+    std::exception_ptr mException;
+
+    void Dispatch(NodeHandle handle);
+    void RunNode(NodeHandle handle);
+    static bool Conflicts(const TaskAccess &before, const TaskAccess &after);
+
+  public:
+    TaskGraph() = default;
+    TaskGraph(const TaskGraph &) = delete;
+    TaskGraph &operator=(const TaskGraph &) = delete;
+
+    NodeHandle AddNode(const std::string &name, std::function<void()> &&work, const TaskAccess &access);
+    /**
+     * @brief 显式依赖，用于读写集合无法表达的顺序
+     */
+    void AddDependency(NodeHandle before, NodeHandle after);
+    void Build();
+    /**
+     * @brief 执行一次任务图，所有节点完成后返回，节点抛出的第一个异常在此重新抛出
+     */
+    void Execute();
+    void Clear();
+
+    size_t GetNodeCount() const noexcept;
+    const std::string &GetNodeName(NodeHandle handle) const;
+    const std::vector<NodeHandle> &GetSuccessors(NodeHandle handle) const;
+};
+} // namespace MEngine
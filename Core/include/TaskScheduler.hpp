@@ -1,11 +1,14 @@
 #pragma once
 #include "MEngine.hpp"
+#include "WorkStealingDeque.hpp"
+#include <atomic>
 #include <condition_variable>
 #include <cstdint>
 #include <functional>
 #include <memory>
 #include <mutex>
 #include <queue>
+#include <random>
 #include <string>
 #include <thread>
 #include <vector>
@@ -20,6 +23,11 @@ class Task
     std::function<void()> mTask;
     std::mutex mMutex;
     std::condition_variable mCondition;
+    // 入队后由调度器持有，保证执行前不被释放
+    std::shared_ptr<Task> mKeepAlive;
+
+    void Invoke() noexcept;
+    void Finish();
 
   public:
     Task(std::function<void()> &&task);
@@ -31,6 +39,9 @@ class Task
 
     void Execute();
     bool IsDone() const noexcept;
+    /**
+     * @brief 等待任务完成，在工作线程中调用时会帮忙执行其他任务而不是阻塞
+     */
     void Wait();
 
     static std::shared_ptr<Task> Run(std::function<void()> &&task);
@@ -38,31 +49,71 @@ class Task
     // static void WhenAny(std::vector<std::shared_ptr<Task>> tasks);
 };
 
+/**
+ * @brief 工作窃取调度器
+ * 每个工作线程拥有一个 Chase-Lev 双端队列，工作线程内提交的任务压入自己的队列，
+ * 外部线程提交的任务进入注入队列（容量为 taskCount，满时阻塞生产者），
+ * 空闲的工作线程随机选择受害者窃取任务。
+ */
 class TaskScheduler final
 {
   private:
-    uint32_t mThreadCount;
-    uint32_t mTaskCount;
-    std::vector<std::thread> mWorkers;
-    std::queue<std::shared_ptr<Task>> mTasks;
-    std::atomic<bool> mStop;
+    struct Worker
+    {
+        WorkStealingDeque<Task *> deque;
+        std::thread thread;
+    };
+    static thread_local int32_t sWorkerIndex;
+
+    uint32_t mThreadCount{0};
+    uint32_t mTaskCount{0};
+    std::vector<std::unique_ptr<Worker>> mWorkers;
+    // 外部线程提交的任务
+    std::queue<Task *> mInjectQueue;
+    std::atomic<uint32_t> mInjectCount{0};
+    std::mutex mMutex;
     std::condition_variable mNotFull;
-    std::condition_variable mNotEmpty;
+    // 空闲工作线程休眠
+    std::mutex mSleepMutex;
+    std::condition_variable mWakeUp;
+    std::atomic<uint32_t> mSleepers{0};
+    std::atomic<uint64_t> mWorkEpoch{0};
+
+    std::atomic<bool> mStop{false};
     std::atomic<uint32_t> mPendingTasks{0};
-    std::mutex mMutex;
+    std::atomic<uint64_t> mStealCount{0};
     TaskScheduler() = default;
     TaskScheduler(const TaskScheduler &) = delete;
     TaskScheduler &operator=(const TaskScheduler &) = delete;
     TaskScheduler(TaskScheduler &&) = delete;
     TaskScheduler &operator=(TaskScheduler &&) = delete;
 
+    void WorkerLoop(uint32_t index);
+    Task *FindTask(int32_t index, std::minstd_rand &random);
+    Task *TakeFromInjectQueue(int32_t index);
+    void RunTask(Task *task);
+    void NotifyWork();
+    void Shutdown();
+
   public:
     ~TaskScheduler();
     static TaskScheduler &Instance();
+    /**
+     * @brief 初始化调度器，重复调用会先等待并回收旧的工作线程
+     * @param threadCount 工作线程数
+     * @param taskCount 外部注入队列容量
+     */
     void Initialize(uint32_t threadCount, uint32_t taskCount);
     uint32_t GetThreadCount() const noexcept;
     uint32_t GetTaskCount() const noexcept;
     uint32_t GetPendingTasks() const noexcept;
+    uint64_t GetStealCount() const noexcept;
+    bool IsWorkerThread() const noexcept;
     void AddTask(std::shared_ptr<Task> task);
+    /**
+     * @brief 在当前线程执行一个待处理任务
+     * @return 是否执行了任务
+     */
+    bool TryRunPendingTask();
 };
-} // namespace MEngine
\ No newline at end of file
+} // namespace MEngine
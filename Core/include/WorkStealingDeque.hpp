@@ -0,0 +1,171 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace MEngine
+{
+/**
+ * @brief Chase-Lev 无锁工作窃取双端队列
+ * 所有者线程在底部 Push/Pop（LIFO），其他线程从顶部 Steal（FIFO）。
+ * 参考 Lê et al. "Correct and Efficient Work-Stealing for Weak Memory Models" (PPoPP 2013)
+ * @tparam T 必须可平凡复制（通常是指针）
+ */
+template <typename T> class WorkStealingDeque final
+{
+    static_assert(std::is_trivially_copyable_v<T>, "WorkStealingDeque requires a trivially copyable type");
+
+  private:
+    class Array
+    {
+      private:
+        int64_t mCapacity;
+        int64_t mMask;
+        std::unique_ptr<std::atomic<T>[]> mData;
+
+      public:
+        explicit Array(int64_t capacity)
+            : mCapacity(capacity), mMask(capacity - 1), mData(std::make_unique<std::atomic<T>[]>(capacity))
+        {
+        }
+        int64_t Capacity() const noexcept
+        {
+            return mCapacity;
+        }
+        void Put(int64_t index, T item) noexcept
+        {
+            mData[index & mMask].store(item, std::memory_order_relaxed);
+        }
+        T Get(int64_t index) const noexcept
+        {
+            return mData[index & mMask].load(std::memory_order_relaxed);
+        }
+        Array *Grow(int64_t bottom, int64_t top) const
+        {
+            auto *array = new Array(mCapacity * 2);
+            for (int64_t i = top; i != bottom; ++i)
+            {
+                array->Put(i, Get(i));
+            }
+            return array;
+        }
+    };
+
+    alignas(64) std::atomic<int64_t> mTop{0};
+    alignas(64) std::atomic<int64_t> mBottom{0};
+    alignas(64) std::atomic<Array *> mArray;
+    // 扩容后的旧数组可能仍被窃取者读取，延迟到析构时释放（仅所有者线程修改）
+    std::vector<std::unique_ptr<Array>> mRetired;
+
+  public:
+    explicit WorkStealingDeque(int64_t capacity = 1024)
+    {
+        if (capacity <= 0 || (capacity & (capacity - 1)) != 0)
+        {
+            throw std::invalid_argument("WorkStealingDeque capacity must be a power of two");
+        }
+        mArray.store(new Array(capacity), std::memory_order_relaxed);
+    }
+    WorkStealingDeque(const WorkStealingDeque &) = delete;
+    WorkStealingDeque &operator=(const WorkStealingDeque &) = delete;
+    WorkStealingDeque(WorkStealingDeque &&) = delete;
+    WorkStealingDeque &operator=(WorkStealingDeque &&) = delete;
+    ~WorkStealingDeque()
+    {
+        delete mArray.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 压入底部，仅所有者线程调用
+     */
+    void Push(T item)
+    {
+        int64_t bottom = mBottom.load(std::memory_order_relaxed);
+        int64_t top = mTop.load(std::memory_order_acquire);
+        Array *array = mArray.load(std::memory_order_relaxed);
+        if (bottom - top > array->Capacity() - 1)
+        {
+            Array *grown = array->Grow(bottom, top);
+            mRetired.emplace_back(array);
+            mArray.store(grown, std::memory_order_release);
+            array = grown;
+        }
+        array->Put(bottom, item);
+        mBottom.store(bottom + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief 从底部弹出，仅所有者线程调用
+     */
+    std::optional<T> Pop()
+    {
+        int64_t bottom = mBottom.load(std::memory_order_relaxed) - 1;
+        Array *array = mArray.load(std::memory_order_relaxed);
+        mBottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = mTop.load(std::memory_order_relaxed);
+        if (top > bottom)
+        {
+            mBottom.store(bottom + 1, std::memory_order_relaxed);
+            return std::nullopt;
+        }
+        T item = array->Get(bottom);
+        if (top == bottom)
+        {
+            // 最后一个元素，与窃取者竞争
+            bool won = mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                    std::memory_order_relaxed);
+            mBottom.store(bottom + 1, std::memory_order_relaxed);
+            if (!won)
+            {
+                return std::nullopt;
+            }
+        }
+        return item;
+    }
+
+    /**
+     * @brief 从顶部窃取，任意线程调用
+     */
+    std::optional<T> Steal()
+    {
+        int64_t top = mTop.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t bottom = mBottom.load(std::memory_order_acquire);
+        if (top >= bottom)
+        {
+            return std::nullopt;
+        }
+        Array *array = mArray.load(std::memory_order_acquire);
+        T item = array->Get(top);
+        if (!mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+            return std::nullopt;
+        }
+        return item;
+    }
+
+    /**
+     * @brief 近似大小，仅用于调度提示
+     */
+    int64_t Size() const noexcept
+    {
+        int64_t bottom = mBottom.load(std::memory_order_relaxed);
+        int64_t top = mTop.load(std::memory_order_relaxed);
+        return bottom > top ? bottom - top : 0;
+    }
+    bool Empty() const noexcept
+    {
+        return Size() == 0;
+    }
+    int64_t Capacity() const noexcept
+    {
+        return mArray.load(std::memory_order_relaxed)->Capacity();
+    }
+};
+} // namespace MEngine
@@ -0,0 +1,401 @@
+#include "BVH.hpp"
+#include <algorithm>
+#include <array>
+
+namespace MEngine
+{
+void BVH::Build(const std::vector<AABB> &bounds, const std::vector<uint32_t> &ids)
+{
+    if (bounds.size() != ids.size())
+    {
+        throw std::invalid_argument("BVH::Build bounds and ids must have the same size");
+    }
+    Clear();
+    if (bounds.empty())
+    {
+        return;
+    }
+    uint32_t primitiveCount = static_cast<uint32_t>(bounds.size());
+    mPrimitiveBounds = bounds;
+    mPrimitiveIds = ids;
+    mCentroids.resize(primitiveCount);
+    mPrimitiveLeaves.assign(primitiveCount, InvalidIndex);
+    mIndices.resize(primitiveCount);
+    for (uint32_t i = 0; i < primitiveCount; i++)
+    {
+        mCentroids[i] = bounds[i].GetCenter();
+        mIndices[i] = i;
+    }
+    // 每次划分产生两个非空子节点，节点数不超过 2n - 1，预先分配后各线程只写自己的节点
+    mNodes.assign(2 * primitiveCount - 1, Node{});
+    mNodes[0].leftFirst = 0;
+    mNodes[0].count = primitiveCount;
+    std::atomic<uint32_t> nodeCount{1};
+    Subdivide(0, nodeCount);
+    mNodeCount = nodeCount.load();
+    mNodes.resize(mNodeCount);
+    mBuildSurfaceArea = mNodes[0].bounds.SurfaceArea();
+}
+void BVH::Subdivide(uint32_t nodeIndex, std::atomic<uint32_t> &nodeCount)
+{
+    Node &node = mNodes[nodeIndex];
+    uint32_t first = node.leftFirst;
+    uint32_t count = node.count;
+    // 1. 节点包围盒与质心包围盒
+    AABB centroidBounds;
+    node.bounds = AABB{};
+    for (uint32_t i = first; i < first + count; i++)
+    {
+        node.bounds.Merge(mPrimitiveBounds[mIndices[i]]);
+        centroidBounds.Expand(mCentroids[mIndices[i]]);
+    }
+    auto makeLeaf = [this, &node, nodeIndex, first, count]() {
+        node.leftFirst = first;
+        node.count = count;
+        for (uint32_t i = first; i < first + count; i++)
+        {
+            mPrimitiveLeaves[mIndices[i]] = nodeIndex;
+        }
+    };
+    if (count <= mMaxLeafSize)
+    {
+        makeLeaf();
+        return;
+    }
+    // 2. 分桶 SAH：代价 = 1 + (左数量 * 左面积 + 右数量 * 右面积) / 父面积，叶节点代价 = 数量
+    struct Bin
+    {
+        AABB bounds;
+        uint32_t count = 0;
+    };
+    float bestCost = std::numeric_limits<float>::max();
+    int bestAxis = -1;
+    uint32_t bestSplit = 0;
+    glm::vec3 centroidExtent = centroidBounds.max - centroidBounds.min;
+    for (int axis = 0; axis < 3; axis++)
+    {
+        float extent = centroidExtent[axis];
+        if (extent <= 0.0f)
+        {
+            continue;
+        }
+        std::array<Bin, mBinCount> bins{};
+        float scale = mBinCount / extent;
+        for (uint32_t i = first; i < first + count; i++)
+        {
+            uint32_t primitive = mIndices[i];
+            uint32_t bin = std::min(mBinCount - 1,
+                                    static_cast<uint32_t>((mCentroids[primitive][axis] - centroidBounds.min[axis]) * scale));
+            bins[bin].count++;
+            bins[bin].bounds.Merge(mPrimitiveBounds[primitive]);
+        }
+        // 从右向左累积，再从左向右扫描各个划分平面
+        std::array<float, mBinCount> rightCost{};
+        AABB rightBounds;
+        uint32_t rightCount = 0;
+        for (uint32_t bin = mBinCount - 1; bin > 0; bin--)
+        {
+            rightBounds.Merge(bins[bin].bounds);
+            rightCount += bins[bin].count;
+            rightCost[bin] = rightCount == 0 ? 0.0f : rightCount * rightBounds.SurfaceArea();
+        }
+        AABB leftBounds;
+        uint32_t leftCount = 0;
+        for (uint32_t split = 1; split < mBinCount; split++)
+        {
+            leftBounds.Merge(bins[split - 1].bounds);
+            leftCount += bins[split - 1].count;
+            if (leftCount == 0 || leftCount == count)
+            {
+                continue;
+            }
+            float cost = leftCount * leftBounds.SurfaceArea() + rightCost[split];
+            if (cost < bestCost)
+            {
+                bestCost = cost;
+                bestAxis = axis;
+                bestSplit = split;
+            }
+        }
+    }
+    // 3. 划分图元
+    uint32_t leftCount = 0;
+    if (bestAxis >= 0)
+    {
+        float parentArea = std::max(node.bounds.SurfaceArea(), std::numeric_limits<float>::min());
+        if (1.0f + bestCost / parentArea >= static_cast<float>(count))
+        {
+            makeLeaf();
+            return;
+        }
+        float minimum = centroidBounds.min[bestAxis];
+        float scale = mBinCount / centroidExtent[bestAxis];
+        auto middle = std::partition(mIndices.begin() + first, mIndices.begin() + first + count,
+                                     [&](uint32_t primitive) {
+                                         uint32_t bin = std::min(
+                                             mBinCount - 1,
+                                             static_cast<uint32_t>((mCentroids[primitive][bestAxis] - minimum) * scale));
+                                         return bin < bestSplit;
+                                     });
+        leftCount = static_cast<uint32_t>(middle - (mIndices.begin() + first));
+    }
+    if (leftCount == 0 || leftCount == count)
+    {
+        // 质心重合，无法按空间划分，按数量对半分
+        leftCount = count / 2;
+    }
+    // 4. 创建子节点并递归
+    uint32_t left = nodeCount.fetch_add(2);
+    mNodes[left] = Node{AABB{}, first, leftCount, nodeIndex};
+    mNodes[left + 1] = Node{AABB{}, first + leftCount, count - leftCount, nodeIndex};
+    node.leftFirst = left;
+    node.count = 0;
+    if (count > mParallelThreshold)
+    {
+        auto task = Task::Run([this, left, &nodeCount]() { Subdivide(left, nodeCount); });
+        Subdivide(left + 1, nodeCount);
+        task->Wait();
+    }
+    else
+    {
+        Subdivide(left, nodeCount);
+        Subdivide(left + 1, nodeCount);
+    }
+}
+void BVH::Clear()
+{
+    mNodes.clear();
+    mNodeCount = 0;
+    mPrimitiveBounds.clear();
+    mCentroids.clear();
+    mPrimitiveIds.clear();
+    mPrimitiveLeaves.clear();
+    mIndices.clear();
+    mDirtyLeaves.clear();
+    mBuildSurfaceArea = 0.0f;
+}
+void BVH::Update(uint32_t primitive, const AABB &bounds)
+{
+    if (primitive >= mPrimitiveBounds.size())
+    {
+        throw std::out_of_range("BVH::Update primitive index out of range");
+    }
+    mPrimitiveBounds[primitive] = bounds;
+    mCentroids[primitive] = bounds.GetCenter();
+    mDirtyLeaves.push_back(mPrimitiveLeaves[primitive]);
+}
+void BVH::UpdateLeafBounds(uint32_t nodeIndex)
+{
+    Node &node = mNodes[nodeIndex];
+    node.bounds = AABB{};
+    for (uint32_t i = node.leftFirst; i < node.leftFirst + node.count; i++)
+    {
+        node.bounds.Merge(mPrimitiveBounds[mIndices[i]]);
+    }
+}
+void BVH::Refit()
+{
+    if (mDirtyLeaves.empty())
+    {
+        return;
+    }
+    // 子节点总在父节点之后分配，按下标从大到小处理即为自底向上
+    std::vector<uint32_t> nodes;
+    std::sort(mDirtyLeaves.begin(), mDirtyLeaves.end());
+    mDirtyLeaves.erase(std::unique(mDirtyLeaves.begin(), mDirtyLeaves.end()), mDirtyLeaves.end());
+    for (uint32_t leaf : mDirtyLeaves)
+    {
+        for (uint32_t current = leaf; current != InvalidIndex; current = mNodes[current].parent)
+        {
+            nodes.push_back(current);
+        }
+    }
+    std::sort(nodes.begin(), nodes.end(), std::greater<>());
+    nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+    for (uint32_t nodeIndex : nodes)
+    {
+        Node &node = mNodes[nodeIndex];
+        if (node.IsLeaf())
+        {
+            UpdateLeafBounds(nodeIndex);
+        }
+        else
+        {
+            node.bounds = mNodes[node.leftFirst].bounds;
+            node.bounds.Merge(mNodes[node.leftFirst + 1].bounds);
+        }
+    }
+    mDirtyLeaves.clear();
+}
+void BVH::CollectSubtree(uint32_t nodeIndex, std::vector<uint32_t> &ids) const
+{
+    std::vector<uint32_t> stack{nodeIndex};
+    while (!stack.empty())
+    {
+        const Node &node = mNodes[stack.back()];
+        stack.pop_back();
+        if (node.IsLeaf())
+        {
+            for (uint32_t i = node.leftFirst; i < node.leftFirst + node.count; i++)
+            {
+                ids.push_back(mPrimitiveIds[mIndices[i]]);
+            }
+            continue;
+        }
+        stack.push_back(node.leftFirst + 1);
+        stack.push_back(node.leftFirst);
+    }
+}
+void BVH::QueryFrustum(const Frustum &frustum, std::vector<uint32_t> &ids) const
+{
+    if (Empty())
+    {
+        return;
+    }
+    std::vector<uint32_t> stack{0};
+    stack.reserve(64);
+    while (!stack.empty())
+    {
+        uint32_t nodeIndex = stack.back();
+        stack.pop_back();
+        const Node &node = mNodes[nodeIndex];
+        Containment containment = frustum.Classify(node.bounds);
+        if (containment == Containment::Outside)
+        {
+            continue;
+        }
+        if (containment == Containment::Inside)
+        {
+            CollectSubtree(nodeIndex, ids);
+            continue;
+        }
+        if (node.IsLeaf())
+        {
+            for (uint32_t i = node.leftFirst; i < node.leftFirst + node.count; i++)
+            {
+                if (frustum.IsVisible(mPrimitiveBounds[mIndices[i]]))
+                {
+                    ids.push_back(mPrimitiveIds[mIndices[i]]);
+                }
+            }
+            continue;
+        }
+        stack.push_back(node.leftFirst + 1);
+        stack.push_back(node.leftFirst);
+    }
+}
+void BVH::QueryOverlap(const AABB &bounds, std::vector<uint32_t> &ids) const
+{
+    if (Empty())
+    {
+        return;
+    }
+    std::vector<uint32_t> stack{0};
+    stack.reserve(64);
+    while (!stack.empty())
+    {
+        const Node &node = mNodes[stack.back()];
+        stack.pop_back();
+        if (!node.bounds.Intersects(bounds))
+        {
+            continue;
+        }
+        if (node.IsLeaf())
+        {
+            for (uint32_t i = node.leftFirst; i < node.leftFirst + node.count; i++)
+            {
+                if (mPrimitiveBounds[mIndices[i]].Intersects(bounds))
+                {
+                    ids.push_back(mPrimitiveIds[mIndices[i]]);
+                }
+            }
+            continue;
+        }
+        stack.push_back(node.leftFirst + 1);
+        stack.push_back(node.leftFirst);
+    }
+}
+std::optional<BVH::RayHit> BVH::Raycast(const Ray &ray, float maxDistance) const
+{
+    if (Empty())
+    {
+        return std::nullopt;
+    }
+    glm::vec3 inverseDirection(1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z);
+    std::optional<RayHit> closest;
+    float closestDistance = maxDistance;
+    // (节点, 进入距离)，先访问较近的子节点，超过当前最近命中的节点直接跳过
+    std::vector<std::pair<uint32_t, float>> stack;
+    stack.reserve(64);
+    float rootDistance = mNodes[0].bounds.IntersectRay(ray, inverseDirection, closestDistance);
+    if (rootDistance >= 0.0f)
+    {
+        stack.emplace_back(0, rootDistance);
+    }
+    while (!stack.empty())
+    {
+        auto [nodeIndex, enterDistance] = stack.back();
+        stack.pop_back();
+        if (enterDistance > closestDistance)
+        {
+            continue;
+        }
+        const Node &node = mNodes[nodeIndex];
+        if (node.IsLeaf())
+        {
+            for (uint32_t i = node.leftFirst; i < node.leftFirst + node.count; i++)
+            {
+                float distance = mPrimitiveBounds[mIndices[i]].IntersectRay(ray, inverseDirection, closestDistance);
+                if (distance >= 0.0f && (!closest || distance < closestDistance))
+                {
+                    closestDistance = distance;
+                    closest = RayHit{mPrimitiveIds[mIndices[i]], distance};
+                }
+            }
+            continue;
+        }
+        uint32_t near = node.leftFirst;
+        uint32_t far = node.leftFirst + 1;
+        float nearDistance = mNodes[near].bounds.IntersectRay(ray, inverseDirection, closestDistance);
+        float farDistance = mNodes[far].bounds.IntersectRay(ray, inverseDirection, closestDistance);
+        if (farDistance >= 0.0f && (nearDistance < 0.0f || farDistance < nearDistance))
+        {
+            std::swap(near, far);
+            std::swap(nearDistance, farDistance);
+        }
+        if (farDistance >= 0.0f)
+        {
+            stack.emplace_back(far, farDistance);
+        }
+        if (nearDistance >= 0.0f)
+        {
+            stack.emplace_back(near, nearDistance);
+        }
+    }
+    return closest;
+}
+bool BVH::Empty() const noexcept
+{
+    return mNodeCount == 0;
+}
+uint32_t BVH::GetNodeCount() const noexcept
+{
+    return mNodeCount;
+}
+uint32_t BVH::GetPrimitiveCount() const noexcept
+{
+    return static_cast<uint32_t>(mPrimitiveIds.size());
+}
+const std::vector<BVH::Node> &BVH::GetNodes() const noexcept
+{
+    return mNodes;
+}
+float BVH::GetDegradation() const noexcept
+{
+    if (Empty() || mBuildSurfaceArea <= 0.0f)
+    {
+        return 1.0f;
+    }
+    return mNodes[0].bounds.SurfaceArea() / mBuildSurfaceArea;
+}
+} // namespace MEngine
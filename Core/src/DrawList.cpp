@@ -0,0 +1,106 @@
+#include "DrawList.hpp"
+#include <algorithm>
+#include <array>
+
+namespace MEngine
+{
+namespace SortKey
+{
+uint32_t QuantizeDepth(float depth) noexcept
+{
+    // NaN 也落到 0
+    if (!(depth > 0.0f))
+    {
+        return 0;
+    }
+    if (depth >= 1.0f)
+    {
+        return DepthMax;
+    }
+    return static_cast<uint32_t>(depth * static_cast<float>(DepthMax));
+}
+uint64_t MakeOpaque(uint8_t pipeline, uint16_t material, uint16_t mesh, float depth) noexcept
+{
+    return (static_cast<uint64_t>(pipeline) << 56) | (static_cast<uint64_t>(material) << 40) |
+           (static_cast<uint64_t>(mesh) << 24) | QuantizeDepth(depth);
+}
+uint64_t MakeTransparent(uint8_t pipeline, uint16_t material, uint16_t mesh, float depth) noexcept
+{
+    uint64_t inverseDepth = DepthMax - QuantizeDepth(depth);
+    return (static_cast<uint64_t>(pipeline) << 56) | (inverseDepth << 32) | (static_cast<uint64_t>(material) << 16) |
+           mesh;
+}
+uint8_t GetPipeline(uint64_t key) noexcept
+{
+    return static_cast<uint8_t>(key >> 56);
+}
+uint64_t GetOpaqueState(uint64_t key) noexcept
+{
+    return key >> DepthBits;
+}
+} // namespace SortKey
+
+void DrawList::Clear() noexcept
+{
+    mPackets.clear();
+}
+void DrawList::Reserve(size_t count)
+{
+    mPackets.reserve(count);
+    mScratch.reserve(count);
+}
+void DrawList::Add(uint64_t key, uint32_t index)
+{
+    mPackets.push_back(DrawPacket{key, index});
+}
+void DrawList::Sort()
+{
+    if (mPackets.size() < 2)
+    {
+        return;
+    }
+    // 一次遍历统计所有字节的直方图
+    std::array<std::array<uint32_t, 256>, 8> histograms{};
+    for (const auto &packet : mPackets)
+    {
+        for (uint32_t pass = 0; pass < 8; pass++)
+        {
+            histograms[pass][(packet.key >> (pass * 8)) & 0xFF]++;
+        }
+    }
+    mScratch.resize(mPackets.size());
+    for (uint32_t pass = 0; pass < 8; pass++)
+    {
+        auto &histogram = histograms[pass];
+        uint8_t firstByte = static_cast<uint8_t>((mPackets.front().key >> (pass * 8)) & 0xFF);
+        if (histogram[firstByte] == mPackets.size())
+        {
+            continue;
+        }
+        uint32_t offset = 0;
+        for (auto &count : histogram)
+        {
+            uint32_t current = count;
+            count = offset;
+            offset += current;
+        }
+        for (const auto &packet : mPackets)
+        {
+            mScratch[histogram[(packet.key >> (pass * 8)) & 0xFF]++] = packet;
+        }
+        mPackets.swap(mScratch);
+    }
+}
+const std::vector<DrawPacket> &DrawList::GetPackets() const noexcept
+{
+    return mPackets;
+}
+size_t DrawList::Size() const noexcept
+{
+    return mPackets.size();
+}
+bool DrawList::Empty() const noexcept
+{
+    return mPackets.empty();
+}
+} // namespace MEngine
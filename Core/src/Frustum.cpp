@@ -0,0 +1,153 @@
+#include "Frustum.hpp"
+
+namespace MEngine
+{
+void BoundsSoA::Resize(size_t count)
+{
+    for (auto *array : {&centerX, &centerY, &centerZ, &extentX, &extentY, &extentZ, &sphereX, &sphereY, &sphereZ,
+                        &radius})
+    {
+        array->resize(count);
+    }
+}
+void BoundsSoA::Set(size_t index, const AABB &box, const BoundingSphere &sphere)
+{
+    glm::vec3 center = box.GetCenter();
+    glm::vec3 extents = box.GetExtents();
+    centerX[index] = center.x;
+    centerY[index] = center.y;
+    centerZ[index] = center.z;
+    extentX[index] = extents.x;
+    extentY[index] = extents.y;
+    extentZ[index] = extents.z;
+    sphereX[index] = sphere.center.x;
+    sphereY[index] = sphere.center.y;
+    sphereZ[index] = sphere.center.z;
+    radius[index] = sphere.radius;
+}
+size_t BoundsSoA::Size() const noexcept
+{
+    return centerX.size();
+}
+
+Frustum::Frustum(const glm::mat4 &viewProjection)
+{
+    // Gribb-Hartmann：从裁剪矩阵的行组合出六个平面
+    auto row = [&viewProjection](int i) {
+        return glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+    };
+    mPlanes[0] = row(3) + row(0); // left
+    mPlanes[1] = row(3) - row(0); // right
+    mPlanes[2] = row(3) + row(1); // bottom
+    mPlanes[3] = row(3) - row(1); // top
+    mPlanes[4] = row(2);          // near (z >= 0)
+    mPlanes[5] = row(3) - row(2); // far
+    for (auto &plane : mPlanes)
+    {
+        plane /= glm::length(glm::vec3(plane));
+    }
+}
+const std::array<glm::vec4, 6> &Frustum::GetPlanes() const noexcept
+{
+    return mPlanes;
+}
+bool Frustum::IsVisible(const AABB &box) const noexcept
+{
+    glm::vec3 center = box.GetCenter();
+    glm::vec3 extents = box.GetExtents();
+    for (const auto &plane : mPlanes)
+    {
+        glm::vec3 normal(plane);
+        float distance = glm::dot(normal, center) + plane.w;
+        float projectedRadius = glm::dot(glm::abs(normal), extents);
+        if (distance < -projectedRadius)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+Containment Frustum::Classify(const AABB &box) const noexcept
+{
+    glm::vec3 center = box.GetCenter();
+    glm::vec3 extents = box.GetExtents();
+    Containment result = Containment::Inside;
+    for (const auto &plane : mPlanes)
+    {
+        glm::vec3 normal(plane);
+        float distance = glm::dot(normal, center) + plane.w;
+        float projectedRadius = glm::dot(glm::abs(normal), extents);
+        if (distance < -projectedRadius)
+        {
+            return Containment::Outside;
+        }
+        if (distance < projectedRadius)
+        {
+            result = Containment::Intersect;
+        }
+    }
+    return result;
+}
+bool Frustum::IsVisible(const BoundingSphere &sphere) const noexcept
+{
+    for (const auto &plane : mPlanes)
+    {
+        if (glm::dot(glm::vec3(plane), sphere.center) + plane.w < -sphere.radius)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+void Frustum::Cull(const BoundsSoA &bounds, size_t begin, size_t end, uint8_t *visible) const
+{
+    size_t i = begin;
+#if defined(MENGINE_SIMD_SSE) || defined(MENGINE_SIMD_AVX2)
+    // 一次测试 4 个物体
+    for (; i + 4 <= end; i += 4)
+    {
+        const __m128 sx = _mm_loadu_ps(&bounds.sphereX[i]);
+        const __m128 sy = _mm_loadu_ps(&bounds.sphereY[i]);
+        const __m128 sz = _mm_loadu_ps(&bounds.sphereZ[i]);
+        const __m128 negativeRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(&bounds.radius[i]));
+        const __m128 cx = _mm_loadu_ps(&bounds.centerX[i]);
+        const __m128 cy = _mm_loadu_ps(&bounds.centerY[i]);
+        const __m128 cz = _mm_loadu_ps(&bounds.centerZ[i]);
+        const __m128 ex = _mm_loadu_ps(&bounds.extentX[i]);
+        const __m128 ey = _mm_loadu_ps(&bounds.extentY[i]);
+        const __m128 ez = _mm_loadu_ps(&bounds.extentZ[i]);
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (const auto &plane : mPlanes)
+        {
+            const __m128 nx = _mm_set1_ps(plane.x);
+            const __m128 ny = _mm_set1_ps(plane.y);
+            const __m128 nz = _mm_set1_ps(plane.z);
+            const __m128 d = _mm_set1_ps(plane.w);
+            // 包围球
+            __m128 sphereDistance =
+                _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, sx), _mm_mul_ps(ny, sy)), _mm_add_ps(_mm_mul_ps(nz, sz), d));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(sphereDistance, negativeRadius));
+            // AABB：中心距离 >= -|n|·extents
+            __m128 boxDistance =
+                _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, cx), _mm_mul_ps(ny, cy)), _mm_add_ps(_mm_mul_ps(nz, cz), d));
+            __m128 projectedRadius = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(_mm_set1_ps(std::abs(plane.x)), ex), _mm_mul_ps(_mm_set1_ps(std::abs(plane.y)), ey)),
+                _mm_mul_ps(_mm_set1_ps(std::abs(plane.z)), ez));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(boxDistance, _mm_sub_ps(_mm_setzero_ps(), projectedRadius)));
+        }
+        int mask = _mm_movemask_ps(inside);
+        visible[i + 0] = (mask >> 0) & 1;
+        visible[i + 1] = (mask >> 1) & 1;
+        visible[i + 2] = (mask >> 2) & 1;
+        visible[i + 3] = (mask >> 3) & 1;
+    }
+#endif
+    for (; i < end; i++)
+    {
+        glm::vec3 center(bounds.centerX[i], bounds.centerY[i], bounds.centerZ[i]);
+        glm::vec3 extents(bounds.extentX[i], bounds.extentY[i], bounds.extentZ[i]);
+        BoundingSphere sphere{glm::vec3(bounds.sphereX[i], bounds.sphereY[i], bounds.sphereZ[i]), bounds.radius[i]};
+        visible[i] = IsVisible(sphere) && IsVisible(AABB{center - extents, center + extents}) ? 1 : 0;
+    }
+}
+} // namespace MEngine
@@ -1,28 +1,157 @@
 #include "Mesh.hpp"
-#include "BufferFactory.hpp"
+#include <atomic>
 
 namespace MEngine
 {
-Mesh::Mesh(std::shared_ptr<BufferFactory> bufferFactory, const std::vector<Vertex> &vertices,
-           const std::vector<uint32_t> &indices)
-    : mVertices(vertices), mIndices(indices), mBufferFactory(bufferFactory)
+namespace
 {
-    // 创建顶点缓冲区
-    mVertexBuffer =
-        mBufferFactory->CreateBuffer(BufferType::Vertex, sizeof(Vertex) * mVertices.size(), mVertices.data());
-    // 创建索引缓冲区
-    mIndexBuffer = mBufferFactory->CreateBuffer(BufferType::Index, sizeof(uint32_t) * mIndices.size(), mIndices.data());
+// 所有存活网格的内存统计，网格可能在加载线程上创建
+std::atomic<uint32_t> gMeshCount{0};
+std::atomic<uint32_t> gRetainedMeshCount{0};
+std::atomic<uint64_t> gMeshGPUBytes{0};
+std::atomic<uint64_t> gMeshCPUBytes{0};
+std::atomic<uint64_t> gMeshSavedCPUBytes{0};
+} // namespace
+
+Mesh::Mesh(std::shared_ptr<GeometryArena> geometryArena, std::span<const Vertex> vertices,
+           std::span<const uint32_t> indices, MeshResidency residency, VertexFormat format,
+           std::span<const MeshLODSource> lods)
+    : mResidency(residency), mVertexFormat(format), mGeometryArena(geometryArena)
+{
+    // 各级 LOD 的索引紧接在 LOD0 之后，只占用一段索引区间
+    std::vector<uint32_t> combinedIndices;
+    std::span<const uint32_t> uploadIndices = indices;
+    if (!lods.empty())
+    {
+        combinedIndices.assign(indices.begin(), indices.end());
+        for (const auto &lod : lods)
+        {
+            combinedIndices.insert(combinedIndices.end(), lod.indices.begin(), lod.indices.end());
+        }
+        uploadIndices = combinedIndices;
+    }
+    // 在共享的顶点/索引缓冲区中分配区间并上传，数据在 Allocate 返回前已复制到暂存缓冲区
+    auto vertexCount = static_cast<uint32_t>(vertices.size());
+    auto indexCount = static_cast<uint32_t>(uploadIndices.size());
+    if (mVertexFormat == VertexFormat::Quantized)
+    {
+        mQuantization = ComputeVertexQuantization(vertices.data(), vertices.size());
+        std::vector<QuantizedVertex> quantized(vertices.size());
+        QuantizeVertices(vertices.data(), vertices.size(), mQuantization, quantized.data());
+        mAllocation =
+            mGeometryArena->Allocate(mVertexFormat, quantized.data(), vertexCount, uploadIndices.data(), indexCount);
+    }
+    else
+    {
+        mAllocation =
+            mGeometryArena->Allocate(mVertexFormat, vertices.data(), vertexCount, uploadIndices.data(), indexCount);
+    }
+    mLODs.push_back({mAllocation.firstIndex, static_cast<uint32_t>(indices.size()), 0.0f});
+    for (const auto &lod : lods)
+    {
+        const auto &previous = mLODs.back();
+        mLODs.push_back(
+            {previous.firstIndex + previous.indexCount, static_cast<uint32_t>(lod.indices.size()), lod.error});
+    }
+    mVertexBuffer = mGeometryArena->GetVertexBuffer(mAllocation.page);
+    mIndexBuffer = mGeometryArena->GetIndexBuffer(mAllocation.page);
+    // 计算包围体：包围球以包围盒中心为球心，半径取最远顶点
+    for (const auto &vertex : vertices)
+    {
+        mBoundingBox.Expand(vertex.position);
+    }
+    if (!mBoundingBox.IsValid())
+    {
+        mBoundingBox = AABB{glm::vec3(0.0f), glm::vec3(0.0f)};
+    }
+    mBoundingSphere.center = mBoundingBox.GetCenter();
+    for (const auto &vertex : vertices)
+    {
+        mBoundingSphere.radius = std::max(mBoundingSphere.radius, glm::length(vertex.position - mBoundingSphere.center));
+    }
+    if (mResidency == MeshResidency::Retained)
+    {
+        mVertices.assign(vertices.begin(), vertices.end());
+        mIndices.assign(indices.begin(), indices.end());
+        gRetainedMeshCount++;
+        gMeshCPUBytes += GetCPUMemorySize();
+    }
+    else
+    {
+        gMeshSavedCPUBytes += GetRetainedMemorySize();
+    }
+    gMeshCount++;
+    gMeshGPUBytes += GetGPUMemorySize();
+}
+Mesh::~Mesh()
+{
+    gMeshCount--;
+    gMeshGPUBytes -= GetGPUMemorySize();
+    if (mResidency == MeshResidency::Retained)
+    {
+        gRetainedMeshCount--;
+        gMeshCPUBytes -= GetCPUMemorySize();
+    }
+    else
+    {
+        gMeshSavedCPUBytes -= GetRetainedMemorySize();
+    }
+    mGeometryArena->Free(mAllocation);
+}
+uint64_t Mesh::GetRetainedMemorySize() const
+{
+    return sizeof(Vertex) * static_cast<uint64_t>(mAllocation.vertexCount) +
+           sizeof(uint32_t) * static_cast<uint64_t>(GetIndexCount());
+}
+uint64_t Mesh::GetGPUMemorySize() const
+{
+    return Vertex::GetStride(mVertexFormat) * static_cast<uint64_t>(mAllocation.vertexCount) +
+           sizeof(uint32_t) * static_cast<uint64_t>(mAllocation.indexCount);
+}
+uint64_t Mesh::GetCPUMemorySize() const
+{
+    return sizeof(Vertex) * mVertices.capacity() + sizeof(uint32_t) * mIndices.capacity();
+}
+MeshMemoryStats Mesh::GetMemoryStats()
+{
+    MeshMemoryStats stats{};
+    stats.meshes = gMeshCount;
+    stats.retainedMeshes = gRetainedMeshCount;
+    stats.gpuBytes = gMeshGPUBytes;
+    stats.cpuBytes = gMeshCPUBytes;
+    stats.savedCPUBytes = gMeshSavedCPUBytes;
+    return stats;
+}
+glm::mat4 Mesh::GetDequantizeMatrix() const
+{
+    return mVertexFormat == VertexFormat::Quantized ? mQuantization.GetDequantizeMatrix() : glm::mat4(1.0f);
 }
 vk::Buffer Mesh::GetVertexBuffer() const
 {
-    return mVertexBuffer->GetHandle();
+    return mVertexBuffer;
 }
 vk::Buffer Mesh::GetIndexBuffer() const
 {
-    return mIndexBuffer->GetHandle();
+    return mIndexBuffer;
 }
 uint32_t Mesh::GetIndexCount() const
 {
-    return static_cast<uint32_t>(mIndices.size());
+    return mLODs.front().indexCount;
+}
+int32_t Mesh::GetVertexOffset() const
+{
+    return static_cast<int32_t>(mAllocation.vertexOffset);
+}
+uint32_t Mesh::GetFirstIndex() const
+{
+    return mLODs.front().firstIndex;
+}
+const AABB &Mesh::GetBoundingBox() const
+{
+    return mBoundingBox;
+}
+const BoundingSphere &Mesh::GetBoundingSphere() const
+{
+    return mBoundingSphere;
 }
 } // namespace MEngine
\ No newline at end of file
@@ -129,6 +129,15 @@ bool PBRMaterialRepository::Update(const UUID &id, const PBRMaterial &delta)
     mLogger->Info("Material with ID {} not exist", id);
     return false;
 }
+vk::UniqueDescriptorSet PBRMaterialRepository::DetachDescriptorSet(const UUID &id)
+{
+    auto material = Get(id);
+    if (!material)
+    {
+        return {};
+    }
+    return std::move(material->mMaterialDescriptorSet);
+}
 bool PBRMaterialRepository::CheckValidate(const std::filesystem::path &filePath) const
 {
     if (filePath.empty())
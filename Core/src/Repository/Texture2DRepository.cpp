@@ -1,31 +1,97 @@
 #include "Repository/Texture2DRepository.hpp"
+#include <algorithm>
 #include <utility>
 
 namespace MEngine
 {
+namespace
+{
+vk::Format GetContainerFormat(const TextureContainerHeader &header)
+{
+    bool srgb = header.flags & TextureContainerSrgb;
+    switch (header.compression)
+    {
+    case BlockCompression::BC1:
+        return srgb ? vk::Format::eBc1RgbaSrgbBlock : vk::Format::eBc1RgbaUnormBlock;
+    case BlockCompression::BC5:
+        return vk::Format::eBc5UnormBlock;
+    case BlockCompression::BC7:
+        return srgb ? vk::Format::eBc7SrgbBlock : vk::Format::eBc7UnormBlock;
+    case BlockCompression::None:
+    default:
+        return srgb ? vk::Format::eR8G8B8A8Srgb : vk::Format::eR8G8B8A8Unorm;
+    }
+}
+} // namespace
 Texture2DRepository::Texture2DRepository(std::shared_ptr<ILogger> logger, std::shared_ptr<Context> context,
                                          std::shared_ptr<IConfigure> configure,
                                          std::shared_ptr<ImageFactory> imageFactory,
                                          std::shared_ptr<SamplerManager> samplerManager)
     : Repository<Texture2D>(logger, context, configure), mImageFactory(imageFactory), mSamplerManager(samplerManager)
 {
-    mCheckBoardData = CheckBoard();
+    CreateFallbackTextures();
     auto defaultTexture = Create();
     auto id = defaultTexture->GetID();
     std::swap(mEntities[id], mEntities[UUID{}]);
     mEntities.erase(id); // 交换后记得删除原ID，因为[]会默认创建一个键值对{UUID, nullptr}
 }
+void Texture2DRepository::CreateFallbackTextures()
+{
+    // 棋盘格带 mip 链以免缩小时闪烁，纯色纹理 4x4 即可
+    constexpr uint32_t checkerSize = 256;
+    constexpr uint32_t solidSize = 4;
+    auto solid = [](std::array<unsigned char, 4> color) {
+        std::vector<unsigned char> pixels;
+        for (uint32_t i = 0; i < solidSize * solidSize; i++)
+        {
+            pixels.insert(pixels.end(), color.begin(), color.end());
+        }
+        return pixels;
+    };
+    std::array<std::vector<unsigned char>, static_cast<size_t>(FallbackTexture::Count)> pixels = {
+        CheckBoard(checkerSize),
+        solid({255, 255, 255, 255}),
+        solid({0, 0, 0, 255}),
+        solid({128, 128, 255, 255}),
+    };
+    std::vector<ImageUploadRequest> requests;
+    for (size_t i = 0; i < pixels.size(); i++)
+    {
+        ImageUploadRequest request{};
+        request.type = ImageType::Texture2D;
+        request.extent = vk::Extent3D{solidSize, solidSize, 1};
+        request.size = pixels[i].size();
+        request.data = pixels[i].data();
+        requests.push_back(request);
+    }
+    auto &checker = requests[static_cast<size_t>(FallbackTexture::Checker)];
+    checker.extent = vk::Extent3D{checkerSize, checkerSize, 1};
+    checker.generateMipmaps = true;
+    // 法线是数据而不是颜色，不能经过 sRGB 解码
+    requests[static_cast<size_t>(FallbackTexture::FlatNormal)].format = vk::Format::eR8G8B8A8Unorm;
+
+    auto images = mImageFactory->CreateImages(requests);
+    for (size_t i = 0; i < images.size(); i++)
+    {
+        auto &fallback = mFallbackTextures[i];
+        fallback.image = std::move(images[i]);
+        fallback.imageView = mImageFactory->CreateImageView(fallback.image.get());
+        fallback.sampler = mSamplerManager->GetTextureSampler(fallback.image->GetMipLevels());
+    }
+}
 Texture2D *Texture2DRepository::Create()
+{
+    return Create(FallbackTexture::Checker);
+}
+Texture2D *Texture2DRepository::Create(FallbackTexture fallback)
 {
     auto texture = std::make_unique<Texture2D>();
-    texture->mWidth = 4096;
-    texture->mHeight = 4096;
+    const auto &shared = mFallbackTextures[static_cast<size_t>(fallback)];
+    texture->mWidth = shared.image->GetExtent().width;
+    texture->mHeight = shared.image->GetExtent().height;
     texture->mChannels = 4;
-    texture->mImage =
-        mImageFactory->CreateImage(ImageType::Texture2D, vk::Extent3D{texture->mWidth, texture->mHeight, 1},
-                                   mCheckBoardData.size(), mCheckBoardData.data());
-    texture->mImageView = mImageFactory->CreateImageView(texture->mImage.get());
-    texture->mSampler = mSamplerManager->CreateUniqueSampler(vk::Filter::eLinear, vk::Filter::eLinear);
+    texture->mPlaceholderImageView = shared.imageView.get();
+    texture->mPlaceholderSampler = shared.sampler->get();
     auto id = texture->GetID();
     mEntities[id] = std::move(texture);
     return mEntities[id].get();
@@ -37,31 +103,149 @@ bool Texture2DRepository::Update(const UUID &id, const Texture2D &delta)
         return false;
     }
     auto it = mEntities.find(id);
-    auto texture = Get(id);
-    if (it != mEntities.end())
+    if (it == mEntities.end())
+    {
+        mLogger->Info("Texture with ID {} not exist", id);
+        return false;
+    }
+    auto texture = it->second.get();
+    texture->imagePath = delta.imagePath;
+    // 加载完成前继续采样创建时指定的共享默认纹理
+    texture->mLoading = true;
+    uint64_t request = ++mNextDecodeRequest;
+    mDecodeRequests[id] = request;
+    // PNG 解压与 .mtex 映射在工作线程完成，主线程只负责上传
+    Task::Run([queue = mDecodeQueue, id, request, path = delta.imagePath]() {
+        DecodedTexture decoded{};
+        decoded.id = id;
+        decoded.request = request;
+        decoded.path = path;
+        if (path.extension() == ".mtex")
+        {
+            auto mapping = std::make_unique<MappedFile>();
+            if (mapping->Open(path))
+            {
+                decoded.container = ParseTextureContainer(mapping->GetData(), mapping->GetSize());
+            }
+            if (decoded.container)
+            {
+                // 提前让系统读入整个文件，主线程拷贝时不再等待磁盘
+                mapping->Prefetch();
+                decoded.width = decoded.container->header.width;
+                decoded.height = decoded.container->header.height;
+                decoded.mapping = std::move(mapping);
+            }
+        }
+        else
+        {
+            int width, height, channels;
+            stbi_set_flip_vertically_on_load_thread(true);
+            decoded.pixels.reset(stbi_load(path.string().c_str(), &width, &height, &channels, STBI_rgb_alpha));
+            if (decoded.pixels)
+            {
+                decoded.width = static_cast<uint32_t>(width);
+                decoded.height = static_cast<uint32_t>(height);
+            }
+        }
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        queue->decoded.push_back(std::move(decoded));
+    });
+    return true;
+}
+bool Texture2DRepository::HasDecodedTextures() const
+{
+    std::lock_guard<std::mutex> lock(mDecodeQueue->mutex);
+    return !mDecodeQueue->decoded.empty();
+}
+std::vector<UUID> Texture2DRepository::ProcessDecodedTextures(std::vector<RetiredTexture> &retired)
+{
+    std::vector<DecodedTexture> decoded;
+    {
+        std::lock_guard<std::mutex> lock(mDecodeQueue->mutex);
+        decoded.swap(mDecodeQueue->decoded);
+    }
+    std::vector<Texture2D *> textures;
+    std::vector<ImageUploadRequest> requests;
+    for (auto &item : decoded)
     {
-        it->second->imagePath = delta.imagePath;
-        int width, height, channels;
-        stbi_set_flip_vertically_on_load(true);
-        auto imageData = stbi_load(delta.imagePath.string().c_str(), &width, &height, &channels, STBI_rgb_alpha);
-        if (!imageData)
+        auto request = mDecodeRequests.find(item.id);
+        if (request == mDecodeRequests.end() || request->second != item.request)
         {
-            mLogger->Error("Failed to load default texture image: {}", delta.imagePath.string().c_str());
-            return false;
+            continue; // 纹理已删除或有更新的请求
         }
-        texture->mWidth = static_cast<uint32_t>(width);
-        texture->mHeight = static_cast<uint32_t>(height);
+        mDecodeRequests.erase(request);
+        auto texture = Get(item.id);
+        if (!texture)
+        {
+            continue;
+        }
+        if (!item.pixels && !item.container)
+        {
+            mLogger->Error("Failed to load texture image: {}", item.path.string());
+            texture->mLoading = false;
+            continue;
+        }
+        ImageUploadRequest uploadRequest{};
+        uploadRequest.type = ImageType::Texture2D;
+        uploadRequest.extent = vk::Extent3D{item.width, item.height, 1};
+        if (item.container)
+        {
+            // 烘焙数据已含完整 mip 链，不需要解码或生成
+            const auto &container = *item.container;
+            uploadRequest.format = GetContainerFormat(container.header);
+            if (!mImageFactory->IsFormatSampleable(uploadRequest.format))
+            {
+                mLogger->Error("Texture format {} of {} is not supported by the device",
+                               vk::to_string(uploadRequest.format), item.path.string());
+                texture->mLoading = false;
+                continue;
+            }
+            uploadRequest.mipLevels = container.header.mipLevels;
+            for (uint32_t level = 0; level < container.header.mipLevels; level++)
+            {
+                uploadRequest.mips.push_back({container.GetMipData(level), container.mips[level].size});
+            }
+        }
+        else
+        {
+            uploadRequest.size = static_cast<vk::DeviceSize>(item.width) * item.height * 4;
+            uploadRequest.data = item.pixels.get();
+            uploadRequest.generateMipmaps = true;
+        }
+        requests.push_back(std::move(uploadRequest));
+        textures.push_back(texture);
+    }
+    std::vector<UUID> updated;
+    if (requests.empty())
+    {
+        return updated;
+    }
+    // 单个纹理创建失败时保留 fallback，不影响同批次的其他纹理
+    auto images = mImageFactory->CreateImages(requests, true);
+    for (size_t i = 0; i < textures.size(); i++)
+    {
+        auto texture = textures[i];
+        if (!images[i])
+        {
+            mLogger->Error("Failed to create texture image: {}", texture->imagePath.string());
+            texture->mLoading = false;
+            continue;
+        }
+        texture->mWidth = requests[i].extent.width;
+        texture->mHeight = requests[i].extent.height;
         texture->mChannels = 4;
-        auto size = static_cast<vk::DeviceSize>(texture->mWidth * texture->mHeight * texture->mChannels);
-        texture->mImage = mImageFactory->CreateImage(
-            ImageType::Texture2D, vk::Extent3D{texture->mWidth, texture->mHeight, 1}, size, imageData);
+        if (texture->mImage)
+        {
+            retired.push_back({std::move(texture->mImage), std::move(texture->mImageView), texture->mSampler});
+        }
+        texture->mImage = std::move(images[i]);
         texture->mImageView = mImageFactory->CreateImageView(texture->mImage.get());
-        texture->mSampler = mSamplerManager->CreateUniqueSampler(vk::Filter::eLinear, vk::Filter::eLinear);
-        stbi_image_free(imageData);
-        return true;
+        texture->mSampler = mSamplerManager->GetTextureSampler(texture->mImage->GetMipLevels());
+        texture->mLoading = false;
+        updated.push_back(texture->GetID());
     }
-    mLogger->Info("Texture with ID {} not exist", id);
-    return false;
+    mLogger->Debug("{} textures uploaded", updated.size());
+    return updated;
 }
 bool Texture2DRepository::CheckValidate(const std::filesystem::path &filePath) const
 {
@@ -80,9 +264,9 @@ bool Texture2DRepository::CheckValidate(const std::filesystem::path &filePath) c
         mLogger->Error("Default texture path is a directory!");
         return false;
     }
-    if (filePath.extension() != ".png")
+    if (filePath.extension() != ".png" && filePath.extension() != ".mtex")
     {
-        mLogger->Error("Default texture path is not a png file!");
+        mLogger->Error("Default texture path is not a png or mtex file!");
         return false;
     }
     return true;
@@ -93,31 +277,21 @@ bool Texture2DRepository::CheckValidate(const Texture2D &delta) const
     return CheckValidate(delta.imagePath);
     // TODO: CheckValidate other members
 }
-std::vector<unsigned char> Texture2DRepository::CheckBoard()
+std::vector<unsigned char> Texture2DRepository::CheckBoard(uint32_t size, uint32_t grid)
 {
-    // 4k
-    int width = 4096;
-    int height = 4096;
-    int channels = 4; // RGBA
-    int grid = 8;
-    int tileSize = width / grid;
-    std::vector<unsigned char> checkBoard(width * height * channels, 0);
-    for (int y = 0; y < height; y += tileSize)
+    uint32_t channels = 4; // RGBA
+    uint32_t tileSize = std::max(size / grid, 1u);
+    std::vector<unsigned char> checkBoard(static_cast<size_t>(size) * size * channels, 0);
+    for (uint32_t y = 0; y < size; y++)
     {
-        for (int x = 0; x < width; x += tileSize)
+        for (uint32_t x = 0; x < size; x++)
         {
             unsigned char color = ((x / tileSize) % 2 == (y / tileSize) % 2) ? 255 : 0;
-            for (int j = 0; j < tileSize && (y + j) < height; ++j)
-            {
-                for (int i = 0; i < tileSize && (x + i) < width; ++i)
-                {
-                    int index = ((y + j) * width + (x + i)) * channels;
-                    checkBoard[index] = color;
-                    checkBoard[index + 1] = color;
-                    checkBoard[index + 2] = color;
-                    checkBoard[index + 3] = 255; // Alpha channel
-                }
-            }
+            size_t index = (static_cast<size_t>(y) * size + x) * channels;
+            checkBoard[index] = color;
+            checkBoard[index + 1] = color;
+            checkBoard[index + 2] = color;
+            checkBoard[index + 3] = 255; // Alpha channel
         }
     }
     return checkBoard;
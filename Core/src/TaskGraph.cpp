@@ -0,0 +1,161 @@
+#include "TaskGraph.hpp"
+
+namespace MEngine
+{
+TaskGraph::NodeHandle TaskGraph::AddNode(const std::string &name, std::function<void()> &&work,
+                                         const TaskAccess &access)
+{
+    auto node = std::make_unique<Node>();
+    node->name = name;
+    node->work = std::move(work);
+    node->access = access;
+    mNodes.push_back(std::move(node));
+    mIsBuilt = false;
+    return static_cast<NodeHandle>(mNodes.size() - 1);
+}
+void TaskGraph::AddDependency(NodeHandle before, NodeHandle after)
+{
+    if (before >= mNodes.size() || after >= mNodes.size() || before >= after)
+    {
+        throw std::runtime_error("TaskGraph dependency must point from an earlier node to a later node");
+    }
+    mExplicitDependencies.emplace_back(before, after);
+    mIsBuilt = false;
+}
+bool TaskGraph::Conflicts(const TaskAccess &before, const TaskAccess &after)
+{
+    auto intersects = [](const std::vector<std::type_index> &a, const std::vector<std::type_index> &b) {
+        return std::ranges::any_of(a, [&b](const std::type_index &type) { return std::ranges::find(b, type) != b.end(); });
+    };
+    return intersects(before.writes, after.reads) || intersects(before.writes, after.writes) ||
+           intersects(before.reads, after.writes);
+}
+void TaskGraph::Build()
+{
+    for (auto &node : mNodes)
+    {
+        node->successors.clear();
+        node->predecessorCount = 0;
+    }
+    // 节点按添加顺序排列，边只从前指向后，因此图必然无环
+    for (NodeHandle after = 0; after < mNodes.size(); after++)
+    {
+        for (NodeHandle before = 0; before < after; before++)
+        {
+            bool explicitEdge = std::ranges::find(mExplicitDependencies, std::make_pair(before, after)) !=
+                                mExplicitDependencies.end();
+            if (explicitEdge || Conflicts(mNodes[before]->access, mNodes[after]->access))
+            {
+                mNodes[before]->successors.push_back(after);
+                mNodes[after]->predecessorCount++;
+            }
+        }
+    }
+    mIsBuilt = true;
+}
+void TaskGraph::Execute()
+{
+    if (!mIsBuilt)
+    {
+        Build();
+    }
+    if (mNodes.empty())
+    {
+        return;
+    }
+    mException = nullptr;
+    mRemaining = static_cast<uint32_t>(mNodes.size());
+    for (auto &node : mNodes)
+    {
+        node->pending = node->predecessorCount;
+    }
+    for (NodeHandle handle = 0; handle < mNodes.size(); handle++)
+    {
+        if (mNodes[handle]->predecessorCount == 0)
+        {
+            Dispatch(handle);
+        }
+    }
+    // 调用线程负责执行主线程节点，直到所有节点完成
+    while (true)
+    {
+        NodeHandle handle;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mCondition.wait(lock, [this]() { return mRemaining.load() == 0 || !mMainThreadQueue.empty(); });
+            if (mMainThreadQueue.empty())
+            {
+                break;
+            }
+            handle = mMainThreadQueue.front();
+            mMainThreadQueue.pop();
+        }
+        RunNode(handle);
+    }
+    if (mException)
+    {
+        std::rethrow_exception(mException);
+    }
+}
+void TaskGraph::Dispatch(NodeHandle handle)
+{
+    if (mNodes[handle]->access.mainThread)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mMainThreadQueue.push(handle);
+        }
+        mCondition.notify_all();
+        return;
+    }
+    Task::Run([this, handle]() { RunNode(handle); });
+}
+void TaskGraph::RunNode(NodeHandle handle)
+{
+    auto &node = mNodes[handle];
+    try
+    {
+        node->work();
+    }
+    catch (...)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (!mException)
+        {
+            mException = std::current_exception();
+        }
+    }
+    // 延续：最后一个前驱完成时派发后继
+    for (NodeHandle successor : node->successors)
+    {
+        if (mNodes[successor]->pending.fetch_sub(1) == 1)
+        {
+            Dispatch(successor);
+        }
+    }
+    // 计数在锁内递减：Execute 只有在本线程释放锁之后才能看到 0 并返回，之后不再访问图
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mRemaining.fetch_sub(1) == 1)
+    {
+        mCondition.notify_all();
+    }
+}
+void TaskGraph::Clear()
+{
+    mNodes.clear();
+    mExplicitDependencies.clear();
+    mIsBuilt = false;
+}
+size_t TaskGraph::GetNodeCount() const noexcept
+{
+    return mNodes.size();
+}
+const std::string &TaskGraph::GetNodeName(NodeHandle handle) const
+{
+    return mNodes.at(handle)->name;
+}
+const std::vector<TaskGraph::NodeHandle> &TaskGraph::GetSuccessors(NodeHandle handle) const
+{
+    return mNodes.at(handle)->successors;
+}
+} // namespace MEngine
@@ -6,27 +6,35 @@ Task::Task(std::function<void()> &&task) : mTask(task)
 {
 }
 
-void Task::Execute()
+void Task::Invoke() noexcept
 {
     try
     {
         mTask();
-        mDone = true;
-        {
-            std::lock_guard<std::mutex> lock(mMutex);
-            mCondition.notify_all();
-        }
     }
     catch (const std::exception &e)
     {
-        mDone = true;
-        {
-            std::lock_guard<std::mutex> lock(mMutex);
-            mCondition.notify_all();
-        }
+    }
+    catch (...)
+    {
+    }
+}
+
+void Task::Finish()
+{
+    mDone = true;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mCondition.notify_all();
     }
 }
 
+void Task::Execute()
+{
+    Invoke();
+    Finish();
+}
+
 bool Task::IsDone() const noexcept
 {
     return mDone.load();
@@ -34,6 +42,19 @@ bool Task::IsDone() const noexcept
 
 void Task::Wait()
 {
+    auto &scheduler = TaskScheduler::Instance();
+    if (scheduler.IsWorkerThread())
+    {
+        // 工作线程不能阻塞，否则嵌套等待会耗尽线程
+        while (!mDone.load())
+        {
+            if (!scheduler.TryRunPendingTask())
+            {
+                std::this_thread::yield();
+            }
+        }
+        return;
+    }
     std::unique_lock<std::mutex> lock(mMutex);
     mCondition.wait(lock, [this]() { return mDone.load(); });
 }
@@ -58,6 +79,8 @@ void Task::WhenAll(std::vector<std::shared_ptr<Task>> tasks)
 
 // }
 
+thread_local int32_t TaskScheduler::sWorkerIndex = -1;
+
 TaskScheduler &TaskScheduler::Instance()
 {
     static TaskScheduler instance;
@@ -65,56 +88,191 @@ TaskScheduler &TaskScheduler::Instance()
 }
 void TaskScheduler::Initialize(uint32_t threadCount, uint32_t taskCount)
 {
+    Shutdown();
     mTaskCount = taskCount;
     mThreadCount = threadCount;
     mStop = false;
-    for (int i = 0; i < threadCount; i++)
+    for (uint32_t i = 0; i < threadCount; i++)
     {
-        mWorkers.emplace_back([this]() {
-            while (true)
-            {
-                std::shared_ptr<Task> task;
-                {
-                    std::unique_lock<std::mutex> lock(mMutex);
-                    mNotEmpty.wait(lock, [this]() { return mStop || !mTasks.empty(); });
-                    if (mStop && mTasks.empty())
-                    {
-                        break;
-                    }
-                    task = mTasks.front();
-                    mTasks.pop();
-                }
-                task->Execute();
-                mPendingTasks--;
-                mNotFull.notify_one();
-            }
-            std::stringstream ss;
-            ss << std::this_thread::get_id();
-            std::string threadID = ss.str();
-        });
+        mWorkers.push_back(std::make_unique<Worker>());
+    }
+    // 先创建全部队列再启动线程，窃取时不会访问到未构造的队列
+    for (uint32_t i = 0; i < threadCount; i++)
+    {
+        mWorkers[i]->thread = std::thread([this, i]() { WorkerLoop(i); });
     }
 }
-TaskScheduler::~TaskScheduler()
+void TaskScheduler::Shutdown()
 {
+    if (mWorkers.empty())
     {
-        std::unique_lock<std::mutex> lock(mMutex);
-        mStop = true;
+        return;
+    }
+    mStop = true;
+    {
+        std::lock_guard<std::mutex> lock(mSleepMutex);
+        mWakeUp.notify_all();
     }
-    mNotEmpty.notify_all();
     for (auto &worker : mWorkers)
     {
-        worker.join();
+        if (worker->thread.joinable())
+        {
+            worker->thread.join();
+        }
+    }
+    mWorkers.clear();
+}
+TaskScheduler::~TaskScheduler()
+{
+    Shutdown();
+}
+void TaskScheduler::WorkerLoop(uint32_t index)
+{
+    sWorkerIndex = static_cast<int32_t>(index);
+    std::minstd_rand random(index + 1);
+    while (true)
+    {
+        if (Task *task = FindTask(sWorkerIndex, random))
+        {
+            RunTask(task);
+            continue;
+        }
+        if (mStop)
+        {
+            break;
+        }
+        // 先登记休眠再复查一次，与 NotifyWork 配合避免丢失唤醒
+        uint64_t epoch = mWorkEpoch.load();
+        mSleepers++;
+        if (Task *task = FindTask(sWorkerIndex, random))
+        {
+            mSleepers--;
+            RunTask(task);
+            continue;
+        }
+        {
+            std::unique_lock<std::mutex> lock(mSleepMutex);
+            mWakeUp.wait_for(lock, std::chrono::milliseconds(10),
+                             [this, epoch]() { return mStop.load() || mWorkEpoch.load() != epoch; });
+        }
+        mSleepers--;
+    }
+    sWorkerIndex = -1;
+}
+Task *TaskScheduler::FindTask(int32_t index, std::minstd_rand &random)
+{
+    if (index >= 0)
+    {
+        if (auto task = mWorkers[index]->deque.Pop())
+        {
+            return *task;
+        }
+    }
+    if (Task *task = TakeFromInjectQueue(index))
+    {
+        return task;
+    }
+    // 从随机受害者开始依次尝试窃取
+    uint32_t workerCount = static_cast<uint32_t>(mWorkers.size());
+    if (workerCount == 0)
+    {
+        return nullptr;
+    }
+    uint32_t start = random() % workerCount;
+    for (uint32_t i = 0; i < workerCount; i++)
+    {
+        uint32_t victim = (start + i) % workerCount;
+        if (static_cast<int32_t>(victim) == index)
+        {
+            continue;
+        }
+        if (auto task = mWorkers[victim]->deque.Steal())
+        {
+            mStealCount++;
+            return *task;
+        }
+    }
+    return nullptr;
+}
+Task *TaskScheduler::TakeFromInjectQueue(int32_t index)
+{
+    if (mInjectCount.load() == 0)
+    {
+        return nullptr;
+    }
+    Task *task = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mInjectQueue.empty())
+        {
+            return nullptr;
+        }
+        task = mInjectQueue.front();
+        mInjectQueue.pop();
+        // 工作线程一次多取一批放入自己的队列，分摊锁开销并让其他线程可窃取
+        if (index >= 0)
+        {
+            size_t batch = std::min<size_t>(mInjectQueue.size() / mWorkers.size(), 32);
+            for (size_t i = 0; i < batch; i++)
+            {
+                mWorkers[index]->deque.Push(mInjectQueue.front());
+                mInjectQueue.pop();
+            }
+        }
+        mInjectCount = static_cast<uint32_t>(mInjectQueue.size());
+    }
+    mNotFull.notify_all();
+    return task;
+}
+void TaskScheduler::RunTask(Task *task)
+{
+    std::shared_ptr<Task> keepAlive = std::move(task->mKeepAlive);
+    task->Invoke();
+    mPendingTasks--;
+    task->Finish();
+}
+void TaskScheduler::NotifyWork()
+{
+    mWorkEpoch++;
+    if (mSleepers.load() > 0)
+    {
+        std::lock_guard<std::mutex> lock(mSleepMutex);
+        mWakeUp.notify_one();
     }
 }
 void TaskScheduler::AddTask(std::shared_ptr<Task> task)
 {
+    if (mWorkers.empty())
+    {
+        // 未初始化时同步执行
+        task->Execute();
+        return;
+    }
+    Task *raw = task.get();
+    raw->mKeepAlive = std::move(task);
+    mPendingTasks++;
+    if (IsWorkerThread())
+    {
+        mWorkers[sWorkerIndex]->deque.Push(raw);
+    }
+    else
     {
         std::unique_lock<std::mutex> lock(mMutex);
-        mNotFull.wait(lock, [this]() { return mTasks.size() < mTaskCount; });
-        mTasks.push(task);
-        mPendingTasks++;
+        mNotFull.wait(lock, [this]() { return mInjectQueue.size() < mTaskCount; });
+        mInjectQueue.push(raw);
+        mInjectCount = static_cast<uint32_t>(mInjectQueue.size());
     }
-    mNotEmpty.notify_one();
+    NotifyWork();
+}
+bool TaskScheduler::TryRunPendingTask()
+{
+    thread_local std::minstd_rand random(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    if (Task *task = FindTask(sWorkerIndex, random))
+    {
+        RunTask(task);
+        return true;
+    }
+    return false;
 }
 
 uint32_t TaskScheduler::GetThreadCount() const noexcept
@@ -129,4 +287,12 @@ uint32_t TaskScheduler::GetPendingTasks() const noexcept
 {
     return mPendingTasks.load();
 }
-} // namespace MEngine
\ No newline at end of file
+uint64_t TaskScheduler::GetStealCount() const noexcept
+{
+    return mStealCount.load();
+}
+bool TaskScheduler::IsWorkerThread() const noexcept
+{
+    return sWorkerIndex >= 0;
+}
+} // namespace MEngine
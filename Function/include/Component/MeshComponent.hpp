@@ -9,6 +9,7 @@ namespace MEngine
 struct MeshComponent : public IComponent<>
 {
     std::shared_ptr<Mesh> mesh{};
+    uint32_t lod = 0; // 当前使用的 LOD，由 RenderSystem 根据屏幕空间误差逐帧更新
     MeshComponent() = default;
     MeshComponent(std::shared_ptr<Mesh> mesh) : mesh(mesh)
     {
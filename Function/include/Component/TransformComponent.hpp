@@ -4,6 +4,8 @@
 #include "Component/Interface/IComponent.hpp"
 #include "Context.hpp"
 #include "MEngine.hpp"
+#include "Math.hpp"
+#include "entt/entity/entity.hpp"
 #include "entt/entity/storage.hpp"
 #include "glm/fwd.hpp"
 #include "glm/glm.hpp"
@@ -18,7 +20,15 @@ struct TransformComponent : public IComponent<>
     glm::vec3 position{0.0f, 0.0f, 0.0f};
     glm::quat rotation{1.0f, 0.0f, 0.0f, 0.0f};
     glm::vec3 scale{1.0f, 1.0f, 1.0f};
+    // 世界矩阵，有父节点时为 parent.modelMatrix * local
     glm::mat4x4 modelMatrix;
+    // 修改 position/rotation/scale 后需置为 true，TransformSystem 只重算脏变换
+    bool isDirty = true;
+    // 层级，通过 TransformSystem::SetParent 修改
+    entt::entity parent = entt::null;
+    uint32_t depth = 0;
+    // 本帧世界矩阵是否被重算，子节点据此决定是否需要更新
+    bool isWorldChanged = false;
     TransformComponent() = default;
     TransformComponent(glm::vec3 position, glm::quat rotation, glm::vec3 scale)
         : position(position), rotation(rotation), scale(scale)
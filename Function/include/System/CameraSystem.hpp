@@ -21,5 +21,6 @@ class CameraSystem final : public System
     void Init() override;
     void Tick(float deltaTime) override;
     void Shutdown() override;
+    TaskAccess GetAccess() const override;
 };
 } // namespace MEngine
\ No newline at end of file
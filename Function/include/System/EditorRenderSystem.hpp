@@ -22,6 +22,8 @@
 #include <memory>
 #include <stack>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 #include <vulkan/vulkan_core.h>
 
@@ -38,8 +40,11 @@
 #include "Math.hpp"
 #include "PipelineManager.hpp"
 #include "Repository/Interface/IRepository.hpp"
+#include "Repository/PBRMaterialRepository.hpp"
+#include "Repository/Texture2DRepository.hpp"
 #include "System/RenderSystem.hpp"
 #include "System/System.hpp"
+#include "System/TransformSystem.hpp"
 #include "stb_image.h"
 
 #undef max
@@ -86,6 +91,7 @@ class EditorRenderSystem : public RenderSystem
     std::shared_ptr<SamplerManager> mSamplerManager;
     std::shared_ptr<IRepository<PBRMaterial>> mPBRMaterialRepository;
     std::shared_ptr<IRepository<Texture2D>> mTexture2DRepository;
+    std::shared_ptr<TransformSystem> mTransformSystem;
     // std::shared_ptr<ResourceManager> mResourceManager;
 
   private:
@@ -117,9 +123,7 @@ class EditorRenderSystem : public RenderSystem
     std::vector<vk::UniqueImageView> mIconImageViews;
     vk::DescriptorSet mFileIcon;
     vk::DescriptorSet mFolderIcon;
-    vk::UniqueSampler mIconSampler;
-    vk::UniqueCommandBuffer mIconTransitionCommandBuffer;
-    vk::UniqueFence mIconTransitionFence;
+    SharedSampler mIconSampler;
     entt::entity mAssetsSelectedEntity = entt::null;
     entt::entity mAssetsHoveredEntity = entt::null;
 
@@ -134,7 +138,7 @@ class EditorRenderSystem : public RenderSystem
     bool mIsSceneViewPortChanged = false;
     uint32_t mSceneViewPortWidth = 0;
     uint32_t mSceneViewPortHeight = 0;
-    vk::UniqueSampler mSceneSampler;
+    SharedSampler mSceneSampler;
     std::vector<vk::DescriptorSet> mSceneDescriptorSets;
     uint32_t mImageIndex = 0;
 
@@ -164,13 +168,31 @@ class EditorRenderSystem : public RenderSystem
     void RightClickMenu();
     void DockingSpace();
     void HierarchyWindow();
+    /**
+     * @brief 递归显示层级树中的一个节点，节点之间可拖放修改父节点
+     */
+    void HierarchyNode(entt::entity entity,
+                       const std::unordered_map<entt::entity, std::vector<entt::entity>> &children);
+    /**
+     * @brief 通过 TransformSystem 修改父节点并保持世界变换，成环等非法操作只记录日志
+     */
+    void SetEntityParent(entt::entity child, entt::entity parent);
     void InspectorWindow();
     void ToolbarWindow();
     void SceneViewWindow();
     void AssetWindow();
     void FileExplore();
-    void LoadUIIcon(const std::filesystem::path &iconPath, vk::DescriptorSet &descriptorSet);
+    /**
+     * @brief 上传解码完成的纹理，并刷新引用它们的材质与 ImGui 描述符集
+     */
+    void ProcessStreamedTextures();
+    void LoadUIIcons(const std::vector<std::pair<std::filesystem::path, vk::DescriptorSet *>> &icons);
     void CreateSceneView();
+    /**
+     * @brief 用场景 BVH 拾取视口坐标下最近的实体（按包围盒）
+     */
+    entt::entity PickEntity(const glm::vec2 &viewportPosition, const glm::vec2 &viewportSize,
+                            const CameraComponent &camera) const;
 
   private:
     void ShowTexture(const std::string &name, UUID textureID, ImVec2 size = ImVec2(50, 50));
@@ -185,13 +207,16 @@ class EditorRenderSystem : public RenderSystem
                        std::shared_ptr<SyncPrimitiveManager> syncPrimitiveManager,
                        std::shared_ptr<DescriptorManager> descriptorManager,
                        std::shared_ptr<SamplerManager> samplerManager, std::shared_ptr<BufferFactory> bufferFactory,
-                       std::shared_ptr<ImageFactory> imageFactory, std::shared_ptr<IWindow> window,
+                       std::shared_ptr<ImageFactory> imageFactory, std::shared_ptr<GeometryArena> geometryArena,
+                       std::shared_ptr<IWindow> window,
                        std::shared_ptr<IRepository<PBRMaterial>> pbrMaterialRepository,
-                       std::shared_ptr<IRepository<Texture2D>> texture2DRepository);
+                       std::shared_ptr<IRepository<Texture2D>> texture2DRepository,
+                       std::shared_ptr<TransformSystem> transformSystem);
     ~EditorRenderSystem();
     virtual void Init() override;
     virtual void Tick(float deltaTime) override;
     virtual void Shutdown() override;
+    virtual TaskAccess GetAccess() const override;
 };
 
 } // namespace MEngine
\ No newline at end of file
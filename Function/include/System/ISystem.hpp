@@ -1,5 +1,6 @@
 #pragma once
 #include "Component/Interface/IComponent.hpp"
+#include "TaskGraph.hpp"
 #include "entt/entt.hpp"
 #include <concepts>
 namespace MEngine
@@ -12,5 +13,9 @@ class ISystem
     virtual void Init() = 0;
     virtual void Tick(float deltaTime) = 0;
     virtual void Shutdown() = 0;
+    /**
+     * @brief 声明 Tick 读写的组件，帧任务图据此推导依赖
+     */
+    virtual TaskAccess GetAccess() const = 0;
 };
 } // namespace MEngine
\ No newline at end of file
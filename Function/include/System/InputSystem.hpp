@@ -125,5 +125,6 @@ class InputSystem final : public System
     void HandleSDLEvent(const SDL_Event *event);
     void Tick(float deltaTime) override;
     void Shutdown() override;
+    TaskAccess GetAccess() const override;
 };
 } // namespace MEngine
\ No newline at end of file
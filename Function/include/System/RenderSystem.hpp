@@ -1,4 +1,5 @@
 #pragma once
+#include "BVH.hpp"
 #include "Buffer.hpp"
 #include "BufferFactory.hpp"
 #include "CommandBuffeManager.hpp"
@@ -9,9 +10,13 @@
 #include "Component/TransformComponent.hpp"
 #include "Context.hpp"
 #include "DescriptorManager.hpp"
+#include "DrawList.hpp"
 #include "Entity/Interface/IMaterial.hpp"
+#include "Frustum.hpp"
+#include "GeometryArena.hpp"
 #include "Image.hpp"
 #include "ImageFactory.hpp"
+#include "IndirectDraw.hpp"
 #include "Interface/ILogger.hpp"
 #include "Interface/IWindow.hpp"
 #include "MEngine.hpp"
@@ -27,11 +32,45 @@
 #include "Vertex.hpp"
 #include "entt/entt.hpp"
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <vector>
 
 namespace MEngine
 {
+/**
+ * @brief 视锥剔除统计（每帧）
+ */
+struct CullingStats
+{
+    uint32_t total = 0;
+    uint32_t culled = 0;
+    uint32_t drawn = 0;
+    // 交给 GPU 剔除的物体数量，不计入以上统计
+    uint32_t gpuObjects = 0;
+};
+/**
+ * @brief 每帧实际录制的绑定与绘制次数
+ */
+struct BindStats
+{
+    uint32_t pipelineBinds = 0;
+    uint32_t descriptorSetBinds = 0;
+    uint32_t vertexBufferBinds = 0;
+    uint32_t indexBufferBinds = 0;
+    uint32_t drawCalls = 0;
+    uint32_t instances = 0;
+};
+/**
+ * @brief 每帧的 LOD 选择统计
+ */
+struct LODStats
+{
+    uint32_t objects = 0;
+    uint32_t reducedObjects = 0; // 使用 LOD0 以外级别的物体
+    uint64_t triangles = 0;      // 按所选 LOD 计算的三角形数
+    uint64_t fullTriangles = 0;  // 全部使用 LOD0 时的三角形数
+};
 class RenderSystem : public System
 {
   protected:
@@ -46,6 +85,7 @@ class RenderSystem : public System
 
     std::shared_ptr<BufferFactory> mBufferFactory;
     std::shared_ptr<ImageFactory> mImageFactory;
+    std::shared_ptr<GeometryArena> mGeometryArena;
 
     std::shared_ptr<IWindow> mWindow;
 
@@ -61,6 +101,10 @@ class RenderSystem : public System
     uint32_t mImageIndex;
     std::vector<std::vector<vk::UniqueCommandBuffer>> mSecondaryCommandBuffers;
     std::vector<vk::UniqueCommandBuffer> mGraphicCommandBuffers;
+    // 每帧提交前录制上传资源的队列族所有权获取屏障
+    std::vector<vk::UniqueCommandBuffer> mOwnershipCommandBuffers;
+    // 可能仍被在途帧引用的资源，按排队时的帧下标存放，下次等待该帧的 fence 后释放
+    std::vector<std::vector<std::function<void()>>> mDeferredReleases;
 
     // Global DescriptorSet
     std::vector<vk::UniqueDescriptorSet> mGlobalDescriptorSets;
@@ -89,13 +133,100 @@ class RenderSystem : public System
     };
     // ShadowParameters_SBO
     //  main camera
-    entt::entity mMainCameraEntity;
+    entt::entity mMainCameraEntity = entt::null;
+    // 视锥剔除
+    static constexpr uint32_t mCullChunkSize = 1024;
+    CullingStats mCullingStats;
+    std::vector<uint32_t> mVisibleIds;
+    // 按实体下标标记 BVH 查询结果
+    std::vector<uint8_t> mVisibleMask;
+    // 排序后的绘制列表，DrawPacket::index 指向 mDrawEntities
+    DrawList mOpaqueDrawList;
+    DrawList mTransparentDrawList;
+    std::vector<entt::entity> mDrawEntities;
+    // 材质或网格 LOD 超过 16 位编号时排序键无法区分状态，本帧不透明物体不合批
+    bool mIsSortIdOverflow = false;
+    BindStats mBindStats;
+    // 每帧的实例缓冲区，不透明物体按 (材质, 网格) 合批后写入模型矩阵
+    static constexpr uint32_t mInitialInstanceCapacity = 1024;
+    std::vector<UniqueBuffer> mInstanceBuffers;
+    // GPU 驱动：不透明 PBR 物体由计算着色器剔除并生成间接绘制命令，每个 (材质, 网格) 一条命令
+    bool mUseGPUDriven = false;
+    static constexpr uint32_t mGPUCullingGroupSize = 64;
+    static constexpr uint32_t mInitialGPUBatchCapacity = 256;
+    struct GPUDrivenFrame
+    {
+        UniqueBuffer objectBuffer;    // GPUObjectData[]
+        UniqueBuffer commandBuffer;   // DrawIndexedIndirectCommand[]，每批次一条
+        UniqueBuffer drawCountBuffer; // uint32_t[]，每个绘制组一个，由计算着色器写入
+        UniqueBuffer instanceBuffer;  // InstanceData[]，计算着色器输出
+        vk::UniqueDescriptorSet descriptorSet;
+    };
+    std::vector<GPUDrivenFrame> mGPUDrivenFrames;
+    // 相同 (顶点格式, 材质, 几何页) 的批次命令连续存放，合并为一次间接绘制
+    struct GPUDrawGroup
+    {
+        entt::entity entity; // 代表实体，用于取材质与网格
+        uint32_t firstBatch = 0;
+        uint32_t batchCount = 0;
+    };
+    std::vector<GPUDrawGroup> mGPUDrawGroups;
+    uint32_t mMaxGroupBatches = 1; // 一次间接绘制最多执行的命令数
+    uint32_t mGPUDrivenObjectCount = 0;
+    // LOD：按主相机下的屏幕空间误差（像素）逐实体选择，阈值上下留出滞回区间避免在边界处来回切换
+    bool mUseLOD = true;
+    float mLODPixelError = 1.0f;
+    float mLODHysteresis = 0.25f;
+    bool mHasLODCamera = false;
+    glm::vec3 mLODCameraPosition = glm::vec3(0.0f);
+    float mLODNearPlane = 0.1f;
+    float mLODProjectionScale = 0.0f; // 距离为 1 处一个世界单位对应的像素数
+    LODStats mLODStats;
 
   protected:
     void InitialRenderTargetImageLayout();
     void InitialSwapchainImageLayout();
     void CollectEntities();
+    void CullEntities();
+    void CullEntities(const Frustum &frustum, std::vector<entt::entity> &entities);
+    void BuildDrawLists();
+    /**
+     * @brief 每帧计算 LOD 选择所需的相机参数
+     */
+    void PrepareLODSelection();
+    /**
+     * @brief 当前级别的投影误差超过阈值上沿时细化，下一级低于阈值下沿时粗化，结果写回 MeshComponent::lod
+     */
+    uint32_t SelectLOD(MeshComponent &meshComponent, const glm::mat4 &model);
+    /**
+     * @brief 按排序顺序录制绘制命令，与上一次绑定相同的管线/描述符集/缓冲区不再重复绑定
+     * useInstancing 时相邻的相同 (管线, 材质, 网格) 合并为一次实例化绘制，仅用于不透明物体
+     */
+    void RecordDrawList(const DrawList &drawList, bool useInstancing = false);
+    void PrepareInstanceBuffer(uint32_t instanceCount);
+    void PrepareGPUDrivenFrame(GPUDrivenFrame &frame, uint32_t objectCount, uint32_t batchCount);
+    /**
+     * @brief 取出不透明 PBR 物体写入物体缓冲区并按 (材质, 网格) 生成间接绘制命令，这些物体不再参与 CPU 剔除与排序
+     * 命令按 (顶点格式, 材质, 几何页) 分组，组内绑定状态相同
+     */
+    void BuildGPUDrawData();
+    /**
+     * @brief 在渲染通道之前录制剔除计算着色器
+     */
+    void DispatchGPUCulling();
+    /**
+     * @brief 每个绘制组一次 drawIndexedIndirectCount，录制开销与物体及网格数量无关
+     */
+    void RecordIndirectDraws();
     void Prepare();
+    /**
+     * @brief release 在当前帧及之前提交的帧全部完成后执行，用于替换可能仍被 GPU 引用的资源
+     */
+    void DeferRelease(std::function<void()> &&release);
+    /**
+     * @brief 等待设备空闲并执行所有排队的释放
+     */
+    void FlushDeferredReleases();
     void RenderShadowDepthPass();
     void RenderDeferred();
     void RenderForward();
@@ -117,7 +248,7 @@ class RenderSystem : public System
                  std::shared_ptr<CommandBufferManager> commandBufferManager,
                  std::shared_ptr<SyncPrimitiveManager> syncPrimitiveManager,
                  std::shared_ptr<DescriptorManager> descriptorManager, std::shared_ptr<BufferFactory> bufferFactory,
-                 std::shared_ptr<ImageFactory> imageFactory);
+                 std::shared_ptr<ImageFactory> imageFactory, std::shared_ptr<GeometryArena> geometryArena);
     ~RenderSystem();
     inline auto BeginRender()
     {
@@ -130,5 +261,9 @@ class RenderSystem : public System
     virtual void Init() override;
     virtual void Tick(float deltaTime) override;
     virtual void Shutdown() override;
+    virtual TaskAccess GetAccess() const override;
+    const CullingStats &GetCullingStats() const noexcept;
+    const BindStats &GetBindStats() const noexcept;
+    const LODStats &GetLODStats() const noexcept;
 };
 } // namespace MEngine
\ No newline at end of file
@@ -0,0 +1,42 @@
+#pragma once
+#include "BVH.hpp"
+#include "Component/MeshComponent.hpp"
+#include "Component/TransformComponent.hpp"
+#include "Interface/IConfigure.hpp"
+#include "System/System.hpp"
+#include "TaskScheduler.hpp"
+#include "entt/entt.hpp"
+#include <memory>
+#include <vector>
+namespace MEngine
+{
+/**
+ * @brief 维护场景 BVH（存放在 registry.ctx() 中）
+ * 网格实体增删时重建，仅变换变化时 Refit，Refit 导致质量下降过多时重建。
+ */
+class SpatialSystem final : public System
+{
+  private:
+    // 并行计算包围盒时每个任务处理的实体数量
+    static constexpr uint32_t mChunkSize = 4096;
+    // 根节点表面积超过构建时的该倍数后重建
+    static constexpr float mMaxDegradation = 2.0f;
+    // BVH 图元下标 -> 实体
+    std::vector<entt::entity> mPrimitiveEntities;
+    bool mNeedsRebuild = true;
+
+  private:
+    void OnSceneChanged(entt::registry &registry, entt::entity entity);
+    void Rebuild(BVH &bvh);
+    static AABB GetWorldBounds(const TransformComponent &transform, const MeshComponent &mesh);
+
+  public:
+    SpatialSystem(std::shared_ptr<ILogger> logger, std::shared_ptr<Context> context,
+                  std::shared_ptr<IConfigure> configure, std::shared_ptr<entt::registry> registry);
+
+    void Init() override;
+    void Tick(float deltaTime) override;
+    void Shutdown() override;
+    TaskAccess GetAccess() const override;
+};
+} // namespace MEngine
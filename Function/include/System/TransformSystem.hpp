@@ -5,14 +5,41 @@
 #include "Component/TransformComponent.hpp"
 #include "Interface/IConfigure.hpp"
 #include "System/System.hpp"
+#include "TaskScheduler.hpp"
 #include "entt/entt.hpp"
 #include <memory>
+#include <unordered_map>
 namespace MEngine
 {
 class TransformSystem final : public System
 {
   private:
     glm::mat4x4 mRotationMatrix = glm::mat4(1.0f);
+    // 每个任务处理的变换数量，少于一个分块时直接在当前线程更新
+    static constexpr uint32_t mChunkSize = 4096;
+    // 每次批量合成的局部矩阵数量，暂存数组放在栈上
+    static constexpr size_t mBatchSize = 64;
+    std::atomic<uint32_t> mUpdatedCount{0};
+    // 按深度排序的实体（广度优先），mLevelOffsets[d] 为第 d 层的起始下标
+    std::vector<entt::entity> mSortedEntities;
+    std::vector<size_t> mLevelOffsets;
+    bool mHierarchyChanged = true;
+    // 本帧被销毁实体的最后世界矩阵，重建层级时用于把子节点的局部变换换算成世界变换
+    std::unordered_map<entt::entity, glm::mat4> mDestroyedWorldMatrices;
+
+  private:
+    void OnHierarchyChanged(entt::registry &registry, entt::entity entity);
+    void OnTransformDestroyed(entt::registry &registry, entt::entity entity);
+    void RebuildHierarchy();
+    void UpdateLevel(size_t begin, size_t end);
+    /**
+     * @brief 沿父链由局部变换合成世界矩阵，不依赖上一帧的 modelMatrix
+     */
+    glm::mat4 ComputeWorldMatrix(entt::entity entity) const;
+    /**
+     * @brief 将矩阵分解后写入局部 TRS，带切变时只保留 TRS 部分
+     */
+    static void SetLocalMatrix(TransformComponent &transform, const glm::mat4 &localMatrix);
 
   public:
     TransformSystem(std::shared_ptr<ILogger> logger, std::shared_ptr<Context> context,
@@ -21,5 +48,15 @@ class TransformSystem final : public System
     void Init() override;
     void Tick(float deltaTime) override;
     void Shutdown() override;
+    TaskAccess GetAccess() const override;
+    /**
+     * @brief 上一帧重算的变换数量
+     */
+    uint32_t GetUpdatedCount() const noexcept;
+    /**
+     * @brief 设置父节点，parent 为 entt::null 时成为根节点
+     * keepWorldTransform 为 true 时改写局部变换，使子节点的世界变换保持不变（编辑器中拖动层级时使用）
+     */
+    void SetParent(entt::entity child, entt::entity parent, bool keepWorldTransform = false);
 };
 } // namespace MEngine
\ No newline at end of file
@@ -81,11 +81,10 @@ void CameraSystem::Tick(float deltaTime)
         auto extent = mRenderPassManager->GetRenderTargetExtent();
         camera.aspectRatio = static_cast<float>(extent.width * 1.0f) / extent.height;
         glm::mat4 viewMatrix = glm::lookAtRH(camera.position, camera.position + camera.front, camera.up);
-        glm::mat4 pitchMatrix = glm::rotate(glm::mat4(1.0f), glm::radians(camera.pitch), glm::vec3(1.0f, 0.0f, 0.0f));
-        glm::mat4 yawMatrix = glm::rotate(glm::mat4(1.0f), glm::radians(camera.yaw), glm::vec3(0.0f, 1.0f, 0.0f));
-        glm::mat4 rollMatrix = glm::rotate(glm::mat4(1.0f), glm::radians(camera.roll), glm::vec3(0.0f, 0.0f, 1.0f));
-        glm::mat4 rotationMatrix = yawMatrix * pitchMatrix * rollMatrix;
-        camera.viewMatrix = rotationMatrix * viewMatrix;
+        // yaw * pitch * roll 一次构建
+        glm::mat4 rotationMatrix =
+            glm::eulerAngleYXZ(glm::radians(camera.yaw), glm::radians(camera.pitch), glm::radians(camera.roll));
+        camera.viewMatrix = Math::Multiply(rotationMatrix, viewMatrix);
         camera.projectionMatrix = glm::perspective(glm::radians(camera.fovY / camera.zoom), camera.aspectRatio,
                                                    camera.nearPlane, camera.farPlane);
     }
@@ -94,4 +93,8 @@ void CameraSystem::Shutdown()
 {
     mLogger->Info("Camera System Shutdown");
 }
+TaskAccess CameraSystem::GetAccess() const
+{
+    return TaskAccess().Write<CameraComponent>();
+}
 } // namespace MEngine
\ No newline at end of file
@@ -16,23 +16,23 @@ EditorRenderSystem::EditorRenderSystem(
     std::shared_ptr<CommandBufferManager> commandBufferManager,
     std::shared_ptr<SyncPrimitiveManager> syncPrimitiveManager, std::shared_ptr<DescriptorManager> descriptorManager,
     std::shared_ptr<SamplerManager> samplerManager, std::shared_ptr<BufferFactory> bufferFactory,
-    std::shared_ptr<ImageFactory> imageFactory, std::shared_ptr<IWindow> window,
+    std::shared_ptr<ImageFactory> imageFactory, std::shared_ptr<GeometryArena> geometryArena,
+    std::shared_ptr<IWindow> window,
     std::shared_ptr<IRepository<PBRMaterial>> pbrMaterialRepository,
-    std::shared_ptr<IRepository<Texture2D>> texture2DRepository)
+    std::shared_ptr<IRepository<Texture2D>> texture2DRepository, std::shared_ptr<TransformSystem> transformSystem)
     : RenderSystem(logger, context, configure, registry, renderPassManager, pipelineLayoutManager, pipelineManager,
-                   commandBufferManager, syncPrimitiveManager, descriptorManager, bufferFactory, imageFactory),
+                   commandBufferManager, syncPrimitiveManager, descriptorManager, bufferFactory, imageFactory,
+                   geometryArena),
       mWindow(window), mSamplerManager(samplerManager), mPBRMaterialRepository(pbrMaterialRepository),
-      mTexture2DRepository(texture2DRepository)
+      mTexture2DRepository(texture2DRepository), mTransformSystem(transformSystem)
 {
 }
 void EditorRenderSystem::Init()
 {
     RenderSystem::Init();
     InitialEditorRenderTargetImageLayout();
-    mIconTransitionCommandBuffer = mCommandBufferManager->CreatePrimaryCommandBuffer(CommandBufferType::Graphic);
-    mIconSampler = mSamplerManager->CreateUniqueSampler(vk::Filter::eLinear, vk::Filter::eLinear);
-    mSceneSampler = mSamplerManager->CreateUniqueSampler(vk::Filter::eLinear, vk::Filter::eLinear);
-    mIconTransitionFence = mSyncPrimitiveManager->CreateFence();
+    mIconSampler = mSamplerManager->GetSampler(vk::Filter::eLinear, vk::Filter::eLinear);
+    mSceneSampler = mSamplerManager->GetSampler(vk::Filter::eLinear, vk::Filter::eLinear);
     //  Initialize ImGui context
     IMGUI_CHECKVERSION();
     ImGui::CreateContext();
@@ -74,7 +74,7 @@ void EditorRenderSystem::Init()
 
     // auto defaultTexture = mTextureManager->GetDefaultTexture();
     // mDefaultTextureDescriptorSet =
-    //     ImGui_ImplVulkan_AddTexture(mSceneSampler.get(), defaultTexture->GetImageView(),
+    //     ImGui_ImplVulkan_AddTexture(mSceneSampler->get(), defaultTexture->GetImageView(),
     //                                 static_cast<VkImageLayout>(vk::ImageLayout::eShaderReadOnlyOptimal));
     // 添加编辑相机
     auto editorCameraEntity = mRegistry->create();
@@ -90,8 +90,8 @@ void EditorRenderSystem::InitialFileExplore()
 {
     mCurrentPath = mProjectPath;
     // Icons
-    LoadUIIcon(mUIResourcePath / "Icon" / "folder.png", mFolderIcon);
-    LoadUIIcon(mUIResourcePath / "Icon" / "file.png", mFileIcon);
+    LoadUIIcons({{mUIResourcePath / "Icon" / "folder.png", &mFolderIcon},
+                 {mUIResourcePath / "Icon" / "file.png", &mFileIcon}});
     // entity
     auto entity = mAssetRegistry->create();
     mAssetRegistry->emplace<AssetsComponent>(entity);
@@ -109,7 +109,7 @@ AssetType EditorRenderSystem::GetAssetTypeFromExtension(const std::filesystem::p
     auto ext = path.extension().string();
     if (ext == ".pbrmat" || ext == ".phongmat")
         return AssetType::PBRMaterial;
-    if (ext == ".tex2D" || ext == ".png" || ext == ".jpg")
+    if (ext == ".tex2D" || ext == ".png" || ext == ".jpg" || ext == ".mtex")
         return AssetType::Texture2D;
     if (ext == ".glb" || ext == ".fbx")
         return AssetType::Model;
@@ -182,8 +182,16 @@ void EditorRenderSystem::RemoveAssetNode(entt::entity entity)
 void EditorRenderSystem::Tick(float deltaTime)
 {
     Prepare();
+    ProcessStreamedTextures();
     // TickRotationMatrix();
     CollectEntities(); // Collect same material render entities
+    if (mUseGPUDriven)
+    {
+        BuildGPUDrawData();
+        DispatchGPUCulling();
+    }
+    CullEntities();
+    BuildDrawLists();
     ImGui_ImplSDL3_NewFrame();
     ImGui_ImplVulkan_NewFrame();
     ImGui::NewFrame();
@@ -257,6 +265,8 @@ void EditorRenderSystem::Tick(float deltaTime)
 }
 void EditorRenderSystem::Shutdown()
 {
+    // 排队的释放包含 ImGui 纹理，需在 ImGui 后端关闭前执行
+    FlushDeferredReleases();
     mIO->Fonts->Clear();
     mIO->Fonts->ClearInputData();
     mIO->Fonts->ClearTexData();
@@ -327,62 +337,112 @@ void EditorRenderSystem::CreateSceneView()
     for (size_t i = 0; i < editorRenderTargets.size(); ++i)
     {
         mSceneDescriptorSets.push_back(
-            ImGui_ImplVulkan_AddTexture(mSceneSampler.get(), editorRenderTargets[i].colorImageView.get(),
+            ImGui_ImplVulkan_AddTexture(mSceneSampler->get(), editorRenderTargets[i].colorImageView.get(),
                                         static_cast<VkImageLayout>(vk::ImageLayout::eShaderReadOnlyOptimal)));
     }
     mLogger->Info("Scene View Descriptor Set Created");
 }
-void EditorRenderSystem::LoadUIIcon(const std::filesystem::path &iconPath, vk::DescriptorSet &descriptorSet)
+void EditorRenderSystem::ProcessStreamedTextures()
 {
-    mIconTransitionCommandBuffer->reset();
-    int iconWidth, iconHeight, iconChannels;
-    stbi_set_flip_vertically_on_load(true);
-    auto iconData = stbi_load(iconPath.string().c_str(), &iconWidth, &iconHeight, &iconChannels, STBI_rgb_alpha);
-    iconChannels = 4;
-    if (iconData)
-    {
-        // 1. 创建Image
-        vk::DeviceSize folderSize = iconWidth * iconHeight * iconChannels;
-        mIconImages.push_back(mImageFactory->CreateImage(ImageType::Texture2D, vk::Extent3D(iconWidth, iconHeight, 1),
-                                                         folderSize, iconData));
-        // 2. 创建ImageView
-        auto imageView = mImageFactory->CreateImageView(mIconImages.back().get());
-        mIconImageViews.push_back(std::move(imageView));
-        // 3. 转换布局
-        vk::ImageMemoryBarrier imagebarrier;
-        imagebarrier.setImage(mIconImages.back()->GetHandle())
-            .setOldLayout(vk::ImageLayout::eUndefined)
-            .setNewLayout(vk::ImageLayout::eShaderReadOnlyOptimal)
-            .setSrcQueueFamilyIndex(mContext->GetQueueFamilyIndicates().graphicsFamily.value())
-            .setDstQueueFamilyIndex(mContext->GetQueueFamilyIndicates().graphicsFamily.value())
-            .setSubresourceRange(vk::ImageSubresourceRange(vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1))
-            .setSrcAccessMask(vk::AccessFlagBits::eNoneKHR)
-            .setDstAccessMask(vk::AccessFlagBits::eShaderRead);
-        mIconTransitionCommandBuffer->begin(vk::CommandBufferBeginInfo());
-        mIconTransitionCommandBuffer->pipelineBarrier(vk::PipelineStageFlagBits::eTopOfPipe,
-                                                      vk::PipelineStageFlagBits::eFragmentShader, {}, {}, {},
-                                                      imagebarrier);
-        mIconTransitionCommandBuffer->end();
-        vk::SubmitInfo submitInfo;
-        submitInfo.setCommandBuffers(mIconTransitionCommandBuffer.get());
-        //  4. 创建描述符集
-        descriptorSet =
-            ImGui_ImplVulkan_AddTexture(mIconSampler.get(), mIconImageViews.back().get(),
-                                        static_cast<VkImageLayout>(vk::ImageLayout::eShaderReadOnlyOptimal));
-        mContext->GetDevice().resetFences({mIconTransitionFence.get()});
-        mContext->SubmitToGraphicQueue({submitInfo}, mIconTransitionFence.get());
-        auto result = mContext->GetDevice().waitForFences({mIconTransitionFence.get()}, VK_TRUE, 1000000000); // 1s
-        if (result != vk::Result::eSuccess)
+    auto textureRepository = std::dynamic_pointer_cast<Texture2DRepository>(mTexture2DRepository);
+    auto materialRepository = std::dynamic_pointer_cast<PBRMaterialRepository>(mPBRMaterialRepository);
+    if (!textureRepository || !materialRepository || !textureRepository->HasDecodedTextures())
+    {
+        return;
+    }
+    // 新图像由本帧提交在上传时间线上等待；其他在途帧仍可能引用旧图像与描述符集，
+    // 它们延迟到这些帧完成后释放，材质改用新分配的描述符集，不需要等待设备空闲
+    std::vector<Texture2DRepository::RetiredTexture> retired;
+    auto updated = textureRepository->ProcessDecodedTextures(retired);
+    if (!retired.empty())
+    {
+        DeferRelease([resources = std::make_shared<decltype(retired)>(std::move(retired))]() { resources->clear(); });
+    }
+    if (updated.empty())
+    {
+        return;
+    }
+    std::unordered_set<UUID> updatedSet(updated.begin(), updated.end());
+    for (auto id : updated)
+    {
+        auto it = mDescriptorSetMap.find(id);
+        if (it != mDescriptorSetMap.end())
+        {
+            DeferRelease([descriptorSet = it->second]() { ImGui_ImplVulkan_RemoveTexture(descriptorSet); });
+            mDescriptorSetMap.erase(it);
+        }
+    }
+    for (auto material : mPBRMaterialRepository->GetAll())
+    {
+        if (updatedSet.contains(material->GetAlbedoMapID()) || updatedSet.contains(material->GetNormalMapID()) ||
+            updatedSet.contains(material->GetMetallicRoughnessMapID()) || updatedSet.contains(material->GetAOMapID()) ||
+            updatedSet.contains(material->GetEmissiveMapID()))
+        {
+            auto descriptorSet = std::make_shared<vk::UniqueDescriptorSet>(
+                materialRepository->DetachDescriptorSet(material->GetID()));
+            DeferRelease([descriptorSet]() { descriptorSet->reset(); });
+            mPBRMaterialRepository->Update(material->GetID(), material);
+        }
+    }
+}
+void EditorRenderSystem::LoadUIIcons(const std::vector<std::pair<std::filesystem::path, vk::DescriptorSet *>> &icons)
+{
+    // 1. 在工作线程并行解码所有图标，合并为一次上传
+    struct DecodedIcon
+    {
+        stbi_uc *data = nullptr;
+        int width = 0;
+        int height = 0;
+    };
+    std::vector<DecodedIcon> decodedIcons(icons.size());
+    std::vector<std::shared_ptr<Task>> decodeTasks;
+    for (size_t i = 0; i < icons.size(); ++i)
+    {
+        decodeTasks.push_back(Task::Run([&icon = decodedIcons[i], path = icons[i].first]() {
+            int channels;
+            stbi_set_flip_vertically_on_load_thread(true);
+            icon.data = stbi_load(path.string().c_str(), &icon.width, &icon.height, &channels, STBI_rgb_alpha);
+        }));
+    }
+    Task::WhenAll(decodeTasks);
+    std::vector<stbi_uc *> iconData;
+    std::vector<ImageUploadRequest> requests;
+    std::vector<vk::DescriptorSet *> descriptorSets;
+    for (size_t i = 0; i < icons.size(); ++i)
+    {
+        const auto &[iconPath, descriptorSet] = icons[i];
+        auto &icon = decodedIcons[i];
+        if (!icon.data)
         {
-            mLogger->Error("Failed to create icon: {}", iconPath.string());
+            mLogger->Error("Failed to load icon: {}", iconPath.string());
+            continue;
         }
+        ImageUploadRequest request{};
+        request.type = ImageType::Texture2D;
+        request.extent = vk::Extent3D(icon.width, icon.height, 1);
+        request.size = static_cast<vk::DeviceSize>(icon.width) * icon.height * 4;
+        request.data = icon.data;
+        requests.push_back(request);
+        iconData.push_back(icon.data);
+        descriptorSets.push_back(descriptorSet);
         mLogger->Debug("loaded icon: {}", iconPath.string());
     }
-    else
+    // 2. 创建 Image，上传结束时已处于 ShaderReadOnlyOptimal，渲染提交会等待上传完成
+    auto images = mImageFactory->CreateImages(requests);
+    for (auto data : iconData)
+    {
+        stbi_image_free(data);
+    }
+    for (size_t i = 0; i < images.size(); ++i)
     {
-        mLogger->Error("Failed to load icon: {}", iconPath.string());
+        // 3. 创建ImageView
+        mIconImages.push_back(std::move(images[i]));
+        mIconImageViews.push_back(mImageFactory->CreateImageView(mIconImages.back().get()));
+        //  4. 创建描述符集
+        *descriptorSets[i] =
+            ImGui_ImplVulkan_AddTexture(mIconSampler->get(), mIconImageViews.back().get(),
+                                        static_cast<VkImageLayout>(vk::ImageLayout::eShaderReadOnlyOptimal));
     }
-    stbi_image_free(iconData);
 }
 void EditorRenderSystem::SetDefaultWindowLayout()
 {
@@ -426,7 +486,8 @@ void EditorRenderSystem::HierarchyWindow()
         mAssetsHoveredEntity = entt::null;
         mAssetsSelectedEntity = entt::null;
     }
-    // 显示实体列表
+    // 按父节点分组显示实体树，父节点已销毁的实体显示为根节点
+    std::unordered_map<entt::entity, std::vector<entt::entity>> children;
     auto entities = mRegistry->view<TransformComponent>();
     for (auto entity : entities)
     {
@@ -434,21 +495,13 @@ void EditorRenderSystem::HierarchyWindow()
         {
             continue;
         }
-        ImGui::PushID(static_cast<int>(entt::to_integral(entity)));
-        auto entityLabel = std::format("Entity {}", entt::to_integral(entity));
-        if (ImGui::Selectable(entityLabel.c_str(), mSelectedEntity == entity))
-        {
-            mSelectedEntity = entity;
-        }
-        if (ImGui::IsItemHovered(ImGuiHoveredFlags_AllowWhenBlockedByPopup))
-        {
-            mHoveredEntity = entity;
-            if (ImGui::IsMouseClicked(ImGuiMouseButton_Right))
-            {
-                mSelectedEntity = entity;
-            }
-        }
-        ImGui::PopID();
+        entt::entity parent = entities.get<TransformComponent>(entity).parent;
+        bool hasParent = parent != entt::null && entities.contains(parent);
+        children[hasParent ? parent : entt::null].push_back(entity);
+    }
+    for (auto entity : children[entt::null])
+    {
+        HierarchyNode(entity, children);
     }
     if (ImGui::IsWindowHovered() && !ImGui::IsAnyItemHovered())
     {
@@ -469,6 +522,18 @@ void EditorRenderSystem::HierarchyWindow()
         }
         if (mHoveredEntity != entt::null)
         {
+            if (ImGui::MenuItem("Create Child Entity"))
+            {
+                auto entity = mRegistry->create();
+                mRegistry->emplace<TransformComponent>(entity);
+                SetEntityParent(entity, mHoveredEntity);
+                mSelectedEntity = entity;
+            }
+            if (mRegistry->get<TransformComponent>(mHoveredEntity).parent != entt::null &&
+                ImGui::MenuItem("Clear Parent"))
+            {
+                SetEntityParent(mHoveredEntity, entt::null);
+            }
             ImGui::Separator();
             if (ImGui::MenuItem("Delete Entity"))
             {
@@ -482,6 +547,72 @@ void EditorRenderSystem::HierarchyWindow()
     }
     ImGui::End();
 }
+void EditorRenderSystem::HierarchyNode(entt::entity entity,
+                                       const std::unordered_map<entt::entity, std::vector<entt::entity>> &children)
+{
+    ImGui::PushID(static_cast<int>(entt::to_integral(entity)));
+    auto it = children.find(entity);
+    bool isLeaf = it == children.end();
+    ImGuiTreeNodeFlags flags =
+        ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_SpanAvailWidth | ImGuiTreeNodeFlags_DefaultOpen;
+    if (isLeaf)
+    {
+        flags |= ImGuiTreeNodeFlags_Leaf | ImGuiTreeNodeFlags_NoTreePushOnOpen;
+    }
+    if (mSelectedEntity == entity)
+    {
+        flags |= ImGuiTreeNodeFlags_Selected;
+    }
+    auto entityLabel = std::format("Entity {}", entt::to_integral(entity));
+    bool isOpen = ImGui::TreeNodeEx(entityLabel.c_str(), flags);
+    if (ImGui::IsItemClicked() && !ImGui::IsItemToggledOpen())
+    {
+        mSelectedEntity = entity;
+    }
+    if (ImGui::IsItemHovered(ImGuiHoveredFlags_AllowWhenBlockedByPopup))
+    {
+        mHoveredEntity = entity;
+        if (ImGui::IsMouseClicked(ImGuiMouseButton_Right))
+        {
+            mSelectedEntity = entity;
+        }
+    }
+    // 把实体拖到另一个实体上作为其子节点
+    if (ImGui::BeginDragDropSource(ImGuiDragDropFlags_None))
+    {
+        ImGui::SetDragDropPayload("HIERARCHY_ENTITY", &entity, sizeof(entity));
+        ImGui::Text("%s", entityLabel.c_str());
+        ImGui::EndDragDropSource();
+    }
+    if (ImGui::BeginDragDropTarget())
+    {
+        if (auto payload = ImGui::AcceptDragDropPayload("HIERARCHY_ENTITY"))
+        {
+            SetEntityParent(*static_cast<const entt::entity *>(payload->Data), entity);
+        }
+        ImGui::EndDragDropTarget();
+    }
+    if (isOpen && !isLeaf)
+    {
+        for (auto child : it->second)
+        {
+            HierarchyNode(child, children);
+        }
+        ImGui::TreePop();
+    }
+    ImGui::PopID();
+}
+void EditorRenderSystem::SetEntityParent(entt::entity child, entt::entity parent)
+{
+    try
+    {
+        mTransformSystem->SetParent(child, parent, true);
+    }
+    catch (const std::runtime_error &)
+    {
+        // SetParent 已记录原因，编辑器中忽略这次操作
+    }
+}
 void EditorRenderSystem::ShowTexture(const std::string &name, UUID textureID, ImVec2 size)
 {
     auto texture2D = mTexture2DRepository->Get(textureID);
@@ -607,24 +738,31 @@ void EditorRenderSystem::InspectorWindow()
             {
                 ImGui::BeginChild("Transform", ImVec2(0, 100), true);
                 auto &transform = mRegistry->get<TransformComponent>(mSelectedEntity);
+                // 显示和编辑的是相对父节点的局部变换
                 auto modelMatrix = transform.modelMatrix;
+                if (transform.parent != entt::null)
+                {
+                    modelMatrix =
+                        glm::inverse(mRegistry->get<TransformComponent>(transform.parent).modelMatrix) * modelMatrix;
+                }
                 float matrixTranslation[3], matrixRotation[3], matrixScale[3];
                 ImGuizmo::DecomposeMatrixToComponents(glm::value_ptr(modelMatrix), matrixTranslation, matrixRotation,
                                                       matrixScale);
-                ImGui::DragFloat3("Position", matrixTranslation, 0.1f);
-                ImGui::DragFloat3("Rotation", matrixRotation, 0.1f);
-                ImGui::DragFloat3("Scale", matrixScale, 0.1f);
+                bool changed = ImGui::DragFloat3("Position", matrixTranslation, 0.1f);
+                changed |= ImGui::DragFloat3("Rotation", matrixRotation, 0.1f);
+                changed |= ImGui::DragFloat3("Scale", matrixScale, 0.1f);
                 ImGuizmo::RecomposeMatrixFromComponents(matrixTranslation, matrixRotation, matrixScale,
                                                         glm::value_ptr(modelMatrix));
                 // 分解矩阵
                 glm::vec3 translation, scale, skew;
                 glm::quat rotation;
                 glm::vec4 perspective;
-                if (glm::decompose(modelMatrix, scale, rotation, translation, skew, perspective))
+                if (changed && glm::decompose(modelMatrix, scale, rotation, translation, skew, perspective))
                 {
                     transform.position = translation;
                     transform.rotation = rotation;
                     transform.scale = scale;
+                    transform.isDirty = true;
                 }
                 ImGui::EndChild();
             }
@@ -717,6 +855,28 @@ void EditorRenderSystem::ToolbarWindow()
         ImGui::Text("SceneView Size: %1.f x %1.f", sceneWindow->ContentSize.x, sceneWindow->ContentSize.y);
         ImGui::SameLine();
         ImGui::TextColored(ImVec4(1, 1, 0, 1), "FPS: %1.f", ImGui::GetIO().Framerate);
+        ImGui::SameLine();
+        ImGui::Text("Drawn: %u Culled: %u GPU: %u", mCullingStats.drawn, mCullingStats.culled,
+                    mCullingStats.gpuObjects);
+        ImGui::SameLine();
+        ImGui::Text("Binds: pipeline %u set %u vb %u ib %u", mBindStats.pipelineBinds, mBindStats.descriptorSetBinds,
+                    mBindStats.vertexBufferBinds, mBindStats.indexBufferBinds);
+        ImGui::SameLine();
+        ImGui::Text("Draws: %u Instances: %u", mBindStats.drawCalls, mBindStats.instances);
+        ImGui::SameLine();
+        ImGui::Text("LOD: triangles %llu / %llu reduced %u / %u", static_cast<unsigned long long>(mLODStats.triangles),
+                    static_cast<unsigned long long>(mLODStats.fullTriangles), mLODStats.reducedObjects,
+                    mLODStats.objects);
+        ImGui::SameLine();
+        auto geometryStats = mGeometryArena->GetStats();
+        ImGui::Text("Geometry: %u meshes %u pages %.1f%% vertices used", geometryStats.allocations,
+                    geometryStats.pages,
+                    geometryStats.vertexCapacity ? 100.0 * geometryStats.vertexUsed / geometryStats.vertexCapacity
+                                                 : 0.0);
+        ImGui::SameLine();
+        auto meshStats = Mesh::GetMemoryStats();
+        ImGui::Text("Mesh memory: GPU %.1f MB CPU %.1f MB (saved %.1f MB)", meshStats.gpuBytes / 1048576.0,
+                    meshStats.cpuBytes / 1048576.0, meshStats.savedCPUBytes / 1048576.0);
         if (ImGui::RadioButton("Translate", mGuizmoOperation == ImGuizmo::TRANSLATE) || ImGui::IsKeyDown(ImGuiKey_W))
             mGuizmoOperation = ImGuizmo::TRANSLATE;
         ImGui::SameLine();
@@ -767,6 +927,7 @@ void EditorRenderSystem::SceneViewWindow()
                 reinterpret_cast<ImTextureID>(static_cast<VkDescriptorSet>(mSceneDescriptorSets[mFrameIndex]));
             ImGui::Image(textureId, ImVec2(mSceneViewPortWidth, mSceneViewPortHeight), ImVec2(0, 1), ImVec2(1, 0));
         }
+        bool isSceneHovered = ImGui::IsItemHovered();
         // 3. imGuizmo
         ImVec2 imagePos = ImGui::GetItemRectMin();
         ImVec2 imageSize = ImGui::GetItemRectSize();
@@ -781,6 +942,12 @@ void EditorRenderSystem::SceneViewWindow()
                                  glm::value_ptr(modelMatrix));
             if (ImGuizmo::IsUsing())
             {
+                // Gizmo 操作的是世界矩阵，转换回父节点空间
+                if (transform.parent != entt::null)
+                {
+                    modelMatrix =
+                        glm::inverse(mRegistry->get<TransformComponent>(transform.parent).modelMatrix) * modelMatrix;
+                }
                 // 分解矩阵
                 glm::vec3 translation, scale, skew;
                 glm::quat rotation;
@@ -790,12 +957,46 @@ void EditorRenderSystem::SceneViewWindow()
                     transform.position = translation;
                     transform.rotation = rotation;
                     transform.scale = scale;
+                    transform.isDirty = true;
                 }
             }
         }
+        // 4. 点击拾取，操作 Gizmo 时不改变选中
+        if (isSceneHovered && ImGui::IsMouseClicked(ImGuiMouseButton_Left) && !ImGuizmo::IsOver() &&
+            !ImGuizmo::IsUsing())
+        {
+            ImVec2 mousePos = ImGui::GetMousePos();
+            mSelectedEntity = PickEntity(glm::vec2(mousePos.x - imagePos.x, mousePos.y - imagePos.y),
+                                         glm::vec2(imageSize.x, imageSize.y), cameraComponent);
+        }
     }
     ImGui::End();
 }
+entt::entity EditorRenderSystem::PickEntity(const glm::vec2 &viewportPosition, const glm::vec2 &viewportSize,
+                                            const CameraComponent &camera) const
+{
+    const auto *bvh = mRegistry->ctx().find<BVH>();
+    if (!bvh || bvh->Empty() || viewportSize.x <= 0.0f || viewportSize.y <= 0.0f)
+    {
+        return entt::null;
+    }
+    // 场景图像上下翻转显示，视口顶部对应 NDC y = 1
+    float ndcX = viewportPosition.x / viewportSize.x * 2.0f - 1.0f;
+    float ndcY = 1.0f - viewportPosition.y / viewportSize.y * 2.0f;
+    glm::mat4 inverseViewProjection = glm::inverse(camera.projectionMatrix * camera.viewMatrix);
+    glm::vec4 nearPoint = inverseViewProjection * glm::vec4(ndcX, ndcY, 0.0f, 1.0f);
+    glm::vec4 farPoint = inverseViewProjection * glm::vec4(ndcX, ndcY, 1.0f, 1.0f);
+    Ray ray;
+    ray.origin = glm::vec3(nearPoint) / nearPoint.w;
+    ray.direction = glm::vec3(farPoint) / farPoint.w - ray.origin;
+    auto hit = bvh->Raycast(ray, 1.0f);
+    if (!hit)
+    {
+        return entt::null;
+    }
+    auto entity = static_cast<entt::entity>(hit->id);
+    return mRegistry->valid(entity) ? entity : entt::null;
+}
 void EditorRenderSystem::AssetWindow()
 {
     ImGui::Begin("Assets", nullptr, ImGuiWindowFlags_MenuBar);
@@ -950,4 +1151,12 @@ EditorRenderSystem::~EditorRenderSystem()
         Shutdown();
     }
 }
+TaskAccess EditorRenderSystem::GetAccess() const
+{
+    // 编辑器通过 Gizmo 和 Inspector 修改选中实体，SelectLOD 写回 MeshComponent::lod
+    return TaskAccess()
+        .Read<LightComponent, BVH>()
+        .Write<TransformComponent, CameraComponent, MaterialComponent, MeshComponent>()
+        .MainThread();
+}
 } // namespace MEngine
\ No newline at end of file
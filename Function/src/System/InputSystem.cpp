@@ -1,4 +1,5 @@
 #include "System/InputSystem.hpp"
+#include "Component/CameraComponent.hpp"
 
 namespace MEngine
 {
@@ -45,4 +46,8 @@ void InputSystem::HandleSDLEvent(const SDL_Event *event)
     //                static_cast<int>(event->type), 0, static_cast<int>(event->key.key),
     //                static_cast<int>(event->button.button), event->motion.x, event->motion.y);
 }
+TaskAccess InputSystem::GetAccess() const
+{
+    return TaskAccess().Read<InputComponent>().Write<CameraComponent>().MainThread();
+}
 } // namespace MEngine
\ No newline at end of file
@@ -1,11 +1,34 @@
 #include "System/RenderSystem.hpp"
 #include "Component/TransformComponent.hpp"
 #include "glm/ext/vector_float3_precision.hpp"
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
 #include <cstring>
+#include <limits>
+#include <map>
+#include <optional>
+#include <tuple>
+#include <unordered_map>
 
 namespace MEngine
 {
+namespace
+{
+// 排序键的管线字节：低 4 位为 RenderType，高位为顶点格式，不同格式使用不同的管线
+uint8_t MakePipelineKey(RenderType renderType, VertexFormat format)
+{
+    return static_cast<uint8_t>(static_cast<uint8_t>(renderType) | (static_cast<uint8_t>(format) << 4));
+}
+RenderType GetPipelineKeyRenderType(uint8_t pipelineKey)
+{
+    return static_cast<RenderType>(pipelineKey & 0x0F);
+}
+VertexFormat GetPipelineKeyVertexFormat(uint8_t pipelineKey)
+{
+    return static_cast<VertexFormat>(pipelineKey >> 4);
+}
+} // namespace
 
 RenderSystem::RenderSystem(std::shared_ptr<ILogger> logger, std::shared_ptr<Context> context,
                            std::shared_ptr<IConfigure> configure, std::shared_ptr<entt::registry> registry,
@@ -15,11 +38,13 @@ RenderSystem::RenderSystem(std::shared_ptr<ILogger> logger, std::shared_ptr<Cont
                            std::shared_ptr<CommandBufferManager> commandBufferManager,
                            std::shared_ptr<SyncPrimitiveManager> syncPrimitiveManager,
                            std::shared_ptr<DescriptorManager> descriptorManager,
-                           std::shared_ptr<BufferFactory> bufferFactory, std::shared_ptr<ImageFactory> imageFactory)
+                           std::shared_ptr<BufferFactory> bufferFactory, std::shared_ptr<ImageFactory> imageFactory,
+                           std::shared_ptr<GeometryArena> geometryArena)
     : System(logger, context, configure, registry), mRenderPassManager(renderPassManager),
       mPipelineLayoutManager(pipelineLayoutManager), mPipelineManager(pipelineManager),
       mCommandBufferManager(commandBufferManager), mSyncPrimitiveManager(syncPrimitiveManager),
-      mDescriptorManager(descriptorManager), mBufferFactory(bufferFactory), mImageFactory(imageFactory)
+      mDescriptorManager(descriptorManager), mBufferFactory(bufferFactory), mImageFactory(imageFactory),
+      mGeometryArena(geometryArena)
 {
 }
 void RenderSystem::Init()
@@ -29,6 +54,8 @@ void RenderSystem::Init()
     // command buffer
     mGraphicCommandBuffers =
         mCommandBufferManager->CreatePrimaryCommandBuffers(CommandBufferType::Graphic, mFrameCount);
+    mOwnershipCommandBuffers =
+        mCommandBufferManager->CreatePrimaryCommandBuffers(CommandBufferType::Graphic, mFrameCount);
     // mSecondaryCommandBuffers = std::vector<std::vector<vk::UniqueCommandBuffer>>(mFrameCount);
     // fence/semaphore
     for (size_t i = 0; i < mFrameCount; ++i)
@@ -40,6 +67,7 @@ void RenderSystem::Init()
         mRenderFinishedSemaphores.push_back(std::move(renderFinishedSemaphores));
         mInFlightFences.push_back(std::move(inFlightFence));
     }
+    mDeferredReleases.resize(mFrameCount);
     // Uniform Buffer
     mCameraUBO = mBufferFactory->CreateBuffer(BufferType::Uniform, sizeof(CameraUniform));
     auto globalDescriptorSetLayout = mPipelineLayoutManager->GetGlobalDescriptorSetLayout();
@@ -53,6 +81,40 @@ void RenderSystem::Init()
     {
         mLightSBOs[i] = mBufferFactory->CreateBuffer(BufferType::Uniform, sizeof(LightUniform));
     }
+    // Instance Buffer
+    for (uint32_t i = 0; i < mFrameCount; ++i)
+    {
+        mInstanceBuffers.push_back(
+            mBufferFactory->CreateBuffer(BufferType::Instance, sizeof(InstanceData) * mInitialInstanceCapacity));
+    }
+    // GPU Driven
+    mUseGPUDriven = mConfigure->GetJson()["RenderSetting"].value("GPUDriven", false);
+    if (mUseGPUDriven && !mContext->GetEnabledFeatures().drawIndirectFirstInstance)
+    {
+        mLogger->Warn("drawIndirectFirstInstance is not supported, GPU driven rendering disabled");
+        mUseGPUDriven = false;
+    }
+    if (mUseGPUDriven)
+    {
+        // 不支持 multiDrawIndirect 时每次间接绘制只能执行一条命令，每组只含一个批次
+        if (mContext->GetEnabledFeatures().multiDrawIndirect)
+        {
+            mMaxGroupBatches = mContext->GetPhysicalDevice().getProperties().limits.maxDrawIndirectCount;
+        }
+        auto gpuCullingDescriptorSetLayout = mPipelineLayoutManager->GetGPUCullingDescriptorSetLayout();
+        mGPUDrivenFrames.resize(mFrameCount);
+        for (auto &frame : mGPUDrivenFrames)
+        {
+            auto sets = mDescriptorManager->AllocateUniqueDescriptorSet({gpuCullingDescriptorSetLayout});
+            frame.descriptorSet = std::move(sets[0]);
+            PrepareGPUDrivenFrame(frame, mInitialInstanceCapacity, mInitialGPUBatchCapacity);
+        }
+    }
+    // LOD
+    auto lodSetting = mConfigure->GetJson()["LODSetting"];
+    mUseLOD = lodSetting.value("Enabled", true);
+    mLODPixelError = lodSetting.value("PixelError", 1.0f);
+    mLODHysteresis = std::clamp(lodSetting.value("Hysteresis", 0.25f), 0.0f, 0.9f);
     InitialRenderTargetImageLayout();
     InitialSwapchainImageLayout();
     mIsInit = true;
@@ -66,7 +128,7 @@ RenderSystem::~RenderSystem()
 }
 void RenderSystem::Shutdown()
 {
-    mContext->GetDevice().waitIdle();
+    FlushDeferredReleases();
     mIsShutdown = true;
     mLogger->Info("RenderSystem Shutdown");
 }
@@ -214,11 +276,648 @@ void RenderSystem::CollectEntities()
     }
     mDescriptorManager->UpdateUniformDescriptorSet(lightSBOsReferences, 1, mGlobalDescriptorSets[mFrameIndex].get());
 }
+void RenderSystem::CullEntities()
+{
+    mCullingStats = CullingStats{};
+    mCullingStats.gpuObjects = mGPUDrivenObjectCount;
+    if (!mRegistry->valid(mMainCameraEntity) || !mRegistry->all_of<CameraComponent>(mMainCameraEntity))
+    {
+        for (auto &[renderType, entities] : mRenderEntities)
+        {
+            mCullingStats.total += static_cast<uint32_t>(entities.size());
+        }
+        mCullingStats.drawn = mCullingStats.total;
+        return;
+    }
+    auto &camera = mRegistry->get<CameraComponent>(mMainCameraEntity);
+    Frustum frustum(camera.projectionMatrix * camera.viewMatrix);
+    // 有场景 BVH 时按层次查询可见实体，否则逐实体测试
+    const auto *bvh = mRegistry->ctx().find<BVH>();
+    bool useBVH = bvh && !bvh->Empty();
+    if (useBVH)
+    {
+        mVisibleIds.clear();
+        bvh->QueryFrustum(frustum, mVisibleIds);
+        std::fill(mVisibleMask.begin(), mVisibleMask.end(), 0);
+        for (uint32_t id : mVisibleIds)
+        {
+            auto index = entt::to_entity(static_cast<entt::entity>(id));
+            if (index >= mVisibleMask.size())
+            {
+                mVisibleMask.resize(index + 1, 0);
+            }
+            mVisibleMask[index] = 1;
+        }
+    }
+    auto &transforms = mRegistry->storage<TransformComponent>();
+    std::vector<entt::entity> untracked;
+    for (auto &[renderType, entities] : mRenderEntities)
+    {
+        uint32_t total = static_cast<uint32_t>(entities.size());
+        if (useBVH)
+        {
+            // BVH 只包含带 TransformComponent 的实体，其余实体与没有 BVH 时一样按单位变换逐个测试
+            untracked.clear();
+            std::erase_if(entities, [this, &transforms, &untracked](entt::entity entity) {
+                if (!transforms.contains(entity))
+                {
+                    untracked.push_back(entity);
+                    return true;
+                }
+                auto index = entt::to_entity(entity);
+                return index >= mVisibleMask.size() || !mVisibleMask[index];
+            });
+            CullEntities(frustum, untracked);
+            entities.insert(entities.end(), untracked.begin(), untracked.end());
+        }
+        else
+        {
+            CullEntities(frustum, entities);
+        }
+        mCullingStats.total += total;
+        mCullingStats.drawn += static_cast<uint32_t>(entities.size());
+    }
+    mCullingStats.culled = mCullingStats.total - mCullingStats.drawn;
+}
+void RenderSystem::CullEntities(const Frustum &frustum, std::vector<entt::entity> &entities)
+{
+    if (entities.empty())
+    {
+        return;
+    }
+    // 预先取出 storage，工作线程中只做只读访问
+    auto &transforms = mRegistry->storage<TransformComponent>();
+    auto &meshes = mRegistry->storage<MeshComponent>();
+    BoundsSoA bounds;
+    bounds.Resize(entities.size());
+    std::vector<uint8_t> visible(entities.size(), 1);
+    auto cullRange = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+        {
+            auto entity = entities[i];
+            const auto &mesh = meshes.get(entity).mesh;
+            glm::mat4 model = transforms.contains(entity) ? transforms.get(entity).modelMatrix : glm::mat4(1.0f);
+            bounds.Set(i, mesh->GetBoundingBox().Transform(model), mesh->GetBoundingSphere().Transform(model));
+        }
+        frustum.Cull(bounds, begin, end, visible.data());
+    };
+    if (entities.size() <= mCullChunkSize)
+    {
+        cullRange(0, entities.size());
+    }
+    else
+    {
+        std::vector<std::shared_ptr<Task>> tasks;
+        tasks.reserve((entities.size() + mCullChunkSize - 1) / mCullChunkSize);
+        for (size_t begin = 0; begin < entities.size(); begin += mCullChunkSize)
+        {
+            size_t end = std::min<size_t>(begin + mCullChunkSize, entities.size());
+            tasks.push_back(Task::Run([&cullRange, begin, end]() { cullRange(begin, end); }));
+        }
+        Task::WhenAll(tasks);
+    }
+    // 保持原有顺序压缩可见实体
+    size_t drawCount = 0;
+    for (size_t i = 0; i < entities.size(); i++)
+    {
+        if (visible[i])
+        {
+            entities[drawCount++] = entities[i];
+        }
+    }
+    entities.resize(drawCount);
+}
+const CullingStats &RenderSystem::GetCullingStats() const noexcept
+{
+    return mCullingStats;
+}
+void RenderSystem::PrepareLODSelection()
+{
+    mLODStats = LODStats{};
+    mHasLODCamera = false;
+    if (!mUseLOD || !mRegistry->valid(mMainCameraEntity) || !mRegistry->all_of<CameraComponent>(mMainCameraEntity))
+    {
+        return;
+    }
+    const auto &camera = mRegistry->get<CameraComponent>(mMainCameraEntity);
+    auto renderTargets = mRenderPassManager->GetRenderTargets();
+    float height = static_cast<float>(renderTargets[mFrameIndex].colorImage->GetExtent().height);
+    // projection[1][1] = 1 / tan(fovY / 2)，Vulkan 翻转 Y 时为负
+    mLODProjectionScale = std::abs(camera.projectionMatrix[1][1]) * 0.5f * height;
+    mLODCameraPosition = glm::vec3(glm::inverse(camera.viewMatrix)[3]);
+    mLODNearPlane = std::max(camera.nearPlane, 1e-3f);
+    mHasLODCamera = true;
+}
+uint32_t RenderSystem::SelectLOD(MeshComponent &meshComponent, const glm::mat4 &model)
+{
+    const auto &mesh = meshComponent.mesh;
+    uint32_t lodCount = mesh->GetLODCount();
+    uint32_t lod = 0;
+    if (mHasLODCamera && lodCount > 1)
+    {
+        // 模型空间误差按最大轴缩放换算到世界空间，距离取包围球上离相机最近的点
+        float scale = std::sqrt(std::max({glm::dot(glm::vec3(model[0]), glm::vec3(model[0])),
+                                          glm::dot(glm::vec3(model[1]), glm::vec3(model[1])),
+                                          glm::dot(glm::vec3(model[2]), glm::vec3(model[2]))}));
+        const auto &sphere = mesh->GetBoundingSphere();
+        glm::vec3 center(model * glm::vec4(sphere.center, 1.0f));
+        float distance = std::max(glm::length(center - mLODCameraPosition) - sphere.radius * scale, mLODNearPlane);
+        float pixelsPerUnit = scale * mLODProjectionScale / distance;
+        float upper = mLODPixelError * (1.0f + mLODHysteresis);
+        float lower = mLODPixelError * (1.0f - mLODHysteresis);
+        lod = std::min(meshComponent.lod, lodCount - 1);
+        while (lod > 0 && mesh->GetLOD(lod).error * pixelsPerUnit > upper)
+        {
+            lod--;
+        }
+        while (lod + 1 < lodCount && mesh->GetLOD(lod + 1).error * pixelsPerUnit < lower)
+        {
+            lod++;
+        }
+    }
+    meshComponent.lod = lod;
+    mLODStats.objects++;
+    mLODStats.reducedObjects += lod > 0 ? 1 : 0;
+    mLODStats.triangles += mesh->GetLOD(lod).indexCount / 3;
+    mLODStats.fullTriangles += mesh->GetIndexCount() / 3;
+    return lod;
+}
+const LODStats &RenderSystem::GetLODStats() const noexcept
+{
+    return mLODStats;
+}
+void RenderSystem::BuildDrawLists()
+{
+    mOpaqueDrawList.Clear();
+    mTransparentDrawList.Clear();
+    mDrawEntities.clear();
+    glm::mat4 view(1.0f);
+    float farPlane = 1.0f;
+    if (mRegistry->valid(mMainCameraEntity) && mRegistry->all_of<CameraComponent>(mMainCameraEntity))
+    {
+        const auto &camera = mRegistry->get<CameraComponent>(mMainCameraEntity);
+        view = camera.viewMatrix;
+        farPlane = camera.farPlane;
+    }
+    // 材质和网格 LOD 在本帧内按首次出现顺序编号，编号只用于排序分组，同一网格的不同 LOD 不合批
+    std::unordered_map<const void *, uint16_t> materialIds;
+    std::unordered_map<const void *, uint16_t> meshIds;
+    // 编号用尽后新的状态共用最后一个编号，逐个绘制仍然正确，只是不能再按键合批
+    bool isSortIdOverflow = false;
+    auto getId = [&isSortIdOverflow](std::unordered_map<const void *, uint16_t> &ids, const void *pointer) {
+        auto it = ids.find(pointer);
+        if (it != ids.end())
+        {
+            return it->second;
+        }
+        if (ids.size() > std::numeric_limits<uint16_t>::max())
+        {
+            isSortIdOverflow = true;
+            return std::numeric_limits<uint16_t>::max();
+        }
+        return ids.emplace(pointer, static_cast<uint16_t>(ids.size())).first->second;
+    };
+    auto &transforms = mRegistry->storage<TransformComponent>();
+    auto &materials = mRegistry->storage<MaterialComponent>();
+    auto &meshes = mRegistry->storage<MeshComponent>();
+    for (auto &[renderType, entities] : mRenderEntities)
+    {
+        bool isTransparent =
+            renderType == RenderType::ForwardTransparentPBR || renderType == RenderType::ForwardTransparentPhong;
+        auto &drawList = isTransparent ? mTransparentDrawList : mOpaqueDrawList;
+        for (auto entity : entities)
+        {
+            auto &meshComponent = meshes.get(entity);
+            const auto &mesh = meshComponent.mesh;
+            glm::mat4 model = transforms.contains(entity) ? transforms.get(entity).modelMatrix : glm::mat4(1.0f);
+            uint32_t lod = SelectLOD(meshComponent, model);
+            glm::vec3 center(model * glm::vec4(mesh->GetBoundingSphere().center, 1.0f));
+            float depth = -(view * glm::vec4(center, 1.0f)).z / farPlane;
+            uint8_t pipeline = MakePipelineKey(renderType, mesh->GetVertexFormat());
+            uint16_t material = getId(materialIds, materials.get(entity).material.get());
+            uint16_t meshId = getId(meshIds, &mesh->GetLOD(lod));
+            uint64_t key = isTransparent ? SortKey::MakeTransparent(pipeline, material, meshId, depth)
+                                         : SortKey::MakeOpaque(pipeline, material, meshId, depth);
+            drawList.Add(key, static_cast<uint32_t>(mDrawEntities.size()));
+            mDrawEntities.push_back(entity);
+        }
+    }
+    mOpaqueDrawList.Sort();
+    mTransparentDrawList.Sort();
+    if (isSortIdOverflow && !mIsSortIdOverflow)
+    {
+        mLogger->Warn("More than 65536 materials or mesh LODs in view, opaque instancing disabled");
+    }
+    mIsSortIdOverflow = isSortIdOverflow;
+}
+void RenderSystem::PrepareInstanceBuffer(uint32_t instanceCount)
+{
+    // Prepare 已等待本帧的 fence，本帧的实例缓冲区不再被 GPU 使用，可以直接替换
+    auto &instanceBuffer = mInstanceBuffers[mFrameIndex];
+    vk::DeviceSize requiredSize = sizeof(InstanceData) * static_cast<vk::DeviceSize>(instanceCount);
+    if (instanceBuffer->GetSize() < requiredSize)
+    {
+        vk::DeviceSize newSize = std::max(requiredSize, instanceBuffer->GetSize() * 2);
+        instanceBuffer = mBufferFactory->CreateBuffer(BufferType::Instance, newSize);
+    }
+}
+void RenderSystem::RecordDrawList(const DrawList &drawList, bool useInstancing)
+{
+    auto &commandBuffer = mGraphicCommandBuffers[mFrameIndex];
+    auto &transforms = mRegistry->storage<TransformComponent>();
+    auto &materials = mRegistry->storage<MaterialComponent>();
+    auto &meshes = mRegistry->storage<MeshComponent>();
+    const auto &packets = drawList.GetPackets();
+    if (useInstancing)
+    {
+        PrepareInstanceBuffer(static_cast<uint32_t>(packets.size()));
+    }
+    auto *instances = useInstancing
+                          ? static_cast<InstanceData *>(mInstanceBuffers[mFrameIndex]->GetAllocationInfo().pMappedData)
+                          : nullptr;
+    uint32_t instanceOffset = 0;
+    auto getModelMatrix = [&transforms](entt::entity entity) {
+        return transforms.contains(entity) ? transforms.get(entity).modelMatrix : glm::mat4(1.0f);
+    };
+    std::optional<uint8_t> currentPipelineKey;
+    bool isPipelineSupported = false;
+    bool isInstanced = false;
+    vk::PipelineLayout pipelineLayout;
+    vk::PipelineLayout boundGlobalLayout;
+    vk::DescriptorSet boundMaterialSet;
+    vk::Buffer boundVertexBuffer;
+    vk::Buffer boundIndexBuffer;
+    vk::Buffer boundInstanceBuffer;
+    for (size_t i = 0; i < packets.size();)
+    {
+        const auto &packet = packets[i];
+        uint8_t pipelineKey = SortKey::GetPipeline(packet.key);
+        if (pipelineKey != currentPipelineKey)
+        {
+            currentPipelineKey = pipelineKey;
+            // 目前只有 PBR 管线
+            auto renderType = GetPipelineKeyRenderType(pipelineKey);
+            isPipelineSupported =
+                renderType == RenderType::ForwardOpaquePBR || renderType == RenderType::ForwardTransparentPBR;
+            if (!isPipelineSupported)
+            {
+                i++;
+                continue;
+            }
+            // 透明物体需要严格按深度排序，不合批
+            isInstanced = useInstancing && renderType == RenderType::ForwardOpaquePBR;
+            PipelineType pipelineType = renderType == RenderType::ForwardTransparentPBR
+                                            ? PipelineType::ForwardTransparentPBR
+                                            : (isInstanced ? PipelineType::ForwardOpaquePBRInstanced
+                                                           : PipelineType::ForwardOpaquePBR);
+            pipelineLayout = mPipelineLayoutManager->GetPipelineLayout(PipelineLayoutType::PBR);
+            commandBuffer->bindPipeline(vk::PipelineBindPoint::eGraphics,
+                                        mPipelineManager->GetPipeline(pipelineType,
+                                                                      GetPipelineKeyVertexFormat(pipelineKey)));
+            mBindStats.pipelineBinds++;
+            // 布局兼容时 Global 描述符集在切换管线后仍然有效
+            if (pipelineLayout != boundGlobalLayout)
+            {
+                commandBuffer->bindDescriptorSets(vk::PipelineBindPoint::eGraphics, pipelineLayout, 0,
+                                                  mGlobalDescriptorSets[mFrameIndex].get(), {});
+                mBindStats.descriptorSetBinds++;
+                boundGlobalLayout = pipelineLayout;
+                boundMaterialSet = nullptr;
+            }
+            // 实例缓冲区只绑定一次，各批次通过 firstInstance 定位
+            if (isInstanced && boundInstanceBuffer != mInstanceBuffers[mFrameIndex]->GetHandle())
+            {
+                boundInstanceBuffer = mInstanceBuffers[mFrameIndex]->GetHandle();
+                commandBuffer->bindVertexBuffers(1, boundInstanceBuffer, {0});
+                mBindStats.vertexBufferBinds++;
+            }
+        }
+        if (!isPipelineSupported)
+        {
+            i++;
+            continue;
+        }
+        // 确定批次范围：排序后相同 (管线, 材质, 网格) 的绘制包相邻
+        size_t batchEnd = i + 1;
+        if (isInstanced)
+        {
+            uint64_t state = SortKey::GetOpaqueState(packet.key);
+            while (batchEnd < packets.size() && SortKey::GetOpaqueState(packets[batchEnd].key) == state)
+            {
+                batchEnd++;
+            }
+        }
+        auto entity = mDrawEntities[packet.index];
+        const auto &material = materials.get(entity);
+        const auto &mesh = meshes.get(entity);
+        // 1. 模型矩阵：实例化时写入实例缓冲区，否则通过 push constant；量化网格并入反量化变换
+        glm::mat4 dequantize = mesh.mesh->GetDequantizeMatrix();
+        if (isInstanced)
+        {
+            for (size_t j = i; j < batchEnd; j++)
+            {
+                instances[instanceOffset + (j - i)].modelMatrix =
+                    getModelMatrix(mDrawEntities[packets[j].index]) * dequantize;
+            }
+        }
+        else
+        {
+            glm::mat4 modelMatrix = getModelMatrix(entity) * dequantize;
+            commandBuffer->pushConstants(pipelineLayout, vk::ShaderStageFlagBits::eVertex, 0, sizeof(glm::mat4x4),
+                                         &modelMatrix);
+        }
+        // 2. 绑定材质描述符集
+        auto materialDescriptorSet = material.material->GetDescriptorSet();
+        if (materialDescriptorSet != boundMaterialSet)
+        {
+            commandBuffer->bindDescriptorSets(vk::PipelineBindPoint::eGraphics, pipelineLayout, 1,
+                                              materialDescriptorSet, {});
+            mBindStats.descriptorSetBinds++;
+            boundMaterialSet = materialDescriptorSet;
+        }
+        // 3. 绑定顶点缓冲区：同一页的网格共享缓冲区，只在换页时重新绑定
+        auto vertexBuffer = mesh.mesh->GetVertexBuffer();
+        if (vertexBuffer != boundVertexBuffer)
+        {
+            commandBuffer->bindVertexBuffers(0, vertexBuffer, {0});
+            mBindStats.vertexBufferBinds++;
+            boundVertexBuffer = vertexBuffer;
+        }
+        // 4. 绑定索引缓冲区
+        auto indexBuffer = mesh.mesh->GetIndexBuffer();
+        if (indexBuffer != boundIndexBuffer)
+        {
+            commandBuffer->bindIndexBuffer(indexBuffer, 0, vk::IndexType::eUint32);
+            mBindStats.indexBufferBinds++;
+            boundIndexBuffer = indexBuffer;
+        }
+        // 5. 绘制：批次内的实体使用同一级 LOD
+        uint32_t instanceCount = static_cast<uint32_t>(batchEnd - i);
+        const auto &lod = mesh.mesh->GetLOD(mesh.lod);
+        commandBuffer->drawIndexed(lod.indexCount, instanceCount, lod.firstIndex, mesh.mesh->GetVertexOffset(),
+                                   isInstanced ? instanceOffset : 0);
+        mBindStats.drawCalls++;
+        mBindStats.instances += instanceCount;
+        if (isInstanced)
+        {
+            instanceOffset += instanceCount;
+        }
+        i = batchEnd;
+    }
+}
+void RenderSystem::PrepareGPUDrivenFrame(GPUDrivenFrame &frame, uint32_t objectCount, uint32_t batchCount)
+{
+    // 与实例缓冲区相同：调用前已等待该帧的 fence，缓冲区可以直接替换
+    bool isResized = false;
+    uint32_t objectCapacity = frame.objectBuffer
+                                  ? static_cast<uint32_t>(frame.objectBuffer->GetSize() / sizeof(GPUObjectData))
+                                  : 0;
+    if (objectCapacity < objectCount || objectCapacity == 0)
+    {
+        objectCapacity = std::max({objectCount, objectCapacity * 2, 1u});
+        frame.objectBuffer = mBufferFactory->CreateBuffer(BufferType::Instance, sizeof(GPUObjectData) * objectCapacity);
+        frame.instanceBuffer =
+            mBufferFactory->CreateBuffer(BufferType::GPUInstance, sizeof(InstanceData) * objectCapacity);
+        isResized = true;
+    }
+    uint32_t batchCapacity =
+        frame.commandBuffer
+            ? static_cast<uint32_t>(frame.commandBuffer->GetSize() / sizeof(DrawIndexedIndirectCommand))
+            : 0;
+    if (batchCapacity < batchCount || batchCapacity == 0)
+    {
+        batchCapacity = std::max({batchCount, batchCapacity * 2, 1u});
+        frame.commandBuffer =
+            mBufferFactory->CreateBuffer(BufferType::Indirect, sizeof(DrawIndexedIndirectCommand) * batchCapacity);
+        frame.drawCountBuffer = mBufferFactory->CreateBuffer(BufferType::Indirect, sizeof(uint32_t) * batchCapacity);
+        isResized = true;
+    }
+    if (isResized)
+    {
+        const auto &bindings = mPipelineLayoutManager->GetGPUCullingDescriptorLayoutBindings();
+        auto set = frame.descriptorSet.get();
+        mDescriptorManager->UpdateStorageDescriptorSet({*frame.objectBuffer}, bindings.mObjectBinding.binding, set);
+        mDescriptorManager->UpdateStorageDescriptorSet({*frame.commandBuffer}, bindings.mDrawCommandBinding.binding,
+                                                       set);
+        mDescriptorManager->UpdateStorageDescriptorSet({*frame.drawCountBuffer}, bindings.mDrawCountBinding.binding,
+                                                       set);
+        mDescriptorManager->UpdateStorageDescriptorSet({*frame.instanceBuffer}, bindings.mInstanceBinding.binding,
+                                                       set);
+    }
+}
+void RenderSystem::BuildGPUDrawData()
+{
+    mGPUDrawGroups.clear();
+    mGPUDrivenObjectCount = 0;
+    auto it = mRenderEntities.find(RenderType::ForwardOpaquePBR);
+    if (it == mRenderEntities.end())
+    {
+        return;
+    }
+    auto entities = std::move(it->second);
+    mRenderEntities.erase(it);
+    auto &transforms = mRegistry->storage<TransformComponent>();
+    auto &materials = mRegistry->storage<MaterialComponent>();
+    auto &meshes = mRegistry->storage<MeshComponent>();
+    // 1. 按 (顶点格式, 材质, 几何页, 网格, LOD) 分批，map 有序，绑定状态相同的批次相邻，可以合并为一次间接绘制；
+    //    LOD 在 CPU 上按包围球选择，不依赖剔除结果
+    struct Batch
+    {
+        entt::entity entity;
+        uint32_t objectCount = 0;
+        uint32_t index = 0;
+        uint32_t group = 0;
+        uint32_t groupDrawCount = 0;
+    };
+    using BatchKey = std::tuple<VertexFormat, const void *, uint32_t, const void *, uint32_t>;
+    std::map<BatchKey, Batch> batches;
+    auto getBatchKey = [&](entt::entity entity) {
+        const auto &meshComponent = meshes.get(entity);
+        const auto &mesh = meshComponent.mesh;
+        return BatchKey{mesh->GetVertexFormat(), materials.get(entity).material.get(), mesh->GetAllocation().page,
+                        mesh.get(), meshComponent.lod};
+    };
+    auto isSameGroup = [](const BatchKey &a, const BatchKey &b) {
+        return std::get<0>(a) == std::get<0>(b) && std::get<1>(a) == std::get<1>(b) && std::get<2>(a) == std::get<2>(b);
+    };
+    for (auto entity : entities)
+    {
+        SelectLOD(meshes.get(entity),
+                  transforms.contains(entity) ? transforms.get(entity).modelMatrix : glm::mat4(1.0f));
+        batches.try_emplace(getBatchKey(entity), Batch{entity}).first->second.objectCount++;
+    }
+    auto &frame = mGPUDrivenFrames[mFrameIndex];
+    PrepareGPUDrivenFrame(frame, static_cast<uint32_t>(entities.size()), static_cast<uint32_t>(batches.size()));
+    // 2. 每个批次一条间接绘制命令，instanceCount 由计算着色器累加，firstInstance 为该批次在实例缓冲区中的区间起点；
+    //    相邻且绑定状态相同的批次组成一个绘制组，drawCount 由计算着色器写入
+    auto *commands = static_cast<DrawIndexedIndirectCommand *>(frame.commandBuffer->GetAllocationInfo().pMappedData);
+    auto *drawCounts = static_cast<uint32_t *>(frame.drawCountBuffer->GetAllocationInfo().pMappedData);
+    uint32_t firstInstance = 0;
+    uint32_t batchIndex = 0;
+    const BatchKey *previousKey = nullptr;
+    for (auto &[key, batch] : batches)
+    {
+        batch.index = batchIndex++;
+        const auto &meshComponent = meshes.get(batch.entity);
+        const auto &lod = meshComponent.mesh->GetLOD(meshComponent.lod);
+        commands[batch.index] = DrawIndexedIndirectCommand{lod.indexCount, 0, lod.firstIndex,
+                                                           meshComponent.mesh->GetVertexOffset(), firstInstance};
+        firstInstance += batch.objectCount;
+        if (!previousKey || !isSameGroup(*previousKey, key) || mGPUDrawGroups.back().batchCount == mMaxGroupBatches)
+        {
+            drawCounts[mGPUDrawGroups.size()] = 0;
+            mGPUDrawGroups.push_back(GPUDrawGroup{batch.entity, batch.index, 0});
+        }
+        batch.group = static_cast<uint32_t>(mGPUDrawGroups.size() - 1);
+        batch.groupDrawCount = ++mGPUDrawGroups.back().batchCount;
+        previousKey = &key;
+    }
+    // 3. 物体数据：顶点缓冲区坐标系下的包围体与模型矩阵，由着色器变换
+    //    量化网格的模型矩阵包含反量化变换（平移加均匀缩放），包围体相应地变换到 snorm 空间
+    auto *objects = static_cast<GPUObjectData *>(frame.objectBuffer->GetAllocationInfo().pMappedData);
+    for (size_t i = 0; i < entities.size(); i++)
+    {
+        auto entity = entities[i];
+        const auto &mesh = meshes.get(entity).mesh;
+        const auto &box = mesh->GetBoundingBox();
+        const auto &sphere = mesh->GetBoundingSphere();
+        glm::mat4 dequantize = mesh->GetDequantizeMatrix();
+        glm::vec3 offset(dequantize[3]);
+        float invScale = 1.0f / dequantize[0][0];
+        auto &object = objects[i];
+        object.modelMatrix =
+            (transforms.contains(entity) ? transforms.get(entity).modelMatrix : glm::mat4(1.0f)) * dequantize;
+        object.boundingSphere = glm::vec4((sphere.center - offset) * invScale, sphere.radius * invScale);
+        object.boxCenter = glm::vec4((box.GetCenter() - offset) * invScale, 0.0f);
+        object.boxExtents = glm::vec4(box.GetExtents() * invScale, 0.0f);
+        const auto &batch = batches.at(getBatchKey(entity));
+        object.batchIndex = batch.index;
+        object.groupIndex = batch.group;
+        object.groupDrawCount = batch.groupDrawCount;
+    }
+    mGPUDrivenObjectCount = static_cast<uint32_t>(entities.size());
+}
+void RenderSystem::DispatchGPUCulling()
+{
+    if (mGPUDrivenObjectCount == 0)
+    {
+        return;
+    }
+    auto &commandBuffer = mGraphicCommandBuffers[mFrameIndex];
+    auto &frame = mGPUDrivenFrames[mFrameIndex];
+    GPUCullingParams params{};
+    // 没有主相机时平面取 (0, 0, 0, 1)，所有物体可见
+    params.planes.fill(glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+    if (mRegistry->valid(mMainCameraEntity) && mRegistry->all_of<CameraComponent>(mMainCameraEntity))
+    {
+        const auto &camera = mRegistry->get<CameraComponent>(mMainCameraEntity);
+        params.planes = Frustum(camera.projectionMatrix * camera.viewMatrix).GetPlanes();
+    }
+    params.objectCount = mGPUDrivenObjectCount;
+    auto pipelineLayout = mPipelineLayoutManager->GetPipelineLayout(PipelineLayoutType::GPUCulling);
+    commandBuffer->bindPipeline(vk::PipelineBindPoint::eCompute, mPipelineManager->GetPipeline(PipelineType::GPUCulling));
+    commandBuffer->bindDescriptorSets(vk::PipelineBindPoint::eCompute, pipelineLayout, 0, frame.descriptorSet.get(),
+                                      {});
+    commandBuffer->pushConstants(pipelineLayout, vk::ShaderStageFlagBits::eCompute, 0, sizeof(GPUCullingParams),
+                                 &params);
+    commandBuffer->dispatch((mGPUDrivenObjectCount + mGPUCullingGroupSize - 1) / mGPUCullingGroupSize, 1, 1);
+    // 剔除结果随后作为间接绘制参数和实例顶点属性读取
+    vk::MemoryBarrier barrier;
+    barrier.setSrcAccessMask(vk::AccessFlagBits::eShaderWrite)
+        .setDstAccessMask(vk::AccessFlagBits::eIndirectCommandRead | vk::AccessFlagBits::eVertexAttributeRead);
+    commandBuffer->pipelineBarrier(vk::PipelineStageFlagBits::eComputeShader,
+                                   vk::PipelineStageFlagBits::eDrawIndirect | vk::PipelineStageFlagBits::eVertexInput,
+                                   {}, barrier, {}, {});
+}
+void RenderSystem::RecordIndirectDraws()
+{
+    if (mGPUDrawGroups.empty())
+    {
+        return;
+    }
+    auto &commandBuffer = mGraphicCommandBuffers[mFrameIndex];
+    auto &frame = mGPUDrivenFrames[mFrameIndex];
+    auto &materials = mRegistry->storage<MaterialComponent>();
+    auto &meshes = mRegistry->storage<MeshComponent>();
+    auto pipelineLayout = mPipelineLayoutManager->GetPipelineLayout(PipelineLayoutType::PBR);
+    commandBuffer->bindDescriptorSets(vk::PipelineBindPoint::eGraphics, pipelineLayout, 0,
+                                      mGlobalDescriptorSets[mFrameIndex].get(), {});
+    mBindStats.descriptorSetBinds++;
+    commandBuffer->bindVertexBuffers(1, frame.instanceBuffer->GetHandle(), {0});
+    mBindStats.vertexBufferBinds++;
+    bool useDrawCount = mContext->GetEnabledFeatures().drawIndirectCount;
+    // 绘制组已按顶点格式排序，管线只在格式变化时切换；布局相同，描述符集与实例缓冲区保持有效
+    std::optional<VertexFormat> boundFormat;
+    vk::DescriptorSet boundMaterialSet;
+    vk::Buffer boundVertexBuffer;
+    vk::Buffer boundIndexBuffer;
+    for (uint32_t groupIndex = 0; groupIndex < mGPUDrawGroups.size(); groupIndex++)
+    {
+        const auto &group = mGPUDrawGroups[groupIndex];
+        auto entity = group.entity;
+        auto materialDescriptorSet = materials.get(entity).material->GetDescriptorSet();
+        const auto &mesh = meshes.get(entity).mesh;
+        if (mesh->GetVertexFormat() != boundFormat)
+        {
+            boundFormat = mesh->GetVertexFormat();
+            commandBuffer->bindPipeline(vk::PipelineBindPoint::eGraphics,
+                                        mPipelineManager->GetPipeline(PipelineType::ForwardOpaquePBRInstanced,
+                                                                      *boundFormat));
+            mBindStats.pipelineBinds++;
+        }
+        if (materialDescriptorSet != boundMaterialSet)
+        {
+            commandBuffer->bindDescriptorSets(vk::PipelineBindPoint::eGraphics, pipelineLayout, 1,
+                                              materialDescriptorSet, {});
+            mBindStats.descriptorSetBinds++;
+            boundMaterialSet = materialDescriptorSet;
+        }
+        if (mesh->GetVertexBuffer() != boundVertexBuffer)
+        {
+            boundVertexBuffer = mesh->GetVertexBuffer();
+            commandBuffer->bindVertexBuffers(0, boundVertexBuffer, {0});
+            mBindStats.vertexBufferBinds++;
+        }
+        if (mesh->GetIndexBuffer() != boundIndexBuffer)
+        {
+            boundIndexBuffer = mesh->GetIndexBuffer();
+            commandBuffer->bindIndexBuffer(boundIndexBuffer, 0, vk::IndexType::eUint32);
+            mBindStats.indexBufferBinds++;
+        }
+        // 组内命令连续存放，drawCount 截到最后一个可见批次，整组被剔除时为 0，GPU 跳过该绘制；
+        // 不支持 drawIndirectCount 时执行整组命令，被剔除批次的 instanceCount 为 0
+        vk::DeviceSize commandOffset = sizeof(DrawIndexedIndirectCommand) * group.firstBatch;
+        if (useDrawCount)
+        {
+            commandBuffer->drawIndexedIndirectCount(frame.commandBuffer->GetHandle(), commandOffset,
+                                                    frame.drawCountBuffer->GetHandle(), sizeof(uint32_t) * groupIndex,
+                                                    group.batchCount, sizeof(DrawIndexedIndirectCommand));
+        }
+        else
+        {
+            commandBuffer->drawIndexedIndirect(frame.commandBuffer->GetHandle(), commandOffset, group.batchCount,
+                                               sizeof(DrawIndexedIndirectCommand));
+        }
+        mBindStats.drawCalls++;
+    }
+}
+const BindStats &RenderSystem::GetBindStats() const noexcept
+{
+    return mBindStats;
+}
 void RenderSystem::Tick(float deltaTime)
 {
     Prepare();
     // TickRotationMatrix();
     CollectEntities(); // Collect same material render entities
+    PrepareLODSelection();
+    if (mUseGPUDriven)
+    {
+        BuildGPUDrawData();
+        DispatchGPUCulling();
+    }
+    CullEntities();
+    BuildDrawLists();
     // RenderShadowDepthPass();  // Shadow pass
     // void RenderDeferred();
     RenderForward();
@@ -239,6 +938,12 @@ void RenderSystem::Prepare()
         throw std::runtime_error("Failed to wait fence");
     }
     mContext->GetDevice().resetFences({mInFlightFences[mFrameIndex].get()});
+    // 该帧上次提交时排队的资源：同一队列按提交顺序完成，之前的帧也已结束
+    for (auto &release : mDeferredReleases[mFrameIndex])
+    {
+        release();
+    }
+    mDeferredReleases[mFrameIndex].clear();
     mGraphicCommandBuffers[mFrameIndex]->reset();
     auto resultValue = mContext->GetDevice().acquireNextImageKHR(mContext->GetSwapchain(), 1000000000,
                                                                  mImageAvailableSemaphores[mFrameIndex].get(), nullptr);
@@ -255,6 +960,22 @@ void RenderSystem::Prepare()
     beginInfo.setFlags(vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
     mGraphicCommandBuffers[mFrameIndex]->begin(beginInfo);
 }
+void RenderSystem::DeferRelease(std::function<void()> &&release)
+{
+    mDeferredReleases[mFrameIndex].push_back(std::move(release));
+}
+void RenderSystem::FlushDeferredReleases()
+{
+    mContext->GetDevice().waitIdle();
+    for (auto &releases : mDeferredReleases)
+    {
+        for (auto &release : releases)
+        {
+            release();
+        }
+        releases.clear();
+    }
+}
 void RenderSystem::RenderShadowDepthPass()
 {
 }
@@ -263,6 +984,7 @@ void RenderSystem::RenderDeferred()
 }
 void RenderSystem::RenderForward()
 {
+    mBindStats = BindStats{};
     auto forwardFrameBuffers = mRenderPassManager->GetFrameBuffer(RenderPassType::ForwardComposition);
     auto renderTargetImages = mRenderPassManager->GetRenderTargets();
     auto extent = renderTargetImages[mFrameIndex].colorImage->GetExtent();
@@ -289,115 +1011,26 @@ void RenderSystem::RenderForward()
     vk::Rect2D scissor;
     scissor.setOffset({0, 0}).setExtent(vk::Extent2D(extent.width, extent.height));
     mGraphicCommandBuffers[mFrameIndex]->setScissor(0, scissor);
-    // subpass 0: 不透明物体
-    // PBR
+    // subpass 0: 不透明物体（按排序键：管线 -> 材质 -> 网格 -> 由近到远），相同材质和网格合并为实例化绘制
+    if (mUseGPUDriven)
     {
-        auto forwardOpaquePBRPipelineLayout = mPipelineLayoutManager->GetPipelineLayout(PipelineLayoutType::PBR);
-        auto forwardOpaquePBRPipeline = mPipelineManager->GetPipeline(PipelineType::ForwardOpaquePBR);
-        auto forwardOpaqueEntities = mRenderEntities[RenderType::ForwardOpaquePBR];
-        // 1. 绑定管线
-        mGraphicCommandBuffers[mFrameIndex]->bindPipeline(vk::PipelineBindPoint::eGraphics, forwardOpaquePBRPipeline);
-        // 2. 绑定Global描述符集
-        mGraphicCommandBuffers[mFrameIndex]->bindDescriptorSets(vk::PipelineBindPoint::eGraphics,
-                                                                forwardOpaquePBRPipelineLayout, 0,
-                                                                mGlobalDescriptorSets[mFrameIndex].get(), {});
-        for (auto entity : forwardOpaqueEntities)
-        {
-            auto &material = mRegistry->get<MaterialComponent>(entity);
-            auto &mesh = mRegistry->get<MeshComponent>(entity);
-            auto &transform = mRegistry->get<TransformComponent>(entity);
-            // 1. 绑定push constant
-            mGraphicCommandBuffers[mFrameIndex]->pushConstants(forwardOpaquePBRPipelineLayout,
-                                                               vk::ShaderStageFlagBits::eVertex, 0, sizeof(glm::mat4x4),
-                                                               &transform.modelMatrix);
-            // 3. 绑定材质描述符集
-            auto materialDescriptorSet = material.material->GetDescriptorSet();
-            mGraphicCommandBuffers[mFrameIndex]->bindDescriptorSets(
-                vk::PipelineBindPoint::eGraphics, forwardOpaquePBRPipelineLayout, 1, materialDescriptorSet, {});
-            // 4. 绑定顶点缓冲区
-            auto vertexBuffer = mesh.mesh->GetVertexBuffer();
-            mGraphicCommandBuffers[mFrameIndex]->bindVertexBuffers(0, vertexBuffer, {0});
-            // 5. 绑定索引缓冲区
-            auto indexBuffer = mesh.mesh->GetIndexBuffer();
-            mGraphicCommandBuffers[mFrameIndex]->bindIndexBuffer(indexBuffer, 0, vk::IndexType::eUint32);
-            // 6. 绘制
-            mGraphicCommandBuffers[mFrameIndex]->drawIndexed(mesh.mesh->GetIndexCount(), 1, 0, 0, 0);
-        }
+        RecordIndirectDraws();
     }
+    RecordDrawList(mOpaqueDrawList, !mIsSortIdOverflow);
     // Phong
     {
     }
     mGraphicCommandBuffers[mFrameIndex]->nextSubpass(vk::SubpassContents::eInline);
-    // subpass 1: 透明物体
+    // subpass 1: 透明物体，沿用不透明物体的深度缓冲区，按排序键由远到近逐个绘制
     // PBR
+    RecordDrawList(mTransparentDrawList);
     // Phong
 
     mGraphicCommandBuffers[mFrameIndex]->endRenderPass();
 }
 void RenderSystem::RenderTranslucencyPass()
 {
-    auto renderTargetImages = mRenderPassManager->GetRenderTargets();
-    auto extent = renderTargetImages[mFrameIndex].colorImage->GetExtent();
-    // PBR
-    auto forwardTransparentPBREntities = mRenderEntities[RenderType::ForwardTransparentPBR];
-    auto pipelineLayout = mPipelineLayoutManager->GetPipelineLayout(PipelineLayoutType::PBR);
-    auto pipeline = mPipelineManager->GetPipeline(PipelineType::ForwardTransparentPBR);
-    auto renderPass = mRenderPassManager->GetRenderPass(RenderPassType::Transparent);
-    auto transparentFrameBuffers = mRenderPassManager->GetFrameBuffer(RenderPassType::Transparent);
-    vk::RenderPassBeginInfo renderPassBeginInfo;
-    std::vector<vk::ClearValue> clearValues{
-        vk::ClearValue(std::array<float, 4>{0.1f, 0.1f, 0.1f, 1.0f}), // 附件0: Render Target
-        vk::ClearDepthStencilValue(1.0f, 0)                           // 附件1: Depth Stencil
-    };
-    renderPassBeginInfo.setRenderPass(renderPass)
-        .setFramebuffer(transparentFrameBuffers[mFrameIndex])
-        .setRenderArea(vk::Rect2D({0, 0}, vk::Extent2D(extent.width, extent.height)))
-        .setClearValues(clearValues);
-    mGraphicCommandBuffers[mFrameIndex]->beginRenderPass(renderPassBeginInfo, vk::SubpassContents::eInline);
-    {
-        // viewport
-        vk::Viewport viewport;
-        viewport.setX(0.0f)
-            .setY(0.0f)
-            .setWidth(static_cast<float>(extent.width))
-            .setHeight(static_cast<float>(extent.height))
-            .setMinDepth(0.0f)
-            .setMaxDepth(1.0f);
-        mGraphicCommandBuffers[mFrameIndex]->setViewport(0, viewport);
-        // scissor
-        vk::Rect2D scissor;
-        scissor.setOffset({0, 0}).setExtent(vk::Extent2D(extent.width, extent.height));
-        mGraphicCommandBuffers[mFrameIndex]->setScissor(0, scissor);
-        // 1. 绑定管线
-        mGraphicCommandBuffers[mFrameIndex]->bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline);
-
-        for (auto entity : forwardTransparentPBREntities)
-        {
-            auto &material = mRegistry->get<MaterialComponent>(entity);
-            auto &mesh = mRegistry->get<MeshComponent>(entity);
-            auto &transform = mRegistry->get<TransformComponent>(entity);
-            // 1. 绑定push constant
-            mGraphicCommandBuffers[mFrameIndex]->pushConstants(pipelineLayout, vk::ShaderStageFlagBits::eVertex, 0,
-                                                               sizeof(glm::mat4x4), &transform.modelMatrix);
-            // 2. 绑定Global描述符集
-            mGraphicCommandBuffers[mFrameIndex]->bindDescriptorSets(vk::PipelineBindPoint::eGraphics, pipelineLayout, 0,
-                                                                    mGlobalDescriptorSets[mFrameIndex].get(), {});
-            // 3. 绑定材质描述符集
-            auto materialDescriptorSet = material.material->GetDescriptorSet();
-            mGraphicCommandBuffers[mFrameIndex]->bindDescriptorSets(vk::PipelineBindPoint::eGraphics, pipelineLayout, 1,
-                                                                    materialDescriptorSet, {});
-            //  4. 绑定顶点缓冲区
-            auto vertexBuffer = mesh.mesh->GetVertexBuffer();
-            mGraphicCommandBuffers[mFrameIndex]->bindVertexBuffers(0, vertexBuffer, {0});
-            // 5. 绑定索引缓冲区
-            auto indexBuffer = mesh.mesh->GetIndexBuffer();
-            mGraphicCommandBuffers[mFrameIndex]->bindIndexBuffer(indexBuffer, 0, vk::IndexType::eUint32);
-            // 6. 绘制
-            mGraphicCommandBuffers[mFrameIndex]->drawIndexed(mesh.mesh->GetIndexCount(), 1, 0, 0, 0);
-        }
-    }
-    // Phong
-    mGraphicCommandBuffers[mFrameIndex]->endRenderPass();
+    // 透明物体在 RenderForward 的 subpass 1 中绘制，需要读取不透明物体的深度，不再使用单独的渲染通道
 }
 void RenderSystem::RenderPostProcessPass()
 {
@@ -413,12 +1046,36 @@ void RenderSystem::Present()
 
     mGraphicCommandBuffers[mFrameIndex]->end();
 
+    // 本帧可能用到刚创建的网格与纹理，先提交排队的上传，再等待上传时间线信号量
+    auto &uploadQueue = mBufferFactory->GetUploadQueue();
+    UploadTicket uploadTicket = uploadQueue->Flush();
+    // 传输队列属于独立族时，在本帧命令之前获取上传资源的所有权
+    auto &ownershipCommandBuffer = mOwnershipCommandBuffers[mFrameIndex];
+    ownershipCommandBuffer->reset();
+    ownershipCommandBuffer->begin(vk::CommandBufferBeginInfo{vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
+    bool hasAcquire = uploadQueue->RecordOwnershipAcquire(ownershipCommandBuffer.get(), uploadTicket);
+    ownershipCommandBuffer->end();
+    std::vector<vk::CommandBuffer> commandBuffers;
+    if (hasAcquire)
+    {
+        commandBuffers.push_back(ownershipCommandBuffer.get());
+    }
+    commandBuffers.push_back(mGraphicCommandBuffers[mFrameIndex].get());
+
+    std::array<vk::Semaphore, 2> waitSemaphores{mImageAvailableSemaphores[mFrameIndex].get(),
+                                                uploadQueue->GetTimelineSemaphore()};
+    std::array<vk::PipelineStageFlags, 2> waitStages{vk::PipelineStageFlagBits::eColorAttachmentOutput,
+                                                     vk::PipelineStageFlagBits::eAllCommands};
+    // 二值信号量的值会被忽略
+    std::array<uint64_t, 2> waitValues{0, uploadTicket};
+    vk::TimelineSemaphoreSubmitInfo timelineSubmitInfo;
+    timelineSubmitInfo.setWaitSemaphoreValues(waitValues);
     vk::SubmitInfo submitInfo;
-    vk::PipelineStageFlags waitStage = vk::PipelineStageFlagBits::eColorAttachmentOutput;
-    submitInfo.setCommandBuffers(mGraphicCommandBuffers[mFrameIndex].get())
+    submitInfo.setCommandBuffers(commandBuffers)
         .setSignalSemaphores(mRenderFinishedSemaphores[mFrameIndex].get())
-        .setWaitSemaphores(mImageAvailableSemaphores[mFrameIndex].get())
-        .setWaitDstStageMask({waitStage});
+        .setWaitSemaphores(waitSemaphores)
+        .setWaitDstStageMask(waitStages)
+        .setPNext(&timelineSubmitInfo);
     mContext->SubmitToGraphicQueue({submitInfo}, mInFlightFences[mFrameIndex].get());
 
     vk::PresentInfoKHR presentInfo;
@@ -435,6 +1092,7 @@ void RenderSystem::Present()
         HandleSwapchainOutOfDate();
     }
     mFrameIndex = (mFrameIndex + 1) % mFrameCount;
+    mGeometryArena->NextFrame(mFrameCount);
 }
 void RenderSystem::HandleSwapchainOutOfDate()
 {
@@ -509,4 +1167,12 @@ void RenderSystem::CopyColorAttachmentToSwapchainImage(Image &image)
                                                          vk::PipelineStageFlagBits::eColorAttachmentOutput, {}, {}, {},
                                                          lastFrameImagePostBarrier);
 }
+TaskAccess RenderSystem::GetAccess() const
+{
+    // SelectLOD 写回 MeshComponent::lod
+    return TaskAccess()
+        .Read<TransformComponent, CameraComponent, LightComponent, MaterialComponent, BVH>()
+        .Write<MeshComponent>()
+        .MainThread();
+}
 } // namespace MEngine
\ No newline at end of file
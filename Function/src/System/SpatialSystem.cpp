@@ -0,0 +1,99 @@
+#include "System/SpatialSystem.hpp"
+
+namespace MEngine
+{
+SpatialSystem::SpatialSystem(std::shared_ptr<ILogger> logger, std::shared_ptr<Context> context,
+                             std::shared_ptr<IConfigure> configure, std::shared_ptr<entt::registry> registry)
+    : System(logger, context, configure, registry)
+{
+}
+void SpatialSystem::Init()
+{
+    mRegistry->ctx().emplace<BVH>();
+    mRegistry->on_construct<MeshComponent>().connect<&SpatialSystem::OnSceneChanged>(this);
+    mRegistry->on_update<MeshComponent>().connect<&SpatialSystem::OnSceneChanged>(this);
+    mRegistry->on_destroy<MeshComponent>().connect<&SpatialSystem::OnSceneChanged>(this);
+    mRegistry->on_construct<TransformComponent>().connect<&SpatialSystem::OnSceneChanged>(this);
+    mRegistry->on_destroy<TransformComponent>().connect<&SpatialSystem::OnSceneChanged>(this);
+    mLogger->Info("Spatial System Init");
+}
+void SpatialSystem::Shutdown()
+{
+    mRegistry->on_construct<MeshComponent>().disconnect<&SpatialSystem::OnSceneChanged>(this);
+    mRegistry->on_update<MeshComponent>().disconnect<&SpatialSystem::OnSceneChanged>(this);
+    mRegistry->on_destroy<MeshComponent>().disconnect<&SpatialSystem::OnSceneChanged>(this);
+    mRegistry->on_construct<TransformComponent>().disconnect<&SpatialSystem::OnSceneChanged>(this);
+    mRegistry->on_destroy<TransformComponent>().disconnect<&SpatialSystem::OnSceneChanged>(this);
+    mRegistry->ctx().erase<BVH>();
+    mLogger->Info("Spatial System Shutdown");
+}
+void SpatialSystem::Tick(float deltaTime)
+{
+    auto &bvh = mRegistry->ctx().get<BVH>();
+    if (!mNeedsRebuild)
+    {
+        // 只更新本帧世界矩阵变化的实体
+        auto &transforms = mRegistry->storage<TransformComponent>();
+        auto &meshes = mRegistry->storage<MeshComponent>();
+        for (uint32_t primitive = 0; primitive < mPrimitiveEntities.size(); primitive++)
+        {
+            auto entity = mPrimitiveEntities[primitive];
+            const auto &transform = transforms.get(entity);
+            if (transform.isWorldChanged)
+            {
+                bvh.Update(primitive, GetWorldBounds(transform, meshes.get(entity)));
+            }
+        }
+        bvh.Refit();
+        mNeedsRebuild = bvh.GetDegradation() > mMaxDegradation;
+    }
+    if (mNeedsRebuild)
+    {
+        Rebuild(bvh);
+    }
+}
+void SpatialSystem::Rebuild(BVH &bvh)
+{
+    auto &transforms = mRegistry->storage<TransformComponent>();
+    auto &meshes = mRegistry->storage<MeshComponent>();
+    auto view = mRegistry->view<TransformComponent, MeshComponent>();
+    mPrimitiveEntities.assign(view.begin(), view.end());
+    std::vector<AABB> bounds(mPrimitiveEntities.size());
+    std::vector<uint32_t> ids(mPrimitiveEntities.size());
+    auto computeBounds = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+        {
+            auto entity = mPrimitiveEntities[i];
+            bounds[i] = GetWorldBounds(transforms.get(entity), meshes.get(entity));
+            ids[i] = entt::to_integral(entity);
+        }
+    };
+    std::vector<std::shared_ptr<Task>> tasks;
+    for (size_t begin = mChunkSize; begin < mPrimitiveEntities.size(); begin += mChunkSize)
+    {
+        size_t end = std::min<size_t>(begin + mChunkSize, mPrimitiveEntities.size());
+        tasks.push_back(Task::Run([&computeBounds, begin, end]() { computeBounds(begin, end); }));
+    }
+    computeBounds(0, std::min<size_t>(mChunkSize, mPrimitiveEntities.size()));
+    Task::WhenAll(tasks);
+    bvh.Build(bounds, ids);
+    mNeedsRebuild = false;
+}
+AABB SpatialSystem::GetWorldBounds(const TransformComponent &transform, const MeshComponent &mesh)
+{
+    if (!mesh.mesh)
+    {
+        glm::vec3 position(transform.modelMatrix[3]);
+        return AABB{position, position};
+    }
+    return mesh.mesh->GetBoundingBox().Transform(transform.modelMatrix);
+}
+void SpatialSystem::OnSceneChanged(entt::registry &registry, entt::entity entity)
+{
+    mNeedsRebuild = true;
+}
+TaskAccess SpatialSystem::GetAccess() const
+{
+    return TaskAccess().Read<TransformComponent, MeshComponent>().Write<BVH>();
+}
+} // namespace MEngine
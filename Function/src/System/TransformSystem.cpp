@@ -1,4 +1,6 @@
 #include "System/TransformSystem.hpp"
+#include <array>
+#include <limits>
 
 namespace MEngine
 {
@@ -9,27 +11,234 @@ TransformSystem::TransformSystem(std::shared_ptr<ILogger> logger, std::shared_pt
 }
 void TransformSystem::Init()
 {
+    mRegistry->on_construct<TransformComponent>().connect<&TransformSystem::OnHierarchyChanged>(this);
+    mRegistry->on_destroy<TransformComponent>().connect<&TransformSystem::OnTransformDestroyed>(this);
     mLogger->Info("Transform System Init");
 }
 void TransformSystem::Shutdown()
 {
+    mRegistry->on_construct<TransformComponent>().disconnect<&TransformSystem::OnHierarchyChanged>(this);
+    mRegistry->on_destroy<TransformComponent>().disconnect<&TransformSystem::OnTransformDestroyed>(this);
     mLogger->Info("Transform System Shutdown");
 }
 void TransformSystem::Tick(float deltaTime)
 {
     // 1. 更新旋转矩阵
     mRotationMatrix = glm::rotate(mRotationMatrix, glm::radians(60.f) * deltaTime, glm::vec3(0.0f, 1.0f, 0.0f));
-    auto views = mRegistry->view<TransformComponent>();
-    for (auto entity : views)
-    {
-        auto &transform = mRegistry->get<TransformComponent>(entity);
-        glm::mat4x4 modelMatrix = glm::mat4(1.0f);
-        modelMatrix = glm::translate(modelMatrix, transform.position);
-        modelMatrix = modelMatrix * glm::mat4_cast(transform.rotation);
-        modelMatrix = glm::scale(modelMatrix, transform.scale);
-
-        transform.modelMatrix = modelMatrix;
+    // 2. 层级变化时重新按深度排序
+    if (mHierarchyChanged)
+    {
+        RebuildHierarchy();
+    }
+    // 3. 逐层传播世界矩阵，同一层内分块并行
+    mUpdatedCount = 0;
+    for (size_t level = 0; level + 1 < mLevelOffsets.size(); level++)
+    {
+        size_t levelBegin = mLevelOffsets[level];
+        size_t levelEnd = mLevelOffsets[level + 1];
+        if (levelEnd - levelBegin <= mChunkSize)
+        {
+            UpdateLevel(levelBegin, levelEnd);
+            continue;
+        }
+        std::vector<std::shared_ptr<Task>> tasks;
+        tasks.reserve((levelEnd - levelBegin + mChunkSize - 1) / mChunkSize);
+        for (size_t begin = levelBegin; begin < levelEnd; begin += mChunkSize)
+        {
+            size_t end = std::min<size_t>(begin + mChunkSize, levelEnd);
+            tasks.push_back(Task::Run([this, begin, end]() { UpdateLevel(begin, end); }));
+        }
+        Task::WhenAll(tasks);
+    }
+}
+void TransformSystem::UpdateLevel(size_t begin, size_t end)
+{
+    auto &storage = mRegistry->storage<TransformComponent>();
+    // 需要更新的变换先收集成连续数组，再用 Math::ComposeTRSBatch 批量合成局部矩阵
+    std::array<TransformComponent *, mBatchSize> transforms;
+    std::array<const TransformComponent *, mBatchSize> parents;
+    std::array<glm::vec3, mBatchSize> positions;
+    std::array<glm::quat, mBatchSize> rotations;
+    std::array<glm::vec3, mBatchSize> scales;
+    std::array<glm::mat4, mBatchSize> localMatrices;
+    size_t pending = 0;
+    uint32_t updated = 0;
+    auto flush = [&]() {
+        Math::ComposeTRSBatch(positions.data(), rotations.data(), scales.data(), localMatrices.data(), pending);
+        for (size_t j = 0; j < pending; j++)
+        {
+            transforms[j]->modelMatrix =
+                parents[j] ? Math::Multiply(parents[j]->modelMatrix, localMatrices[j]) : localMatrices[j];
+            transforms[j]->isDirty = false;
+        }
+        updated += static_cast<uint32_t>(pending);
+        pending = 0;
+    };
+    for (size_t i = begin; i < end; i++)
+    {
+        auto &transform = storage.get(mSortedEntities[i]);
+        // 父节点位于更浅的层，已在之前的层中更新完毕
+        const TransformComponent *parent =
+            transform.parent == entt::null ? nullptr : &storage.get(transform.parent);
+        bool parentChanged = parent && parent->isWorldChanged;
+        transform.isWorldChanged = transform.isDirty || parentChanged;
+        if (!transform.isWorldChanged)
+        {
+            continue;
+        }
+        transforms[pending] = &transform;
+        parents[pending] = parent;
+        positions[pending] = transform.position;
+        rotations[pending] = transform.rotation;
+        scales[pending] = transform.scale;
+        if (++pending == mBatchSize)
+        {
+            flush();
+        }
+    }
+    flush();
+    mUpdatedCount += updated;
+}
+void TransformSystem::RebuildHierarchy()
+{
+    auto &storage = mRegistry->storage<TransformComponent>();
+    auto view = mRegistry->view<TransformComponent>();
+    constexpr uint32_t unknownDepth = std::numeric_limits<uint32_t>::max();
+    // 1. 失效的父节点视为根节点，并重置深度；父节点最后的世界矩阵并入局部变换，子节点不会跳变
+    for (auto entity : view)
+    {
+        auto &transform = storage.get(entity);
+        if (transform.parent != entt::null && !storage.contains(transform.parent))
+        {
+            auto destroyed = mDestroyedWorldMatrices.find(transform.parent);
+            if (destroyed != mDestroyedWorldMatrices.end())
+            {
+                glm::mat4 localMatrix = Math::ComposeTRS(transform.position, transform.rotation, transform.scale);
+                SetLocalMatrix(transform, Math::Multiply(destroyed->second, localMatrix));
+            }
+            transform.parent = entt::null;
+        }
+        transform.depth = unknownDepth;
+        transform.isDirty = true;
+    }
+    mDestroyedWorldMatrices.clear();
+    // 2. 沿父链计算深度
+    std::vector<entt::entity> chain;
+    for (auto entity : view)
+    {
+        chain.clear();
+        entt::entity current = entity;
+        while (current != entt::null && storage.get(current).depth == unknownDepth)
+        {
+            chain.push_back(current);
+            current = storage.get(current).parent;
+        }
+        uint32_t depth = current == entt::null ? 0 : storage.get(current).depth + 1;
+        for (auto it = chain.rbegin(); it != chain.rend(); ++it)
+        {
+            storage.get(*it).depth = depth++;
+        }
+    }
+    // 3. 存储按 (深度, 父节点) 排序，兄弟节点相邻
+    mRegistry->sort<TransformComponent>([](const TransformComponent &lhs, const TransformComponent &rhs) {
+        if (lhs.depth != rhs.depth)
+        {
+            return lhs.depth < rhs.depth;
+        }
+        return entt::to_integral(lhs.parent) < entt::to_integral(rhs.parent);
+    });
+    // 4. 记录排序后的顺序和每层的起始位置
+    mSortedEntities.clear();
+    mLevelOffsets.clear();
+    mSortedEntities.reserve(storage.size());
+    for (auto entity : view)
+    {
+        uint32_t depth = storage.get(entity).depth;
+        while (mLevelOffsets.size() <= depth)
+        {
+            mLevelOffsets.push_back(mSortedEntities.size());
+        }
+        mSortedEntities.push_back(entity);
+    }
+    mLevelOffsets.push_back(mSortedEntities.size());
+    mHierarchyChanged = false;
+}
+void TransformSystem::OnHierarchyChanged(entt::registry &registry, entt::entity entity)
+{
+    mHierarchyChanged = true;
+}
+void TransformSystem::OnTransformDestroyed(entt::registry &registry, entt::entity entity)
+{
+    // 回调时组件尚未移除；modelMatrix 为上次更新的世界矩阵，尚未更新过或局部变换已修改时沿父链重新合成
+    auto &transform = registry.get<TransformComponent>(entity);
+    mDestroyedWorldMatrices[entity] = transform.isDirty ? ComputeWorldMatrix(entity) : transform.modelMatrix;
+    mHierarchyChanged = true;
+}
+glm::mat4 TransformSystem::ComputeWorldMatrix(entt::entity entity) const
+{
+    auto &storage = mRegistry->storage<TransformComponent>();
+    glm::mat4 world(1.0f);
+    // 父节点可能已被销毁但层级尚未重建，此时按根节点处理
+    for (entt::entity current = entity; current != entt::null && storage.contains(current);
+         current = storage.get(current).parent)
+    {
+        auto &transform = storage.get(current);
+        world = Math::Multiply(Math::ComposeTRS(transform.position, transform.rotation, transform.scale), world);
+    }
+    return world;
+}
+void TransformSystem::SetLocalMatrix(TransformComponent &transform, const glm::mat4 &localMatrix)
+{
+    glm::vec3 translation, scale, skew;
+    glm::quat rotation;
+    glm::vec4 perspective;
+    // 父节点有非均匀缩放时结果可能带切变，无法完全保持，只保留 TRS 部分
+    if (glm::decompose(localMatrix, scale, rotation, translation, skew, perspective))
+    {
+        transform.position = translation;
+        transform.rotation = rotation;
+        transform.scale = scale;
+    }
+}
+void TransformSystem::SetParent(entt::entity child, entt::entity parent, bool keepWorldTransform)
+{
+    auto &storage = mRegistry->storage<TransformComponent>();
+    if (!storage.contains(child) || (parent != entt::null && !storage.contains(parent)))
+    {
+        mLogger->Error("SetParent: entity without TransformComponent");
+        throw std::runtime_error("SetParent: entity without TransformComponent");
+    }
+    // 防止成环
+    for (entt::entity current = parent; current != entt::null; current = storage.get(current).parent)
+    {
+        if (current == child)
+        {
+            mLogger->Error("SetParent: entity {} cannot be parented to its descendant {}",
+                           entt::to_integral(child), entt::to_integral(parent));
+            throw std::runtime_error("SetParent: hierarchy cycle");
+        }
+    }
+    auto &transform = storage.get(child);
+    if (keepWorldTransform)
+    {
+        glm::mat4 localMatrix = ComputeWorldMatrix(child);
+        if (parent != entt::null)
+        {
+            localMatrix = glm::inverse(ComputeWorldMatrix(parent)) * localMatrix;
+        }
+        SetLocalMatrix(transform, localMatrix);
     }
+    transform.parent = parent;
+    transform.isDirty = true;
+    mHierarchyChanged = true;
+}
+uint32_t TransformSystem::GetUpdatedCount() const noexcept
+{
+    return mUpdatedCount.load();
+}
+TaskAccess TransformSystem::GetAccess() const
+{
+    return TaskAccess().Write<TransformComponent>();
 }
 
 } // namespace MEngine
\ No newline at end of file
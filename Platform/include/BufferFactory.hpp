@@ -4,6 +4,7 @@
 #include "MEngine.hpp"
 #include "NoCopyable.hpp"
 #include "SyncPrimitiveManager.hpp"
+#include "UploadQueue.hpp"
 #include "VMA.hpp"
 #include <memory>
 #include <vulkan/vulkan.hpp>
@@ -16,7 +17,10 @@ enum class BufferType
     Index,   // 索引缓冲区
     Uniform, // Uniform 缓冲区
     Staging, // 临时缓冲区
-    Storage  // 存储缓冲区
+    Storage, // 存储缓冲区
+    Instance, // 实例缓冲区（主机可见，每帧写入，可作顶点或存储缓冲区）
+    Indirect, // 间接绘制参数缓冲区（主机可见，可由计算着色器写入）
+    GPUInstance // GPU 实例缓冲区（计算着色器写入，作顶点缓冲区读取）
 };
 class BufferFactory final : public NoCopyable
 {
@@ -27,16 +31,22 @@ class BufferFactory final : public NoCopyable
 
     std::shared_ptr<CommandBufferManager> mCommandBufferManager;
     std::shared_ptr<SyncPrimitiveManager> mSyncPrimitiveManager;
-
-  private:
-    vk::UniqueCommandBuffer mCommandBuffer;
-    vk::UniqueFence mFence;
+    std::shared_ptr<UploadQueue> mUploadQueue;
 
   public:
     BufferFactory(std::shared_ptr<ILogger> logger, std::shared_ptr<Context> context,
                   std::shared_ptr<CommandBufferManager> commandBufferManager,
-                  std::shared_ptr<SyncPrimitiveManager> syncPrimitiveManager);
-    UniqueBuffer CreateBuffer(BufferType type, vk::DeviceSize size, const void *data = nullptr);
-    void CopyBuffer(Buffer *src, Buffer *dst);
+                  std::shared_ptr<SyncPrimitiveManager> syncPrimitiveManager,
+                  std::shared_ptr<UploadQueue> uploadQueue);
+    /**
+     * @brief 创建缓冲区，主机可见类型直接写入 data；GPU 类型通过 UploadQueue 异步上传，
+     * 返回时数据可能尚未到达，ticket 非空时写入本次上传的凭据
+     */
+    UniqueBuffer CreateBuffer(BufferType type, vk::DeviceSize size, const void *data = nullptr,
+                              UploadTicket *ticket = nullptr);
+    inline const std::shared_ptr<UploadQueue> &GetUploadQueue() const
+    {
+        return mUploadQueue;
+    }
 };
 } // namespace MEngine
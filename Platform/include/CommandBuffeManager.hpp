@@ -14,7 +14,8 @@ enum class CommandBufferType
 {
     Graphic,
     Transfer,
-    Present
+    Present,
+    Compute
 };
 class CommandBufferManager final : public NoCopyable
 {
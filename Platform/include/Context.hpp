@@ -21,6 +21,17 @@ struct ContextConfig
     std::vector<const char *> deviceRequiredExtensions;
     std::vector<const char *> deviceRequiredLayers;
 };
+/**
+ * @brief 实际启用的可选设备特性，不支持时由调用方退化
+ */
+struct DeviceFeatures
+{
+    bool drawIndirectFirstInstance = false; // 间接绘制命令可使用非 0 的 firstInstance
+    bool multiDrawIndirect = false;         // 一次间接绘制调用执行多条命令
+    bool drawIndirectCount = false;         // Vulkan 1.2 drawIndexedIndirectCount
+    bool timelineSemaphore = false;         // Vulkan 1.2 时间线信号量
+    bool textureCompressionBC = false;      // BC1-BC7 块压缩纹理
+};
 class Context final : public NoCopyable
 {
   private:
@@ -40,14 +51,23 @@ class Context final : public NoCopyable
         std::optional<uint32_t> presentFamilyCount;
         std::optional<uint32_t> transferFamily;
         std::optional<uint32_t> transferFamilyCount;
+        std::optional<uint32_t> computeFamily;
+        std::optional<uint32_t> computeFamilyCount;
     };
     QueueFamilyIndicates mQueueFamilyIndicates;
+    DeviceFeatures mEnabledFeatures;
     vk::UniqueInstance mVKInstance;
     vk::PhysicalDevice mPhysicalDevice;
     vk::UniqueDevice mDevice;
     vk::Queue mGraphicQueue;
     vk::Queue mPresentQueue;
     vk::Queue mTransferQueue;
+    vk::Queue mComputeQueue;
+    // 各用途在所属族内的队列索引，族内队列不足时共用
+    uint32_t mGraphicQueueIndex = 0;
+    uint32_t mPresentQueueIndex = 0;
+    uint32_t mTransferQueueIndex = 0;
+    uint32_t mComputeQueueIndex = 0;
     VmaAllocator mVmaAllocator;
     // surface
     struct SurfaceInfo
@@ -67,11 +87,13 @@ class Context final : public NoCopyable
     std::mutex mGraphicQueueMutex;
     std::mutex mPresentQueueMutex;
     std::mutex mTransferQueueMutex;
+    std::mutex mComputeQueueMutex;
 
   private:
     void CreateInstance();
     void QueryQueueFamilyIndicates();
     void GetQueues();
+    std::mutex &GetQueueMutex(vk::Queue queue);
     void PickPhysicalDevice();
     void CreateDevice();
     int RatePhysicalDevices(vk::PhysicalDevice &physicalDevice);
@@ -85,6 +107,9 @@ class Context final : public NoCopyable
     void CreateSwapchainImageViews();
 
   public:
+    /**
+     * @brief window 为空时创建无窗口的上下文：不创建表面与交换链，呈现队列与图形队列相同
+     */
     Context(std::shared_ptr<ILogger> logger, std::shared_ptr<IWindow> window);
     ~Context();
     void SetPresentQueueFamilyIndex(vk::SurfaceKHR surface);
@@ -100,6 +125,10 @@ class Context final : public NoCopyable
     {
         return mPhysicalDevice;
     }
+    inline const DeviceFeatures &GetEnabledFeatures() const
+    {
+        return mEnabledFeatures;
+    }
     inline const VmaAllocator &GetVmaAllocator() const
     {
         return mVmaAllocator;
@@ -124,6 +153,17 @@ class Context final : public NoCopyable
     {
         return mTransferQueue;
     }
+    inline const vk::Queue &GetComputeQueue() const
+    {
+        return mComputeQueue;
+    }
+    /**
+     * @brief 传输队列是否属于独立的队列族，是则上传的资源需要做所有权转移
+     */
+    inline bool HasDedicatedTransferFamily() const
+    {
+        return mQueueFamilyIndicates.transferFamily != mQueueFamilyIndicates.graphicsFamily;
+    }
     inline const vk::SurfaceKHR &GetSurface() const
     {
         return mSurface.get();
@@ -154,6 +194,7 @@ class Context final : public NoCopyable
     void SubmitToGraphicQueue(std::vector<vk::SubmitInfo> submits, vk::Fence fence);
     void SubmitToPresnetQueue(vk::PresentInfoKHR presentInfo);
     void SubmitToTransferQueue(std::vector<vk::SubmitInfo> submits, vk::Fence fence);
+    void SubmitToComputeQueue(std::vector<vk::SubmitInfo> submits, vk::Fence fence);
 };
 
 } // namespace MEngine
\ No newline at end of file
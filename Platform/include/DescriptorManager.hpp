@@ -89,6 +89,8 @@ class DescriptorManager final : public NoCopyable
     }
     void UpdateUniformDescriptorSet(const std::vector<std::reference_wrapper<Buffer>> &uniformBuffers, uint32_t binding,
                                     vk::DescriptorSet dstSet);
+    void UpdateStorageDescriptorSet(const std::vector<std::reference_wrapper<Buffer>> &storageBuffers, uint32_t binding,
+                                    vk::DescriptorSet dstSet);
     void UpdateCombinedSamplerImageDescriptorSet(std::vector<ImageDescriptor> imageDescriptors, uint32_t binding,
                                                  vk::DescriptorSet dstSet);
 };
@@ -0,0 +1,116 @@
+#pragma once
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <set>
+#include <utility>
+
+namespace MEngine
+{
+/**
+ * @brief 空闲链表区间分配器，只管理偏移，不持有内存
+ * 按最佳适配选取空闲块，释放时与相邻空闲块合并。单位由调用方决定（字节、顶点或索引）。
+ */
+class FreeListAllocator final
+{
+  private:
+    uint64_t mCapacity;
+    uint64_t mUsed = 0;
+    // 偏移 -> 大小，用于合并相邻块
+    std::map<uint64_t, uint64_t> mFreeBlocks;
+    // (大小, 偏移)，用于最佳适配查找
+    std::set<std::pair<uint64_t, uint64_t>> mFreeBySize;
+
+  private:
+    void InsertFree(uint64_t offset, uint64_t size)
+    {
+        mFreeBlocks.emplace(offset, size);
+        mFreeBySize.emplace(size, offset);
+    }
+    void EraseFree(std::map<uint64_t, uint64_t>::iterator it)
+    {
+        mFreeBySize.erase({it->second, it->first});
+        mFreeBlocks.erase(it);
+    }
+
+  public:
+    explicit FreeListAllocator(uint64_t capacity) : mCapacity(capacity)
+    {
+        if (capacity > 0)
+        {
+            InsertFree(0, capacity);
+        }
+    }
+    /**
+     * @brief 分配 size 个单位，返回起始偏移；没有足够大的连续空闲块时返回空
+     */
+    std::optional<uint64_t> Allocate(uint64_t size)
+    {
+        if (size == 0)
+        {
+            return std::nullopt;
+        }
+        auto best = mFreeBySize.lower_bound({size, 0});
+        if (best == mFreeBySize.end())
+        {
+            return std::nullopt;
+        }
+        auto [blockSize, offset] = *best;
+        EraseFree(mFreeBlocks.find(offset));
+        if (blockSize > size)
+        {
+            InsertFree(offset + size, blockSize - size);
+        }
+        mUsed += size;
+        return offset;
+    }
+    /**
+     * @brief 归还 Allocate 返回的区间，size 必须与分配时一致
+     */
+    void Free(uint64_t offset, uint64_t size)
+    {
+        if (size == 0)
+        {
+            return;
+        }
+        mUsed -= size;
+        auto next = mFreeBlocks.lower_bound(offset);
+        if (next != mFreeBlocks.end() && next->first == offset + size)
+        {
+            size += next->second;
+            EraseFree(next++);
+        }
+        if (next != mFreeBlocks.begin())
+        {
+            auto prev = std::prev(next);
+            if (prev->first + prev->second == offset)
+            {
+                offset = prev->first;
+                size += prev->second;
+                EraseFree(prev);
+            }
+        }
+        InsertFree(offset, size);
+    }
+    inline uint64_t GetCapacity() const
+    {
+        return mCapacity;
+    }
+    inline uint64_t GetUsed() const
+    {
+        return mUsed;
+    }
+    inline uint64_t GetLargestFreeBlock() const
+    {
+        return mFreeBySize.empty() ? 0 : mFreeBySize.rbegin()->first;
+    }
+    /**
+     * @brief 空闲块数量，1 表示空闲空间完全连续
+     */
+    inline size_t GetFreeBlockCount() const
+    {
+        return mFreeBlocks.size();
+    }
+};
+} // namespace MEngine
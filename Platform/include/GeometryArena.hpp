@@ -0,0 +1,115 @@
+#pragma once
+#include "Buffer.hpp"
+#include "Context.hpp"
+#include "FreeListAllocator.hpp"
+#include "Interface/IConfigure.hpp"
+#include "Interface/ILogger.hpp"
+#include "MEngine.hpp"
+#include "NoCopyable.hpp"
+#include "UploadQueue.hpp"
+#include "Vertex.hpp"
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <vulkan/vulkan.hpp>
+
+namespace MEngine
+{
+/**
+ * @brief 网格在几何数据池中占用的区间
+ * 顶点与索引以元素为单位：绘制时 vertexOffset 加到索引值上，firstIndex 为索引缓冲区内的起点，索引本身保持网格局部。
+ */
+struct GeometryAllocation
+{
+    uint32_t page = 0;
+    VertexFormat format = VertexFormat::Standard;
+    uint32_t vertexOffset = 0;
+    uint32_t vertexCount = 0;
+    uint32_t firstIndex = 0;
+    uint32_t indexCount = 0;
+};
+struct GeometryArenaStats
+{
+    uint32_t pages = 0;
+    uint32_t allocations = 0;
+    uint64_t vertexCapacity = 0;
+    uint64_t vertexUsed = 0;
+    uint64_t indexCapacity = 0;
+    uint64_t indexUsed = 0;
+    // 所有页中空闲块的总数，远大于页数时说明碎片较多
+    uint64_t freeBlocks = 0;
+};
+/**
+ * @brief 全局几何数据池：所有网格共享大块顶点/索引缓冲区，按区间子分配
+ * 每页包含一个顶点缓冲区和一个索引缓冲区，各自由 FreeListAllocator 管理；页满时追加新页，已有网格的偏移不受影响。
+ * 一页只存放一种顶点格式，vertexOffset 以该格式的顶点为单位。
+ * 同一页内的网格绘制时无需重新绑定缓冲区，可以合并进同一组间接绘制命令。
+ * 释放的区间可能仍被飞行中的帧读取，延迟到 NextFrame 推进足够帧数后才回收。
+ */
+class GeometryArena final : public NoCopyable
+{
+  private:
+    // DI
+    std::shared_ptr<ILogger> mLogger;
+    std::shared_ptr<Context> mContext;
+    std::shared_ptr<IConfigure> mConfigure;
+    std::shared_ptr<UploadQueue> mUploadQueue;
+
+  private:
+    struct Page
+    {
+        VertexFormat format;
+        UniqueBuffer vertexBuffer;
+        UniqueBuffer indexBuffer;
+        FreeListAllocator vertexAllocator;
+        FreeListAllocator indexAllocator;
+    };
+    struct RetiredAllocation
+    {
+        GeometryAllocation allocation;
+        uint64_t frame;
+    };
+    std::mutex mMutex;
+    std::vector<Page> mPages;
+    std::deque<RetiredAllocation> mRetiredAllocations;
+    vk::DeviceSize mVertexPageSize = 0;
+    uint64_t mIndexPageCapacity = 0;
+    VertexFormat mPreferredVertexFormat = VertexFormat::Standard;
+    uint64_t mFrame = 0;
+    uint32_t mAllocationCount = 0;
+
+  private:
+    Page &CreatePageLocked(VertexFormat format, uint64_t vertexCount, uint64_t indexCount);
+    void ReleaseLocked(const GeometryAllocation &allocation);
+
+  public:
+    GeometryArena(std::shared_ptr<ILogger> logger, std::shared_ptr<Context> context,
+                  std::shared_ptr<IConfigure> configure, std::shared_ptr<UploadQueue> uploadQueue);
+    /**
+     * @brief 分配区间并通过 UploadQueue 上传数据，数据在返回前已被复制，ticket 非空时写入本次上传的凭据
+     * vertices 按 format 的布局紧密排列（Vertex 或 QuantizedVertex）
+     */
+    GeometryAllocation Allocate(VertexFormat format, const void *vertices, uint32_t vertexCount,
+                                const uint32_t *indices, uint32_t indexCount, UploadTicket *ticket = nullptr);
+    /**
+     * @brief 标记区间不再使用，framesInFlight 帧之后才真正回收
+     */
+    void Free(const GeometryAllocation &allocation);
+    /**
+     * @brief 每帧提交后调用一次，回收已经不会被 GPU 读取的区间
+     */
+    void NextFrame(uint32_t framesInFlight);
+    vk::Buffer GetVertexBuffer(uint32_t page);
+    vk::Buffer GetIndexBuffer(uint32_t page);
+    GeometryArenaStats GetStats();
+    /**
+     * @brief 配置中 GeometrySetting.QuantizeVertices 决定新网格默认使用的顶点格式
+     */
+    inline VertexFormat GetPreferredVertexFormat() const
+    {
+        return mPreferredVertexFormat;
+    }
+};
+} // namespace MEngine
@@ -30,6 +30,8 @@ class Image final
     uint32_t mMipLevels;
     uint32_t mArrayLayers;
     vk::ImageLayout mCurrentLayout;
+    // 初始数据所在上传批次的 ticket，0 表示没有待完成的上传
+    uint64_t mUploadTicket = 0;
 
   public:
     Image(std::shared_ptr<Context> context, const vk::ImageCreateInfo &imageInfo, VmaMemoryUsage memoryUsage,
@@ -53,6 +55,7 @@ class Image final
     uint32_t GetMipLevels() const;
     uint32_t GetArrayLayers() const;
     vk::ImageLayout GetCurrentLayout() const;
+    uint64_t GetUploadTicket() const;
 
   private:
     void Release();
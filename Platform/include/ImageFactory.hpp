@@ -6,6 +6,7 @@
 #include "MEngine.hpp"
 #include "NoCopyable.hpp"
 #include "SyncPrimitiveManager.hpp"
+#include "UploadQueue.hpp"
 #include "VMA.hpp"
 #include <memory>
 #include <unordered_map>
@@ -21,6 +22,37 @@ enum class ImageType
     DepthStencil, // 深度/模板附件
     Storage       // 存储图像
 };
+/**
+ * @brief 批量创建图像时的单个请求，data 只需在 CreateImages 返回前有效
+ * generateMipmaps 为 true 时 data 只含 mip 0，mipLevels 被忽略并生成完整 mip 链；
+ * 否则 data 需按 mip 级别紧密排列包含全部 mipLevels 级，或由 mips 逐级给出
+ */
+struct ImageUploadRequest
+{
+    ImageType type = ImageType::Texture2D;
+    vk::Extent3D extent;
+    vk::DeviceSize size = 0;
+    const void *data = nullptr;
+    uint32_t mipLevels = 1;
+    bool generateMipmaps = false;
+    // 非 eUndefined 时覆盖 type 对应的默认格式，例如烘焙好的块压缩纹理
+    vk::Format format = vk::Format::eUndefined;
+    // 非空时取代 data/size，逐级给出已有的 mip 数据，可直接指向内存映射文件
+    std::vector<ImageMipData> mips;
+};
+/**
+ * @brief 格式的拷贝单位：未压缩格式为 1x1 纹素，块压缩格式为 4x4 块
+ */
+struct FormatBlockInfo
+{
+    uint32_t blockWidth = 1;
+    uint32_t blockHeight = 1;
+    uint32_t blockSize = 0;
+    inline bool IsCompressed() const
+    {
+        return blockWidth > 1 || blockHeight > 1;
+    }
+};
 class ImageFactory final : public NoCopyable
 {
   private:
@@ -31,16 +63,9 @@ class ImageFactory final : public NoCopyable
     std::shared_ptr<CommandBufferManager> mCommandBufferManager;
     std::shared_ptr<SyncPrimitiveManager> mSyncPrimitiveManager;
     std::shared_ptr<BufferFactory> mBufferFactory;
+    std::shared_ptr<UploadQueue> mUploadQueue;
 
   private:
-    vk::UniqueCommandBuffer mCopyCommandBuffer;
-    vk::UniqueCommandBuffer mPreTransitionCommandBuffer;
-    vk::UniqueCommandBuffer mPostTransitionCommandBuffer;
-    vk::UniqueFence mFence;
-    vk::UniqueSemaphore mPreTransitionDone;
-    vk::UniqueSemaphore mPostTransitionDone;
-    vk::UniqueSemaphore mCopyDone;
-
     std::vector<vk::Format> mTexture2DFormats;
     std::vector<vk::Format> mTextureCubeFormats;
     std::vector<vk::Format> mRenderTargetFormats;
@@ -57,21 +82,46 @@ class ImageFactory final : public NoCopyable
     ImageFactory(std::shared_ptr<ILogger> logger, std::shared_ptr<Context> context,
                  std::shared_ptr<CommandBufferManager> commandBufferManager,
                  std::shared_ptr<SyncPrimitiveManager> syncPrimitiveManager,
-                 std::shared_ptr<BufferFactory> bufferFactory);
+                 std::shared_ptr<BufferFactory> bufferFactory, std::shared_ptr<UploadQueue> uploadQueue);
 
     UniqueImage CreateImage(ImageType type, vk::Extent3D extent, uint32_t mipLevels = 1,
                             vk::SampleCountFlagBits samples = vk::SampleCountFlagBits::e1);
 
     UniqueImage CreateImage(ImageType type, vk::Extent3D extent, vk::DeviceSize size, const void *data,
                             uint32_t mipLevels = 1, vk::SampleCountFlagBits samples = vk::SampleCountFlagBits::e1);
+    /**
+     * @brief 批量创建并上传图像，全部拷贝与布局转换合并为一次提交，不等待完成
+     * 每个图像的 GetUploadTicket() 可用于按需等待
+     * skipFailed 为 true 时单个请求失败只记录错误并在对应位置返回空图像，其余图像照常提交；
+     * 上传数据在录制命令前校验，失败的请求不会留下引用已销毁图像的命令
+     */
+    std::vector<UniqueImage> CreateImages(const std::vector<ImageUploadRequest> &requests, bool skipFailed = false);
     vk::UniqueImageView CreateImageView(Image *image, vk::ImageAspectFlags aspectMask = {},
                                         vk::ComponentMapping components = {});
     void TransitionImageLayout(Image *image, vk::ImageLayout newLayout, vk::PipelineStageFlagBits srcStage,
                                vk::PipelineStageFlagBits dstStage, vk::AccessFlags srcAccessMask,
                                vk::AccessFlags dstAccessMask, vk::ImageSubresourceRange subresourceRange);
-    void CopyBufferToImage(Buffer *srcBuffer, Image *dstImage, vk::ImageSubresourceLayers imageSubresourceLayers);
+    /**
+     * @brief 格式支持线性 blit 且上传队列具备图形能力时，mip 链在 GPU 上生成
+     */
+    bool SupportsMipmapBlit(vk::Format format) const;
+    /**
+     * @brief 格式能否以最优排布创建并采样，块压缩格式还需要设备启用 textureCompressionBC
+     */
+    bool IsFormatSampleable(vk::Format format) const;
+    FormatBlockInfo GetFormatBlockInfo(vk::Format format) const;
 
   private:
+    UniqueImage AllocateImage(ImageType type, vk::Extent3D extent, uint32_t mipLevels, vk::SampleCountFlagBits samples,
+                              ImageUploadInfo &uploadInfo, vk::Format format = vk::Format::eUndefined);
+    /**
+     * @brief 需要生成 mip 链时的级数，GPU 与 CPU 路径都不支持该格式时退化为 1
+     */
+    uint32_t GetGeneratedMipLevels(ImageType type, vk::Format format, vk::Extent3D extent);
+    UploadTicket EnqueueUpload(Image *image, ImageUploadInfo &uploadInfo, const void *data, vk::DeviceSize size,
+                               bool generateMipmaps);
+    UploadTicket EnqueueUpload(Image *image, ImageUploadInfo &uploadInfo, const std::vector<ImageMipData> &mips);
+    void SetUploadFormat(Image *image, ImageUploadInfo &uploadInfo) const;
     void QueryImageFormat();
     vk::Format GetBestFormat(ImageType type);
     uint32_t GetFormatPixelSize(vk::Format format) const;
@@ -0,0 +1,47 @@
+#pragma once
+#include "glm/glm.hpp"
+#include <array>
+#include <cstdint>
+
+namespace MEngine
+{
+/**
+ * @brief GPU 剔除的输入物体，布局与 gpuCulling.comp 中的 std430 结构一致
+ * 包围盒与包围球位于网格局部空间，由着色器使用模型矩阵变换到世界空间
+ */
+struct GPUObjectData
+{
+    glm::mat4 modelMatrix;
+    glm::vec4 boundingSphere; // xyz: 球心, w: 半径
+    glm::vec4 boxCenter;      // xyz: 包围盒中心
+    glm::vec4 boxExtents;     // xyz: 包围盒半长
+    uint32_t batchIndex;      // 所属批次，即间接绘制命令的下标
+    uint32_t groupIndex;      // 批次所在的绘制组，即 drawCount 的下标
+    uint32_t groupDrawCount;  // 批次在组内的位置加 1，组内有可见物体的最后一个批次决定 drawCount
+    uint32_t padding;
+};
+static_assert(sizeof(GPUObjectData) == 128, "GPUObjectData must match the std430 layout in gpuCulling.comp");
+
+/**
+ * @brief 与 VkDrawIndexedIndirectCommand 布局一致
+ */
+struct DrawIndexedIndirectCommand
+{
+    uint32_t indexCount;
+    uint32_t instanceCount;
+    uint32_t firstIndex;
+    int32_t vertexOffset;
+    uint32_t firstInstance;
+};
+static_assert(sizeof(DrawIndexedIndirectCommand) == 20, "DrawIndexedIndirectCommand must match Vulkan");
+
+/**
+ * @brief 剔除着色器的 push constant：六个视锥平面（与 Frustum::GetPlanes 相同）与物体数量
+ */
+struct GPUCullingParams
+{
+    std::array<glm::vec4, 6> planes;
+    uint32_t objectCount;
+};
+static_assert(sizeof(GPUCullingParams) == 100, "GPUCullingParams must match the push constant block");
+} // namespace MEngine
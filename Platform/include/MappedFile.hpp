@@ -0,0 +1,50 @@
+#pragma once
+#include "NoCopyable.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+namespace MEngine
+{
+/**
+ * @brief 只读内存映射文件，映射在析构时解除
+ * 读取映射内存时由操作系统按页调入，不需要额外的读缓冲区。
+ */
+class MappedFile final : public NoCopyable
+{
+  private:
+    const uint8_t *mData = nullptr;
+    uint64_t mSize = 0;
+#if defined(PLATFORM_WINDOWS)
+    void *mFileHandle = nullptr;
+    void *mMappingHandle = nullptr;
+#else
+    int mFileDescriptor = -1;
+#endif
+
+  public:
+    MappedFile() = default;
+    ~MappedFile();
+    /**
+     * @brief 映射整个文件，失败或文件为空时返回 false
+     */
+    bool Open(const std::filesystem::path &path);
+    void Close();
+    /**
+     * @brief 提示操作系统预读整个映射，在工作线程调用可把磁盘读取移出主线程
+     */
+    void Prefetch() const;
+    inline const uint8_t *GetData() const
+    {
+        return mData;
+    }
+    inline uint64_t GetSize() const
+    {
+        return mSize;
+    }
+    inline bool IsOpen() const
+    {
+        return mData != nullptr;
+    }
+};
+} // namespace MEngine
@@ -0,0 +1,81 @@
+#pragma once
+#include "MeshOptimizer.hpp"
+#include "MeshSimplifier.hpp"
+#include "Vertex.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace MEngine
+{
+/**
+ * @brief .mmesh 烘焙网格容器
+ * 布局：MeshContainerHeader | MeshContainerLOD[lodCount] | 顶点数据 | 索引数据，
+ * 顶点与索引两段均按 MeshContainerAlignment 对齐。
+ * 顶点为 Vertex 的紧密数组，索引为 uint32，内容已经过 OptimizeMesh，运行时可直接从映射内存上传。
+ * 各级 LOD 的索引依次存放在索引段中（LOD0 在前），全部指向同一组顶点。
+ * 所有字段按小端序存储。
+ */
+constexpr uint32_t MeshContainerMagic = 0x48534D4D; // "MMSH"
+constexpr uint32_t MeshContainerVersion = 2;
+constexpr uint64_t MeshContainerAlignment = 16;
+
+enum MeshContainerFlags : uint32_t
+{
+    MeshContainerOptimized = 1u << 0,
+};
+struct MeshContainerHeader
+{
+    uint32_t magic = MeshContainerMagic;
+    uint32_t version = MeshContainerVersion;
+    uint32_t vertexStride = sizeof(Vertex);
+    uint32_t flags = 0;
+    uint32_t vertexCount = 0;
+    uint32_t indexCount = 0; // 所有 LOD 的索引总数
+    uint32_t lodCount = 0;   // 包含 LOD0
+    uint32_t reserved = 0;
+    // 烘焙时统计的 LOD0 ACMR/ATVR，便于离线比较
+    float acmr = 0.0f;
+    float atvr = 0.0f;
+    uint64_t vertexOffset = 0; // 相对文件开头
+    uint64_t indexOffset = 0;
+};
+struct MeshContainerLOD
+{
+    uint32_t firstIndex = 0; // 相对索引段开头
+    uint32_t indexCount = 0;
+    float error = 0.0f; // 相对原始网格的模型空间误差
+    uint32_t reserved = 0;
+};
+static_assert(sizeof(MeshContainerHeader) == 56, "MeshContainerHeader layout is part of the file format");
+static_assert(sizeof(MeshContainerLOD) == 16, "MeshContainerLOD layout is part of the file format");
+static_assert(sizeof(Vertex) == 32, "Vertex layout is part of the .mmesh file format");
+
+/**
+ * @brief 指向容器字节的只读视图，data 的生命周期由调用方保证
+ */
+struct MeshContainerView
+{
+    MeshContainerHeader header;
+    const MeshContainerLOD *lods = nullptr;
+    const Vertex *vertices = nullptr;
+    const uint32_t *indices = nullptr;
+};
+
+struct MeshCookOptions
+{
+    MeshOptimizeOptions optimize;
+    bool generateLODs = true;
+    MeshLODOptions lod;
+};
+/**
+ * @brief 优化网格、生成 LOD 链并输出完整的 .mmesh 文件内容，report 非空时写入优化前后的统计
+ */
+std::vector<uint8_t> CookMesh(std::vector<Vertex> vertices, std::vector<uint32_t> indices,
+                              const MeshCookOptions &options = {}, MeshOptimizeReport *report = nullptr);
+/**
+ * @brief 校验并解析容器，文件头、LOD 表、数据范围或索引越界时返回空
+ */
+std::optional<MeshContainerView> ParseMeshContainer(const uint8_t *data, uint64_t size);
+} // namespace MEngine
@@ -0,0 +1,65 @@
+#pragma once
+#include "Vertex.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace MEngine
+{
+/**
+ * @brief 变换后顶点缓存的模拟结果（FIFO 缓存）
+ */
+struct VertexCacheStats
+{
+    uint32_t triangles = 0;
+    uint32_t transforms = 0; // 缓存未命中、需要执行顶点着色器的次数
+    float acmr = 0.0f;       // 每个三角形的平均未命中数，下限约 0.5，上限 3
+    float atvr = 0.0f;       // 每个被引用顶点的平均变换次数，理想值为 1
+};
+struct MeshOptimizeOptions
+{
+    bool weld = true;        // 合并完全相同的顶点
+    bool vertexCache = true; // Tipsify 三角形重排
+    bool overdraw = true;    // 在缓存命中率允许的范围内按朝外程度重排簇
+    bool vertexFetch = true; // 按首次使用顺序重排顶点
+    uint32_t cacheSize = 16;
+    // 重排簇后 ACMR 最多为原来的多少倍
+    float overdrawThreshold = 1.05f;
+};
+struct MeshOptimizeReport
+{
+    uint32_t verticesBefore = 0;
+    uint32_t verticesAfter = 0;
+    VertexCacheStats before;
+    VertexCacheStats after;
+};
+
+/**
+ * @brief 以给定大小的 FIFO 缓存模拟索引序列，统计 ACMR/ATVR
+ */
+VertexCacheStats AnalyzeVertexCache(const uint32_t *indices, size_t indexCount, size_t vertexCount,
+                                    uint32_t cacheSize = 16);
+/**
+ * @brief 合并位置、法线、纹理坐标完全相同的顶点并改写索引，返回合并后的顶点数
+ */
+size_t WeldVertices(std::vector<Vertex> &vertices, std::vector<uint32_t> &indices);
+/**
+ * @brief Tipsify（Sander 等, 2007）：围绕扇心顶点输出三角形，线性时间，就地改写索引
+ */
+void OptimizeVertexCache(uint32_t *indices, size_t indexCount, size_t vertexCount, uint32_t cacheSize = 16);
+/**
+ * @brief 把已按缓存优化的索引切成簇，按簇朝外程度从大到小排序，先画的外表面可以遮挡后画的内部
+ * 只在局部 ACMR 不超过整体 ACMR * threshold 的位置切分，保证缓存命中率的损失有上界。
+ */
+void OptimizeOverdraw(uint32_t *indices, size_t indexCount, const Vertex *vertices, size_t vertexCount,
+                      uint32_t cacheSize = 16, float threshold = 1.05f);
+/**
+ * @brief 按索引中首次出现的顺序重排顶点，删除未被引用的顶点
+ */
+void OptimizeVertexFetch(std::vector<Vertex> &vertices, std::vector<uint32_t> &indices);
+/**
+ * @brief 依次执行合并、缓存重排、过度绘制重排、顶点读取重排，返回前后的统计
+ */
+MeshOptimizeReport OptimizeMesh(std::vector<Vertex> &vertices, std::vector<uint32_t> &indices,
+                                const MeshOptimizeOptions &options = {});
+} // namespace MEngine
@@ -0,0 +1,43 @@
+#pragma once
+#include "Vertex.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace MEngine
+{
+/**
+ * @brief LOD 链中的一级：索引指向原始顶点数组，error 为与原始网格之间的最大双向距离（模型空间），
+ * 随级别单调不减，可以直接投影到屏幕空间选择 LOD
+ */
+struct MeshLODLevel
+{
+    std::vector<uint32_t> indices;
+    float error = 0.0f;
+};
+struct MeshLODOptions
+{
+    uint32_t maxLevels = 4;  // 不含 LOD0
+    float reduction = 0.5f;  // 每一级相对上一级的目标三角形比例
+    float maxError = 0.05f;  // 允许的最大误差，相对网格包围球半径
+    uint32_t minTriangles = 8;
+};
+
+/**
+ * @brief 基于二次误差度量（Garland & Heckbert）的半边折叠简化
+ * 顶点只会折叠到相邻的已有顶点上，结果索引仍然指向原顶点数组，各级 LOD 可以共用同一个顶点缓冲区。
+ * 开放边界与属性接缝上的顶点保持不动，避免产生裂缝与纹理错位。
+ * 二次误差只用于排序候选，每次折叠都用到原始三角形的实际距离检验，保证结果与原始网格的偏差不超过 maxError。
+ * @param targetIndexCount 目标索引数，没有满足误差上限的折叠时提前停止
+ * @param resultError 非空时写入测得的最大偏差：原始顶点到简化网格、简化三角形采样点到原始网格的距离取最大
+ */
+std::vector<uint32_t> SimplifyMesh(const Vertex *vertices, size_t vertexCount, const uint32_t *indices,
+                                   size_t indexCount, size_t targetIndexCount, float maxError,
+                                   float *resultError = nullptr);
+/**
+ * @brief 在同一个简化状态上逐级继续折叠生成 LOD 链（不含 LOD0），每级误差都相对原始网格；
+ * 每级索引经过顶点缓存重排，简化不再有效时提前结束
+ */
+std::vector<MeshLODLevel> GenerateLODChain(const Vertex *vertices, size_t vertexCount, const uint32_t *indices,
+                                           size_t indexCount, const MeshLODOptions &options = {});
+} // namespace MEngine
@@ -0,0 +1,32 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+namespace MEngine
+{
+/**
+ * @brief 完整 mip 链的层数：floor(log2(max(width, height, depth))) + 1
+ */
+uint32_t CalculateMipLevels(uint32_t width, uint32_t height, uint32_t depth = 1);
+/**
+ * @brief 第 level 级 mip 的边长，最小为 1
+ */
+inline uint32_t GetMipExtent(uint32_t extent, uint32_t level)
+{
+    uint32_t value = extent >> level;
+    return value > 0 ? value : 1;
+}
+/**
+ * @brief mipLevels 级 mip 紧密排列后的总字节数
+ */
+uint64_t GetMipChainSize(uint32_t width, uint32_t height, uint32_t mipLevels, uint32_t texelSize);
+/**
+ * @brief CPU 生成 RGBA8 纹理的完整 mip 链，2x2 盒式滤波，逐级由上一级缩小
+ * 奇数边长的方向使用 3 个样本的加权盒式滤波，最后一行/列同样参与平均。
+ * 返回 mip 0 到 mipLevels - 1 紧密排列的数据（包含 mip 0 的拷贝）。
+ * srgb 为 true 时颜色通道在线性空间平均，alpha 始终线性平均。
+ * 用于格式不支持线性 blit 或上传队列不具备图形能力时的回退路径。
+ */
+std::vector<uint8_t> GenerateMipChainRGBA8(const uint8_t *pixels, uint32_t width, uint32_t height,
+                                           uint32_t mipLevels, bool srgb);
+} // namespace MEngine
@@ -1,5 +1,6 @@
 #pragma once
 #include "Context.hpp"
+#include "IndirectDraw.hpp"
 #include "Interface/ILogger.hpp"
 #include "MEngine.hpp"
 #include "NoCopyable.hpp"
@@ -44,6 +45,8 @@ enum class PipelineLayoutType
     Toon, // 卡通渲染 Set0:{Camera_UBO, Light_SBO[6], ShadowParameters_SBO,ShadowMap[6](需要和Light_SBO按顺序一一对应)}
           // , Set1: Toon{RampMap, ToonParameters_UBO{RampScale, Color,...}}
     SubsurfaceScatter, // TODO: 集成到 PBR 材质中
+    GPUCulling,        // GPU 视锥剔除（计算） Set0:{Objects_SBO, DrawCommands_SBO, DrawCounts_SBO, Instances_SBO},
+                       // PushConstant: GPUCullingParams
 };
 
 class PipelineLayoutManager final : public NoCopyable
@@ -94,16 +97,33 @@ class PipelineLayoutManager final : public NoCopyable
         vk::DescriptorSetLayoutBinding mEmissiveBinding{5, vk::DescriptorType::eCombinedImageSampler, 1,
                                                         vk::ShaderStageFlagBits::eFragment};
     } mPBRDescriptorLayoutBindings;
+    struct GPUCullingLayoutBindings
+    {
+        // Set: 0, Binding: 0 Objects
+        vk::DescriptorSetLayoutBinding mObjectBinding{0, vk::DescriptorType::eStorageBuffer, 1,
+                                                      vk::ShaderStageFlagBits::eCompute};
+        // Set: 0, Binding: 1 Draw Commands
+        vk::DescriptorSetLayoutBinding mDrawCommandBinding{1, vk::DescriptorType::eStorageBuffer, 1,
+                                                           vk::ShaderStageFlagBits::eCompute};
+        // Set: 0, Binding: 2 Draw Counts
+        vk::DescriptorSetLayoutBinding mDrawCountBinding{2, vk::DescriptorType::eStorageBuffer, 1,
+                                                         vk::ShaderStageFlagBits::eCompute};
+        // Set: 0, Binding: 3 Instances
+        vk::DescriptorSetLayoutBinding mInstanceBinding{3, vk::DescriptorType::eStorageBuffer, 1,
+                                                        vk::ShaderStageFlagBits::eCompute};
+    } mGPUCullingDescriptorLayoutBindings;
 
   private:
     std::unordered_map<PipelineLayoutType, vk::UniquePipelineLayout> mPipelineLayouts;
     vk::UniqueDescriptorSetLayout mPBRDescriptorSetLayout;
     vk::UniqueDescriptorSetLayout mGlobalDescriptorSetLayout;
+    vk::UniqueDescriptorSetLayout mGPUCullingDescriptorSetLayout;
 
     // DescriptorSetLayout
     void CreateGlobalDescriptorSetLayout();
     void CreatePBRDescriptorSetLayout();
     void CreatePhongDescriptorSetLayout();
+    void CreateGPUCullingDescriptorSetLayout();
 
     // PipelineLayout
     void CreateShadowDepthPipelineLayout();
@@ -118,6 +138,7 @@ class PipelineLayoutManager final : public NoCopyable
     void CreateUIPipelineLayout();
     void CreateSpritePipelineLayout();
     void CreateToonPipelineLayout();
+    void CreateGPUCullingPipelineLayout();
     // void CreateSubsurfaceScatterPipelineLayout();
 
   public:
@@ -133,6 +154,10 @@ class PipelineLayoutManager final : public NoCopyable
     {
         return mPBRDescriptorSetLayout.get();
     }
+    inline const vk::DescriptorSetLayout &GetGPUCullingDescriptorSetLayout() const
+    {
+        return mGPUCullingDescriptorSetLayout.get();
+    }
     inline const GlobalLayoutBindings &GetGlobalDescriptorLayoutBindings() const
     {
         return mGlobalDescriptorLayoutBindings;
@@ -141,6 +166,10 @@ class PipelineLayoutManager final : public NoCopyable
     {
         return mPBRDescriptorLayoutBindings;
     }
+    inline const GPUCullingLayoutBindings &GetGPUCullingDescriptorLayoutBindings() const
+    {
+        return mGPUCullingDescriptorLayoutBindings;
+    }
 };
 
 } // namespace MEngine
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include "RenderPassManager.hpp"
 #include "ShaderManager.hpp"
 #include "Vertex.hpp"
+#include <array>
 #include <memory>
 #include <vulkan/vulkan.hpp>
 
@@ -17,6 +18,7 @@ enum class PipelineType
     // 基础渲染
     ShadowMap,               // 阴影深度贴图管线
     ForwardOpaquePBR,        // 前向渲染不透明物体管线
+    ForwardOpaquePBRInstanced, // 前向渲染不透明物体管线（实例化，模型矩阵来自实例缓冲区）
     ForwardTransparentPBR,   // 前向渲染透明物体管线
     ForwardOpaquePhong,      // 前向渲染不透明物体管线（Phong）
     ForwardTransparentPhong, // 前向渲染透明物体管线（Phong）
@@ -36,6 +38,9 @@ enum class PipelineType
     ParticleGPU, // GPU驱动的粒子系统（计算着色器+Transform Feedback）
     Decal,       // 贴花渲染（深度测试混合）
 
+    // GPU 驱动
+    GPUCulling, // 视锥剔除（计算着色器），生成间接绘制命令与实例数据
+
     // 后期处理
     PostProcessToneMapping, // 色调映射
     PostProcessBloom,       // 泛光效果
@@ -71,13 +76,15 @@ class PipelineManager final : public NoCopyable
     std::shared_ptr<RenderPassManager> mRenderPassManager;
 
   private:
-    std::unordered_map<PipelineType, vk::UniquePipeline> mPipelines;
+    // 按顶点格式分组，不读取顶点的管线（如计算管线）只存在于 Standard 组
+    std::array<std::unordered_map<PipelineType, vk::UniquePipeline>, VertexFormatCount> mPipelines;
 
   private:
     void CreateShadowMapPipeline();
-    void CreateForwardOpaquePBRPipeline();
+    void CreateForwardOpaquePBRPipeline(VertexFormat format);
+    void CreateForwardOpaquePBRInstancedPipeline(VertexFormat format);
     void CreateForwardOpaquePhongPipeline();
-    void CreateForwardTransparentPBRPipeline();
+    void CreateForwardTransparentPBRPipeline(VertexFormat format);
     void CreateForwardTransparentPhongPipeline();
     void CreateDeferredGBufferPipeline();
     void CreateDeferredLightingPipeline();
@@ -88,6 +95,7 @@ class PipelineManager final : public NoCopyable
     void CreateParticleCPUPipeline();
     void CreateParticleGPUPipeline();
     void CreateDecalPipeline();
+    void CreateGPUCullingPipeline();
     void CreatePostProcessToneMappingPipeline();
     void CreatePostProcessBloomPipeline();
     void CreatePostProcessDOFPipeline();
@@ -108,6 +116,6 @@ class PipelineManager final : public NoCopyable
                     std::shared_ptr<ShaderManager> shaderManager,
                     std::shared_ptr<PipelineLayoutManager> pipelineLayoutManager,
                     std::shared_ptr<RenderPassManager> renderPassManager);
-    vk::Pipeline GetPipeline(PipelineType type) const;
+    vk::Pipeline GetPipeline(PipelineType type, VertexFormat format = VertexFormat::Standard) const;
 };
 } // namespace MEngine
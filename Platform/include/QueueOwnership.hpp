@@ -0,0 +1,39 @@
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include <vulkan/vulkan.hpp>
+
+namespace MEngine
+{
+/**
+ * @brief 查找第一个具备 required 全部能力、且不具备 avoid 中任何能力的队列族
+ */
+std::optional<uint32_t> FindQueueFamily(const std::vector<vk::QueueFamilyProperties> &families,
+                                        vk::QueueFlags required, vk::QueueFlags avoid = {});
+
+/**
+ * @brief 跨队列族所有权转移的一对屏障
+ * release 录制在源队列族的命令缓冲区中，acquire 录制在目标队列族的命令缓冲区中，
+ * 两者的布局、子资源范围与族索引必须一致，且 acquire 所在提交需等待 release 所在提交完成。
+ * srcFamily == dstFamily 时不需要转移，调用方应直接使用普通屏障。
+ */
+struct ImageOwnershipTransfer
+{
+    vk::ImageMemoryBarrier release;
+    vk::ImageMemoryBarrier acquire;
+};
+struct BufferOwnershipTransfer
+{
+    vk::BufferMemoryBarrier release;
+    vk::BufferMemoryBarrier acquire;
+};
+
+ImageOwnershipTransfer MakeImageOwnershipTransfer(vk::Image image, const vk::ImageSubresourceRange &range,
+                                                  vk::ImageLayout oldLayout, vk::ImageLayout newLayout,
+                                                  vk::AccessFlags srcAccess, vk::AccessFlags dstAccess,
+                                                  uint32_t srcFamily, uint32_t dstFamily);
+BufferOwnershipTransfer MakeBufferOwnershipTransfer(vk::Buffer buffer, vk::DeviceSize offset, vk::DeviceSize size,
+                                                    vk::AccessFlags srcAccess, vk::AccessFlags dstAccess,
+                                                    uint32_t srcFamily, uint32_t dstFamily);
+} // namespace MEngine
@@ -0,0 +1,73 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+
+namespace MEngine
+{
+/**
+ * @brief 环形线性分配器，只管理偏移，不持有内存
+ * mHead/mTail 为单调递增的字节计数，取模后得到缓冲区内偏移。
+ * 分配在尾部放不下时跳过剩余空间回到 0，释放按分配顺序进行：Release(marker) 回收 marker 之前的全部空间。
+ */
+class RingAllocator final
+{
+  private:
+    uint64_t mCapacity;
+    uint64_t mHead = 0;
+    uint64_t mTail = 0;
+
+  public:
+    explicit RingAllocator(uint64_t capacity) : mCapacity(capacity)
+    {
+    }
+    /**
+     * @brief 分配 size 字节，返回缓冲区内偏移；空间不足时返回空
+     */
+    std::optional<uint64_t> Allocate(uint64_t size, uint64_t alignment = 1)
+    {
+        if (size == 0 || size > mCapacity)
+        {
+            return std::nullopt;
+        }
+        alignment = std::max<uint64_t>(alignment, 1);
+        uint64_t offset = mHead % mCapacity;
+        uint64_t aligned = (offset + alignment - 1) / alignment * alignment;
+        uint64_t newHead = mHead + (aligned - offset) + size;
+        if (aligned + size > mCapacity)
+        {
+            // 尾部剩余空间不够，整体跳到缓冲区开头
+            aligned = 0;
+            newHead = mHead + (mCapacity - offset) + size;
+        }
+        if (newHead - mTail > mCapacity)
+        {
+            return std::nullopt;
+        }
+        mHead = newHead;
+        return aligned;
+    }
+    /**
+     * @brief 当前分配位置，作为 Release 的标记
+     */
+    inline uint64_t GetHead() const
+    {
+        return mHead;
+    }
+    /**
+     * @brief 回收 marker 之前分配的全部空间
+     */
+    inline void Release(uint64_t marker)
+    {
+        mTail = std::max(mTail, std::min(marker, mHead));
+    }
+    inline uint64_t GetCapacity() const
+    {
+        return mCapacity;
+    }
+    inline uint64_t GetUsed() const
+    {
+        return mHead - mTail;
+    }
+};
+} // namespace MEngine
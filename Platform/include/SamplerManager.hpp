@@ -3,11 +3,40 @@
 #include "MEngine.hpp"
 #include "NoCopyable.hpp"
 
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <vulkan/vulkan.hpp>
 
 namespace MEngine
 {
-using UniqueSampler = vk::UniqueSampler;
+/**
+ * @brief 共享的采样器句柄，最后一个持有者释放时销毁 VkSampler
+ */
+using SharedSampler = std::shared_ptr<const vk::UniqueSampler>;
+
+/**
+ * @brief 按 SamplerCreateInfo 全部字段计算哈希，不支持 pNext 链
+ */
+struct SamplerCreateInfoHash
+{
+    size_t operator()(const vk::SamplerCreateInfo &info) const noexcept;
+};
+struct SamplerCacheStats
+{
+    uint64_t requests = 0;
+    uint64_t hits = 0;
+    // 当前仍被持有的采样器数量
+    size_t liveSamplers = 0;
+    inline double GetHitRate() const
+    {
+        return requests ? static_cast<double>(hits) / static_cast<double>(requests) : 0.0;
+    }
+};
+/**
+ * @brief 采样器缓存：参数完全相同的请求返回同一个 VkSampler
+ * 驱动限制采样器总数（maxSamplerAllocationCount，常见为 4000），而绝大多数纹理使用相同的参数。
+ */
 class SamplerManager final : public NoCopyable
 {
   private:
@@ -15,17 +44,36 @@ class SamplerManager final : public NoCopyable
     std::shared_ptr<ILogger> mLogger;
     std::shared_ptr<Context> mContext;
 
+  private:
+    std::mutex mMutex;
+    std::unordered_map<vk::SamplerCreateInfo, std::weak_ptr<const vk::UniqueSampler>, SamplerCreateInfoHash> mSamplers;
+    SamplerCacheStats mStats;
+
+  private:
+    size_t PurgeExpiredLocked();
+
   public:
     SamplerManager(std::shared_ptr<ILogger> logger, std::shared_ptr<Context> context);
-    UniqueSampler CreateUniqueSampler(vk::Filter magFilter = vk::Filter::eLinear,
-                                      vk::Filter minFilter = vk::Filter::eLinear,
-                                      vk::SamplerMipmapMode mipmapMode = vk::SamplerMipmapMode::eLinear,
-                                      vk::SamplerAddressMode addressMode = vk::SamplerAddressMode::eRepeat,
-                                      float mipLodBias = 0.0f, vk::Bool32 anisotropyEnable = vk::False,
-                                      float maxAnisotropy = 16.0f, vk::Bool32 compareEnable = vk::False,
-                                      vk::CompareOp compareOp = vk::CompareOp::eAlways, float minLod = 0.0f,
-                                      float maxLod = 0.0f,
-                                      vk::BorderColor borderColor = vk::BorderColor::eFloatOpaqueBlack,
-                                      vk::Bool32 unnormalizedCoordinates = vk::False);
+    /**
+     * @brief 查找或创建采样器，pNext 必须为空
+     */
+    SharedSampler GetSampler(const vk::SamplerCreateInfo &samplerCreateInfo);
+    SharedSampler GetSampler(vk::Filter magFilter = vk::Filter::eLinear, vk::Filter minFilter = vk::Filter::eLinear,
+                             vk::SamplerMipmapMode mipmapMode = vk::SamplerMipmapMode::eLinear,
+                             vk::SamplerAddressMode addressMode = vk::SamplerAddressMode::eRepeat,
+                             float mipLodBias = 0.0f, vk::Bool32 anisotropyEnable = vk::False,
+                             float maxAnisotropy = 16.0f, vk::Bool32 compareEnable = vk::False,
+                             vk::CompareOp compareOp = vk::CompareOp::eAlways, float minLod = 0.0f,
+                             float maxLod = 0.0f, vk::BorderColor borderColor = vk::BorderColor::eFloatOpaqueBlack,
+                             vk::Bool32 unnormalizedCoordinates = vk::False);
+    /**
+     * @brief 三线性过滤的纹理采样器，LOD 范围覆盖图像的全部 mip 级别
+     */
+    SharedSampler GetTextureSampler(uint32_t mipLevels,
+                                    vk::SamplerAddressMode addressMode = vk::SamplerAddressMode::eRepeat);
+    /**
+     * @brief 命中率与存活采样器数量，同时清理已释放的缓存项
+     */
+    SamplerCacheStats GetStats();
 };
-} // namespace MEngine
\ No newline at end of file
+} // namespace MEngine
@@ -18,5 +18,6 @@ class SyncPrimitiveManager final : public NoCopyable
     SyncPrimitiveManager(std::shared_ptr<ILogger> logger, std::shared_ptr<Context> context);
     vk::UniqueFence CreateFence(vk::FenceCreateFlags flags = {});
     vk::UniqueSemaphore CreateUniqueSemaphore();
+    vk::UniqueSemaphore CreateTimelineSemaphore(uint64_t initialValue = 0);
 };
 } // namespace MEngine
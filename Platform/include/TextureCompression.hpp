@@ -0,0 +1,33 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+namespace MEngine
+{
+/**
+ * @brief 块压缩格式，数值写入 .mtex 文件头，不可改动已有值
+ */
+enum class BlockCompression : uint32_t
+{
+    None = 0, // 未压缩 RGBA8
+    BC1 = 1,  // RGB 4bpp，不透明漫反射
+    BC5 = 2,  // RG 8bpp，切线空间法线（B 在着色器中重建）
+    BC7 = 3,  // RGBA 8bpp，高质量漫反射/带透明度
+};
+/**
+ * @brief 每个 4x4 块的字节数，None 时为单个纹素的字节数
+ */
+uint32_t GetBlockSize(BlockCompression compression);
+/**
+ * @brief width x height 图像压缩后的字节数，不足 4 的边按整块计算
+ */
+uint64_t GetCompressedSize(BlockCompression compression, uint32_t width, uint32_t height);
+/**
+ * @brief 将 RGBA8 图像编码为块压缩数据，块按行主序排列
+ * 边缘不足 4x4 的块用最后一行/列的像素补齐。
+ * BC1 与 BC7 使用主轴投影选取端点，BC5 使用每通道最小/最大值；
+ * 块内包围盒、BC1/BC7 的索引搜索与误差计算、BC5 各通道的级别量化在 SSE2 可用时向量化，每次处理 4 个像素。
+ */
+std::vector<uint8_t> CompressImage(BlockCompression compression, const uint8_t *rgba, uint32_t width,
+                                   uint32_t height);
+} // namespace MEngine
@@ -0,0 +1,76 @@
+#pragma once
+#include "TextureCompression.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace MEngine
+{
+/**
+ * @brief .mtex 烘焙纹理容器
+ * 布局：TextureContainerHeader | TextureContainerMip[mipLevels] | 各级 mip 数据
+ * 每级数据按 TextureContainerAlignment 对齐，内容与 GPU 拷贝布局一致（块按行主序紧密排列），可直接拷贝到暂存缓冲区。
+ * 所有字段按小端序存储。
+ */
+constexpr uint32_t TextureContainerMagic = 0x5845544D; // "MTEX"
+constexpr uint32_t TextureContainerVersion = 1;
+constexpr uint64_t TextureContainerAlignment = 16;
+
+enum TextureContainerFlags : uint32_t
+{
+    TextureContainerSrgb = 1u << 0,
+};
+struct TextureContainerHeader
+{
+    uint32_t magic = TextureContainerMagic;
+    uint32_t version = TextureContainerVersion;
+    BlockCompression compression = BlockCompression::None;
+    uint32_t flags = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t mipLevels = 0;
+    uint32_t reserved = 0;
+};
+struct TextureContainerMip
+{
+    uint64_t offset = 0; // 相对文件开头
+    uint64_t size = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+};
+static_assert(sizeof(TextureContainerHeader) == 32, "TextureContainerHeader layout is part of the file format");
+static_assert(sizeof(TextureContainerMip) == 24, "TextureContainerMip layout is part of the file format");
+
+/**
+ * @brief 指向容器字节的只读视图，data 的生命周期由调用方保证
+ */
+struct TextureContainerView
+{
+    TextureContainerHeader header;
+    const TextureContainerMip *mips = nullptr;
+    const uint8_t *data = nullptr;
+    uint64_t size = 0;
+    inline const uint8_t *GetMipData(uint32_t level) const
+    {
+        return data + mips[level].offset;
+    }
+};
+
+struct TextureCookOptions
+{
+    BlockCompression compression = BlockCompression::BC7;
+    // 颜色纹理为 sRGB，法线/粗糙度等数据纹理为线性
+    bool srgb = true;
+    bool generateMipmaps = true;
+};
+/**
+ * @brief 把 RGBA8 图像烘焙成完整的 .mtex 文件内容：生成 mip 链并逐级块压缩
+ */
+std::vector<uint8_t> CookTexture(const uint8_t *rgba, uint32_t width, uint32_t height,
+                                 const TextureCookOptions &options);
+/**
+ * @brief 校验并解析容器，文件头、mip 数量与尺寸、对齐或数据范围不合法时返回空
+ */
+std::optional<TextureContainerView> ParseTextureContainer(const uint8_t *data, uint64_t size);
+} // namespace MEngine
@@ -0,0 +1,178 @@
+#pragma once
+#include "Buffer.hpp"
+#include "Context.hpp"
+#include "Interface/IConfigure.hpp"
+#include "Interface/ILogger.hpp"
+#include "MEngine.hpp"
+#include "NoCopyable.hpp"
+#include "QueueOwnership.hpp"
+#include "RingAllocator.hpp"
+#include "SyncPrimitiveManager.hpp"
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+#include <vulkan/vulkan.hpp>
+
+namespace MEngine
+{
+/**
+ * @brief 上传凭据，即所属批次在时间线信号量上的值，信号量计数达到该值时上传完成
+ */
+using UploadTicket = uint64_t;
+
+/**
+ * @brief 图像上传描述，data 先按 mip 级别、再按层紧密排列，包含前 dataMipLevels 级
+ * generateMipmaps 为 true 时其余级别由上一级线性 blit 生成，否则只做布局转换
+ * 压缩格式以块为单位：texelSize 为每块字节数，blockWidth/blockHeight 为块的纹素尺寸
+ */
+struct ImageUploadInfo
+{
+    vk::Image image;
+    vk::Extent3D extent;
+    uint32_t texelSize = 4;
+    uint32_t blockWidth = 1;
+    uint32_t blockHeight = 1;
+    uint32_t mipLevels = 1;
+    uint32_t arrayLayers = 1;
+    uint32_t dataMipLevels = 1;
+    // blit 需要图形能力，只有 CanGenerateMipmaps() 为 true 时可用
+    bool generateMipmaps = false;
+    vk::ImageLayout finalLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+    vk::AccessFlags finalAccess = vk::AccessFlagBits::eShaderRead;
+    vk::PipelineStageFlags finalStage = vk::PipelineStageFlagBits::eFragmentShader;
+};
+
+/**
+ * @brief 单个 mip 级别的数据，包含该级别全部层，按块行紧密排列
+ */
+struct ImageMipData
+{
+    const void *data = nullptr;
+    vk::DeviceSize size = 0;
+};
+
+/**
+ * @brief 异步批量上传队列
+ * 数据先写入常驻映射的环形暂存缓冲区并排队，Flush 时合并到一个命令缓冲区提交到传输队列，
+ * 完成后发出时间线信号量，并按批次回收环形缓冲区空间。
+ * 超过单次上限的上传被切分成多段依次流过环形缓冲区，空间不足时等待最早的批次完成。
+ * 传输队列属于独立队列族时，拷贝结束后在传输队列释放所有权，图形队列在使用前通过 RecordOwnershipAcquire 获取。
+ */
+class UploadQueue final : public NoCopyable
+{
+  private:
+    // DI
+    std::shared_ptr<ILogger> mLogger;
+    std::shared_ptr<Context> mContext;
+    std::shared_ptr<SyncPrimitiveManager> mSyncPrimitiveManager;
+    std::shared_ptr<IConfigure> mConfigure;
+
+  private:
+    using RecordCommand = std::function<void(vk::CommandBuffer)>;
+    struct InFlightBatch
+    {
+        UploadTicket ticket;
+        vk::UniqueCommandBuffer commandBuffer;
+        // 批次完成后环形缓冲区可回收到的位置
+        uint64_t ringMarker;
+    };
+    struct AcquireBarriers
+    {
+        UploadTicket ticket = 0;
+        std::vector<vk::ImageMemoryBarrier> imageBarriers;
+        std::vector<vk::BufferMemoryBarrier> bufferBarriers;
+        vk::PipelineStageFlags dstStage;
+    };
+
+    std::mutex mMutex;
+    vk::UniqueCommandPool mCommandPool;
+    std::vector<vk::UniqueCommandBuffer> mFreeCommandBuffers;
+    vk::UniqueSemaphore mTimelineSemaphore;
+
+    UniqueBuffer mStagingBuffer;
+    uint8_t *mStagingData = nullptr;
+    RingAllocator mStagingRing{0};
+    // 单段上传的上限，保证环形缓冲区中至少能同时容纳两段
+    vk::DeviceSize mMaxChunkSize = 0;
+
+    // 非空时上传需要从传输队列族转移到图形队列族
+    std::optional<uint32_t> mSrcQueueFamily;
+    uint32_t mDstQueueFamily = 0;
+    // 正在收集的批次对应的获取屏障，提交后移入 mFlushedAcquires
+    AcquireBarriers mPendingAcquires;
+    std::deque<AcquireBarriers> mFlushedAcquires;
+
+    std::vector<RecordCommand> mPendingCommands;
+    vk::DeviceSize mPendingBytes = 0;
+    std::deque<InFlightBatch> mInFlightBatches;
+    // 最近一次提交的批次值，正在收集的批次值为 mSubmittedTicket + 1
+    UploadTicket mSubmittedTicket = 0;
+
+  private:
+    UploadTicket FlushLocked();
+    void CollectLocked();
+    /**
+     * @brief 在环形缓冲区中分配空间，不足时提交当前批次并等待最早的批次完成
+     */
+    vk::DeviceSize AllocateStagingLocked(vk::DeviceSize size, vk::DeviceSize alignment);
+
+  public:
+    UploadQueue(std::shared_ptr<ILogger> logger, std::shared_ptr<Context> context,
+                std::shared_ptr<SyncPrimitiveManager> syncPrimitiveManager, std::shared_ptr<IConfigure> configure);
+    ~UploadQueue();
+    /**
+     * @brief 排队一次缓冲区上传，data 在返回前已被复制，dst 需在上传完成前保持有效
+     */
+    UploadTicket EnqueueBufferUpload(const Buffer &dst, const void *data, vk::DeviceSize size,
+                                     vk::DeviceSize dstOffset = 0);
+    /**
+     * @brief 排队一次图像上传：Undefined -> TransferDst -> (blit mip) -> finalLayout，data 在返回前已被复制
+     */
+    UploadTicket EnqueueImageUpload(const ImageUploadInfo &info, const void *data, vk::DeviceSize size);
+    /**
+     * @brief 逐级给出数据的图像上传，各级数据可以不连续（例如直接指向内存映射文件），mips.size() 即已有数据的级数
+     */
+    UploadTicket EnqueueImageUpload(const ImageUploadInfo &info, const std::vector<ImageMipData> &mips);
+    /**
+     * @brief 第 level 级 mip 的上传字节数
+     */
+    static vk::DeviceSize GetMipUploadSize(const ImageUploadInfo &info, uint32_t level);
+    /**
+     * @brief 提交所有排队的拷贝，返回最近提交的 ticket（没有排队请求时返回上一次的值）
+     */
+    UploadTicket Flush();
+    bool IsComplete(UploadTicket ticket) const;
+    /**
+     * @brief 阻塞直到 ticket 完成，ticket 尚未提交时先提交
+     */
+    void Wait(UploadTicket ticket, uint64_t timeout = 1'000'000'000);
+    /**
+     * @brief 回收已完成批次的环形缓冲区空间与命令缓冲区
+     */
+    void Collect();
+    /**
+     * @brief 在图形队列的命令缓冲区中录制 ticket 及之前批次的所有权获取屏障，返回是否录制了内容
+     * 所在提交必须在 eAllCommands 阶段等待时间线信号量达到 ticket
+     */
+    bool RecordOwnershipAcquire(vk::CommandBuffer commandBuffer, UploadTicket ticket);
+    inline vk::Semaphore GetTimelineSemaphore() const
+    {
+        return mTimelineSemaphore.get();
+    }
+    /**
+     * @brief 上传队列与图形队列同族时才能在上传批次中录制 blit 生成 mip 链
+     */
+    inline bool CanGenerateMipmaps() const
+    {
+        return !mSrcQueueFamily.has_value();
+    }
+    inline vk::DeviceSize GetStagingCapacity() const
+    {
+        return mStagingRing.GetCapacity();
+    }
+};
+} // namespace MEngine
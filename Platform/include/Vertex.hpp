@@ -5,13 +5,49 @@
 #include <vulkan/vulkan.hpp>
 namespace MEngine
 {
+/**
+ * @brief 顶点缓冲区中的顶点布局，决定管线的顶点输入状态
+ */
+enum class VertexFormat : uint8_t
+{
+    Standard,  // Vertex，32 字节
+    Quantized, // QuantizedVertex，16 字节
+};
+constexpr size_t VertexFormatCount = 2;
+
 class Vertex
 {
   public:
     glm::vec3 position;
     glm::vec3 normal;
     glm::vec2 texCoords;
-    static std::array<vk::VertexInputAttributeDescription, 3> GetVertexInputAttributeDescription();
-    static vk::VertexInputBindingDescription GetVertexInputBindingDescription();
+    static std::array<vk::VertexInputAttributeDescription, 3> GetVertexInputAttributeDescription(
+        VertexFormat format = VertexFormat::Standard);
+    static vk::VertexInputBindingDescription GetVertexInputBindingDescription(
+        VertexFormat format = VertexFormat::Standard);
+    static uint32_t GetStride(VertexFormat format);
+    // 实例化绘制：binding 1 按实例步进，InstanceData 占用 location 3-6
+    static std::array<vk::VertexInputAttributeDescription, 4> GetInstanceInputAttributeDescription();
+    static vk::VertexInputBindingDescription GetInstanceInputBindingDescription();
+};
+/**
+ * @brief 压缩顶点，与 Vertex 使用相同的属性位置，着色器按格式自动解码为浮点数
+ * position：相对网格包围盒中心、按最大半长统一缩放的 snorm16，反量化矩阵并入模型矩阵，w 恒为 0
+ * normal：八面体映射后的 snorm16x2，由着色器解码
+ * texCoords：half float
+ */
+struct QuantizedVertex
+{
+    int16_t position[4];
+    int16_t normal[2];
+    uint16_t texCoords[2];
+};
+static_assert(sizeof(QuantizedVertex) == 16, "QuantizedVertex must stay 16 bytes");
+/**
+ * @brief 每个实例的数据，按帧写入实例缓冲区
+ */
+struct InstanceData
+{
+    glm::mat4 modelMatrix;
 };
 } // namespace MEngine
\ No newline at end of file
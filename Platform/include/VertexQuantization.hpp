@@ -0,0 +1,50 @@
+#pragma once
+#include "Vertex.hpp"
+#include "glm/glm.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace MEngine
+{
+/**
+ * @brief 网格的位置量化参数：position = center + snorm * scale
+ * 三个轴使用同一个缩放，反量化只是平移加均匀缩放，可以直接并入模型矩阵而不影响法线方向。
+ */
+struct VertexQuantization
+{
+    glm::vec3 center{0.0f};
+    float scale = 1.0f;
+    /**
+     * @brief 把 snorm 空间的位置变换回网格局部空间
+     */
+    glm::mat4 GetDequantizeMatrix() const;
+    /**
+     * @brief 单轴最大量化误差（四舍五入到最近的 snorm16）
+     */
+    inline float GetPositionTolerance() const
+    {
+        return scale / 32767.0f * 0.5f;
+    }
+};
+/**
+ * @brief 以包围盒中心为原点、最大半长为缩放
+ */
+VertexQuantization ComputeVertexQuantization(const Vertex *vertices, size_t count);
+/**
+ * @brief 批量编码，位置与纹理坐标在 SSE2/F16C 可用时向量化
+ */
+void QuantizeVertices(const Vertex *vertices, size_t count, const VertexQuantization &quantization,
+                      QuantizedVertex *output);
+Vertex DequantizeVertex(const QuantizedVertex &vertex, const VertexQuantization &quantization);
+
+/**
+ * @brief 单位向量的八面体映射，结果在 [-1, 1]^2
+ */
+glm::vec2 EncodeOctahedral(const glm::vec3 &normal);
+glm::vec3 DecodeOctahedral(const glm::vec2 &encoded);
+/**
+ * @brief IEEE 754 binary16，就近舍入，超出范围时饱和到最大有限值
+ */
+uint16_t FloatToHalf(float value);
+float HalfToFloat(uint16_t value);
+} // namespace MEngine
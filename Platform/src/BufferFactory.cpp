@@ -4,14 +4,14 @@ namespace MEngine
 {
 BufferFactory::BufferFactory(std::shared_ptr<ILogger> logger, std::shared_ptr<Context> context,
                              std::shared_ptr<CommandBufferManager> commandBufferManager,
-                             std::shared_ptr<SyncPrimitiveManager> syncPrimitiveManager)
+                             std::shared_ptr<SyncPrimitiveManager> syncPrimitiveManager,
+                             std::shared_ptr<UploadQueue> uploadQueue)
     : mContext(context), mLogger(logger), mCommandBufferManager(commandBufferManager),
-      mSyncPrimitiveManager(syncPrimitiveManager)
+      mSyncPrimitiveManager(syncPrimitiveManager), mUploadQueue(uploadQueue)
 {
-    mCommandBuffer = mCommandBufferManager->CreatePrimaryCommandBuffer(CommandBufferType::Transfer);
-    mFence = mSyncPrimitiveManager->CreateFence();
 }
-UniqueBuffer BufferFactory::CreateBuffer(BufferType type, vk::DeviceSize size, const void *data)
+UniqueBuffer BufferFactory::CreateBuffer(BufferType type, vk::DeviceSize size, const void *data,
+                                         UploadTicket *ticket)
 {
     VmaMemoryUsage memoryUsage{};
     vk::BufferUsageFlags bufferUsage{};
@@ -40,6 +40,21 @@ UniqueBuffer BufferFactory::CreateBuffer(BufferType type, vk::DeviceSize size, c
         memoryUsage = VMA_MEMORY_USAGE_GPU_ONLY;
         bufferUsage = vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eTransferDst;
         break;
+    case BufferType::Instance:
+        memoryUsage = VMA_MEMORY_USAGE_CPU_TO_GPU;
+        bufferUsage = vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eStorageBuffer;
+        createflags = VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT;
+        break;
+    case BufferType::Indirect:
+        memoryUsage = VMA_MEMORY_USAGE_CPU_TO_GPU;
+        bufferUsage = vk::BufferUsageFlagBits::eIndirectBuffer | vk::BufferUsageFlagBits::eStorageBuffer;
+        createflags = VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT;
+        break;
+    case BufferType::GPUInstance:
+        memoryUsage = VMA_MEMORY_USAGE_GPU_ONLY;
+        bufferUsage = vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eStorageBuffer |
+                      vk::BufferUsageFlagBits::eTransferDst;
+        break;
     default:
         mLogger->Error("Invalid buffer type");
         throw std::invalid_argument("Invalid buffer type");
@@ -47,51 +62,22 @@ UniqueBuffer BufferFactory::CreateBuffer(BufferType type, vk::DeviceSize size, c
     auto buffer = std::make_unique<Buffer>(mContext, size, bufferUsage, memoryUsage, createflags);
     if (data)
     {
-        if (type == BufferType::Staging)
+        if (type == BufferType::Uniform || type == BufferType::Staging || type == BufferType::Instance ||
+            type == BufferType::Indirect)
         {
             void *mapped = buffer->GetAllocationInfo().pMappedData;
             std::memcpy(mapped, data, size);
         }
         else
         {
-            memoryUsage = VMA_MEMORY_USAGE_CPU_TO_GPU;
-            bufferUsage = vk::BufferUsageFlagBits::eTransferSrc;
-            createflags = VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT;
-            auto staging = std::make_unique<Buffer>(mContext, size, bufferUsage, memoryUsage, createflags);
-            void *mapped = staging->GetAllocationInfo().pMappedData;
-            std::memcpy(mapped, data, size);
-            mContext->GetDevice().resetFences({mFence.get()});
-            CopyBuffer(staging.get(), buffer.get());
-            auto result = mContext->GetDevice().waitForFences(mFence.get(), vk::True, 1'000'000'000);
-            if (result != vk::Result::eSuccess)
+            // 不再逐个缓冲区同步等待：拷贝在 UploadQueue 中合批提交，使用方通过 ticket 或时间线信号量等待
+            auto uploadTicket = mUploadQueue->EnqueueBufferUpload(*buffer, data, size);
+            if (ticket)
             {
-                mLogger->Error("Copy buffer operation failed");
-                throw std::runtime_error("Copy buffer operation failed");
+                *ticket = uploadTicket;
             }
         }
     }
     return buffer;
 }
-void BufferFactory::CopyBuffer(Buffer *src, Buffer *dst)
-{
-    mCommandBuffer->reset();
-    vk::CommandBufferBeginInfo beginInfo{};
-    beginInfo.setFlags(vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
-    mCommandBuffer->begin(beginInfo);
-    {
-        vk::BufferCopy copyRegion{};
-        copyRegion.setSize(src->GetSize()).setDstOffset(0).setSrcOffset(0);
-        mCommandBuffer->copyBuffer(src->GetHandle(), dst->GetHandle(), copyRegion);
-    }
-    mCommandBuffer->end();
-    vk::SubmitInfo submitInfo{};
-    submitInfo.setCommandBuffers(mCommandBuffer.get());
-    mContext->SubmitToTransferQueue({submitInfo}, mFence.get());
-    auto result = mContext->GetDevice().waitForFences(mFence.get(), vk::True, 1'000'000'000);
-    if (result != vk::Result::eSuccess)
-    {
-        mLogger->Error("Copy buffer operation failed");
-        throw std::runtime_error("Copy buffer operation failed");
-    }
-}
 } // namespace MEngine
\ No newline at end of file
@@ -8,15 +8,19 @@ CommandBufferManager::CommandBufferManager(std::shared_ptr<ILogger> logger, std:
     auto graphicQueueFamilyIndex = mContext->GetQueueFamilyIndicates().graphicsFamily.value();
     auto transferQueueFamilyIndex = mContext->GetQueueFamilyIndicates().transferFamily.value();
     auto presentQueueFamilyIndex = mContext->GetQueueFamilyIndicates().presentFamily.value();
+    auto computeQueueFamilyIndex = mContext->GetQueueFamilyIndicates().computeFamily.value();
     vk::CommandPoolCreateInfo graphicCommandPoolCreateInfo{};
     vk::CommandPoolCreateInfo transferCommandPoolCreateInfo{};
     vk::CommandPoolCreateInfo presentCommandPoolCreateInfo{};
+    vk::CommandPoolCreateInfo computeCommandPoolCreateInfo{};
     graphicCommandPoolCreateInfo.setQueueFamilyIndex(graphicQueueFamilyIndex)
         .setFlags(vk::CommandPoolCreateFlagBits::eResetCommandBuffer);
     transferCommandPoolCreateInfo.setQueueFamilyIndex(transferQueueFamilyIndex)
         .setFlags(vk::CommandPoolCreateFlagBits::eResetCommandBuffer);
     presentCommandPoolCreateInfo.setQueueFamilyIndex(presentQueueFamilyIndex)
         .setFlags(vk::CommandPoolCreateFlagBits::eResetCommandBuffer);
+    computeCommandPoolCreateInfo.setQueueFamilyIndex(computeQueueFamilyIndex)
+        .setFlags(vk::CommandPoolCreateFlagBits::eResetCommandBuffer);
     // Create Command Pool
     mCommandPools[CommandBufferType::Graphic] =
         mContext->GetDevice().createCommandPoolUnique(graphicCommandPoolCreateInfo);
@@ -24,6 +28,8 @@ CommandBufferManager::CommandBufferManager(std::shared_ptr<ILogger> logger, std:
         mContext->GetDevice().createCommandPoolUnique(transferCommandPoolCreateInfo);
     mCommandPools[CommandBufferType::Present] =
         mContext->GetDevice().createCommandPoolUnique(presentCommandPoolCreateInfo);
+    mCommandPools[CommandBufferType::Compute] =
+        mContext->GetDevice().createCommandPoolUnique(computeCommandPoolCreateInfo);
 }
 
 vk::UniqueCommandBuffer CommandBufferManager::CreatePrimaryCommandBuffer(CommandBufferType type)
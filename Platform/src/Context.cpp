@@ -1,4 +1,8 @@
 #include "Context.hpp"
+#include "QueueOwnership.hpp"
+#include <algorithm>
+#include <cstring>
+#include <map>
 
 namespace MEngine
 {
@@ -10,12 +14,31 @@ Context::~Context()
 }
 Context::Context(std::shared_ptr<ILogger> logger, std::shared_ptr<IWindow> window) : mLogger(logger), mWindow(window)
 {
-    std::vector<const char *> instanceRequiredExtensions = mWindow->GetInstanceRequiredExtensions();
+    std::vector<const char *> instanceRequiredExtensions;
     std::vector<const char *> instanceRequiredLayers{"VK_LAYER_KHRONOS_validation",
                                                      "VK_LAYER_KHRONOS_synchronization2"};
     std::vector<const char *> deviceRequiredExtension;
     std::vector<const char *> deviceRequiredLayers;
-    deviceRequiredExtension.push_back("VK_KHR_swapchain");
+    if (mWindow)
+    {
+        instanceRequiredExtensions = mWindow->GetInstanceRequiredExtensions();
+        deviceRequiredExtension.push_back("VK_KHR_swapchain");
+    }
+    else
+    {
+        // 无窗口（测试、离线工具）：只启用实际存在的层，有验证层时同时启用调试回调扩展
+        auto availableLayers = vk::enumerateInstanceLayerProperties();
+        auto isAvailable = [&availableLayers](const char *name) {
+            return std::any_of(availableLayers.begin(), availableLayers.end(),
+                               [name](const vk::LayerProperties &layer) { return std::strcmp(layer.layerName, name) == 0; });
+        };
+        std::erase_if(instanceRequiredLayers, [&isAvailable](const char *name) { return !isAvailable(name); });
+        bool validation = isAvailable("VK_LAYER_KHRONOS_validation");
+        if (validation)
+        {
+            instanceRequiredExtensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+        }
+    }
 #ifdef PLATFORM_MACOS
     instanceRequiredExtensions.push_back("VK_KHR_portability_enumeration");
     deviceRequiredExtension.push_back("VK_KHR_portability_subset");
@@ -28,8 +51,11 @@ Context::Context(std::shared_ptr<ILogger> logger, std::shared_ptr<IWindow> windo
     CreateInstance();
     PickPhysicalDevice();
 
-    CreateSurface();
-    QuerySurfaceInfo();
+    if (mWindow)
+    {
+        CreateSurface();
+        QuerySurfaceInfo();
+    }
 
     QueryQueueFamilyIndicates();
     CreateDevice();
@@ -37,9 +63,12 @@ Context::Context(std::shared_ptr<ILogger> logger, std::shared_ptr<IWindow> windo
     GetQueues();
     CreateVmaAllocator();
 
-    CreateSwapchain();
-    CreateSwapchainImages();
-    CreateSwapchainImageViews();
+    if (mWindow)
+    {
+        CreateSwapchain();
+        CreateSwapchainImages();
+        CreateSwapchainImageViews();
+    }
 
     mLogger->Debug("Context Created");
 }
@@ -307,23 +336,66 @@ void Context::CreateDevice()
 
     std::vector<vk::DeviceQueueCreateInfo> queueCreateInfos;
 
-    std::set<uint32_t> uniqueQueueFamilies = {mQueueFamilyIndicates.graphicsFamily.value(),
-                                              mQueueFamilyIndicates.presentFamily.value(),
-                                              mQueueFamilyIndicates.transferFamily.value()};
-    const float queuePriority = 1.0f;
-
-    for (uint32_t queueFamily : uniqueQueueFamilies)
+    // 同一族内为图形、传输、计算各分配一个独立队列，使上传与计算可以和渲染并行；队列不足时共用最后一个
+    auto queueFamilyProperties = mPhysicalDevice.getQueueFamilyProperties();
+    std::map<uint32_t, uint32_t> familyQueueCounts;
+    auto assignQueue = [&](uint32_t family) {
+        uint32_t available = queueFamilyProperties[family].queueCount;
+        uint32_t &used = familyQueueCounts[family];
+        uint32_t index = std::min(used, available - 1);
+        used = std::min(used + 1, available);
+        return index;
+    };
+    mGraphicQueueIndex = assignQueue(mQueueFamilyIndicates.graphicsFamily.value());
+    mTransferQueueIndex = assignQueue(mQueueFamilyIndicates.transferFamily.value());
+    mComputeQueueIndex = assignQueue(mQueueFamilyIndicates.computeFamily.value());
+    mPresentQueueIndex = mQueueFamilyIndicates.presentFamily == mQueueFamilyIndicates.graphicsFamily
+                             ? mGraphicQueueIndex
+                             : assignQueue(mQueueFamilyIndicates.presentFamily.value());
+    uint32_t maxQueueCount = 1;
+    for (auto [family, count] : familyQueueCounts)
+    {
+        maxQueueCount = std::max(maxQueueCount, count);
+    }
+    const std::vector<float> queuePriorities(maxQueueCount, 1.0f);
+    for (auto [family, count] : familyQueueCounts)
     {
         vk::DeviceQueueCreateInfo queueCreateInfo;
-        queueCreateInfo.setQueueFamilyIndex(queueFamily).setQueueCount(1).setPQueuePriorities(&queuePriority);
+        queueCreateInfo.setQueueFamilyIndex(family).setQueueCount(count).setPQueuePriorities(queuePriorities.data());
         queueCreateInfos.push_back(queueCreateInfo);
     }
 
+    // 可选特性：GPU 驱动渲染需要 drawIndirectFirstInstance，drawIndirectCount 不支持时退化为 drawIndexedIndirect，
+    // multiDrawIndirect 不支持时每次间接绘制只执行一条命令
+    vk::PhysicalDeviceFeatures enabledFeatures{};
+    enabledFeatures.setDrawIndirectFirstInstance(mPhysicalDevice.getFeatures().drawIndirectFirstInstance);
+    mEnabledFeatures.drawIndirectFirstInstance = enabledFeatures.drawIndirectFirstInstance;
+    enabledFeatures.setMultiDrawIndirect(mPhysicalDevice.getFeatures().multiDrawIndirect);
+    mEnabledFeatures.multiDrawIndirect = enabledFeatures.multiDrawIndirect;
+    // 烘焙纹理使用 BC 格式，不支持时 ImageFactory::IsFormatSampleable 对 BC 格式返回 false
+    enabledFeatures.setTextureCompressionBC(mPhysicalDevice.getFeatures().textureCompressionBC);
+    mEnabledFeatures.textureCompressionBC = enabledFeatures.textureCompressionBC;
+    vk::PhysicalDeviceVulkan12Features vulkan12Features{};
+    uint32_t apiVersion = std::min(mInstanceVersion, mPhysicalDevice.getProperties().apiVersion);
+    if (apiVersion >= VK_API_VERSION_1_2)
+    {
+        auto features = mPhysicalDevice.getFeatures2<vk::PhysicalDeviceFeatures2, vk::PhysicalDeviceVulkan12Features>();
+        const auto &supported12 = features.get<vk::PhysicalDeviceVulkan12Features>();
+        vulkan12Features.setDrawIndirectCount(supported12.drawIndirectCount)
+            .setTimelineSemaphore(supported12.timelineSemaphore);
+        mEnabledFeatures.drawIndirectCount = vulkan12Features.drawIndirectCount;
+        mEnabledFeatures.timelineSemaphore = vulkan12Features.timelineSemaphore;
+    }
+
     vk::DeviceCreateInfo deviceCreateInfo;
     deviceCreateInfo.setQueueCreateInfos(queueCreateInfos)
         .setPEnabledExtensionNames(mConfig.deviceRequiredExtensions)
         .setPEnabledLayerNames(mConfig.deviceRequiredLayers)
-        .setPEnabledFeatures(nullptr);
+        .setPEnabledFeatures(&enabledFeatures);
+    if (apiVersion >= VK_API_VERSION_1_2)
+    {
+        deviceCreateInfo.setPNext(&vulkan12Features);
+    }
 
     mDevice = mPhysicalDevice.createDeviceUnique(deviceCreateInfo);
     if (!mDevice)
@@ -340,6 +412,11 @@ void Context::CreateDevice()
     {
         mLogger->Trace("Device enabled extension: {}", extension);
     }
+    mLogger->Trace("Device feature drawIndirectFirstInstance: {}", mEnabledFeatures.drawIndirectFirstInstance);
+    mLogger->Trace("Device feature multiDrawIndirect: {}", mEnabledFeatures.multiDrawIndirect);
+    mLogger->Trace("Device feature drawIndirectCount: {}", mEnabledFeatures.drawIndirectCount);
+    mLogger->Trace("Device feature timelineSemaphore: {}", mEnabledFeatures.timelineSemaphore);
+    mLogger->Trace("Device feature textureCompressionBC: {}", mEnabledFeatures.textureCompressionBC);
     mLogger->Debug("Device Created");
 }
 void Context::SetPresentQueueFamilyIndex(vk::SurfaceKHR surface)
@@ -363,41 +440,83 @@ void Context::QueryQueueFamilyIndicates()
     for (size_t i = 0; i < queueFamilyProperties.size(); i++)
     {
         auto &queueFamily = queueFamilyProperties[i];
-        auto queueCount = queueFamily.queueCount;
-        if (queueFamily.queueFlags & vk::QueueFlagBits::eGraphics)
-        {
-            mQueueFamilyIndicates.graphicsFamily = static_cast<uint32_t>(i);
-            mQueueFamilyIndicates.graphicsFamilyCount = queueCount;
-            mLogger->Trace("Queue Family Index: {} Supports Graphics. Supports Queue Index:0~{}", i, queueCount - 1);
-        }
-        if (mPhysicalDevice.getSurfaceSupportKHR(i, mSurface.get()))
-        {
-            mQueueFamilyIndicates.presentFamily = static_cast<uint32_t>(i);
-            mLogger->Trace("Queue Family Index: {} Supports Presentation. Supports Queue Index:0~{}", i,
-                           queueCount - 1);
-        }
-        if (queueFamily.queueFlags & vk::QueueFlagBits::eTransfer)
-        {
-            mQueueFamilyIndicates.transferFamily = static_cast<uint32_t>(i);
-            mQueueFamilyIndicates.transferFamilyCount = queueCount;
-            mLogger->Trace("Queue Family Index: {} Supports Transfer. Supports Queue Index:0~{}", i, queueCount - 1);
-        }
-        if (mQueueFamilyIndicates.graphicsFamily.has_value() && mQueueFamilyIndicates.transferFamily.has_value())
+        mLogger->Trace("Queue Family Index: {} Flags: {} Supports Queue Index:0~{}", i,
+                       vk::to_string(queueFamily.queueFlags), queueFamily.queueCount - 1);
+    }
+    auto graphicsFamily = FindQueueFamily(queueFamilyProperties, vk::QueueFlagBits::eGraphics);
+    if (!graphicsFamily)
+    {
+        mLogger->Error("No queue family supports graphics");
+        throw std::runtime_error("No queue family supports graphics");
+    }
+    // 传输：优先只有传输能力的族（通常对应独立的 DMA 引擎），其次不含图形能力的族，最后退回图形族
+    auto transferFamily = FindQueueFamily(queueFamilyProperties, vk::QueueFlagBits::eTransfer,
+                                          vk::QueueFlagBits::eGraphics | vk::QueueFlagBits::eCompute);
+    if (!transferFamily)
+    {
+        transferFamily = FindQueueFamily(queueFamilyProperties, vk::QueueFlagBits::eTransfer,
+                                         vk::QueueFlagBits::eGraphics);
+    }
+    // 异步计算：优先不含图形能力的计算族
+    auto computeFamily =
+        FindQueueFamily(queueFamilyProperties, vk::QueueFlagBits::eCompute, vk::QueueFlagBits::eGraphics);
+
+    mQueueFamilyIndicates.graphicsFamily = graphicsFamily.value();
+    mQueueFamilyIndicates.transferFamily = transferFamily.value_or(graphicsFamily.value());
+    mQueueFamilyIndicates.computeFamily = computeFamily.value_or(graphicsFamily.value());
+    mQueueFamilyIndicates.graphicsFamilyCount = queueFamilyProperties[*mQueueFamilyIndicates.graphicsFamily].queueCount;
+    mQueueFamilyIndicates.transferFamilyCount = queueFamilyProperties[*mQueueFamilyIndicates.transferFamily].queueCount;
+    mQueueFamilyIndicates.computeFamilyCount = queueFamilyProperties[*mQueueFamilyIndicates.computeFamily].queueCount;
+    // 呈现：优先与图形共用同一族，无窗口时直接使用图形族
+    if (!mSurface || mPhysicalDevice.getSurfaceSupportKHR(graphicsFamily.value(), mSurface.get()))
+    {
+        mQueueFamilyIndicates.presentFamily = graphicsFamily.value();
+    }
+    else
+    {
+        for (uint32_t i = 0; i < queueFamilyProperties.size(); i++)
         {
-            break;
+            if (mPhysicalDevice.getSurfaceSupportKHR(i, mSurface.get()))
+            {
+                mQueueFamilyIndicates.presentFamily = i;
+                break;
+            }
         }
     }
+    if (mQueueFamilyIndicates.presentFamily)
+    {
+        mQueueFamilyIndicates.presentFamilyCount =
+            queueFamilyProperties[*mQueueFamilyIndicates.presentFamily].queueCount;
+    }
+    mLogger->Debug("Queue families: graphics {}, present {}, transfer {}, compute {}",
+                   mQueueFamilyIndicates.graphicsFamily.value(), mQueueFamilyIndicates.presentFamily.value_or(~0u),
+                   mQueueFamilyIndicates.transferFamily.value(), mQueueFamilyIndicates.computeFamily.value());
 }
 void Context::GetQueues()
 {
-    uint32_t graphicQueueIndex = 0;
-    uint32_t presentQueueIndex = 0;
-    uint32_t transferQueueIndex = 0;
-    mGraphicQueue = mDevice->getQueue(mQueueFamilyIndicates.graphicsFamily.value(), graphicQueueIndex);
-    mPresentQueue = mDevice->getQueue(mQueueFamilyIndicates.presentFamily.value(), presentQueueIndex);
-    mTransferQueue = mDevice->getQueue(mQueueFamilyIndicates.transferFamily.value(), transferQueueIndex);
+    mGraphicQueue = mDevice->getQueue(mQueueFamilyIndicates.graphicsFamily.value(), mGraphicQueueIndex);
+    mPresentQueue = mDevice->getQueue(mQueueFamilyIndicates.presentFamily.value(), mPresentQueueIndex);
+    mTransferQueue = mDevice->getQueue(mQueueFamilyIndicates.transferFamily.value(), mTransferQueueIndex);
+    mComputeQueue = mDevice->getQueue(mQueueFamilyIndicates.computeFamily.value(), mComputeQueueIndex);
     mLogger->Debug("Queues Getted");
 }
+std::mutex &Context::GetQueueMutex(vk::Queue queue)
+{
+    // 多个用途可能共用同一个 VkQueue，此时必须使用同一把锁
+    if (queue == mGraphicQueue)
+    {
+        return mGraphicQueueMutex;
+    }
+    if (queue == mPresentQueue)
+    {
+        return mPresentQueueMutex;
+    }
+    if (queue == mTransferQueue)
+    {
+        return mTransferQueueMutex;
+    }
+    return mComputeQueueMutex;
+}
 
 /*
 https://www.reddit.com/r/vulkan/comments/umgs26/synchronize_queue_submission/?rdt=37374
@@ -415,12 +534,12 @@ size).
 */
 void Context::SubmitToGraphicQueue(std::vector<vk::SubmitInfo> submits, vk::Fence fence)
 {
-    std::lock_guard<std::mutex> lock(mGraphicQueueMutex);
+    std::lock_guard<std::mutex> lock(GetQueueMutex(mGraphicQueue));
     mGraphicQueue.submit(submits, fence);
 }
 void Context::SubmitToPresnetQueue(vk::PresentInfoKHR presentInfo)
 {
-    std::lock_guard<std::mutex> lock(mPresentQueueMutex);
+    std::lock_guard<std::mutex> lock(GetQueueMutex(mPresentQueue));
     auto result = mPresentQueue.presentKHR(presentInfo);
     if (result != vk::Result::eSuccess)
     {
@@ -430,9 +549,14 @@ void Context::SubmitToPresnetQueue(vk::PresentInfoKHR presentInfo)
 }
 void Context::SubmitToTransferQueue(std::vector<vk::SubmitInfo> submits, vk::Fence fence)
 {
-    std::lock_guard<std::mutex> lock(mTransferQueueMutex);
+    std::lock_guard<std::mutex> lock(GetQueueMutex(mTransferQueue));
     mTransferQueue.submit(submits, fence);
 }
+void Context::SubmitToComputeQueue(std::vector<vk::SubmitInfo> submits, vk::Fence fence)
+{
+    std::lock_guard<std::mutex> lock(GetQueueMutex(mComputeQueue));
+    mComputeQueue.submit(submits, fence);
+}
 void Context::CreateVmaAllocator()
 {
     // VmaVulkanFunctions vulkanFunctions = {};
@@ -110,6 +110,30 @@ void DescriptorManager::UpdateUniformDescriptorSet(const std::vector<std::refere
     mContext->GetDevice().updateDescriptorSets({writer}, {});
 }
 
+void DescriptorManager::UpdateStorageDescriptorSet(const std::vector<std::reference_wrapper<Buffer>> &storageBuffers,
+                                                   uint32_t binding, vk::DescriptorSet dstSet)
+{
+    std::vector<vk::DescriptorBufferInfo> descriptorBufferInfos;
+    descriptorBufferInfos.reserve(storageBuffers.size());
+    for (auto &storageBuffer : storageBuffers)
+    {
+        vk::DescriptorBufferInfo descriptorBufferInfo;
+        descriptorBufferInfo.setBuffer(storageBuffer.get().GetHandle())
+            .setOffset(0)
+            .setRange(storageBuffer.get().GetSize());
+        descriptorBufferInfos.push_back(descriptorBufferInfo);
+    }
+
+    vk::WriteDescriptorSet writer;
+    writer.setBufferInfo(descriptorBufferInfos)
+        .setDescriptorType(vk::DescriptorType::eStorageBuffer)
+        .setDescriptorCount(storageBuffers.size())
+        .setDstArrayElement(0)
+        .setDstBinding(binding)
+        .setDstSet(dstSet);
+    mContext->GetDevice().updateDescriptorSets({writer}, {});
+}
+
 void DescriptorManager::UpdateCombinedSamplerImageDescriptorSet(std::vector<ImageDescriptor> imageDescriptors,
                                                                 uint32_t binding, vk::DescriptorSet dstSet)
 {
@@ -0,0 +1,161 @@
+#include "GeometryArena.hpp"
+#include "magic_enum/magic_enum.hpp"
+#include <algorithm>
+
+namespace MEngine
+{
+GeometryArena::GeometryArena(std::shared_ptr<ILogger> logger, std::shared_ptr<Context> context,
+                             std::shared_ptr<IConfigure> configure, std::shared_ptr<UploadQueue> uploadQueue)
+    : mLogger(logger), mContext(context), mConfigure(configure), mUploadQueue(uploadQueue)
+{
+    auto &setting = mConfigure->GetJson()["GeometrySetting"];
+    auto vertexPageSizeMB = std::max(setting["VertexPageSizeMB"].get<uint32_t>(), 1u);
+    auto indexPageSizeMB = std::max(setting["IndexPageSizeMB"].get<uint32_t>(), 1u);
+    mVertexPageSize = static_cast<vk::DeviceSize>(vertexPageSizeMB) * 1024 * 1024;
+    mIndexPageCapacity = static_cast<uint64_t>(indexPageSizeMB) * 1024 * 1024 / sizeof(uint32_t);
+    if (setting.value("QuantizeVertices", false))
+    {
+        mPreferredVertexFormat = VertexFormat::Quantized;
+    }
+    mLogger->Debug("GeometryArena Created, page size {} MB vertices / {} MB indices", vertexPageSizeMB,
+                   indexPageSizeMB);
+}
+GeometryArena::Page &GeometryArena::CreatePageLocked(VertexFormat format, uint64_t vertexCount, uint64_t indexCount)
+{
+    // 超过默认页大小的网格单独占用一页
+    uint32_t stride = Vertex::GetStride(format);
+    uint64_t vertexCapacity = std::max(mVertexPageSize / stride, vertexCount);
+    uint64_t indexCapacity = std::max(mIndexPageCapacity, indexCount);
+    // TransferSrc 为以后整理碎片时在页之间搬移数据预留
+    auto usage = vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eTransferSrc |
+                 vk::BufferUsageFlagBits::eStorageBuffer;
+    Page page{
+        format,
+        std::make_unique<Buffer>(mContext, vertexCapacity * stride,
+                                 usage | vk::BufferUsageFlagBits::eVertexBuffer, VMA_MEMORY_USAGE_GPU_ONLY),
+        std::make_unique<Buffer>(mContext, indexCapacity * sizeof(uint32_t),
+                                 usage | vk::BufferUsageFlagBits::eIndexBuffer, VMA_MEMORY_USAGE_GPU_ONLY),
+        FreeListAllocator(vertexCapacity), FreeListAllocator(indexCapacity)};
+    mPages.push_back(std::move(page));
+    mLogger->Debug("GeometryArena page {} created, {} {} vertices / {} indices", mPages.size() - 1, vertexCapacity,
+                   magic_enum::enum_name(format), indexCapacity);
+    return mPages.back();
+}
+GeometryAllocation GeometryArena::Allocate(VertexFormat format, const void *vertices, uint32_t vertexCount,
+                                           const uint32_t *indices, uint32_t indexCount, UploadTicket *ticket)
+{
+    if (vertexCount == 0 || indexCount == 0)
+    {
+        mLogger->Error("GeometryArena allocation requires vertices and indices");
+        throw std::invalid_argument("GeometryArena allocation requires vertices and indices");
+    }
+    GeometryAllocation allocation{};
+    allocation.format = format;
+    allocation.vertexCount = vertexCount;
+    allocation.indexCount = indexCount;
+    Buffer *vertexBuffer = nullptr;
+    Buffer *indexBuffer = nullptr;
+    {
+        Page *page = nullptr;
+        std::lock_guard<std::mutex> lock(mMutex);
+        // 首次适配：优先填满靠前的页，减少绘制时的缓冲区切换
+        for (uint32_t i = 0; i < mPages.size() && !page; i++)
+        {
+            auto &candidate = mPages[i];
+            if (candidate.format != format)
+            {
+                continue;
+            }
+            auto vertexOffset = candidate.vertexAllocator.Allocate(vertexCount);
+            if (!vertexOffset)
+            {
+                continue;
+            }
+            auto firstIndex = candidate.indexAllocator.Allocate(indexCount);
+            if (!firstIndex)
+            {
+                candidate.vertexAllocator.Free(*vertexOffset, vertexCount);
+                continue;
+            }
+            allocation.page = i;
+            allocation.vertexOffset = static_cast<uint32_t>(*vertexOffset);
+            allocation.firstIndex = static_cast<uint32_t>(*firstIndex);
+            page = &candidate;
+        }
+        if (!page)
+        {
+            page = &CreatePageLocked(format, vertexCount, indexCount);
+            allocation.page = static_cast<uint32_t>(mPages.size() - 1);
+            allocation.vertexOffset = static_cast<uint32_t>(page->vertexAllocator.Allocate(vertexCount).value());
+            allocation.firstIndex = static_cast<uint32_t>(page->indexAllocator.Allocate(indexCount).value());
+        }
+        mAllocationCount++;
+        vertexBuffer = page->vertexBuffer.get();
+        indexBuffer = page->indexBuffer.get();
+    }
+    // 页只增不删，mPages 扩容只移动 unique_ptr，缓冲区对象本身保持有效
+    vk::DeviceSize stride = Vertex::GetStride(format);
+    mUploadQueue->EnqueueBufferUpload(*vertexBuffer, vertices, stride * vertexCount, stride * allocation.vertexOffset);
+    auto uploadTicket = mUploadQueue->EnqueueBufferUpload(*indexBuffer, indices, sizeof(uint32_t) * indexCount,
+                                                          sizeof(uint32_t) * allocation.firstIndex);
+    if (ticket)
+    {
+        *ticket = uploadTicket;
+    }
+    return allocation;
+}
+void GeometryArena::ReleaseLocked(const GeometryAllocation &allocation)
+{
+    auto &page = mPages[allocation.page];
+    page.vertexAllocator.Free(allocation.vertexOffset, allocation.vertexCount);
+    page.indexAllocator.Free(allocation.firstIndex, allocation.indexCount);
+    mAllocationCount--;
+}
+void GeometryArena::Free(const GeometryAllocation &allocation)
+{
+    if (allocation.vertexCount == 0)
+    {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mMutex);
+    mRetiredAllocations.push_back({allocation, mFrame});
+}
+void GeometryArena::NextFrame(uint32_t framesInFlight)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mFrame++;
+    // 释放后录制的帧不再引用该区间，之前最多 framesInFlight 帧仍可能在 GPU 上执行；
+    // 多留一帧，保证新数据的上传不会早于这些帧的 fence 等待
+    while (!mRetiredAllocations.empty() && mRetiredAllocations.front().frame + framesInFlight + 1 <= mFrame)
+    {
+        ReleaseLocked(mRetiredAllocations.front().allocation);
+        mRetiredAllocations.pop_front();
+    }
+}
+vk::Buffer GeometryArena::GetVertexBuffer(uint32_t page)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mPages.at(page).vertexBuffer->GetHandle();
+}
+vk::Buffer GeometryArena::GetIndexBuffer(uint32_t page)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mPages.at(page).indexBuffer->GetHandle();
+}
+GeometryArenaStats GeometryArena::GetStats()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    GeometryArenaStats stats{};
+    stats.pages = static_cast<uint32_t>(mPages.size());
+    stats.allocations = mAllocationCount;
+    for (const auto &page : mPages)
+    {
+        stats.vertexCapacity += page.vertexAllocator.GetCapacity();
+        stats.vertexUsed += page.vertexAllocator.GetUsed();
+        stats.indexCapacity += page.indexAllocator.GetCapacity();
+        stats.indexUsed += page.indexAllocator.GetUsed();
+        stats.freeBlocks += page.vertexAllocator.GetFreeBlockCount() + page.indexAllocator.GetFreeBlockCount();
+    }
+    return stats;
+}
+} // namespace MEngine
@@ -38,7 +38,8 @@ Image::Image(Image &&other) noexcept
       mExtent(std::exchange(other.mExtent, {})), mUsageFlags(std::exchange(other.mUsageFlags, {})),
       mImageType(std::exchange(other.mImageType, {})), mTiling(std::exchange(other.mTiling, {})),
       mSamples(std::exchange(other.mSamples, {})), mMipLevels(std::exchange(other.mMipLevels, {})),
-      mArrayLayers(std::exchange(other.mArrayLayers, {})), mContext(std::exchange(other.mContext, nullptr))
+      mArrayLayers(std::exchange(other.mArrayLayers, {})), mContext(std::exchange(other.mContext, nullptr)),
+      mUploadTicket(std::exchange(other.mUploadTicket, 0))
 {
 }
 
@@ -59,6 +60,7 @@ Image &Image::operator=(Image &&other) noexcept
         mSamples = std::exchange(other.mSamples, {});
         mMipLevels = std::exchange(other.mMipLevels, {});
         mArrayLayers = std::exchange(other.mArrayLayers, {});
+        mUploadTicket = std::exchange(other.mUploadTicket, 0);
     }
     return *this;
 }
@@ -112,6 +114,10 @@ vk::ImageLayout Image::GetCurrentLayout() const
 {
     return mCurrentLayout;
 }
+uint64_t Image::GetUploadTicket() const
+{
+    return mUploadTicket;
+}
 void Image::Release()
 {
     vmaDestroyImage(mContext->GetVmaAllocator(), mImage, mAllocation);
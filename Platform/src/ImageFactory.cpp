@@ -1,22 +1,15 @@
 #include "ImageFactory.hpp"
+#include "Mipmap.hpp"
 
 namespace MEngine
 {
 ImageFactory::ImageFactory(std::shared_ptr<ILogger> logger, std::shared_ptr<Context> context,
                            std::shared_ptr<CommandBufferManager> commandBufferManager,
                            std::shared_ptr<SyncPrimitiveManager> syncPrimitiveManager,
-                           std::shared_ptr<BufferFactory> bufferFactory)
+                           std::shared_ptr<BufferFactory> bufferFactory, std::shared_ptr<UploadQueue> uploadQueue)
     : mContext(context), mLogger(logger), mCommandBufferManager(commandBufferManager),
-      mSyncPrimitiveManager(syncPrimitiveManager), mBufferFactory(bufferFactory)
+      mSyncPrimitiveManager(syncPrimitiveManager), mBufferFactory(bufferFactory), mUploadQueue(uploadQueue)
 {
-    mFence = mSyncPrimitiveManager->CreateFence();
-    mCopyCommandBuffer = mCommandBufferManager->CreatePrimaryCommandBuffer(CommandBufferType::Transfer);
-    mPreTransitionCommandBuffer = mCommandBufferManager->CreatePrimaryCommandBuffer(CommandBufferType::Transfer);
-    mPostTransitionCommandBuffer = mCommandBufferManager->CreatePrimaryCommandBuffer(CommandBufferType::Transfer);
-    mPreTransitionDone = mSyncPrimitiveManager->CreateUniqueSemaphore();
-    mPostTransitionDone = mSyncPrimitiveManager->CreateUniqueSemaphore();
-    mCopyDone = mSyncPrimitiveManager->CreateUniqueSemaphore();
-
     mTexture2DFormats = {
         vk::Format::eR8G8B8A8Srgb,       // HDR
         vk::Format::eR32G32B32A32Sfloat, // HDR
@@ -50,6 +43,167 @@ UniqueImage ImageFactory::CreateImage(ImageType type, vk::Extent3D extent, uint3
 UniqueImage ImageFactory::CreateImage(ImageType type, vk::Extent3D extent, vk::DeviceSize size, const void *data,
                                       uint32_t mipLevels, vk::SampleCountFlagBits samples)
 {
+    ImageUploadInfo uploadInfo{};
+    auto image = AllocateImage(type, extent, mipLevels, samples, uploadInfo);
+    if (data && type != ImageType::DepthStencil)
+    {
+        // 只提交不等待，采样前由渲染提交在时间线信号量上等待，或调用方自行 Wait(GetUploadTicket())
+        EnqueueUpload(image.get(), uploadInfo, data, size, false);
+        mUploadQueue->Flush();
+    }
+    return image;
+}
+std::vector<UniqueImage> ImageFactory::CreateImages(const std::vector<ImageUploadRequest> &requests, bool skipFailed)
+{
+    // 所有图像的布局转换与拷贝录制到同一批次，最后只提交一次
+    std::vector<UniqueImage> images;
+    images.reserve(requests.size());
+    for (const auto &request : requests)
+    {
+        try
+        {
+            ImageUploadInfo uploadInfo{};
+            vk::Format format =
+                request.format == vk::Format::eUndefined ? GetBestFormat(request.type) : request.format;
+            uint32_t mipLevels = request.generateMipmaps ? GetGeneratedMipLevels(request.type, format, request.extent)
+                                                         : request.mipLevels;
+            auto image = AllocateImage(request.type, request.extent, mipLevels, vk::SampleCountFlagBits::e1,
+                                       uploadInfo, format);
+            if (!request.mips.empty())
+            {
+                EnqueueUpload(image.get(), uploadInfo, request.mips);
+            }
+            else if (request.data && request.type != ImageType::DepthStencil)
+            {
+                EnqueueUpload(image.get(), uploadInfo, request.data, request.size, request.generateMipmaps);
+            }
+            images.push_back(std::move(image));
+        }
+        catch (const std::exception &e)
+        {
+            if (!skipFailed)
+            {
+                throw;
+            }
+            mLogger->Error("Failed to create image {}x{}: {}", request.extent.width, request.extent.height, e.what());
+            images.push_back(nullptr);
+        }
+    }
+    mUploadQueue->Flush();
+    return images;
+}
+uint32_t ImageFactory::GetGeneratedMipLevels(ImageType type, vk::Format format, vk::Extent3D extent)
+{
+    // CPU 回退只处理单层 8 位 RGBA/BGRA 纹理
+    bool cpuFallback = type == ImageType::Texture2D && extent.depth == 1 &&
+                       (format == vk::Format::eR8G8B8A8Unorm || format == vk::Format::eR8G8B8A8Srgb ||
+                        format == vk::Format::eB8G8R8A8Unorm || format == vk::Format::eB8G8R8A8Srgb);
+    if (!SupportsMipmapBlit(format) && !cpuFallback)
+    {
+        mLogger->Warn("Format " + vk::to_string(format) + " cannot generate mipmaps, using a single level");
+        return 1;
+    }
+    return CalculateMipLevels(extent.width, extent.height, extent.depth);
+}
+UploadTicket ImageFactory::EnqueueUpload(Image *image, ImageUploadInfo &uploadInfo, const void *data,
+                                         vk::DeviceSize size, bool generateMipmaps)
+{
+    SetUploadFormat(image, uploadInfo);
+    uploadInfo.dataMipLevels = uploadInfo.mipLevels;
+    std::vector<uint8_t> mipChain;
+    if (generateMipmaps && uploadInfo.mipLevels > 1)
+    {
+        if (SupportsMipmapBlit(image->GetFormat()))
+        {
+            uploadInfo.dataMipLevels = 1;
+            uploadInfo.generateMipmaps = true;
+        }
+        else
+        {
+            bool srgb = image->GetFormat() == vk::Format::eR8G8B8A8Srgb ||
+                        image->GetFormat() == vk::Format::eB8G8R8A8Srgb;
+            mipChain = GenerateMipChainRGBA8(static_cast<const uint8_t *>(data), uploadInfo.extent.width,
+                                             uploadInfo.extent.height, uploadInfo.mipLevels, srgb);
+            data = mipChain.data();
+            size = mipChain.size();
+        }
+    }
+    image->mUploadTicket = mUploadQueue->EnqueueImageUpload(uploadInfo, data, size);
+    image->mCurrentLayout = uploadInfo.finalLayout;
+    return image->mUploadTicket;
+}
+UploadTicket ImageFactory::EnqueueUpload(Image *image, ImageUploadInfo &uploadInfo,
+                                         const std::vector<ImageMipData> &mips)
+{
+    SetUploadFormat(image, uploadInfo);
+    image->mUploadTicket = mUploadQueue->EnqueueImageUpload(uploadInfo, mips);
+    image->mCurrentLayout = uploadInfo.finalLayout;
+    return image->mUploadTicket;
+}
+void ImageFactory::SetUploadFormat(Image *image, ImageUploadInfo &uploadInfo) const
+{
+    auto blockInfo = GetFormatBlockInfo(image->GetFormat());
+    uploadInfo.texelSize = blockInfo.blockSize;
+    uploadInfo.blockWidth = blockInfo.blockWidth;
+    uploadInfo.blockHeight = blockInfo.blockHeight;
+}
+bool ImageFactory::SupportsMipmapBlit(vk::Format format) const
+{
+    if (!mUploadQueue->CanGenerateMipmaps())
+    {
+        return false;
+    }
+    vk::FormatFeatureFlags requiredFeatures = vk::FormatFeatureFlagBits::eBlitSrc |
+                                              vk::FormatFeatureFlagBits::eBlitDst |
+                                              vk::FormatFeatureFlagBits::eSampledImageFilterLinear;
+    auto formatProperties = mContext->GetPhysicalDevice().getFormatProperties(format);
+    return (formatProperties.optimalTilingFeatures & requiredFeatures) == requiredFeatures;
+}
+bool ImageFactory::IsFormatSampleable(vk::Format format) const
+{
+    if (GetFormatBlockInfo(format).IsCompressed() && !mContext->GetEnabledFeatures().textureCompressionBC)
+    {
+        return false;
+    }
+    vk::FormatFeatureFlags requiredFeatures =
+        vk::FormatFeatureFlagBits::eSampledImage | vk::FormatFeatureFlagBits::eTransferDst;
+    auto formatProperties = mContext->GetPhysicalDevice().getFormatProperties(format);
+    return (formatProperties.optimalTilingFeatures & requiredFeatures) == requiredFeatures;
+}
+FormatBlockInfo ImageFactory::GetFormatBlockInfo(vk::Format format) const
+{
+    switch (format)
+    {
+    case vk::Format::eBc1RgbUnormBlock:
+    case vk::Format::eBc1RgbSrgbBlock:
+    case vk::Format::eBc1RgbaUnormBlock:
+    case vk::Format::eBc1RgbaSrgbBlock:
+    case vk::Format::eBc4UnormBlock:
+    case vk::Format::eBc4SnormBlock:
+        return {4, 4, 8};
+    case vk::Format::eBc2UnormBlock:
+    case vk::Format::eBc2SrgbBlock:
+    case vk::Format::eBc3UnormBlock:
+    case vk::Format::eBc3SrgbBlock:
+    case vk::Format::eBc5UnormBlock:
+    case vk::Format::eBc5SnormBlock:
+    case vk::Format::eBc6HUfloatBlock:
+    case vk::Format::eBc6HSfloatBlock:
+    case vk::Format::eBc7UnormBlock:
+    case vk::Format::eBc7SrgbBlock:
+        return {4, 4, 16};
+    default:
+        return {1, 1, GetFormatPixelSize(format)};
+    }
+}
+UniqueImage ImageFactory::AllocateImage(ImageType type, vk::Extent3D extent, uint32_t mipLevels,
+                                        vk::SampleCountFlagBits samples, ImageUploadInfo &uploadInfo,
+                                        vk::Format format)
+{
+    if (format == vk::Format::eUndefined)
+    {
+        format = GetBestFormat(type);
+    }
     uint32_t arrayLayers{};
     VmaMemoryUsage memoryUsage{};
     VmaAllocationCreateFlags createflags{};
@@ -123,9 +277,15 @@ UniqueImage ImageFactory::CreateImage(ImageType type, vk::Extent3D extent, vk::D
         mLogger->Error("Invalid image type");
         throw std::invalid_argument("Invalid image type");
     }
+    if (GetFormatBlockInfo(format).IsCompressed())
+    {
+        // 块压缩格式不能作为附件
+        imageUsage &= ~(vk::ImageUsageFlagBits::eColorAttachment | vk::ImageUsageFlagBits::eInputAttachment |
+                        vk::ImageUsageFlagBits::eStorage);
+    }
     vk::ImageCreateInfo imageCreateInfo{};
     imageCreateInfo.setImageType(imageType)
-        .setFormat(GetBestFormat(type))
+        .setFormat(format)
         .setExtent(extent)
         .setMipLevels(mipLevels)
         .setArrayLayers(arrayLayers)
@@ -134,116 +294,15 @@ UniqueImage ImageFactory::CreateImage(ImageType type, vk::Extent3D extent, vk::D
         .setUsage(imageUsage)
         .setInitialLayout(vk::ImageLayout::eUndefined);
     auto image = std::make_unique<Image>(mContext, imageCreateInfo, memoryUsage, createflags);
-    if (data)
-    {
-        if (type != ImageType::DepthStencil)
-        {
-            mContext->GetDevice().resetFences({mFence.get()});
-            mPreTransitionCommandBuffer->reset();
-            mPreTransitionCommandBuffer->begin(vk::CommandBufferBeginInfo{});
-            vk::ImageMemoryBarrier preBarrier{};
-            preBarrier.setImage(image->GetHandle())
-                .setOldLayout(vk::ImageLayout::eUndefined)
-                .setNewLayout(vk::ImageLayout::eTransferDstOptimal)
-                .setSrcAccessMask(vk::AccessFlagBits::eNoneKHR)
-                .setDstAccessMask(vk::AccessFlagBits::eTransferWrite)
-                .setSrcQueueFamilyIndex(mContext->GetQueueFamilyIndicates().graphicsFamily.value())
-                .setDstQueueFamilyIndex(mContext->GetQueueFamilyIndicates().graphicsFamily.value())
-                .setSubresourceRange({vk::ImageAspectFlagBits::eColor, 0, mipLevels, 0, arrayLayers});
-            mPreTransitionCommandBuffer->pipelineBarrier(vk::PipelineStageFlagBits::eTopOfPipe,
-                                                         vk::PipelineStageFlagBits::eTransfer, {}, {}, {}, preBarrier);
-            mPreTransitionCommandBuffer->end();
-            vk::SubmitInfo preSubmitInfo;
-            std::vector<vk::PipelineStageFlags> waitDstStageMask = {vk::PipelineStageFlagBits::eTransfer};
-            preSubmitInfo.setCommandBuffers(mPreTransitionCommandBuffer.get())
-                .setSignalSemaphores({mPreTransitionDone.get()});
-
-            // 复制数据到图像
-            auto buffer = mBufferFactory->CreateBuffer(BufferType::Staging, size, data);
-            vk::ImageSubresourceLayers imageSubresourceLayers{};
-            imageSubresourceLayers.setAspectMask(vk::ImageAspectFlagBits::eColor)
-                .setMipLevel(0)
-                .setBaseArrayLayer(0)
-                .setLayerCount(arrayLayers);
-            mCopyCommandBuffer->reset();
-            vk::BufferImageCopy region{};
-            region.setBufferOffset(0)
-                .setBufferRowLength(0)
-                .setBufferImageHeight(0)
-                .setImageOffset(vk::Offset3D(0, 0, 0))
-                .setImageExtent(extent)
-                .setImageSubresource(imageSubresourceLayers);
-            vk::CommandBufferBeginInfo beginInfo;
-            beginInfo.setFlags(vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
-            mCopyCommandBuffer->begin(beginInfo);
-            mCopyCommandBuffer->copyBufferToImage(buffer->GetHandle(), image->GetHandle(),
-                                                  vk::ImageLayout::eTransferDstOptimal, {region});
-            mCopyCommandBuffer->end();
-
-            vk::SubmitInfo copySubmitInfo;
-            copySubmitInfo.setCommandBuffers(mCopyCommandBuffer.get())
-                .setWaitSemaphores({mPreTransitionDone.get()})
-                .setSignalSemaphores({mCopyDone.get()})
-                .setWaitDstStageMask(waitDstStageMask);
-            // 转换图像布局
-            mPostTransitionCommandBuffer->reset();
-            mPostTransitionCommandBuffer->begin(vk::CommandBufferBeginInfo{});
-            vk::ImageMemoryBarrier postBarrier{};
-            postBarrier.setImage(image->GetHandle())
-                .setOldLayout(vk::ImageLayout::eTransferDstOptimal)
-                .setNewLayout(imageLayout)
-                .setSrcAccessMask(vk::AccessFlagBits::eTransferWrite)
-                .setDstAccessMask(accessMask)
-                .setSrcQueueFamilyIndex(mContext->GetQueueFamilyIndicates().graphicsFamily.value())
-                .setDstQueueFamilyIndex(mContext->GetQueueFamilyIndicates().graphicsFamily.value())
-                .setSubresourceRange({vk::ImageAspectFlagBits::eColor, 0, mipLevels, 0, arrayLayers});
-            mPostTransitionCommandBuffer->pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, pipelineStage, {}, {},
-                                                          {}, postBarrier);
-            mPostTransitionCommandBuffer->end();
-            vk::SubmitInfo postSubmitInfo;
-            postSubmitInfo.setCommandBuffers(mPostTransitionCommandBuffer.get())
-                .setWaitSemaphores({mCopyDone.get()})
-                .setWaitDstStageMask(waitDstStageMask);
-            mContext->SubmitToTransferQueue({preSubmitInfo, copySubmitInfo, postSubmitInfo}, mFence.get());
-            auto result = mContext->GetDevice().waitForFences(mFence.get(), vk::True, 1'000'000'000);
-            if (result != vk::Result::eSuccess)
-            {
-                mLogger->Error("Transition image layout operation failed");
-                throw std::runtime_error("Transition image layout operation failed");
-            }
-        }
-    }
+    uploadInfo.image = image->GetHandle();
+    uploadInfo.extent = extent;
+    uploadInfo.mipLevels = mipLevels;
+    uploadInfo.arrayLayers = arrayLayers;
+    uploadInfo.finalLayout = imageLayout;
+    uploadInfo.finalAccess = accessMask;
+    uploadInfo.finalStage = pipelineStage;
     return image;
 }
-void ImageFactory::CopyBufferToImage(Buffer *srcBuffer, Image *dstImage,
-                                     vk::ImageSubresourceLayers imageSubresourceLayers)
-{
-    auto fence = mSyncPrimitiveManager->CreateFence();
-    auto commandBuffer = mCommandBufferManager->CreatePrimaryCommandBuffer(CommandBufferType::Transfer);
-    vk::BufferImageCopy region{};
-    region.setBufferOffset(0)
-        .setBufferRowLength(0)
-        .setBufferImageHeight(0)
-        .setImageOffset(vk::Offset3D(0, 0, 0))
-        .setImageExtent(dstImage->GetExtent())
-        .setImageSubresource(imageSubresourceLayers);
-    vk::CommandBufferBeginInfo beginInfo;
-    beginInfo.setFlags(vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
-    commandBuffer->begin(beginInfo);
-    commandBuffer->copyBufferToImage(srcBuffer->GetHandle(), dstImage->GetHandle(),
-                                     vk::ImageLayout::eTransferDstOptimal, {region});
-    commandBuffer->end();
-
-    vk::SubmitInfo submitInfo;
-    submitInfo.setCommandBuffers(commandBuffer.get());
-    mContext->SubmitToTransferQueue({submitInfo}, fence.get());
-    auto result = mContext->GetDevice().waitForFences(fence.get(), vk::True, 1'000'000'000);
-    if (result != vk::Result::eSuccess)
-    {
-        mLogger->Error("Copy buffer to image operation failed");
-        throw std::runtime_error("Copy buffer to image operation failed");
-    }
-}
 vk::Format ImageFactory::GetBestFormat(ImageType type)
 {
     switch (type)
@@ -370,9 +429,12 @@ uint32_t ImageFactory::GetFormatPixelSize(vk::Format format) const
     case vk::Format::eD32SfloatS8Uint: // D32(4字节) + S8(1字节) + 3字节填充
         return 8;
 
-    // 压缩格式（需特别处理）
+    // 压缩格式按块计算，见 GetFormatBlockInfo
     case vk::Format::eBc1RgbUnormBlock:
     case vk::Format::eBc1RgbaUnormBlock:
+    case vk::Format::eBc5UnormBlock:
+    case vk::Format::eBc7UnormBlock:
+    case vk::Format::eBc7SrgbBlock:
         throw std::runtime_error("Compressed formats require block-based calculation");
 
     default:
@@ -400,6 +462,11 @@ vk::UniqueImageView ImageFactory::CreateImageView(Image *image, vk::ImageAspectF
         case vk::Format::eB8G8R8A8Srgb:
         case vk::Format::eR8G8B8A8Unorm:
         case vk::Format::eB8G8R8A8Unorm:
+        case vk::Format::eBc1RgbaUnormBlock:
+        case vk::Format::eBc1RgbaSrgbBlock:
+        case vk::Format::eBc5UnormBlock:
+        case vk::Format::eBc7UnormBlock:
+        case vk::Format::eBc7SrgbBlock:
             aspectMask = vk::ImageAspectFlagBits::eColor;
             break;
         default:
@@ -522,8 +589,9 @@ void ImageFactory::TransitionImageLayout(Image *image, vk::ImageLayout newLayout
                                          vk::AccessFlags dstAccessMask, vk::ImageSubresourceRange subresourceRange)
 {
     vk::UniqueFence fence = mSyncPrimitiveManager->CreateFence();
+    // 任意布局与阶段的转换只能保证在图形队列上合法，独立传输族不支持图形阶段
     vk::UniqueCommandBuffer commandBuffer =
-        mCommandBufferManager->CreatePrimaryCommandBuffer(CommandBufferType::Transfer);
+        mCommandBufferManager->CreatePrimaryCommandBuffer(CommandBufferType::Graphic);
     mLogger->Info("Using the provided command buffer for image layout transition. Ensure it is reset if necessary.");
     mLogger->Info("Using the provided fence for image layout transition. Need to wait for the fence externally.");
     commandBuffer->begin(vk::CommandBufferBeginInfo{});
@@ -540,7 +608,7 @@ void ImageFactory::TransitionImageLayout(Image *image, vk::ImageLayout newLayout
     commandBuffer->end();
     vk::SubmitInfo submitInfo;
     submitInfo.setCommandBuffers(commandBuffer.get());
-    mContext->SubmitToTransferQueue({submitInfo}, fence.get());
+    mContext->SubmitToGraphicQueue({submitInfo}, fence.get());
     auto result = mContext->GetDevice().waitForFences(fence.get(), vk::True, 1'000'000'000);
     if (result != vk::Result::eSuccess)
     {
@@ -0,0 +1,132 @@
+#include "MappedFile.hpp"
+
+#if defined(PLATFORM_WINDOWS)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace MEngine
+{
+MappedFile::~MappedFile()
+{
+    Close();
+}
+#if defined(PLATFORM_WINDOWS)
+bool MappedFile::Open(const std::filesystem::path &path)
+{
+    Close();
+    HANDLE file = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping)
+    {
+        CloseHandle(file);
+        return false;
+    }
+    void *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!data)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    mFileHandle = file;
+    mMappingHandle = mapping;
+    mData = static_cast<const uint8_t *>(data);
+    mSize = static_cast<uint64_t>(size.QuadPart);
+    return true;
+}
+void MappedFile::Close()
+{
+    if (mData)
+    {
+        UnmapViewOfFile(mData);
+    }
+    if (mMappingHandle)
+    {
+        CloseHandle(mMappingHandle);
+    }
+    if (mFileHandle)
+    {
+        CloseHandle(mFileHandle);
+    }
+    mData = nullptr;
+    mSize = 0;
+    mMappingHandle = nullptr;
+    mFileHandle = nullptr;
+}
+void MappedFile::Prefetch() const
+{
+    if (!mData)
+    {
+        return;
+    }
+    WIN32_MEMORY_RANGE_ENTRY range{const_cast<uint8_t *>(mData), static_cast<SIZE_T>(mSize)};
+    PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+}
+#else
+bool MappedFile::Open(const std::filesystem::path &path)
+{
+    Close();
+    int fileDescriptor = open(path.c_str(), O_RDONLY);
+    if (fileDescriptor < 0)
+    {
+        return false;
+    }
+    struct stat status{};
+    if (fstat(fileDescriptor, &status) != 0 || status.st_size <= 0)
+    {
+        close(fileDescriptor);
+        return false;
+    }
+    void *data = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+    if (data == MAP_FAILED)
+    {
+        close(fileDescriptor);
+        return false;
+    }
+    mFileDescriptor = fileDescriptor;
+    mData = static_cast<const uint8_t *>(data);
+    mSize = static_cast<uint64_t>(status.st_size);
+    return true;
+}
+void MappedFile::Close()
+{
+    if (mData)
+    {
+        munmap(const_cast<uint8_t *>(mData), static_cast<size_t>(mSize));
+    }
+    if (mFileDescriptor >= 0)
+    {
+        close(mFileDescriptor);
+    }
+    mData = nullptr;
+    mSize = 0;
+    mFileDescriptor = -1;
+}
+void MappedFile::Prefetch() const
+{
+    if (mData)
+    {
+        madvise(const_cast<uint8_t *>(mData), static_cast<size_t>(mSize), MADV_WILLNEED);
+    }
+}
+#endif
+} // namespace MEngine
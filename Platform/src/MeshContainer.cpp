@@ -0,0 +1,107 @@
+#include "MeshContainer.hpp"
+#include <cstring>
+
+namespace MEngine
+{
+namespace
+{
+uint64_t AlignUp(uint64_t value, uint64_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+} // namespace
+std::vector<uint8_t> CookMesh(std::vector<Vertex> vertices, std::vector<uint32_t> indices,
+                              const MeshCookOptions &options, MeshOptimizeReport *report)
+{
+    auto optimizeReport = OptimizeMesh(vertices, indices, options.optimize);
+    if (report)
+    {
+        *report = optimizeReport;
+    }
+    // LOD 在顶点读取重排之后生成，各级索引共用 LOD0 的顶点顺序
+    std::vector<MeshLODLevel> chain;
+    if (options.generateLODs)
+    {
+        chain = GenerateLODChain(vertices.data(), vertices.size(), indices.data(), indices.size(), options.lod);
+    }
+    std::vector<MeshContainerLOD> lods(chain.size() + 1);
+    lods[0].indexCount = static_cast<uint32_t>(indices.size());
+    for (size_t i = 0; i < chain.size(); i++)
+    {
+        lods[i + 1].firstIndex = lods[i].firstIndex + lods[i].indexCount;
+        lods[i + 1].indexCount = static_cast<uint32_t>(chain[i].indices.size());
+        lods[i + 1].error = chain[i].error;
+    }
+    MeshContainerHeader header{};
+    header.flags = MeshContainerOptimized;
+    header.vertexCount = static_cast<uint32_t>(vertices.size());
+    header.indexCount = lods.back().firstIndex + lods.back().indexCount;
+    header.lodCount = static_cast<uint32_t>(lods.size());
+    header.acmr = optimizeReport.after.acmr;
+    header.atvr = optimizeReport.after.atvr;
+    header.vertexOffset =
+        AlignUp(sizeof(MeshContainerHeader) + sizeof(MeshContainerLOD) * lods.size(), MeshContainerAlignment);
+    header.indexOffset =
+        AlignUp(header.vertexOffset + sizeof(Vertex) * static_cast<uint64_t>(vertices.size()), MeshContainerAlignment);
+    uint64_t size = header.indexOffset + sizeof(uint32_t) * static_cast<uint64_t>(header.indexCount);
+    std::vector<uint8_t> file(AlignUp(size, MeshContainerAlignment), 0);
+    std::memcpy(file.data(), &header, sizeof(header));
+    std::memcpy(file.data() + sizeof(header), lods.data(), sizeof(MeshContainerLOD) * lods.size());
+    std::memcpy(file.data() + header.vertexOffset, vertices.data(), sizeof(Vertex) * vertices.size());
+    auto *indexData = file.data() + header.indexOffset;
+    std::memcpy(indexData, indices.data(), sizeof(uint32_t) * indices.size());
+    for (size_t i = 0; i < chain.size(); i++)
+    {
+        std::memcpy(indexData + sizeof(uint32_t) * lods[i + 1].firstIndex, chain[i].indices.data(),
+                    sizeof(uint32_t) * chain[i].indices.size());
+    }
+    return file;
+}
+std::optional<MeshContainerView> ParseMeshContainer(const uint8_t *data, uint64_t size)
+{
+    if (!data || size < sizeof(MeshContainerHeader))
+    {
+        return std::nullopt;
+    }
+    MeshContainerView view{};
+    std::memcpy(&view.header, data, sizeof(MeshContainerHeader));
+    const auto &header = view.header;
+    if (header.magic != MeshContainerMagic || header.version != MeshContainerVersion ||
+        header.vertexStride != sizeof(Vertex) || header.vertexCount == 0 || header.indexCount == 0 ||
+        header.indexCount % 3 != 0 || header.lodCount == 0 || header.lodCount > 32)
+    {
+        return std::nullopt;
+    }
+    uint64_t tableEnd = sizeof(MeshContainerHeader) + sizeof(MeshContainerLOD) * header.lodCount;
+    uint64_t vertexSize = sizeof(Vertex) * static_cast<uint64_t>(header.vertexCount);
+    uint64_t indexSize = sizeof(uint32_t) * static_cast<uint64_t>(header.indexCount);
+    if (header.vertexOffset < tableEnd || header.vertexOffset % MeshContainerAlignment != 0 ||
+        header.indexOffset % MeshContainerAlignment != 0 || header.vertexOffset > size ||
+        vertexSize > size - header.vertexOffset || header.indexOffset < header.vertexOffset + vertexSize ||
+        header.indexOffset > size || indexSize > size - header.indexOffset)
+    {
+        return std::nullopt;
+    }
+    view.lods = reinterpret_cast<const MeshContainerLOD *>(data + sizeof(MeshContainerHeader));
+    for (uint32_t level = 0; level < header.lodCount; level++)
+    {
+        const auto &lod = view.lods[level];
+        if (lod.indexCount == 0 || lod.indexCount % 3 != 0 || lod.firstIndex > header.indexCount ||
+            lod.indexCount > header.indexCount - lod.firstIndex)
+        {
+            return std::nullopt;
+        }
+    }
+    view.vertices = reinterpret_cast<const Vertex *>(data + header.vertexOffset);
+    view.indices = reinterpret_cast<const uint32_t *>(data + header.indexOffset);
+    // 越界索引会让 GPU 读取到其他网格的顶点，加载时一次性检查
+    for (uint32_t i = 0; i < header.indexCount; i++)
+    {
+        if (view.indices[i] >= header.vertexCount)
+        {
+            return std::nullopt;
+        }
+    }
+    return view;
+}
+} // namespace MEngine
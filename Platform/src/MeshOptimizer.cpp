@@ -0,0 +1,381 @@
+#include "MeshOptimizer.hpp"
+#include "glm/glm.hpp"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+
+namespace MEngine
+{
+namespace
+{
+constexpr uint32_t InvalidIndex = std::numeric_limits<uint32_t>::max();
+
+// 顶点的位模式，-0.0 与 0.0 视为相同
+using VertexKey = std::array<uint32_t, 8>;
+struct VertexKeyHash
+{
+    size_t operator()(const VertexKey &key) const noexcept
+    {
+        // FNV-1a
+        uint64_t hash = 1469598103934665603ull;
+        for (auto word : key)
+        {
+            hash = (hash ^ word) * 1099511628211ull;
+        }
+        return static_cast<size_t>(hash);
+    }
+};
+VertexKey MakeVertexKey(const Vertex &vertex)
+{
+    std::array<float, 8> values = {vertex.position.x,  vertex.position.y, vertex.position.z, vertex.normal.x,
+                                   vertex.normal.y,    vertex.normal.z,   vertex.texCoords.x, vertex.texCoords.y};
+    VertexKey key;
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        float value = values[i] + 0.0f;
+        std::memcpy(&key[i], &value, sizeof(float));
+    }
+    return key;
+}
+/**
+ * @brief FIFO 缓存：用时间戳判断顶点是否还在最近 cacheSize 次未命中之内
+ */
+class FIFOCache
+{
+  private:
+    std::vector<uint32_t> mTimestamps;
+    uint32_t mTime;
+    uint32_t mSize;
+
+  public:
+    FIFOCache(size_t vertexCount, uint32_t cacheSize)
+        : mTimestamps(vertexCount, 0), mTime(cacheSize + 1), mSize(cacheSize)
+    {
+    }
+    // 返回是否未命中
+    bool Access(uint32_t vertex)
+    {
+        if (mTime - mTimestamps[vertex] > mSize)
+        {
+            mTimestamps[vertex] = mTime++;
+            return true;
+        }
+        return false;
+    }
+    // 清空缓存：时间戳整体前移超过缓存大小
+    void Reset()
+    {
+        mTime += mSize + 1;
+    }
+};
+} // namespace
+
+VertexCacheStats AnalyzeVertexCache(const uint32_t *indices, size_t indexCount, size_t vertexCount,
+                                    uint32_t cacheSize)
+{
+    VertexCacheStats stats{};
+    stats.triangles = static_cast<uint32_t>(indexCount / 3);
+    if (stats.triangles == 0)
+    {
+        return stats;
+    }
+    FIFOCache cache(vertexCount, cacheSize);
+    std::vector<bool> referenced(vertexCount, false);
+    uint32_t referencedCount = 0;
+    for (size_t i = 0; i < stats.triangles * 3; i++)
+    {
+        if (cache.Access(indices[i]))
+        {
+            stats.transforms++;
+        }
+        if (!referenced[indices[i]])
+        {
+            referenced[indices[i]] = true;
+            referencedCount++;
+        }
+    }
+    stats.acmr = static_cast<float>(stats.transforms) / static_cast<float>(stats.triangles);
+    stats.atvr = static_cast<float>(stats.transforms) / static_cast<float>(referencedCount);
+    return stats;
+}
+size_t WeldVertices(std::vector<Vertex> &vertices, std::vector<uint32_t> &indices)
+{
+    std::unordered_map<VertexKey, uint32_t, VertexKeyHash> unique;
+    unique.reserve(vertices.size());
+    std::vector<uint32_t> remap(vertices.size());
+    std::vector<Vertex> welded;
+    welded.reserve(vertices.size());
+    for (size_t i = 0; i < vertices.size(); i++)
+    {
+        auto [it, inserted] = unique.try_emplace(MakeVertexKey(vertices[i]), static_cast<uint32_t>(welded.size()));
+        if (inserted)
+        {
+            welded.push_back(vertices[i]);
+        }
+        remap[i] = it->second;
+    }
+    for (auto &index : indices)
+    {
+        index = remap[index];
+    }
+    vertices = std::move(welded);
+    return vertices.size();
+}
+void OptimizeVertexCache(uint32_t *indices, size_t indexCount, size_t vertexCount, uint32_t cacheSize)
+{
+    size_t triangleCount = indexCount / 3;
+    if (triangleCount == 0 || vertexCount == 0)
+    {
+        return;
+    }
+    // 1. 顶点 -> 三角形邻接表（CSR），live 为每个顶点尚未输出的三角形数
+    std::vector<uint32_t> live(vertexCount, 0);
+    for (size_t i = 0; i < triangleCount * 3; i++)
+    {
+        live[indices[i]]++;
+    }
+    std::vector<uint32_t> offsets(vertexCount + 1, 0);
+    std::partial_sum(live.begin(), live.end(), offsets.begin() + 1);
+    std::vector<uint32_t> adjacency(triangleCount * 3);
+    {
+        std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+        for (size_t i = 0; i < triangleCount * 3; i++)
+        {
+            adjacency[cursor[indices[i]]++] = static_cast<uint32_t>(i / 3);
+        }
+    }
+    // 2. 从扇心顶点输出所有相邻三角形，再在刚输出的顶点中选下一个扇心
+    std::vector<uint32_t> cacheTime(vertexCount, 0);
+    std::vector<bool> emitted(triangleCount, false);
+    std::vector<uint32_t> deadEnd;
+    std::vector<uint32_t> candidates;
+    std::vector<uint32_t> result;
+    deadEnd.reserve(triangleCount * 3);
+    result.reserve(triangleCount * 3);
+    uint32_t timestamp = cacheSize + 1;
+    size_t scan = 0;
+    auto nextLiveVertex = [&]() -> uint32_t {
+        // 先回溯最近输出的顶点，它们更可能还在缓存中，最后才按顺序扫描
+        while (!deadEnd.empty())
+        {
+            uint32_t vertex = deadEnd.back();
+            deadEnd.pop_back();
+            if (live[vertex] > 0)
+            {
+                return vertex;
+            }
+        }
+        for (; scan < vertexCount; scan++)
+        {
+            if (live[scan] > 0)
+            {
+                return static_cast<uint32_t>(scan);
+            }
+        }
+        return InvalidIndex;
+    };
+    uint32_t fan = nextLiveVertex();
+    while (fan != InvalidIndex)
+    {
+        candidates.clear();
+        for (uint32_t a = offsets[fan]; a < offsets[fan + 1]; a++)
+        {
+            uint32_t triangle = adjacency[a];
+            if (emitted[triangle])
+            {
+                continue;
+            }
+            emitted[triangle] = true;
+            for (uint32_t k = 0; k < 3; k++)
+            {
+                uint32_t vertex = indices[triangle * 3 + k];
+                result.push_back(vertex);
+                deadEnd.push_back(vertex);
+                candidates.push_back(vertex);
+                live[vertex]--;
+                if (timestamp - cacheTime[vertex] > cacheSize)
+                {
+                    cacheTime[vertex] = timestamp++;
+                }
+            }
+        }
+        // 优先选择输出其剩余三角形后仍在缓存中的、最早进入缓存的顶点
+        uint32_t best = InvalidIndex;
+        int64_t bestPriority = -1;
+        for (auto vertex : candidates)
+        {
+            if (live[vertex] == 0)
+            {
+                continue;
+            }
+            int64_t age = static_cast<int64_t>(timestamp - cacheTime[vertex]);
+            int64_t priority = age + 2 * static_cast<int64_t>(live[vertex]) <= cacheSize ? age : 0;
+            if (priority > bestPriority)
+            {
+                bestPriority = priority;
+                best = vertex;
+            }
+        }
+        fan = best != InvalidIndex ? best : nextLiveVertex();
+    }
+    std::copy(result.begin(), result.end(), indices);
+}
+void OptimizeOverdraw(uint32_t *indices, size_t indexCount, const Vertex *vertices, size_t vertexCount,
+                      uint32_t cacheSize, float threshold)
+{
+    size_t triangleCount = indexCount / 3;
+    if (triangleCount < 2 || vertexCount == 0)
+    {
+        return;
+    }
+    FIFOCache cache(vertexCount, cacheSize);
+    auto triangleMisses = [&](size_t triangle) {
+        uint32_t misses = 0;
+        for (uint32_t k = 0; k < 3; k++)
+        {
+            misses += cache.Access(indices[triangle * 3 + k]) ? 1 : 0;
+        }
+        return misses;
+    };
+    // 1. 硬边界：三个顶点全部未命中，说明 Tipsify 在这里跳到了不相邻的区域
+    std::vector<size_t> hardBoundaries;
+    for (size_t t = 0; t < triangleCount; t++)
+    {
+        if (triangleMisses(t) == 3)
+        {
+            hardBoundaries.push_back(t);
+        }
+    }
+    if (hardBoundaries.empty() || hardBoundaries.front() != 0)
+    {
+        hardBoundaries.insert(hardBoundaries.begin(), 0);
+    }
+    hardBoundaries.push_back(triangleCount);
+    // 2. 软边界：簇从冷缓存开始，局部 ACMR 降到所在硬簇 ACMR * threshold 以下时切分
+    //    每个簇单独的 ACMR 都有上界，任意排列后整体 ACMR 的增长也有上界
+    std::vector<size_t> clusters;
+    for (size_t h = 0; h + 1 < hardBoundaries.size(); h++)
+    {
+        size_t begin = hardBoundaries[h];
+        size_t end = hardBoundaries[h + 1];
+        cache.Reset();
+        uint32_t hardMisses = 0;
+        for (size_t t = begin; t < end; t++)
+        {
+            hardMisses += triangleMisses(t);
+        }
+        float clusterThreshold = threshold * static_cast<float>(hardMisses) / static_cast<float>(end - begin);
+        cache.Reset();
+        size_t clusterBegin = begin;
+        uint32_t clusterMisses = 0;
+        clusters.push_back(begin);
+        for (size_t t = begin; t < end; t++)
+        {
+            clusterMisses += triangleMisses(t);
+            float acmr = static_cast<float>(clusterMisses) / static_cast<float>(t - clusterBegin + 1);
+            if (t + 1 < end && acmr <= clusterThreshold)
+            {
+                clusters.push_back(t + 1);
+                clusterBegin = t + 1;
+                clusterMisses = 0;
+                cache.Reset();
+            }
+        }
+    }
+    clusters.push_back(triangleCount);
+    // 3. 排序键：簇的面积加权中心相对网格中心在簇法线方向上的投影，越朝外越先画
+    glm::vec3 meshCenter(0.0f);
+    float meshArea = 0.0f;
+    size_t clusterCount = clusters.size() - 1;
+    std::vector<glm::vec3> clusterCenters(clusterCount, glm::vec3(0.0f));
+    std::vector<glm::vec3> clusterNormals(clusterCount, glm::vec3(0.0f));
+    std::vector<float> clusterAreas(clusterCount, 0.0f);
+    for (size_t c = 0; c < clusterCount; c++)
+    {
+        for (size_t t = clusters[c]; t < clusters[c + 1]; t++)
+        {
+            const auto &p0 = vertices[indices[t * 3 + 0]].position;
+            const auto &p1 = vertices[indices[t * 3 + 1]].position;
+            const auto &p2 = vertices[indices[t * 3 + 2]].position;
+            glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+            float area = glm::length(normal);
+            glm::vec3 centroid = (p0 + p1 + p2) / 3.0f;
+            clusterCenters[c] += centroid * area;
+            clusterNormals[c] += normal;
+            clusterAreas[c] += area;
+        }
+        meshCenter += clusterCenters[c];
+        meshArea += clusterAreas[c];
+    }
+    if (meshArea > 0.0f)
+    {
+        meshCenter /= meshArea;
+    }
+    std::vector<float> sortKeys(clusterCount, 0.0f);
+    for (size_t c = 0; c < clusterCount; c++)
+    {
+        float normalLength = glm::length(clusterNormals[c]);
+        if (clusterAreas[c] > 0.0f && normalLength > 0.0f)
+        {
+            glm::vec3 center = clusterCenters[c] / clusterAreas[c];
+            sortKeys[c] = glm::dot(center - meshCenter, clusterNormals[c] / normalLength);
+        }
+    }
+    std::vector<uint32_t> order(clusterCount);
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return sortKeys[a] > sortKeys[b]; });
+    std::vector<uint32_t> result;
+    result.reserve(triangleCount * 3);
+    for (auto c : order)
+    {
+        result.insert(result.end(), indices + clusters[c] * 3, indices + clusters[c + 1] * 3);
+    }
+    std::copy(result.begin(), result.end(), indices);
+}
+void OptimizeVertexFetch(std::vector<Vertex> &vertices, std::vector<uint32_t> &indices)
+{
+    std::vector<uint32_t> remap(vertices.size(), InvalidIndex);
+    std::vector<Vertex> reordered;
+    reordered.reserve(vertices.size());
+    for (auto &index : indices)
+    {
+        if (remap[index] == InvalidIndex)
+        {
+            remap[index] = static_cast<uint32_t>(reordered.size());
+            reordered.push_back(vertices[index]);
+        }
+        index = remap[index];
+    }
+    vertices = std::move(reordered);
+}
+MeshOptimizeReport OptimizeMesh(std::vector<Vertex> &vertices, std::vector<uint32_t> &indices,
+                                const MeshOptimizeOptions &options)
+{
+    MeshOptimizeReport report{};
+    report.verticesBefore = static_cast<uint32_t>(vertices.size());
+    report.before = AnalyzeVertexCache(indices.data(), indices.size(), vertices.size(), options.cacheSize);
+    if (options.weld)
+    {
+        WeldVertices(vertices, indices);
+    }
+    if (options.vertexCache)
+    {
+        OptimizeVertexCache(indices.data(), indices.size(), vertices.size(), options.cacheSize);
+    }
+    if (options.overdraw)
+    {
+        OptimizeOverdraw(indices.data(), indices.size(), vertices.data(), vertices.size(), options.cacheSize,
+                         options.overdrawThreshold);
+    }
+    if (options.vertexFetch)
+    {
+        OptimizeVertexFetch(vertices, indices);
+    }
+    report.verticesAfter = static_cast<uint32_t>(vertices.size());
+    report.after = AnalyzeVertexCache(indices.data(), indices.size(), vertices.size(), options.cacheSize);
+    return report;
+}
+} // namespace MEngine
@@ -0,0 +1,659 @@
+#include "MeshSimplifier.hpp"
+#include "MeshOptimizer.hpp"
+#include "glm/glm.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+
+namespace MEngine
+{
+namespace
+{
+constexpr uint32_t InvalidIndex = std::numeric_limits<uint32_t>::max();
+// 检查折叠后三角形偏离原始网格时的采样点（重心坐标）；三个顶点本身就是原始顶点，不需要检查
+constexpr float SamplePoints[7][3] = {{1.0f / 3, 1.0f / 3, 1.0f / 3}, {0.5f, 0.5f, 0.0f}, {0.0f, 0.5f, 0.5f},
+                                      {0.5f, 0.0f, 0.5f},             {4.0f / 6, 1.0f / 6, 1.0f / 6},
+                                      {1.0f / 6, 4.0f / 6, 1.0f / 6}, {1.0f / 6, 1.0f / 6, 4.0f / 6}};
+/**
+ * @brief 对称 4x4 二次型，按面积加权累加三角形所在平面，Evaluate 返回到这些平面距离平方的加权平均
+ * 平均值不是误差上限，只用于折叠排序与快速排除，误差上限由 Simplifier::IsWithinError 的实际距离检查保证。
+ */
+struct Quadric
+{
+    double a2 = 0, b2 = 0, c2 = 0, ab = 0, ac = 0, bc = 0, ad = 0, bd = 0, cd = 0, d2 = 0;
+    double weight = 0;
+
+    static Quadric FromPlane(const glm::vec3 &normal, float distance, double weight)
+    {
+        double a = normal.x, b = normal.y, c = normal.z, d = distance;
+        Quadric q;
+        q.a2 = a * a * weight;
+        q.b2 = b * b * weight;
+        q.c2 = c * c * weight;
+        q.ab = a * b * weight;
+        q.ac = a * c * weight;
+        q.bc = b * c * weight;
+        q.ad = a * d * weight;
+        q.bd = b * d * weight;
+        q.cd = c * d * weight;
+        q.d2 = d * d * weight;
+        q.weight = weight;
+        return q;
+    }
+    Quadric &operator+=(const Quadric &other)
+    {
+        a2 += other.a2, b2 += other.b2, c2 += other.c2;
+        ab += other.ab, ac += other.ac, bc += other.bc;
+        ad += other.ad, bd += other.bd, cd += other.cd;
+        d2 += other.d2, weight += other.weight;
+        return *this;
+    }
+    double Evaluate(const glm::vec3 &point) const
+    {
+        double x = point.x, y = point.y, z = point.z;
+        double error = a2 * x * x + b2 * y * y + c2 * z * z + 2 * (ab * x * y + ac * x * z + bc * y * z) +
+                       2 * (ad * x + bd * y + cd * z) + d2;
+        return weight > 0 ? std::max(error / weight, 0.0) : 0.0;
+    }
+};
+struct Collapse
+{
+    uint32_t from;
+    uint32_t to;
+    double cost;
+};
+uint64_t MakeEdgeKey(uint32_t a, uint32_t b)
+{
+    return a < b ? (static_cast<uint64_t>(a) << 32) | b : (static_cast<uint64_t>(b) << 32) | a;
+}
+// 有位置相同的其他顶点（属性接缝或未合并的重复顶点）时锁定
+std::vector<uint8_t> FindPositionTwins(const Vertex *vertices, size_t vertexCount)
+{
+    struct PositionHash
+    {
+        size_t operator()(const std::array<uint32_t, 3> &key) const noexcept
+        {
+            return (static_cast<size_t>(key[0]) * 73856093u) ^ (static_cast<size_t>(key[1]) * 19349663u) ^
+                   (static_cast<size_t>(key[2]) * 83492791u);
+        }
+    };
+    std::unordered_map<std::array<uint32_t, 3>, uint32_t, PositionHash> counts;
+    std::vector<std::array<uint32_t, 3>> keys(vertexCount);
+    for (size_t i = 0; i < vertexCount; i++)
+    {
+        glm::vec3 position = vertices[i].position + glm::vec3(0.0f);
+        std::memcpy(keys[i].data(), &position.x, sizeof(float) * 3);
+        counts[keys[i]]++;
+    }
+    std::vector<uint8_t> twins(vertexCount, 0);
+    for (size_t i = 0; i < vertexCount; i++)
+    {
+        twins[i] = counts[keys[i]] > 1 ? 1 : 0;
+    }
+    return twins;
+}
+float SegmentDistanceSquared(const glm::vec3 &point, const glm::vec3 &a, const glm::vec3 &b)
+{
+    glm::vec3 ab = b - a;
+    float lengthSquared = glm::dot(ab, ab);
+    float t = lengthSquared > 0.0f ? std::clamp(glm::dot(point - a, ab) / lengthSquared, 0.0f, 1.0f) : 0.0f;
+    glm::vec3 delta = point - (a + ab * t);
+    return glm::dot(delta, delta);
+}
+/**
+ * @brief 点到三角形的最近距离平方（Ericson, Real-Time Collision Detection 5.1.5），退化三角形按三条边计算
+ */
+float TriangleDistanceSquared(const glm::vec3 &point, const glm::vec3 &a, const glm::vec3 &b, const glm::vec3 &c)
+{
+    glm::vec3 ab = b - a;
+    glm::vec3 ac = c - a;
+    glm::vec3 normal = glm::cross(ab, ac);
+    float normalSquared = glm::dot(normal, normal);
+    if (normalSquared <= 1e-12f * glm::dot(ab, ab) * glm::dot(ac, ac))
+    {
+        return std::min({SegmentDistanceSquared(point, a, b), SegmentDistanceSquared(point, b, c),
+                         SegmentDistanceSquared(point, c, a)});
+    }
+    glm::vec3 ap = point - a;
+    glm::vec3 bp = point - b;
+    glm::vec3 cp = point - c;
+    float d1 = glm::dot(ab, ap), d2 = glm::dot(ac, ap);
+    float d3 = glm::dot(ab, bp), d4 = glm::dot(ac, bp);
+    float d5 = glm::dot(ab, cp), d6 = glm::dot(ac, cp);
+    if (d1 <= 0.0f && d2 <= 0.0f)
+    {
+        return glm::dot(ap, ap);
+    }
+    if (d3 >= 0.0f && d4 <= d3)
+    {
+        return glm::dot(bp, bp);
+    }
+    if (d6 >= 0.0f && d5 <= d6)
+    {
+        return glm::dot(cp, cp);
+    }
+    if (d1 * d4 - d3 * d2 <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+    {
+        return SegmentDistanceSquared(point, a, b);
+    }
+    if (d5 * d2 - d1 * d6 <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+    {
+        return SegmentDistanceSquared(point, a, c);
+    }
+    if (d3 * d6 - d5 * d4 <= 0.0f && d4 - d3 >= 0.0f && d5 - d6 >= 0.0f)
+    {
+        return SegmentDistanceSquared(point, b, c);
+    }
+    // 投影落在三角形内部
+    float distance = glm::dot(ap, normal);
+    return distance * distance / normalSquared;
+}
+// 顶点 -> 三角形邻接表，offsets[v] 到 offsets[v + 1] 为顶点 v 所在的三角形
+void BuildAdjacency(const std::vector<uint32_t> &indices, size_t vertexCount, std::vector<uint32_t> &offsets,
+                    std::vector<uint32_t> &adjacency)
+{
+    offsets.assign(vertexCount + 1, 0);
+    for (auto index : indices)
+    {
+        offsets[index + 1]++;
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    adjacency.resize(indices.size());
+    std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < indices.size(); i++)
+    {
+        adjacency[cursor[indices[i]]++] = static_cast<uint32_t>(i / 3);
+    }
+}
+/**
+ * @brief 可以分多次调用 Simplify 的简化器，LOD 链的各级共用同一份二次型与原始网格
+ * 每个保留顶点记录折叠进来的原始顶点。折叠前检查两个方向的实际距离都不超过上限：
+ * 这些原始顶点到代表顶点三角形扇的距离，以及改变形状的三角形上的采样点到原始网格的距离。
+ */
+class Simplifier
+{
+  private:
+    const Vertex *mVertices;
+    size_t mVertexCount;
+    std::vector<uint32_t> mIndices;
+    std::vector<Quadric> mQuadrics;
+    std::vector<uint8_t> mPositionTwins;
+    // 原始网格及其邻接表，误差检查的比较对象
+    std::vector<uint32_t> mOriginalIndices;
+    std::vector<uint32_t> mOriginalOffsets;
+    std::vector<uint32_t> mOriginalAdjacency;
+    // 每个保留顶点代表的原始顶点（含自身）组成的链表
+    std::vector<uint32_t> mRepresentedHead;
+    std::vector<uint32_t> mRepresentedTail;
+    std::vector<uint32_t> mRepresentedNext;
+    // 当前网格的邻接表，每轮重建
+    std::vector<uint32_t> mOffsets;
+    std::vector<uint32_t> mAdjacency;
+    // 收集原始三角形时去重
+    std::vector<uint32_t> mTriangleStamps;
+    uint32_t mStamp = 0;
+    std::vector<uint32_t> mCandidates;
+    std::vector<uint32_t> mRing;
+    // 折叠轮次，记录每个顶点一环最后变化的轮次与每条有向边误差检查失败的轮次
+    uint32_t mRound = 0;
+    std::vector<uint32_t> mChangedRounds;
+    std::unordered_map<uint64_t, uint32_t> mFailedRounds;
+
+  private:
+    const glm::vec3 &PositionOf(uint32_t vertex) const
+    {
+        return mVertices[vertex].position;
+    }
+    /**
+     * @brief point 到顶点 vertex 的三角形扇的最近距离平方；from 不为 InvalidIndex 时按 from 折叠到 to 之后的网格计算
+     * 找到距离平方不超过 acceptDistanceSquared 的三角形时提前返回
+     */
+    float FanDistanceSquared(uint32_t vertex, uint32_t from, uint32_t to, const glm::vec3 &point,
+                             float acceptDistanceSquared) const;
+    /**
+     * @brief 收集 corners 所代表的原始顶点相邻的原始三角形，to 同时代表 from 的原始顶点
+     */
+    void CollectOriginalTriangles(const uint32_t corners[3], uint32_t from, uint32_t to);
+    float OriginalDistanceSquared(const glm::vec3 &point, float acceptDistanceSquared) const;
+    bool IsWithinError(uint32_t from, uint32_t to, float maxDistanceSquared);
+
+  public:
+    Simplifier(const Vertex *vertices, size_t vertexCount, const uint32_t *indices, size_t indexCount);
+    /**
+     * @brief 从当前结果继续简化，直到索引数不超过 targetIndexCount 或没有满足 maxError 的折叠
+     */
+    void Simplify(size_t targetIndexCount, float maxError);
+    /**
+     * @brief 当前结果相对原始网格的误差：原始顶点到简化网格、简化三角形采样点到原始网格的最大距离
+     */
+    float MeasureError();
+    const std::vector<uint32_t> &GetIndices() const
+    {
+        return mIndices;
+    }
+};
+Simplifier::Simplifier(const Vertex *vertices, size_t vertexCount, const uint32_t *indices, size_t indexCount)
+    : mVertices(vertices), mVertexCount(vertexCount), mIndices(indices, indices + indexCount / 3 * 3),
+      mQuadrics(vertexCount), mPositionTwins(FindPositionTwins(vertices, vertexCount)), mOriginalIndices(mIndices),
+      mRepresentedHead(vertexCount, InvalidIndex), mRepresentedTail(vertexCount, InvalidIndex),
+      mRepresentedNext(vertexCount, InvalidIndex), mTriangleStamps(mIndices.size() / 3, 0),
+      mChangedRounds(vertexCount, 0)
+{
+    // 每个顶点累加相邻三角形平面的二次型
+    for (size_t t = 0; t < mIndices.size() / 3; t++)
+    {
+        const auto &p0 = PositionOf(mIndices[t * 3 + 0]);
+        glm::vec3 normal = glm::cross(PositionOf(mIndices[t * 3 + 1]) - p0, PositionOf(mIndices[t * 3 + 2]) - p0);
+        float length = glm::length(normal);
+        if (length <= 0.0f)
+        {
+            continue;
+        }
+        normal /= length;
+        auto quadric = Quadric::FromPlane(normal, -glm::dot(normal, p0), length * 0.5);
+        for (uint32_t k = 0; k < 3; k++)
+        {
+            mQuadrics[mIndices[t * 3 + k]] += quadric;
+        }
+    }
+    for (auto index : mIndices)
+    {
+        mRepresentedHead[index] = index;
+        mRepresentedTail[index] = index;
+    }
+    BuildAdjacency(mOriginalIndices, mVertexCount, mOriginalOffsets, mOriginalAdjacency);
+}
+float Simplifier::FanDistanceSquared(uint32_t vertex, uint32_t from, uint32_t to, const glm::vec3 &point,
+                                     float acceptDistanceSquared) const
+{
+    float best = std::numeric_limits<float>::max();
+    auto visit = [&](const uint32_t *triangle) {
+        glm::vec3 corners[3];
+        for (uint32_t k = 0; k < 3; k++)
+        {
+            corners[k] = PositionOf(triangle[k] == from ? to : triangle[k]);
+        }
+        best = std::min(best, TriangleDistanceSquared(point, corners[0], corners[1], corners[2]));
+    };
+    auto contains = [](const uint32_t *triangle, uint32_t value) {
+        return triangle[0] == value || triangle[1] == value || triangle[2] == value;
+    };
+    // 同时含 from 与 to 的三角形折叠后退化，不再计入
+    for (uint32_t a = mOffsets[vertex]; a < mOffsets[vertex + 1] && best > acceptDistanceSquared; a++)
+    {
+        const uint32_t *triangle = &mIndices[mAdjacency[a] * 3];
+        if (from == InvalidIndex || !contains(triangle, from) || !contains(triangle, to))
+        {
+            visit(triangle);
+        }
+    }
+    // from 的三角形折叠后并入 to 的三角形扇
+    if (from != InvalidIndex && vertex == to)
+    {
+        for (uint32_t a = mOffsets[from]; a < mOffsets[from + 1] && best > acceptDistanceSquared; a++)
+        {
+            const uint32_t *triangle = &mIndices[mAdjacency[a] * 3];
+            if (!contains(triangle, to))
+            {
+                visit(triangle);
+            }
+        }
+    }
+    return best;
+}
+void Simplifier::CollectOriginalTriangles(const uint32_t corners[3], uint32_t from, uint32_t to)
+{
+    mCandidates.clear();
+    mStamp++;
+    auto collect = [this](uint32_t vertex) {
+        for (uint32_t original = mRepresentedHead[vertex]; original != InvalidIndex;
+             original = mRepresentedNext[original])
+        {
+            for (uint32_t a = mOriginalOffsets[original]; a < mOriginalOffsets[original + 1]; a++)
+            {
+                uint32_t triangle = mOriginalAdjacency[a];
+                if (mTriangleStamps[triangle] != mStamp)
+                {
+                    mTriangleStamps[triangle] = mStamp;
+                    mCandidates.push_back(triangle);
+                }
+            }
+        }
+    };
+    for (uint32_t k = 0; k < 3; k++)
+    {
+        collect(corners[k]);
+        if (from != InvalidIndex && corners[k] == to)
+        {
+            collect(from);
+        }
+    }
+}
+float Simplifier::OriginalDistanceSquared(const glm::vec3 &point, float acceptDistanceSquared) const
+{
+    // 候选按收集顺序排列，角点自身相邻的原始三角形在前，通常最先满足条件
+    float best = std::numeric_limits<float>::max();
+    for (size_t i = 0; i < mCandidates.size() && best > acceptDistanceSquared; i++)
+    {
+        uint32_t triangle = mCandidates[i];
+        const uint32_t *corners = &mOriginalIndices[triangle * 3];
+        best = std::min(best, TriangleDistanceSquared(point, PositionOf(corners[0]), PositionOf(corners[1]),
+                                                      PositionOf(corners[2])));
+    }
+    return best;
+}
+bool Simplifier::IsWithinError(uint32_t from, uint32_t to, float maxDistanceSquared)
+{
+    // 1. 折叠后只有 from 的三角形改变形状，其上的采样点必须靠近这些三角形所代表的原始网格
+    mRing.clear();
+    for (uint32_t a = mOffsets[from]; a < mOffsets[from + 1]; a++)
+    {
+        const uint32_t *triangle = &mIndices[mAdjacency[a] * 3];
+        for (uint32_t k = 0; k < 3; k++)
+        {
+            if (triangle[k] != from && std::find(mRing.begin(), mRing.end(), triangle[k]) == mRing.end())
+            {
+                mRing.push_back(triangle[k]);
+            }
+        }
+        if (triangle[0] == to || triangle[1] == to || triangle[2] == to)
+        {
+            continue;
+        }
+        uint32_t corners[3];
+        glm::vec3 positions[3];
+        for (uint32_t k = 0; k < 3; k++)
+        {
+            corners[k] = triangle[k] == from ? to : triangle[k];
+            positions[k] = PositionOf(corners[k]);
+        }
+        CollectOriginalTriangles(corners, from, to);
+        for (const auto &weights : SamplePoints)
+        {
+            glm::vec3 point = positions[0] * weights[0] + positions[1] * weights[1] + positions[2] * weights[2];
+            if (OriginalDistanceSquared(point, maxDistanceSquared) > maxDistanceSquared)
+            {
+                return false;
+            }
+        }
+    }
+    // 2. 一环内各顶点（to 同时代表 from）所代表的原始顶点必须靠近其折叠后的三角形扇
+    for (uint32_t vertex : mRing)
+    {
+        for (uint32_t owner : {vertex, vertex == to ? from : InvalidIndex})
+        {
+            if (owner == InvalidIndex)
+            {
+                continue;
+            }
+            for (uint32_t original = mRepresentedHead[owner]; original != InvalidIndex;
+                 original = mRepresentedNext[original])
+            {
+                if (original != vertex &&
+                    FanDistanceSquared(vertex, from, to, PositionOf(original), maxDistanceSquared) > maxDistanceSquared)
+                {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+void Simplifier::Simplify(size_t targetIndexCount, float maxError)
+{
+    double costLimit = static_cast<double>(maxError) * maxError;
+    float maxDistanceSquared = maxError * maxError;
+    std::vector<uint8_t> locked(mVertexCount);
+    std::vector<uint32_t> remap(mVertexCount);
+    std::vector<uint8_t> touched(mVertexCount);
+    std::vector<Collapse> collapses;
+    std::unordered_map<uint64_t, uint32_t> edgeCounts;
+    // 每一轮选出一环互不相交的低代价折叠批量执行，直到达到目标或没有可行的折叠
+    while (mIndices.size() > targetIndexCount)
+    {
+        size_t triangleCount = mIndices.size() / 3;
+        // 边界与非流形边：只被一个或超过两个三角形使用
+        edgeCounts.clear();
+        for (size_t t = 0; t < triangleCount; t++)
+        {
+            for (uint32_t k = 0; k < 3; k++)
+            {
+                edgeCounts[MakeEdgeKey(mIndices[t * 3 + k], mIndices[t * 3 + (k + 1) % 3])]++;
+            }
+        }
+        locked.assign(mPositionTwins.begin(), mPositionTwins.end());
+        for (const auto &[key, count] : edgeCounts)
+        {
+            if (count != 2)
+            {
+                locked[key >> 32] = 1;
+                locked[key & 0xFFFFFFFFu] = 1;
+            }
+        }
+        BuildAdjacency(mIndices, mVertexCount, mOffsets, mAdjacency);
+        // 二次误差不超过上限的有向边按代价排序，同一顶点的最优方向被拒绝时还可以尝试其他方向
+        collapses.clear();
+        for (size_t t = 0; t < triangleCount; t++)
+        {
+            for (uint32_t k = 0; k < 3; k++)
+            {
+                uint32_t from = mIndices[t * 3 + k];
+                uint32_t to = mIndices[t * 3 + (k + 1) % 3];
+                // 内部边在相邻两个三角形中方向相反，只在 from < to 的一侧生成，两个方向各一次
+                if (from >= to)
+                {
+                    continue;
+                }
+                for (int direction = 0; direction < 2; direction++, std::swap(from, to))
+                {
+                    if (locked[from])
+                    {
+                        continue;
+                    }
+                    Quadric quadric = mQuadrics[from];
+                    quadric += mQuadrics[to];
+                    double cost = quadric.Evaluate(PositionOf(to));
+                    if (cost <= costLimit)
+                    {
+                        collapses.push_back({from, to, cost});
+                    }
+                }
+            }
+        }
+        std::sort(collapses.begin(), collapses.end(),
+                  [](const Collapse &a, const Collapse &b) { return a.cost < b.cost; });
+        mRound++;
+        std::iota(remap.begin(), remap.end(), 0u);
+        std::fill(touched.begin(), touched.end(), 0);
+        size_t removeTarget = (mIndices.size() - targetIndexCount + 2) / 3;
+        size_t removed = 0;
+        for (const auto &collapse : collapses)
+        {
+            if (removed >= removeTarget)
+            {
+                break;
+            }
+            // 一环与本轮已执行的折叠不相交，下面的检查在批量执行后仍然成立
+            bool isValid = true;
+            size_t degenerate = 0;
+            uint32_t changedRound = 0;
+            for (uint32_t a = mOffsets[collapse.from]; a < mOffsets[collapse.from + 1] && isValid; a++)
+            {
+                const uint32_t *triangle = &mIndices[mAdjacency[a] * 3];
+                isValid = !touched[triangle[0]] && !touched[triangle[1]] && !touched[triangle[2]];
+                for (uint32_t k = 0; k < 3; k++)
+                {
+                    changedRound = std::max(changedRound, mChangedRounds[triangle[k]]);
+                }
+            }
+            // 误差检查只依赖一环内顶点的三角形扇与代表的原始顶点，一环没有变化时沿用上次失败的结果
+            uint64_t edgeKey = (static_cast<uint64_t>(collapse.from) << 32) | collapse.to;
+            auto failed = mFailedRounds.find(edgeKey);
+            if (isValid && failed != mFailedRounds.end() && failed->second > changedRound)
+            {
+                continue;
+            }
+            // 折叠后不含 to 的三角形法线偏转不能超过约 75 度，排除翻转以及折到接缝上的竖直薄片
+            const auto &target = PositionOf(collapse.to);
+            for (uint32_t a = mOffsets[collapse.from]; a < mOffsets[collapse.from + 1] && isValid; a++)
+            {
+                const uint32_t *triangle = &mIndices[mAdjacency[a] * 3];
+                if (triangle[0] == collapse.to || triangle[1] == collapse.to || triangle[2] == collapse.to)
+                {
+                    degenerate++;
+                    continue;
+                }
+                glm::vec3 before[3], after[3];
+                for (uint32_t k = 0; k < 3; k++)
+                {
+                    before[k] = PositionOf(triangle[k]);
+                    after[k] = triangle[k] == collapse.from ? target : before[k];
+                }
+                glm::vec3 normalBefore = glm::cross(before[1] - before[0], before[2] - before[0]);
+                glm::vec3 normalAfter = glm::cross(after[1] - after[0], after[2] - after[0]);
+                isValid = glm::dot(normalBefore, normalAfter) >
+                          0.25f * glm::length(normalBefore) * glm::length(normalAfter);
+            }
+            if (!isValid)
+            {
+                continue;
+            }
+            if (!IsWithinError(collapse.from, collapse.to, maxDistanceSquared))
+            {
+                mFailedRounds[edgeKey] = mRound;
+                continue;
+            }
+            for (uint32_t a = mOffsets[collapse.from]; a < mOffsets[collapse.from + 1]; a++)
+            {
+                for (uint32_t k = 0; k < 3; k++)
+                {
+                    touched[mIndices[mAdjacency[a] * 3 + k]] = 1;
+                    mChangedRounds[mIndices[mAdjacency[a] * 3 + k]] = mRound;
+                }
+            }
+            remap[collapse.from] = collapse.to;
+            mQuadrics[collapse.to] += mQuadrics[collapse.from];
+            // from 代表的原始顶点转交给 to
+            mRepresentedNext[mRepresentedTail[collapse.to]] = mRepresentedHead[collapse.from];
+            mRepresentedTail[collapse.to] = mRepresentedTail[collapse.from];
+            mRepresentedHead[collapse.from] = InvalidIndex;
+            mRepresentedTail[collapse.from] = InvalidIndex;
+            removed += degenerate;
+        }
+        if (removed == 0)
+        {
+            break;
+        }
+        // 应用折叠并删除退化三角形
+        size_t write = 0;
+        for (size_t t = 0; t < triangleCount; t++)
+        {
+            uint32_t a = remap[mIndices[t * 3 + 0]];
+            uint32_t b = remap[mIndices[t * 3 + 1]];
+            uint32_t c = remap[mIndices[t * 3 + 2]];
+            if (a != b && b != c && a != c)
+            {
+                mIndices[write++] = a;
+                mIndices[write++] = b;
+                mIndices[write++] = c;
+            }
+        }
+        mIndices.resize(write);
+    }
+}
+float Simplifier::MeasureError()
+{
+    BuildAdjacency(mIndices, mVertexCount, mOffsets, mAdjacency);
+    float maxDistanceSquared = 0.0f;
+    for (uint32_t vertex = 0; vertex < mVertexCount; vertex++)
+    {
+        if (mOffsets[vertex] == mOffsets[vertex + 1])
+        {
+            continue;
+        }
+        for (uint32_t original = mRepresentedHead[vertex]; original != InvalidIndex;
+             original = mRepresentedNext[original])
+        {
+            if (original != vertex)
+            {
+                float distance = FanDistanceSquared(vertex, InvalidIndex, InvalidIndex, PositionOf(original), 0.0f);
+                maxDistanceSquared = std::max(maxDistanceSquared, distance);
+            }
+        }
+    }
+    for (size_t t = 0; t < mIndices.size() / 3; t++)
+    {
+        const uint32_t *corners = &mIndices[t * 3];
+        CollectOriginalTriangles(corners, InvalidIndex, InvalidIndex);
+        for (const auto &weights : SamplePoints)
+        {
+            glm::vec3 point = PositionOf(corners[0]) * weights[0] + PositionOf(corners[1]) * weights[1] +
+                              PositionOf(corners[2]) * weights[2];
+            maxDistanceSquared = std::max(maxDistanceSquared, OriginalDistanceSquared(point, 0.0f));
+        }
+    }
+    return std::sqrt(maxDistanceSquared);
+}
+} // namespace
+
+std::vector<uint32_t> SimplifyMesh(const Vertex *vertices, size_t vertexCount, const uint32_t *indices,
+                                   size_t indexCount, size_t targetIndexCount, float maxError, float *resultError)
+{
+    Simplifier simplifier(vertices, vertexCount, indices, indexCount);
+    simplifier.Simplify(targetIndexCount, maxError);
+    if (resultError)
+    {
+        *resultError = simplifier.MeasureError();
+    }
+    return simplifier.GetIndices();
+}
+std::vector<MeshLODLevel> GenerateLODChain(const Vertex *vertices, size_t vertexCount, const uint32_t *indices,
+                                           size_t indexCount, const MeshLODOptions &options)
+{
+    std::vector<MeshLODLevel> chain;
+    if (indexCount < 3 || vertexCount == 0)
+    {
+        return chain;
+    }
+    // 误差上限相对网格大小，与模型单位无关
+    glm::vec3 minPosition = vertices[indices[0]].position;
+    glm::vec3 maxPosition = minPosition;
+    for (size_t i = 0; i < indexCount; i++)
+    {
+        minPosition = glm::min(minPosition, vertices[indices[i]].position);
+        maxPosition = glm::max(maxPosition, vertices[indices[i]].position);
+    }
+    float radius = glm::length(maxPosition - minPosition) * 0.5f;
+    float maxError = options.maxError * radius;
+    // 各级在同一个简化器上继续折叠，二次型沿用 LOD0 的累加结果，误差都相对原始网格
+    Simplifier simplifier(vertices, vertexCount, indices, indexCount);
+    size_t previousCount = simplifier.GetIndices().size();
+    float error = 0.0f;
+    for (uint32_t level = 0; level < options.maxLevels; level++)
+    {
+        size_t targetTriangles = static_cast<size_t>(previousCount / 3 * options.reduction);
+        if (targetTriangles < options.minTriangles)
+        {
+            break;
+        }
+        simplifier.Simplify(targetTriangles * 3, maxError);
+        const auto &simplified = simplifier.GetIndices();
+        // 三角形减少不到 10%（边界锁定或误差已到上限）时，再生成一级没有意义
+        if (simplified.empty() || simplified.size() * 10 > previousCount * 9)
+        {
+            break;
+        }
+        // 实测误差可能略低于上一级，取较大值使误差随级别单调，LOD 选择依赖这一点
+        error = std::max(error, simplifier.MeasureError());
+        previousCount = simplified.size();
+        std::vector<uint32_t> levelIndices = simplified;
+        OptimizeVertexCache(levelIndices.data(), levelIndices.size(), vertexCount);
+        chain.push_back({std::move(levelIndices), error});
+    }
+    return chain;
+}
+} // namespace MEngine
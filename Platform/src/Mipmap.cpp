@@ -0,0 +1,173 @@
+#include "Mipmap.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+
+namespace MEngine
+{
+namespace
+{
+constexpr uint32_t Channels = 4;
+constexpr uint32_t EncodeTableSize = 4096;
+
+struct SrgbTables
+{
+    std::array<float, 256> decode;
+    std::array<uint8_t, EncodeTableSize> encode;
+    SrgbTables()
+    {
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            float value = i / 255.0f;
+            decode[i] = value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+        }
+        for (uint32_t i = 0; i < EncodeTableSize; i++)
+        {
+            float value = static_cast<float>(i) / (EncodeTableSize - 1);
+            float srgb = value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+            encode[i] = static_cast<uint8_t>(std::clamp(srgb * 255.0f + 0.5f, 0.0f, 255.0f));
+        }
+    }
+};
+const SrgbTables &GetSrgbTables()
+{
+    static const SrgbTables tables;
+    return tables;
+}
+/**
+ * @brief 一个方向上目标纹素覆盖的源纹素及权重
+ */
+struct Taps
+{
+    std::array<uint32_t, 3> index;
+    std::array<float, 3> weight;
+    uint32_t count;
+};
+/**
+ * @brief 偶数边长取 2 个等权样本；奇数边长 2n+1 缩小到 n 时每个目标纹素覆盖 (2n+1)/n 个源纹素，
+ * 取 3 个样本按覆盖比例加权，每个源纹素的总权重相同，最后一行/列不会被丢弃
+ */
+std::vector<Taps> ComputeTaps(uint32_t srcExtent, uint32_t dstExtent)
+{
+    std::vector<Taps> taps(dstExtent);
+    for (uint32_t i = 0; i < dstExtent; i++)
+    {
+        if (srcExtent == 1)
+        {
+            taps[i] = {{0, 0, 0}, {1.0f, 0.0f, 0.0f}, 1};
+        }
+        else if (srcExtent % 2 == 0)
+        {
+            taps[i] = {{2 * i, 2 * i + 1, 0}, {0.5f, 0.5f, 0.0f}, 2};
+        }
+        else
+        {
+            float inverse = 1.0f / srcExtent;
+            taps[i] = {{2 * i, 2 * i + 1, 2 * i + 2},
+                       {(dstExtent - i) * inverse, dstExtent * inverse, (i + 1) * inverse},
+                       3};
+        }
+    }
+    return taps;
+}
+/**
+ * @brief 缩小一级，偶数边长为 2x2 盒式滤波，奇数边长在该方向上使用 3 个样本的加权盒式滤波
+ */
+void Downsample(const uint8_t *src, uint32_t srcWidth, uint32_t srcHeight, uint8_t *dst, uint32_t dstWidth,
+                uint32_t dstHeight, bool srgb)
+{
+    const auto &tables = GetSrgbTables();
+    size_t srcPitch = static_cast<size_t>(srcWidth) * Channels;
+    if (!srgb && srcWidth == dstWidth * 2 && srcHeight == dstHeight * 2)
+    {
+        // 常见的偶数尺寸路径，没有分支，便于编译器向量化
+        for (uint32_t y = 0; y < dstHeight; y++)
+        {
+            const uint8_t *row0 = src + 2 * y * srcPitch;
+            const uint8_t *row1 = row0 + srcPitch;
+            uint8_t *out = dst + static_cast<size_t>(y) * dstWidth * Channels;
+            for (uint32_t i = 0; i < dstWidth * Channels; i++)
+            {
+                uint32_t x = (i / Channels) * 2 * Channels + i % Channels;
+                uint32_t sum = row0[x] + row0[x + Channels] + row1[x] + row1[x + Channels];
+                out[i] = static_cast<uint8_t>((sum + 2) >> 2);
+            }
+        }
+        return;
+    }
+    auto columnTaps = ComputeTaps(srcWidth, dstWidth);
+    auto rowTaps = ComputeTaps(srcHeight, dstHeight);
+    for (uint32_t y = 0; y < dstHeight; y++)
+    {
+        const Taps &rowTap = rowTaps[y];
+        uint8_t *out = dst + static_cast<size_t>(y) * dstWidth * Channels;
+        for (uint32_t x = 0; x < dstWidth; x++)
+        {
+            const Taps &columnTap = columnTaps[x];
+            for (uint32_t c = 0; c < Channels; c++)
+            {
+                bool decode = srgb && c < 3;
+                float sum = 0.0f;
+                for (uint32_t j = 0; j < rowTap.count; j++)
+                {
+                    const uint8_t *row = src + rowTap.index[j] * srcPitch + c;
+                    for (uint32_t i = 0; i < columnTap.count; i++)
+                    {
+                        uint8_t value = row[columnTap.index[i] * Channels];
+                        float weight = rowTap.weight[j] * columnTap.weight[i];
+                        sum += weight * (decode ? tables.decode[value] : static_cast<float>(value));
+                    }
+                }
+                if (decode)
+                {
+                    auto index = static_cast<uint32_t>(std::clamp(sum, 0.0f, 1.0f) * (EncodeTableSize - 1) + 0.5f);
+                    out[x * Channels + c] = tables.encode[index];
+                }
+                else
+                {
+                    out[x * Channels + c] = static_cast<uint8_t>(std::clamp(sum + 0.5f, 0.0f, 255.0f));
+                }
+            }
+        }
+    }
+}
+} // namespace
+
+uint32_t CalculateMipLevels(uint32_t width, uint32_t height, uint32_t depth)
+{
+    uint32_t extent = std::max({width, height, depth, 1u});
+    uint32_t levels = 1;
+    while (extent > 1)
+    {
+        extent >>= 1;
+        levels++;
+    }
+    return levels;
+}
+uint64_t GetMipChainSize(uint32_t width, uint32_t height, uint32_t mipLevels, uint32_t texelSize)
+{
+    uint64_t size = 0;
+    for (uint32_t level = 0; level < mipLevels; level++)
+    {
+        size += static_cast<uint64_t>(GetMipExtent(width, level)) * GetMipExtent(height, level) * texelSize;
+    }
+    return size;
+}
+std::vector<uint8_t> GenerateMipChainRGBA8(const uint8_t *pixels, uint32_t width, uint32_t height,
+                                           uint32_t mipLevels, bool srgb)
+{
+    std::vector<uint8_t> chain(GetMipChainSize(width, height, mipLevels, Channels));
+    std::memcpy(chain.data(), pixels, static_cast<size_t>(width) * height * Channels);
+    uint8_t *src = chain.data();
+    for (uint32_t level = 1; level < mipLevels; level++)
+    {
+        uint32_t srcWidth = GetMipExtent(width, level - 1);
+        uint32_t srcHeight = GetMipExtent(height, level - 1);
+        uint8_t *dst = src + static_cast<size_t>(srcWidth) * srcHeight * Channels;
+        Downsample(src, srcWidth, srcHeight, dst, GetMipExtent(width, level), GetMipExtent(height, level), srgb);
+        src = dst;
+    }
+    return chain;
+}
+} // namespace MEngine
@@ -9,6 +9,7 @@ PipelineLayoutManager::PipelineLayoutManager(std::shared_ptr<ILogger> logger, st
     CreateGlobalDescriptorSetLayout();
     CreatePBRDescriptorSetLayout();
     CreatePhongDescriptorSetLayout();
+    CreateGPUCullingDescriptorSetLayout();
     // PipelineLayout
     CreateShadowDepthPipelineLayout();
     CreatePBRPipelineLayout();
@@ -22,6 +23,7 @@ PipelineLayoutManager::PipelineLayoutManager(std::shared_ptr<ILogger> logger, st
     CreateUIPipelineLayout();
     CreateSpritePipelineLayout();
     CreateToonPipelineLayout();
+    CreateGPUCullingPipelineLayout();
 }
 // DescriptorSetLayout
 void PipelineLayoutManager::CreateGlobalDescriptorSetLayout()
@@ -58,6 +60,21 @@ void PipelineLayoutManager::CreatePBRDescriptorSetLayout()
 void PipelineLayoutManager::CreatePhongDescriptorSetLayout()
 {
 }
+void PipelineLayoutManager::CreateGPUCullingDescriptorSetLayout()
+{
+    std::vector<vk::DescriptorSetLayoutBinding> gpuCullingDescriptorSetLayoutBindings{
+        mGPUCullingDescriptorLayoutBindings.mObjectBinding, mGPUCullingDescriptorLayoutBindings.mDrawCommandBinding,
+        mGPUCullingDescriptorLayoutBindings.mDrawCountBinding, mGPUCullingDescriptorLayoutBindings.mInstanceBinding};
+    vk::DescriptorSetLayoutCreateInfo gpuCullingDescriptorSetLayoutCreateInfo{};
+    gpuCullingDescriptorSetLayoutCreateInfo.setBindings(gpuCullingDescriptorSetLayoutBindings); // set: 0
+    mGPUCullingDescriptorSetLayout =
+        mContext->GetDevice().createDescriptorSetLayoutUnique(gpuCullingDescriptorSetLayoutCreateInfo);
+    if (!mGPUCullingDescriptorSetLayout)
+    {
+        mLogger->Error("Failed to create descriptor set layout for GPU culling");
+    }
+    mLogger->Info("GPU culling descriptor set layout created successfully");
+}
 // PipelineLayout
 void PipelineLayoutManager::CreateShadowDepthPipelineLayout()
 {
@@ -110,6 +127,23 @@ void PipelineLayoutManager::CreateSpritePipelineLayout()
 void PipelineLayoutManager::CreateToonPipelineLayout()
 {
 }
+void PipelineLayoutManager::CreateGPUCullingPipelineLayout()
+{
+    vk::PipelineLayoutCreateInfo pipelineLayoutCreateInfo;
+    std::vector<vk::DescriptorSetLayout> setLayouts{
+        mGPUCullingDescriptorSetLayout.get() // set: 0
+    };
+    std::array<vk::PushConstantRange, 1> pushConstantRanges;
+    pushConstantRanges[0].setOffset(0).setSize(sizeof(GPUCullingParams)).setStageFlags(vk::ShaderStageFlagBits::eCompute);
+    pipelineLayoutCreateInfo.setSetLayouts(setLayouts).setPushConstantRanges(pushConstantRanges);
+    auto pipelineLayout = mContext->GetDevice().createPipelineLayoutUnique(pipelineLayoutCreateInfo);
+    if (!pipelineLayout)
+    {
+        mLogger->Error("Failed to create pipeline layout for GPU culling");
+    }
+    mPipelineLayouts[PipelineLayoutType::GPUCulling] = std::move(pipelineLayout);
+    mLogger->Info("GPU culling pipeline layout created successfully");
+}
 vk::PipelineLayout PipelineLayoutManager::GetPipelineLayout(PipelineLayoutType type) const
 {
     auto it = mPipelineLayouts.find(type);
@@ -10,9 +10,14 @@ PipelineManager::PipelineManager(std::shared_ptr<ILogger> logger, std::shared_pt
       mRenderPassManager(renderPassManager)
 {
     CreateShadowMapPipeline();
-    CreateForwardOpaquePBRPipeline();
+    // 前向 PBR 管线为每种顶点格式各创建一份
+    for (auto format : {VertexFormat::Standard, VertexFormat::Quantized})
+    {
+        CreateForwardOpaquePBRPipeline(format);
+        CreateForwardOpaquePBRInstancedPipeline(format);
+        CreateForwardTransparentPBRPipeline(format);
+    }
     CreateForwardOpaquePhongPipeline();
-    CreateForwardTransparentPBRPipeline();
     CreateForwardTransparentPhongPipeline();
     CreateDeferredGBufferPipeline();
     CreateDeferredLightingPipeline();
@@ -23,6 +28,7 @@ PipelineManager::PipelineManager(std::shared_ptr<ILogger> logger, std::shared_pt
     CreateParticleCPUPipeline();
     CreateParticleGPUPipeline();
     CreateDecalPipeline();
+    CreateGPUCullingPipeline();
     CreatePostProcessToneMappingPipeline();
     CreatePostProcessBloomPipeline();
     CreatePostProcessDOFPipeline();
@@ -41,11 +47,12 @@ PipelineManager::PipelineManager(std::shared_ptr<ILogger> logger, std::shared_pt
 void PipelineManager::CreateShadowMapPipeline()
 {
 }
-void PipelineManager::CreateForwardOpaquePBRPipeline()
+void PipelineManager::CreateForwardOpaquePBRPipeline(VertexFormat format)
 {
+    bool isQuantized = format == VertexFormat::Quantized;
     // ========== 1. 顶点输入状态 ==========
-    auto vertexBindingDescription = Vertex::GetVertexInputBindingDescription();
-    auto vertexInputAttributeDescriptions = Vertex::GetVertexInputAttributeDescription();
+    auto vertexBindingDescription = Vertex::GetVertexInputBindingDescription(format);
+    auto vertexInputAttributeDescriptions = Vertex::GetVertexInputAttributeDescription(format);
     auto vertexAttributeDescriptions = std::vector<vk::VertexInputAttributeDescription>(
         vertexInputAttributeDescriptions.begin(), vertexInputAttributeDescriptions.end());
     vk::PipelineVertexInputStateCreateInfo vertexInputInfo{};
@@ -55,9 +62,13 @@ void PipelineManager::CreateForwardOpaquePBRPipeline()
     vk::PipelineInputAssemblyStateCreateInfo inputAssemblyInfo{};
     inputAssemblyInfo.setTopology(vk::PrimitiveTopology::eTriangleList).setPrimitiveRestartEnable(vk::False);
     // ========== 3. 着色器阶段 ==========
-    mShaderManager->LoadShaderModule("ForwardOpaquePBRVertexShader", "forwardOpaquePBR.vert.spv");
+    // 压缩顶点的着色器额外解码八面体法线，片段着色器共用
+    std::string vertexShaderName =
+        isQuantized ? "ForwardOpaquePBRQuantizedVertexShader" : "ForwardOpaquePBRVertexShader";
+    mShaderManager->LoadShaderModule(vertexShaderName,
+                                     isQuantized ? "forwardOpaquePBRQuantized.vert.spv" : "forwardOpaquePBR.vert.spv");
     mShaderManager->LoadShaderModule("ForwardOpaquePBRFragmentShader", "forwardOpaquePBR.frag.spv");
-    auto vertexShader = mShaderManager->GetShaderModule("ForwardOpaquePBRVertexShader");
+    auto vertexShader = mShaderManager->GetShaderModule(vertexShaderName);
     auto fragmentShader = mShaderManager->GetShaderModule("ForwardOpaquePBRFragmentShader");
     std::array<vk::PipelineShaderStageCreateInfo, 2> shaderStages = {vk::PipelineShaderStageCreateInfo()
                                                                          .setStage(vk::ShaderStageFlagBits::eVertex)
@@ -145,17 +156,134 @@ void PipelineManager::CreateForwardOpaquePBRPipeline()
     {
         mLogger->Error("Failed to create Forward Forward Opaque PBR pipeline");
     }
-    mPipelines[PipelineType::ForwardOpaquePBR] = std::move(pipeline.value);
-    mLogger->Info("Forward Opaque PBR pipeline created successfully");
+    mPipelines[static_cast<size_t>(format)][PipelineType::ForwardOpaquePBR] = std::move(pipeline.value);
+    mLogger->Info("Forward Opaque PBR pipeline ({}) created successfully", magic_enum::enum_name(format));
+}
+void PipelineManager::CreateForwardOpaquePBRInstancedPipeline(VertexFormat format)
+{
+    bool isQuantized = format == VertexFormat::Quantized;
+    // ========== 1. 顶点输入状态 ==========
+    // binding 0: 顶点，binding 1: 实例
+    std::array<vk::VertexInputBindingDescription, 2> vertexBindingDescriptions = {
+        Vertex::GetVertexInputBindingDescription(format), Vertex::GetInstanceInputBindingDescription()};
+    auto vertexInputAttributeDescriptions = Vertex::GetVertexInputAttributeDescription(format);
+    auto instanceInputAttributeDescriptions = Vertex::GetInstanceInputAttributeDescription();
+    auto vertexAttributeDescriptions = std::vector<vk::VertexInputAttributeDescription>(
+        vertexInputAttributeDescriptions.begin(), vertexInputAttributeDescriptions.end());
+    vertexAttributeDescriptions.insert(vertexAttributeDescriptions.end(), instanceInputAttributeDescriptions.begin(),
+                                       instanceInputAttributeDescriptions.end());
+    vk::PipelineVertexInputStateCreateInfo vertexInputInfo{};
+    vertexInputInfo.setVertexBindingDescriptions(vertexBindingDescriptions)
+        .setVertexAttributeDescriptions(vertexAttributeDescriptions);
+    // ========== 2. 输入装配状态 ==========
+    vk::PipelineInputAssemblyStateCreateInfo inputAssemblyInfo{};
+    inputAssemblyInfo.setTopology(vk::PrimitiveTopology::eTriangleList).setPrimitiveRestartEnable(vk::False);
+    // ========== 3. 着色器阶段 ==========
+    // 片段着色器与非实例化管线共用，已在 CreateForwardOpaquePBRPipeline 中加载
+    std::string vertexShaderName =
+        isQuantized ? "ForwardOpaquePBRInstancedQuantizedVertexShader" : "ForwardOpaquePBRInstancedVertexShader";
+    mShaderManager->LoadShaderModule(vertexShaderName, isQuantized ? "forwardOpaquePBRInstancedQuantized.vert.spv"
+                                                                   : "forwardOpaquePBRInstanced.vert.spv");
+    auto vertexShader = mShaderManager->GetShaderModule(vertexShaderName);
+    auto fragmentShader = mShaderManager->GetShaderModule("ForwardOpaquePBRFragmentShader");
+    std::array<vk::PipelineShaderStageCreateInfo, 2> shaderStages = {vk::PipelineShaderStageCreateInfo()
+                                                                         .setStage(vk::ShaderStageFlagBits::eVertex)
+                                                                         .setModule(vertexShader)
+                                                                         .setPName("main"),
+                                                                     vk::PipelineShaderStageCreateInfo()
+                                                                         .setStage(vk::ShaderStageFlagBits::eFragment)
+                                                                         .setModule(fragmentShader)
+                                                                         .setPName("main")};
+    // ========== 4. 视口和裁剪 ==========
+    // Swapchain的宽高和Surface的宽高一致
+    vk::Viewport viewport{};
+    vk::Rect2D scissor{};
+    viewport = vk::Viewport()
+                   .setX(0.0f)
+                   .setY(0.0f)
+                   .setWidth(static_cast<float>(mContext->GetSurfaceInfo().extent.width))
+                   .setHeight(static_cast<float>(mContext->GetSurfaceInfo().extent.height))
+                   .setMinDepth(0.0f)
+                   .setMaxDepth(1.0f);
+    scissor = vk::Rect2D().setOffset({0, 0}).setExtent(mContext->GetSurfaceInfo().extent);
+    vk::PipelineViewportStateCreateInfo viewportInfo;
+    viewportInfo.setViewports(viewport).setScissors(scissor);
+    // ========== 5. 光栅化状态 ==========
+    vk::PipelineRasterizationStateCreateInfo rasterizationInfo{};
+    rasterizationInfo.setDepthClampEnable(vk::False)
+        .setRasterizerDiscardEnable(vk::False)
+        .setPolygonMode(vk::PolygonMode::eFill)
+        .setLineWidth(1.0f)
+        .setCullMode(vk::CullModeFlagBits::eBack)
+        .setFrontFace(vk::FrontFace::eClockwise)
+        .setDepthBiasEnable(vk::False);
+    // ========= 6. 多重采样 ==========
+    vk::PipelineMultisampleStateCreateInfo multisampleInfo{};
+    multisampleInfo.setSampleShadingEnable(vk::False)
+        .setRasterizationSamples(vk::SampleCountFlagBits::e1)
+        .setMinSampleShading(1.0f)
+        .setPSampleMask(nullptr)
+        .setAlphaToCoverageEnable(vk::False)
+        .setAlphaToOneEnable(vk::False);
+    // ========== 7. 深度模板测试 ==========
+    vk::PipelineDepthStencilStateCreateInfo depthStencilInfo{};
+    depthStencilInfo.setDepthTestEnable(vk::True)
+        .setDepthWriteEnable(vk::True)
+        .setDepthCompareOp(vk::CompareOp::eLessOrEqual)
+        .setDepthBoundsTestEnable(vk::False)
+        .setMinDepthBounds(0.0f)
+        .setMaxDepthBounds(1.0f)
+        .setStencilTestEnable(vk::False);
+    // ========== 8. 颜色混合状态 ==========
+    vk::PipelineColorBlendAttachmentState colorBlendAttachment{};
+    colorBlendAttachment.setBlendEnable(vk::False).setColorWriteMask(
+        vk::ColorComponentFlagBits::eR | vk::ColorComponentFlagBits::eG | vk::ColorComponentFlagBits::eB |
+        vk::ColorComponentFlagBits::eA);
+    vk::PipelineColorBlendStateCreateInfo colorBlendInfo{};
+    colorBlendInfo.setLogicOpEnable(vk::False)
+        .setLogicOp(vk::LogicOp::eCopy)
+        .setAttachments(colorBlendAttachment)
+        .setBlendConstants({0.0f, 0.0f, 0.0f, 0.0f});
+    // ========== 9. 动态状态 ==========
+    std::vector<vk::DynamicState> dynamicStates = {vk::DynamicState::eViewport, vk::DynamicState::eScissor};
+    vk::PipelineDynamicStateCreateInfo dynamicStateInfo{};
+    dynamicStateInfo.setDynamicStates(dynamicStates);
+    // ========== 10. 管线布局 ==========
+    auto pipelineLayout = mPipelineLayoutManager->GetPipelineLayout(PipelineLayoutType::PBR);
+    // ========== 11. 渲染通道 ==========
+    auto renderPass = mRenderPassManager->GetRenderPass(RenderPassType::ForwardComposition);
+    // ========== 12. 管线创建 ==========
+    vk::GraphicsPipelineCreateInfo pipelineInfo{};
+    pipelineInfo.setStageCount(static_cast<uint32_t>(shaderStages.size()))
+        .setPStages(shaderStages.data())
+        .setPVertexInputState(&vertexInputInfo)
+        .setPInputAssemblyState(&inputAssemblyInfo)
+        .setPViewportState(&viewportInfo)
+        .setPRasterizationState(&rasterizationInfo)
+        .setPMultisampleState(&multisampleInfo)
+        .setPDepthStencilState(&depthStencilInfo)
+        .setPColorBlendState(&colorBlendInfo)
+        .setPDynamicState(&dynamicStateInfo)
+        .setLayout(pipelineLayout)
+        .setRenderPass(renderPass)
+        .setSubpass(0);
+    auto pipeline = mContext->GetDevice().createGraphicsPipelineUnique(nullptr, pipelineInfo);
+    if (pipeline.result != vk::Result::eSuccess)
+    {
+        mLogger->Error("Failed to create Forward Opaque PBR Instanced pipeline");
+    }
+    mPipelines[static_cast<size_t>(format)][PipelineType::ForwardOpaquePBRInstanced] = std::move(pipeline.value);
+    mLogger->Info("Forward Opaque PBR Instanced pipeline ({}) created successfully", magic_enum::enum_name(format));
 }
 void PipelineManager::CreateForwardOpaquePhongPipeline()
 {
 }
-void PipelineManager::CreateForwardTransparentPBRPipeline()
+void PipelineManager::CreateForwardTransparentPBRPipeline(VertexFormat format)
 {
     // ========== 1. 顶点输入状态 ==========
-    auto vertexBindingDescription = Vertex::GetVertexInputBindingDescription();
-    auto vertexInputAttributeDescriptions = Vertex::GetVertexInputAttributeDescription();
+    // 半透明着色器只读取位置与纹理坐标，两种顶点格式共用同一个着色器
+    auto vertexBindingDescription = Vertex::GetVertexInputBindingDescription(format);
+    auto vertexInputAttributeDescriptions = Vertex::GetVertexInputAttributeDescription(format);
     auto vertexAttributeDescriptions = std::vector<vk::VertexInputAttributeDescription>(
         vertexInputAttributeDescriptions.begin(), vertexInputAttributeDescriptions.end());
     vk::PipelineVertexInputStateCreateInfo vertexInputInfo{};
@@ -230,8 +358,9 @@ void PipelineManager::CreateForwardTransparentPBRPipeline()
         .setCompareMask(0xFF)                 // 比较掩码（全位参与比较）
         .setWriteMask(0xFF)                   // 写入掩码（全位允许写入）
         .setReference(1);                     // 参考值（运行时动态设置）
+    // 与不透明物体共享深度缓冲区：只测试不写入，由远到近的绘制顺序负责正确混合
     depthStencilInfo.setDepthTestEnable(vk::True)
-        .setDepthWriteEnable(vk::True)
+        .setDepthWriteEnable(vk::False)
         .setDepthCompareOp(vk::CompareOp::eLessOrEqual)
         .setDepthBoundsTestEnable(vk::False)
         .setMinDepthBounds(0.0f)
@@ -243,14 +372,14 @@ void PipelineManager::CreateForwardTransparentPBRPipeline()
     // ========== 8. 颜色混合 ==========
     std::array<vk::PipelineColorBlendAttachmentState, 1> colorBlendAttachments{
         vk::PipelineColorBlendAttachmentState()
-            .setBlendEnable(vk::False) // 是否启用混合
+            .setBlendEnable(vk::True) // 是否启用混合
             .setColorWriteMask(vk::ColorComponentFlagBits::eR | vk::ColorComponentFlagBits::eG |
                                vk::ColorComponentFlagBits::eB | vk::ColorComponentFlagBits::eA) // 写入掩码
-            .setSrcColorBlendFactor(vk::BlendFactor::eOne)                                      // 源颜色混合因子
-            .setDstColorBlendFactor(vk::BlendFactor::eZero)                                     // 目标颜色混合因子
+            .setSrcColorBlendFactor(vk::BlendFactor::eSrcAlpha)                                 // 源颜色混合因子
+            .setDstColorBlendFactor(vk::BlendFactor::eOneMinusSrcAlpha)                         // 目标颜色混合因子
             .setColorBlendOp(vk::BlendOp::eAdd)                                                 // 混合操作
             .setSrcAlphaBlendFactor(vk::BlendFactor::eOne)                                      // 源Alpha混合因子
-            .setDstAlphaBlendFactor(vk::BlendFactor::eZero)                                     // 目标Alpha混合因子
+            .setDstAlphaBlendFactor(vk::BlendFactor::eOneMinusSrcAlpha)                         // 目标Alpha混合因子
             .setAlphaBlendOp(vk::BlendOp::eAdd)};
     auto blendConstants = std::array<float, 4>{0.0f, 0.0f, 0.0f, 0.0f}; // 混合常量
     vk::PipelineColorBlendStateCreateInfo colorBlendInfo{};
@@ -269,8 +398,8 @@ void PipelineManager::CreateForwardTransparentPBRPipeline()
         .setPVertexInputState(&vertexInputInfo)
         .setStages(shaderStages)
         .setLayout(mPipelineLayoutManager->GetPipelineLayout(PipelineLayoutType::PBR))
-        .setRenderPass(mRenderPassManager->GetRenderPass(RenderPassType::Transparent))
-        .setSubpass(0)
+        .setRenderPass(mRenderPassManager->GetRenderPass(RenderPassType::ForwardComposition))
+        .setSubpass(1) // ForwardComposition 的透明物体子通道
         .setPRasterizationState(&rasterizationInfo)
         .setPMultisampleState(&multisampleInfo)
         .setPDepthStencilState(&depthStencilInfo)
@@ -281,8 +410,8 @@ void PipelineManager::CreateForwardTransparentPBRPipeline()
     {
         mLogger->Error("Failed to create ForwardTransparent pipeline");
     }
-    mPipelines[PipelineType::ForwardTransparentPBR] = std::move(pipeline.value);
-    mLogger->Info("Create ForwardTransparent pipeline success");
+    mPipelines[static_cast<size_t>(format)][PipelineType::ForwardTransparentPBR] = std::move(pipeline.value);
+    mLogger->Info("Create ForwardTransparent pipeline ({}) success", magic_enum::enum_name(format));
 }
 void PipelineManager::CreateForwardTransparentPhongPipeline()
 {
@@ -314,6 +443,23 @@ void PipelineManager::CreateParticleGPUPipeline()
 void PipelineManager::CreateDecalPipeline()
 {
 }
+void PipelineManager::CreateGPUCullingPipeline()
+{
+    mShaderManager->LoadShaderModule("GPUCullingComputeShader", "gpuCulling.comp.spv");
+    auto computeShader = mShaderManager->GetShaderModule("GPUCullingComputeShader");
+    vk::PipelineShaderStageCreateInfo shaderStage{};
+    shaderStage.setStage(vk::ShaderStageFlagBits::eCompute).setModule(computeShader).setPName("main");
+    vk::ComputePipelineCreateInfo pipelineInfo{};
+    pipelineInfo.setStage(shaderStage).setLayout(
+        mPipelineLayoutManager->GetPipelineLayout(PipelineLayoutType::GPUCulling));
+    auto pipeline = mContext->GetDevice().createComputePipelineUnique(nullptr, pipelineInfo);
+    if (pipeline.result != vk::Result::eSuccess)
+    {
+        mLogger->Error("Failed to create GPU culling pipeline");
+    }
+    mPipelines[static_cast<size_t>(VertexFormat::Standard)][PipelineType::GPUCulling] = std::move(pipeline.value);
+    mLogger->Info("GPU culling pipeline created successfully");
+}
 void PipelineManager::CreatePostProcessToneMappingPipeline()
 {
 }
@@ -357,16 +503,17 @@ void PipelineManager::CreateWireframePipeline()
 {
 }
 
-vk::Pipeline PipelineManager::GetPipeline(PipelineType type) const
+vk::Pipeline PipelineManager::GetPipeline(PipelineType type, VertexFormat format) const
 {
-    auto it = mPipelines.find(type);
-    if (it != mPipelines.end())
+    const auto &pipelines = mPipelines[static_cast<size_t>(format)];
+    auto it = pipelines.find(type);
+    if (it != pipelines.end())
     {
         return it->second.get();
     }
     else
     {
-        mLogger->Error("Pipeline not found: {}", static_cast<int>(type));
+        mLogger->Error("Pipeline not found: {} ({})", static_cast<int>(type), magic_enum::enum_name(format));
         return nullptr;
     }
 }
@@ -0,0 +1,53 @@
+#include "QueueOwnership.hpp"
+
+namespace MEngine
+{
+std::optional<uint32_t> FindQueueFamily(const std::vector<vk::QueueFamilyProperties> &families,
+                                        vk::QueueFlags required, vk::QueueFlags avoid)
+{
+    for (uint32_t i = 0; i < families.size(); i++)
+    {
+        auto flags = families[i].queueFlags;
+        if (families[i].queueCount > 0 && (flags & required) == required && !(flags & avoid))
+        {
+            return i;
+        }
+    }
+    return std::nullopt;
+}
+ImageOwnershipTransfer MakeImageOwnershipTransfer(vk::Image image, const vk::ImageSubresourceRange &range,
+                                                  vk::ImageLayout oldLayout, vk::ImageLayout newLayout,
+                                                  vk::AccessFlags srcAccess, vk::AccessFlags dstAccess,
+                                                  uint32_t srcFamily, uint32_t dstFamily)
+{
+    ImageOwnershipTransfer transfer{};
+    // 布局转换只在其中一次执行，但两侧必须声明相同的 old/new layout
+    transfer.release.setImage(image)
+        .setOldLayout(oldLayout)
+        .setNewLayout(newLayout)
+        .setSrcAccessMask(srcAccess)
+        .setDstAccessMask({})
+        .setSrcQueueFamilyIndex(srcFamily)
+        .setDstQueueFamilyIndex(dstFamily)
+        .setSubresourceRange(range);
+    transfer.acquire = transfer.release;
+    transfer.acquire.setSrcAccessMask({}).setDstAccessMask(dstAccess);
+    return transfer;
+}
+BufferOwnershipTransfer MakeBufferOwnershipTransfer(vk::Buffer buffer, vk::DeviceSize offset, vk::DeviceSize size,
+                                                    vk::AccessFlags srcAccess, vk::AccessFlags dstAccess,
+                                                    uint32_t srcFamily, uint32_t dstFamily)
+{
+    BufferOwnershipTransfer transfer{};
+    transfer.release.setBuffer(buffer)
+        .setOffset(offset)
+        .setSize(size)
+        .setSrcAccessMask(srcAccess)
+        .setDstAccessMask({})
+        .setSrcQueueFamilyIndex(srcFamily)
+        .setDstQueueFamilyIndex(dstFamily);
+    transfer.acquire = transfer.release;
+    transfer.acquire.setSrcAccessMask({}).setDstAccessMask(dstAccess);
+    return transfer;
+}
+} // namespace MEngine
@@ -2,17 +2,83 @@
 
 namespace MEngine
 {
+namespace
+{
+template <typename T> void HashCombine(size_t &seed, const T &value)
+{
+    seed ^= std::hash<T>{}(value) + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
+}
+} // namespace
+size_t SamplerCreateInfoHash::operator()(const vk::SamplerCreateInfo &info) const noexcept
+{
+    size_t seed = 0;
+    HashCombine(seed, static_cast<VkSamplerCreateFlags>(info.flags));
+    HashCombine(seed, static_cast<uint32_t>(info.magFilter));
+    HashCombine(seed, static_cast<uint32_t>(info.minFilter));
+    HashCombine(seed, static_cast<uint32_t>(info.mipmapMode));
+    HashCombine(seed, static_cast<uint32_t>(info.addressModeU));
+    HashCombine(seed, static_cast<uint32_t>(info.addressModeV));
+    HashCombine(seed, static_cast<uint32_t>(info.addressModeW));
+    HashCombine(seed, info.mipLodBias);
+    HashCombine(seed, info.anisotropyEnable);
+    HashCombine(seed, info.maxAnisotropy);
+    HashCombine(seed, info.compareEnable);
+    HashCombine(seed, static_cast<uint32_t>(info.compareOp));
+    HashCombine(seed, info.minLod);
+    HashCombine(seed, info.maxLod);
+    HashCombine(seed, static_cast<uint32_t>(info.borderColor));
+    HashCombine(seed, info.unnormalizedCoordinates);
+    return seed;
+}
 SamplerManager::SamplerManager(std::shared_ptr<ILogger> logger, std::shared_ptr<Context> context)
     : mLogger(logger), mContext(context)
 {
 }
-vk::UniqueSampler SamplerManager::CreateUniqueSampler(vk::Filter magFilter, vk::Filter minFilter,
-                                                      vk::SamplerMipmapMode mipmapMode,
-                                                      vk::SamplerAddressMode addressMode, float mipLodBias,
-                                                      vk::Bool32 anisotropyEnable, float maxAnisotropy,
-                                                      vk::Bool32 compareEnable, vk::CompareOp compareOp, float minLod,
-                                                      float maxLod, vk::BorderColor borderColor,
-                                                      vk::Bool32 unnormalizedCoordinates)
+SharedSampler SamplerManager::GetSampler(const vk::SamplerCreateInfo &samplerCreateInfo)
+{
+    if (samplerCreateInfo.pNext)
+    {
+        mLogger->Error("Sampler cache does not support pNext chains");
+        throw std::invalid_argument("Sampler cache does not support pNext chains");
+    }
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStats.requests++;
+    if (auto it = mSamplers.find(samplerCreateInfo); it != mSamplers.end())
+    {
+        if (auto sampler = it->second.lock())
+        {
+            mStats.hits++;
+            return sampler;
+        }
+    }
+    auto limit = mContext->GetPhysicalDevice().getProperties().limits.maxSamplerAllocationCount;
+    if (PurgeExpiredLocked() >= limit)
+    {
+        mLogger->Error("Sampler count reached the device limit of {}", limit);
+        throw std::runtime_error("Sampler count reached the device limit");
+    }
+    auto sampler =
+        std::make_shared<const vk::UniqueSampler>(mContext->GetDevice().createSamplerUnique(samplerCreateInfo));
+    mSamplers[samplerCreateInfo] = sampler;
+    mLogger->Debug("Sampler created, {} live samplers", mSamplers.size());
+    return sampler;
+}
+size_t SamplerManager::PurgeExpiredLocked()
+{
+    std::erase_if(mSamplers, [](const auto &entry) { return entry.second.expired(); });
+    return mSamplers.size();
+}
+SamplerCacheStats SamplerManager::GetStats()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStats.liveSamplers = PurgeExpiredLocked();
+    return mStats;
+}
+SharedSampler SamplerManager::GetSampler(vk::Filter magFilter, vk::Filter minFilter, vk::SamplerMipmapMode mipmapMode,
+                                         vk::SamplerAddressMode addressMode, float mipLodBias,
+                                         vk::Bool32 anisotropyEnable, float maxAnisotropy, vk::Bool32 compareEnable,
+                                         vk::CompareOp compareOp, float minLod, float maxLod,
+                                         vk::BorderColor borderColor, vk::Bool32 unnormalizedCoordinates)
 {
     vk::SamplerCreateInfo samplerCreateInfo;
     samplerCreateInfo
@@ -42,9 +108,13 @@ vk::UniqueSampler SamplerManager::CreateUniqueSampler(vk::Filter magFilter, vk::
         .setUnnormalizedCoordinates(
             unnormalizedCoordinates); // 是否使用非归一化坐标：设为 VK_TRUE 时，纹理坐标范围为 [0, texWidth]、[0,
                                       // texHeight]、[0, texDepth]，而非 [0, 1]
-    auto sampler = mContext->GetDevice().createSamplerUnique(samplerCreateInfo);
-    mLogger->Debug("Sampler created");
-    return sampler;
+    return GetSampler(samplerCreateInfo);
+}
+SharedSampler SamplerManager::GetTextureSampler(uint32_t mipLevels, vk::SamplerAddressMode addressMode)
+{
+    // maxLod 为最后一级的索引，只有一级时退化为普通双线性采样
+    return GetSampler(vk::Filter::eLinear, vk::Filter::eLinear, vk::SamplerMipmapMode::eLinear, addressMode, 0.0f,
+                      vk::False, 16.0f, vk::False, vk::CompareOp::eAlways, 0.0f,
+                      static_cast<float>(mipLevels > 0 ? mipLevels - 1 : 0));
 }
-
 } // namespace MEngine
\ No newline at end of file
@@ -34,4 +34,19 @@ vk::UniqueSemaphore SyncPrimitiveManager::CreateUniqueSemaphore()
     mLogger->Debug("Semaphore created");
     return semaphore;
 }
+vk::UniqueSemaphore SyncPrimitiveManager::CreateTimelineSemaphore(uint64_t initialValue)
+{
+    vk::SemaphoreTypeCreateInfo semaphoreTypeCreateInfo{};
+    semaphoreTypeCreateInfo.setSemaphoreType(vk::SemaphoreType::eTimeline).setInitialValue(initialValue);
+    vk::SemaphoreCreateInfo semaphoreCreateInfo{};
+    semaphoreCreateInfo.setPNext(&semaphoreTypeCreateInfo);
+    auto semaphore = mContext->GetDevice().createSemaphoreUnique(semaphoreCreateInfo);
+    if (!semaphore)
+    {
+        mLogger->Error("Failed to create timeline semaphore");
+        throw std::runtime_error("Failed to create timeline semaphore");
+    }
+    mLogger->Debug("Timeline semaphore created");
+    return semaphore;
+}
 } // namespace MEngine
\ No newline at end of file
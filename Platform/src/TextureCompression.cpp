@@ -0,0 +1,469 @@
+#include "TextureCompression.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MENGINE_BLOCK_SSE 1
+#include <emmintrin.h>
+#endif
+
+namespace MEngine
+{
+namespace
+{
+struct Block
+{
+    alignas(16) uint8_t pixels[16][4];
+};
+/**
+ * @brief 读取 (blockX, blockY) 处的 4x4 块，越界部分复制边缘像素
+ */
+void LoadBlock(const uint8_t *rgba, uint32_t width, uint32_t height, uint32_t blockX, uint32_t blockY, Block &block)
+{
+    for (uint32_t y = 0; y < 4; y++)
+    {
+        uint32_t sourceY = std::min(blockY * 4 + y, height - 1);
+        for (uint32_t x = 0; x < 4; x++)
+        {
+            uint32_t sourceX = std::min(blockX * 4 + x, width - 1);
+            std::memcpy(block.pixels[y * 4 + x], rgba + (static_cast<size_t>(sourceY) * width + sourceX) * 4, 4);
+        }
+    }
+}
+/**
+ * @brief 块内每个通道的最小/最大值
+ */
+void ComputeBounds(const Block &block, uint8_t minimum[4], uint8_t maximum[4])
+{
+#if defined(MENGINE_BLOCK_SSE)
+    // 每个寄存器装 4 个 RGBA 像素，先两两合并 16 个像素，再把寄存器内的 4 个像素折叠成 1 个
+    __m128i row0 = _mm_load_si128(reinterpret_cast<const __m128i *>(block.pixels[0]));
+    __m128i row1 = _mm_load_si128(reinterpret_cast<const __m128i *>(block.pixels[4]));
+    __m128i row2 = _mm_load_si128(reinterpret_cast<const __m128i *>(block.pixels[8]));
+    __m128i row3 = _mm_load_si128(reinterpret_cast<const __m128i *>(block.pixels[12]));
+    __m128i low = _mm_min_epu8(_mm_min_epu8(row0, row1), _mm_min_epu8(row2, row3));
+    __m128i high = _mm_max_epu8(_mm_max_epu8(row0, row1), _mm_max_epu8(row2, row3));
+    low = _mm_min_epu8(low, _mm_srli_si128(low, 8));
+    low = _mm_min_epu8(low, _mm_srli_si128(low, 4));
+    high = _mm_max_epu8(high, _mm_srli_si128(high, 8));
+    high = _mm_max_epu8(high, _mm_srli_si128(high, 4));
+    uint32_t packedLow = static_cast<uint32_t>(_mm_cvtsi128_si32(low));
+    uint32_t packedHigh = static_cast<uint32_t>(_mm_cvtsi128_si32(high));
+    std::memcpy(minimum, &packedLow, 4);
+    std::memcpy(maximum, &packedHigh, 4);
+#else
+    for (uint32_t c = 0; c < 4; c++)
+    {
+        minimum[c] = 255;
+        maximum[c] = 0;
+        for (const auto &pixel : block.pixels)
+        {
+            minimum[c] = std::min(minimum[c], pixel[c]);
+            maximum[c] = std::max(maximum[c], pixel[c]);
+        }
+    }
+#endif
+}
+/**
+ * @brief 为块内 16 个像素在 count 个调色板颜色中选出平方误差最小的索引，误差相同时取较小的索引
+ * channels 为 3 时忽略 alpha（BC1），为 4 时比较 RGBA（BC7），count 不超过 16
+ */
+void FindClosestIndices(const Block &block, const int (*palette)[4], uint32_t count, int channels,
+                        uint32_t indices[16])
+{
+#if defined(MENGINE_BLOCK_SSE)
+    // 像素扩展到 16 位后，madd 一次得到每个像素的 dr²+dg² 与 db²+da²，两两相加即为误差，4 个像素同时比较
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i channelMask = _mm_set1_epi32(channels == 3 ? 0x00FFFFFF : -1);
+    __m128i colors[16];
+    for (uint32_t p = 0; p < count; p++)
+    {
+        auto alpha = static_cast<int16_t>(channels == 3 ? 0 : palette[p][3]);
+        auto r = static_cast<int16_t>(palette[p][0]);
+        auto g = static_cast<int16_t>(palette[p][1]);
+        auto b = static_cast<int16_t>(palette[p][2]);
+        colors[p] = _mm_setr_epi16(r, g, b, alpha, r, g, b, alpha);
+    }
+    for (uint32_t group = 0; group < 4; group++)
+    {
+        __m128i pixels = _mm_load_si128(reinterpret_cast<const __m128i *>(block.pixels[group * 4]));
+        pixels = _mm_and_si128(pixels, channelMask);
+        __m128i low = _mm_unpacklo_epi8(pixels, zero);
+        __m128i high = _mm_unpackhi_epi8(pixels, zero);
+        __m128i bestError = _mm_set1_epi32(INT32_MAX);
+        __m128i bestIndex = zero;
+        for (uint32_t p = 0; p < count; p++)
+        {
+            __m128i lowDelta = _mm_sub_epi16(low, colors[p]);
+            __m128i highDelta = _mm_sub_epi16(high, colors[p]);
+            __m128 lowSum = _mm_castsi128_ps(_mm_madd_epi16(lowDelta, lowDelta));
+            __m128 highSum = _mm_castsi128_ps(_mm_madd_epi16(highDelta, highDelta));
+            __m128i error = _mm_add_epi32(_mm_castps_si128(_mm_shuffle_ps(lowSum, highSum, _MM_SHUFFLE(2, 0, 2, 0))),
+                                          _mm_castps_si128(_mm_shuffle_ps(lowSum, highSum, _MM_SHUFFLE(3, 1, 3, 1))));
+            __m128i better = _mm_cmplt_epi32(error, bestError);
+            bestError = _mm_or_si128(_mm_and_si128(better, error), _mm_andnot_si128(better, bestError));
+            bestIndex = _mm_or_si128(_mm_and_si128(better, _mm_set1_epi32(static_cast<int>(p))),
+                                     _mm_andnot_si128(better, bestIndex));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(indices + group * 4), bestIndex);
+    }
+#else
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        int bestError = INT32_MAX;
+        for (uint32_t p = 0; p < count; p++)
+        {
+            int error = 0;
+            for (int c = 0; c < channels; c++)
+            {
+                int delta = block.pixels[i][c] - palette[p][c];
+                error += delta * delta;
+            }
+            if (error < bestError)
+            {
+                bestError = error;
+                indices[i] = p;
+            }
+        }
+    }
+#endif
+}
+/**
+ * @brief 沿块颜色分布的主轴投影，得到主轴两端作为端点，N 为参与的通道数
+ */
+template <int N>
+void FindEndpoints(const Block &block, const uint8_t minimum[4], const uint8_t maximum[4], float start[4],
+                   float end[4])
+{
+    float mean[N]{};
+    for (const auto &pixel : block.pixels)
+    {
+        for (int c = 0; c < N; c++)
+        {
+            mean[c] += pixel[c];
+        }
+    }
+    for (int c = 0; c < N; c++)
+    {
+        mean[c] /= 16.0f;
+    }
+    float covariance[N][N]{};
+    for (const auto &pixel : block.pixels)
+    {
+        for (int i = 0; i < N; i++)
+        {
+            for (int j = 0; j < N; j++)
+            {
+                covariance[i][j] += (pixel[i] - mean[i]) * (pixel[j] - mean[j]);
+            }
+        }
+    }
+    // 以包围盒对角线为初值做幂迭代
+    float axis[N];
+    for (int c = 0; c < N; c++)
+    {
+        axis[c] = static_cast<float>(maximum[c] - minimum[c]);
+    }
+    for (int iteration = 0; iteration < 8; iteration++)
+    {
+        float next[N]{};
+        float largest = 0.0f;
+        for (int i = 0; i < N; i++)
+        {
+            for (int j = 0; j < N; j++)
+            {
+                next[i] += covariance[i][j] * axis[j];
+            }
+            largest = std::max(largest, std::abs(next[i]));
+        }
+        if (largest <= 0.0f)
+        {
+            break;
+        }
+        for (int c = 0; c < N; c++)
+        {
+            axis[c] = next[c] / largest;
+        }
+    }
+    float length = 0.0f;
+    for (int c = 0; c < N; c++)
+    {
+        length += axis[c] * axis[c];
+    }
+    if (length <= 0.0f)
+    {
+        for (int c = 0; c < N; c++)
+        {
+            start[c] = end[c] = mean[c];
+        }
+        return;
+    }
+    length = std::sqrt(length);
+    float minT = 0.0f;
+    float maxT = 0.0f;
+    for (const auto &pixel : block.pixels)
+    {
+        float t = 0.0f;
+        for (int c = 0; c < N; c++)
+        {
+            t += (pixel[c] - mean[c]) * axis[c] / length;
+        }
+        minT = std::min(minT, t);
+        maxT = std::max(maxT, t);
+    }
+    for (int c = 0; c < N; c++)
+    {
+        start[c] = std::clamp(mean[c] + axis[c] / length * minT, 0.0f, 255.0f);
+        end[c] = std::clamp(mean[c] + axis[c] / length * maxT, 0.0f, 255.0f);
+    }
+}
+uint16_t PackRGB565(const float color[4])
+{
+    auto r = static_cast<uint16_t>(std::lround(color[0] * 31.0f / 255.0f));
+    auto g = static_cast<uint16_t>(std::lround(color[1] * 63.0f / 255.0f));
+    auto b = static_cast<uint16_t>(std::lround(color[2] * 31.0f / 255.0f));
+    return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+}
+std::array<int, 3> UnpackRGB565(uint16_t color)
+{
+    int r = (color >> 11) & 31;
+    int g = (color >> 5) & 63;
+    int b = color & 31;
+    return {(r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2)};
+}
+void EncodeBC1(const Block &block, uint8_t *out)
+{
+    uint8_t minimum[4], maximum[4];
+    ComputeBounds(block, minimum, maximum);
+    float start[4], end[4];
+    FindEndpoints<3>(block, minimum, maximum, start, end);
+    uint16_t color0 = PackRGB565(end);
+    uint16_t color1 = PackRGB565(start);
+    if (color0 < color1)
+    {
+        std::swap(color0, color1);
+    }
+    uint32_t indices = 0;
+    if (color0 != color1)
+    {
+        // color0 > color1 时为不透明 4 色模式
+        auto c0 = UnpackRGB565(color0);
+        auto c1 = UnpackRGB565(color1);
+        int palette[4][4]{};
+        for (int c = 0; c < 3; c++)
+        {
+            palette[0][c] = c0[c];
+            palette[1][c] = c1[c];
+            palette[2][c] = (2 * c0[c] + c1[c]) / 3;
+            palette[3][c] = (c0[c] + 2 * c1[c]) / 3;
+        }
+        uint32_t best[16];
+        FindClosestIndices(block, palette, 4, 3, best);
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            indices |= best[i] << (2 * i);
+        }
+    }
+    out[0] = static_cast<uint8_t>(color0);
+    out[1] = static_cast<uint8_t>(color0 >> 8);
+    out[2] = static_cast<uint8_t>(color1);
+    out[3] = static_cast<uint8_t>(color1 >> 8);
+    for (int i = 0; i < 4; i++)
+    {
+        out[4 + i] = static_cast<uint8_t>(indices >> (8 * i));
+    }
+}
+void EncodeBC4(const Block &block, uint32_t channel, uint8_t minimum, uint8_t maximum, uint8_t *out)
+{
+    // red0 > red1 时为 8 级插值模式，相等时全部取 red0
+    out[0] = maximum;
+    out[1] = minimum;
+    uint64_t indices = 0;
+    if (maximum != minimum)
+    {
+        float range = static_cast<float>(maximum - minimum);
+        uint32_t levels[16];
+#if defined(MENGINE_BLOCK_SSE)
+        // 每个像素占 32 位，移位并屏蔽后得到该通道的值，4 个像素一起量化；非负数加 0.5 截断与 lround 一致
+        const __m128i shift = _mm_cvtsi32_si128(static_cast<int>(8 * channel));
+        const __m128 minimumValue = _mm_set1_ps(static_cast<float>(minimum));
+        const __m128 rangeValue = _mm_set1_ps(range);
+        for (uint32_t group = 0; group < 4; group++)
+        {
+            __m128i pixels = _mm_load_si128(reinterpret_cast<const __m128i *>(block.pixels[group * 4]));
+            __m128i values = _mm_and_si128(_mm_srl_epi32(pixels, shift), _mm_set1_epi32(0xFF));
+            __m128 level = _mm_div_ps(_mm_sub_ps(_mm_cvtepi32_ps(values), minimumValue), rangeValue);
+            level = _mm_add_ps(_mm_mul_ps(level, _mm_set1_ps(7.0f)), _mm_set1_ps(0.5f));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(levels + group * 4), _mm_cvttps_epi32(level));
+        }
+#else
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            levels[i] = static_cast<uint32_t>(std::lround((block.pixels[i][channel] - minimum) / range * 7.0f));
+        }
+#endif
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            // level 7 对应 red0，level 0 对应 red1，中间级别 k 的索引为 8 - k
+            uint32_t level = levels[i];
+            uint64_t index = level == 7 ? 0 : level == 0 ? 1 : 8 - level;
+            indices |= index << (3 * i);
+        }
+    }
+    for (int i = 0; i < 6; i++)
+    {
+        out[2 + i] = static_cast<uint8_t>(indices >> (8 * i));
+    }
+}
+void EncodeBC5(const Block &block, uint8_t *out)
+{
+    uint8_t minimum[4], maximum[4];
+    ComputeBounds(block, minimum, maximum);
+    EncodeBC4(block, 0, minimum[0], maximum[0], out);
+    EncodeBC4(block, 1, minimum[1], maximum[1], out + 8);
+}
+void PutBits(uint8_t *out, uint32_t &position, uint32_t value, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++, position++)
+    {
+        if (value & (1u << i))
+        {
+            out[position / 8] |= static_cast<uint8_t>(1u << (position % 8));
+        }
+    }
+}
+/**
+ * @brief BC7 模式 6：单分区 RGBA，7 位端点加每端点 1 位 p 位，4 位索引
+ */
+void EncodeBC7(const Block &block, uint8_t *out)
+{
+    static constexpr int weights[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+    uint8_t minimum[4], maximum[4];
+    ComputeBounds(block, minimum, maximum);
+    float endpoints[2][4];
+    FindEndpoints<4>(block, minimum, maximum, endpoints[0], endpoints[1]);
+    // 每个端点选择量化误差更小的 p 位
+    uint32_t quantized[2][4];
+    uint32_t pbits[2];
+    for (int e = 0; e < 2; e++)
+    {
+        float bestError = 0.0f;
+        for (uint32_t p = 0; p < 2; p++)
+        {
+            float error = 0.0f;
+            uint32_t values[4];
+            for (int c = 0; c < 4; c++)
+            {
+                values[c] = static_cast<uint32_t>(std::clamp(std::lround((endpoints[e][c] - p) / 2.0f), 0L, 127L));
+                float delta = static_cast<float>(values[c] * 2 + p) - endpoints[e][c];
+                error += delta * delta;
+            }
+            if (p == 0 || error < bestError)
+            {
+                bestError = error;
+                pbits[e] = p;
+                std::copy(values, values + 4, quantized[e]);
+            }
+        }
+    }
+    int palette[16][4];
+    for (int c = 0; c < 4; c++)
+    {
+        int e0 = static_cast<int>(quantized[0][c] * 2 + pbits[0]);
+        int e1 = static_cast<int>(quantized[1][c] * 2 + pbits[1]);
+        for (int i = 0; i < 16; i++)
+        {
+            palette[i][c] = ((64 - weights[i]) * e0 + weights[i] * e1 + 32) >> 6;
+        }
+    }
+    uint32_t indices[16];
+    FindClosestIndices(block, palette, 16, 4, indices);
+    // 锚点（像素 0）索引的最高位隐含为 0，否则交换端点并翻转全部索引
+    if (indices[0] >= 8)
+    {
+        std::swap(quantized[0], quantized[1]);
+        std::swap(pbits[0], pbits[1]);
+        for (auto &index : indices)
+        {
+            index = 15 - index;
+        }
+    }
+    std::memset(out, 0, 16);
+    uint32_t position = 0;
+    PutBits(out, position, 1u << 6, 7);
+    for (int c = 0; c < 4; c++)
+    {
+        PutBits(out, position, quantized[0][c], 7);
+        PutBits(out, position, quantized[1][c], 7);
+    }
+    PutBits(out, position, pbits[0], 1);
+    PutBits(out, position, pbits[1], 1);
+    PutBits(out, position, indices[0], 3);
+    for (uint32_t i = 1; i < 16; i++)
+    {
+        PutBits(out, position, indices[i], 4);
+    }
+}
+} // namespace
+
+uint32_t GetBlockSize(BlockCompression compression)
+{
+    switch (compression)
+    {
+    case BlockCompression::BC1:
+        return 8;
+    case BlockCompression::BC5:
+    case BlockCompression::BC7:
+        return 16;
+    case BlockCompression::None:
+    default:
+        return 4;
+    }
+}
+uint64_t GetCompressedSize(BlockCompression compression, uint32_t width, uint32_t height)
+{
+    if (compression == BlockCompression::None)
+    {
+        return static_cast<uint64_t>(width) * height * 4;
+    }
+    return static_cast<uint64_t>((width + 3) / 4) * ((height + 3) / 4) * GetBlockSize(compression);
+}
+std::vector<uint8_t> CompressImage(BlockCompression compression, const uint8_t *rgba, uint32_t width,
+                                   uint32_t height)
+{
+    if (compression == BlockCompression::None)
+    {
+        return std::vector<uint8_t>(rgba, rgba + static_cast<size_t>(width) * height * 4);
+    }
+    std::vector<uint8_t> output(GetCompressedSize(compression, width, height));
+    uint32_t blockSize = GetBlockSize(compression);
+    uint32_t blocksX = (width + 3) / 4;
+    uint32_t blocksY = (height + 3) / 4;
+    Block block;
+    for (uint32_t y = 0; y < blocksY; y++)
+    {
+        for (uint32_t x = 0; x < blocksX; x++)
+        {
+            LoadBlock(rgba, width, height, x, y, block);
+            uint8_t *out = output.data() + (static_cast<size_t>(y) * blocksX + x) * blockSize;
+            switch (compression)
+            {
+            case BlockCompression::BC1:
+                EncodeBC1(block, out);
+                break;
+            case BlockCompression::BC5:
+                EncodeBC5(block, out);
+                break;
+            case BlockCompression::BC7:
+                EncodeBC7(block, out);
+                break;
+            default:
+                break;
+            }
+        }
+    }
+    return output;
+}
+} // namespace MEngine
@@ -0,0 +1,86 @@
+#include "TextureContainer.hpp"
+#include "Mipmap.hpp"
+#include <cstring>
+
+namespace MEngine
+{
+namespace
+{
+uint64_t AlignUp(uint64_t value, uint64_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+} // namespace
+
+std::vector<uint8_t> CookTexture(const uint8_t *rgba, uint32_t width, uint32_t height,
+                                 const TextureCookOptions &options)
+{
+    TextureContainerHeader header{};
+    header.compression = options.compression;
+    header.flags = options.srgb ? TextureContainerSrgb : 0;
+    header.width = width;
+    header.height = height;
+    header.mipLevels = options.generateMipmaps ? CalculateMipLevels(width, height) : 1;
+    auto chain = GenerateMipChainRGBA8(rgba, width, height, header.mipLevels, options.srgb);
+
+    std::vector<TextureContainerMip> mips(header.mipLevels);
+    uint64_t offset = AlignUp(sizeof(TextureContainerHeader) + sizeof(TextureContainerMip) * mips.size(),
+                              TextureContainerAlignment);
+    for (uint32_t level = 0; level < header.mipLevels; level++)
+    {
+        mips[level].width = GetMipExtent(width, level);
+        mips[level].height = GetMipExtent(height, level);
+        mips[level].size = GetCompressedSize(options.compression, mips[level].width, mips[level].height);
+        mips[level].offset = offset;
+        offset = AlignUp(offset + mips[level].size, TextureContainerAlignment);
+    }
+    std::vector<uint8_t> file(offset, 0);
+    std::memcpy(file.data(), &header, sizeof(header));
+    std::memcpy(file.data() + sizeof(header), mips.data(), sizeof(TextureContainerMip) * mips.size());
+    const uint8_t *source = chain.data();
+    for (uint32_t level = 0; level < header.mipLevels; level++)
+    {
+        auto blocks = CompressImage(options.compression, source, mips[level].width, mips[level].height);
+        std::memcpy(file.data() + mips[level].offset, blocks.data(), blocks.size());
+        source += static_cast<size_t>(mips[level].width) * mips[level].height * 4;
+    }
+    return file;
+}
+std::optional<TextureContainerView> ParseTextureContainer(const uint8_t *data, uint64_t size)
+{
+    if (!data || size < sizeof(TextureContainerHeader))
+    {
+        return std::nullopt;
+    }
+    TextureContainerView view{};
+    std::memcpy(&view.header, data, sizeof(TextureContainerHeader));
+    const auto &header = view.header;
+    if (header.magic != TextureContainerMagic || header.version != TextureContainerVersion ||
+        header.width == 0 || header.height == 0 || header.mipLevels == 0 ||
+        header.mipLevels > CalculateMipLevels(header.width, header.height) ||
+        static_cast<uint32_t>(header.compression) > static_cast<uint32_t>(BlockCompression::BC7))
+    {
+        return std::nullopt;
+    }
+    uint64_t tableEnd = sizeof(TextureContainerHeader) + sizeof(TextureContainerMip) * header.mipLevels;
+    if (tableEnd > size)
+    {
+        return std::nullopt;
+    }
+    view.mips = reinterpret_cast<const TextureContainerMip *>(data + sizeof(TextureContainerHeader));
+    // mip 尺寸必须与文件头推导的一致，否则创建图像或上传时才会出错
+    for (uint32_t level = 0; level < header.mipLevels; level++)
+    {
+        const auto &mip = view.mips[level];
+        if (mip.width != GetMipExtent(header.width, level) || mip.height != GetMipExtent(header.height, level) ||
+            mip.offset % TextureContainerAlignment != 0 || mip.offset < tableEnd || mip.offset > size ||
+            mip.size > size - mip.offset || mip.size != GetCompressedSize(header.compression, mip.width, mip.height))
+        {
+            return std::nullopt;
+        }
+    }
+    view.data = data;
+    view.size = size;
+    return view;
+}
+} // namespace MEngine
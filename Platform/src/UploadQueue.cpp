@@ -0,0 +1,454 @@
+#include "UploadQueue.hpp"
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+namespace MEngine
+{
+UploadQueue::UploadQueue(std::shared_ptr<ILogger> logger, std::shared_ptr<Context> context,
+                         std::shared_ptr<SyncPrimitiveManager> syncPrimitiveManager,
+                         std::shared_ptr<IConfigure> configure)
+    : mLogger(logger), mContext(context), mSyncPrimitiveManager(syncPrimitiveManager), mConfigure(configure)
+{
+    if (!mContext->GetEnabledFeatures().timelineSemaphore)
+    {
+        mLogger->Error("UploadQueue requires timeline semaphore support");
+        throw std::runtime_error("UploadQueue requires timeline semaphore support");
+    }
+    // 独立的命令池，录制与 CommandBufferManager 的命令池互不干扰
+    vk::CommandPoolCreateInfo commandPoolCreateInfo{};
+    commandPoolCreateInfo.setQueueFamilyIndex(mContext->GetQueueFamilyIndicates().transferFamily.value())
+        .setFlags(vk::CommandPoolCreateFlagBits::eResetCommandBuffer | vk::CommandPoolCreateFlagBits::eTransient);
+    mCommandPool = mContext->GetDevice().createCommandPoolUnique(commandPoolCreateInfo);
+    mTimelineSemaphore = mSyncPrimitiveManager->CreateTimelineSemaphore(0);
+    if (mContext->HasDedicatedTransferFamily())
+    {
+        mSrcQueueFamily = mContext->GetQueueFamilyIndicates().transferFamily.value();
+        mDstQueueFamily = mContext->GetQueueFamilyIndicates().graphicsFamily.value();
+    }
+
+    // 常驻映射的环形暂存缓冲区，所有上传共用
+    auto stagingSizeMB = mConfigure->GetJson()["UploadSetting"]["StagingRingSizeMB"].get<uint32_t>();
+    vk::DeviceSize stagingSize = std::max<vk::DeviceSize>(stagingSizeMB, 1) * 1024 * 1024;
+    mStagingBuffer = std::make_unique<Buffer>(mContext, stagingSize, vk::BufferUsageFlagBits::eTransferSrc,
+                                              VMA_MEMORY_USAGE_CPU_ONLY,
+                                              VMA_ALLOCATION_CREATE_MAPPED_BIT |
+                                                  VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT);
+    mStagingData = static_cast<uint8_t *>(mStagingBuffer->GetAllocationInfo().pMappedData);
+    mStagingRing = RingAllocator(stagingSize);
+    mMaxChunkSize = stagingSize / 2;
+    mLogger->Debug("UploadQueue Created, staging ring {} MB", stagingSizeMB);
+}
+UploadQueue::~UploadQueue()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (!mPendingCommands.empty())
+    {
+        FlushLocked();
+    }
+    if (mSubmittedTicket > 0)
+    {
+        vk::SemaphoreWaitInfo waitInfo{};
+        waitInfo.setSemaphores(mTimelineSemaphore.get()).setValues(mSubmittedTicket);
+        auto result = mContext->GetDevice().waitSemaphores(waitInfo, UINT64_MAX);
+        if (result != vk::Result::eSuccess)
+        {
+            mLogger->Error("Failed to wait for pending uploads");
+        }
+    }
+    mInFlightBatches.clear();
+    mFreeCommandBuffers.clear();
+}
+vk::DeviceSize UploadQueue::AllocateStagingLocked(vk::DeviceSize size, vk::DeviceSize alignment)
+{
+    while (true)
+    {
+        if (auto offset = mStagingRing.Allocate(size, alignment))
+        {
+            return *offset;
+        }
+        // 环形缓冲区已满：先提交正在收集的批次，再等待最早的批次完成以回收空间
+        if (!mPendingCommands.empty())
+        {
+            FlushLocked();
+        }
+        if (mInFlightBatches.empty())
+        {
+            mLogger->Error("Staging ring cannot hold {} bytes", size);
+            throw std::runtime_error("Staging ring cannot hold the upload");
+        }
+        vk::SemaphoreWaitInfo waitInfo{};
+        waitInfo.setSemaphores(mTimelineSemaphore.get()).setValues(mInFlightBatches.front().ticket);
+        auto result = mContext->GetDevice().waitSemaphores(waitInfo, UINT64_MAX);
+        if (result != vk::Result::eSuccess)
+        {
+            mLogger->Error("Wait for upload {} failed", mInFlightBatches.front().ticket);
+            throw std::runtime_error("Wait for upload failed");
+        }
+        CollectLocked();
+    }
+}
+UploadTicket UploadQueue::EnqueueBufferUpload(const Buffer &dst, const void *data, vk::DeviceSize size,
+                                              vk::DeviceSize dstOffset)
+{
+    if (dstOffset + size > dst.GetSize())
+    {
+        mLogger->Error("Upload range exceeds destination buffer");
+        throw std::out_of_range("Upload range exceeds destination buffer");
+    }
+    vk::Buffer stagingBuffer = mStagingBuffer->GetHandle();
+    vk::Buffer dstBuffer = dst.GetHandle();
+    auto source = static_cast<const uint8_t *>(data);
+    std::lock_guard<std::mutex> lock(mMutex);
+    // 大块数据切分成多段，每段单独占用环形缓冲区空间
+    for (vk::DeviceSize copied = 0; copied < size;)
+    {
+        vk::DeviceSize chunkSize = std::min(size - copied, mMaxChunkSize);
+        vk::DeviceSize stagingOffset = AllocateStagingLocked(chunkSize, 4);
+        std::memcpy(mStagingData + stagingOffset, source + copied, chunkSize);
+        vk::BufferCopy region{};
+        region.setSrcOffset(stagingOffset).setDstOffset(dstOffset + copied).setSize(chunkSize);
+        mPendingCommands.push_back([stagingBuffer, dstBuffer, region](vk::CommandBuffer commandBuffer) {
+            commandBuffer.copyBuffer(stagingBuffer, dstBuffer, region);
+        });
+        mPendingBytes += chunkSize;
+        copied += chunkSize;
+    }
+    if (mSrcQueueFamily)
+    {
+        // 目标缓冲区的用途未知，获取时对所有读访问可见
+        auto transfer = MakeBufferOwnershipTransfer(dstBuffer, dstOffset, size, vk::AccessFlagBits::eTransferWrite,
+                                                    vk::AccessFlagBits::eMemoryRead, *mSrcQueueFamily,
+                                                    mDstQueueFamily);
+        mPendingCommands.push_back([release = transfer.release](vk::CommandBuffer commandBuffer) {
+            commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eBottomOfPipe,
+                                          {}, {}, release, {});
+        });
+        mPendingAcquires.bufferBarriers.push_back(transfer.acquire);
+        mPendingAcquires.dstStage |= vk::PipelineStageFlagBits::eAllCommands;
+    }
+    return mSubmittedTicket + 1;
+}
+UploadTicket UploadQueue::EnqueueImageUpload(const ImageUploadInfo &info, const void *data, vk::DeviceSize size)
+{
+    // 连续数据按级别切分后与逐级数据走同一路径
+    uint32_t dataMipLevels = std::clamp(info.dataMipLevels, 1u, info.mipLevels);
+    std::vector<ImageMipData> mips(dataMipLevels);
+    vk::DeviceSize offset = 0;
+    for (uint32_t level = 0; level < dataMipLevels; level++)
+    {
+        vk::DeviceSize levelSize = GetMipUploadSize(info, level);
+        if (offset + levelSize > size)
+        {
+            mLogger->Error("Image upload data is smaller than the image");
+            throw std::out_of_range("Image upload data is smaller than the image");
+        }
+        mips[level] = {static_cast<const uint8_t *>(data) + offset, levelSize};
+        offset += levelSize;
+    }
+    return EnqueueImageUpload(info, mips);
+}
+vk::DeviceSize UploadQueue::GetMipUploadSize(const ImageUploadInfo &info, uint32_t level)
+{
+    // 压缩格式的一“行”是一行块，不足一块的边按整块计算
+    uint32_t width = std::max(info.extent.width >> level, 1u);
+    uint32_t height = std::max(info.extent.height >> level, 1u);
+    uint32_t depth = std::max(info.extent.depth >> level, 1u);
+    return static_cast<vk::DeviceSize>((width + info.blockWidth - 1) / info.blockWidth) *
+           ((height + info.blockHeight - 1) / info.blockHeight) * depth * info.texelSize * info.arrayLayers;
+}
+UploadTicket UploadQueue::EnqueueImageUpload(const ImageUploadInfo &info, const std::vector<ImageMipData> &mips)
+{
+    if (mips.empty())
+    {
+        mLogger->Error("Image upload without data");
+        throw std::invalid_argument("Image upload without data");
+    }
+    uint32_t dataMipLevels = std::min(static_cast<uint32_t>(mips.size()), info.mipLevels);
+    bool generateMipmaps = info.generateMipmaps && dataMipLevels < info.mipLevels;
+    if (generateMipmaps && mSrcQueueFamily)
+    {
+        mLogger->Error("Mipmap blit requires an upload queue with graphics capability");
+        throw std::runtime_error("Mipmap blit requires an upload queue with graphics capability");
+    }
+    auto mipExtent = [&info](uint32_t level) {
+        return vk::Extent3D(std::max(info.extent.width >> level, 1u), std::max(info.extent.height >> level, 1u),
+                            std::max(info.extent.depth >> level, 1u));
+    };
+    auto blocksWide = [&info](uint32_t width) { return (width + info.blockWidth - 1) / info.blockWidth; };
+    auto blocksHigh = [&info](uint32_t height) { return (height + info.blockHeight - 1) / info.blockHeight; };
+    for (uint32_t level = 0; level < dataMipLevels; level++)
+    {
+        if (!mips[level].data || mips[level].size < GetMipUploadSize(info, level))
+        {
+            mLogger->Error("Image upload data of mip {} is smaller than the image", level);
+            throw std::out_of_range("Image upload data is smaller than the image");
+        }
+    }
+    if (static_cast<vk::DeviceSize>(blocksWide(info.extent.width)) * info.texelSize > mMaxChunkSize)
+    {
+        mLogger->Error("Image row of {} bytes exceeds staging chunk size",
+                       static_cast<vk::DeviceSize>(blocksWide(info.extent.width)) * info.texelSize);
+        throw std::runtime_error("Image row exceeds staging chunk size");
+    }
+    vk::Buffer stagingBuffer = mStagingBuffer->GetHandle();
+    vk::Image image = info.image;
+    // bufferOffset 需同时是纹素大小与 4 的整数倍
+    vk::DeviceSize alignment = std::lcm<vk::DeviceSize>(info.texelSize, 4);
+    vk::ImageSubresourceRange range{vk::ImageAspectFlagBits::eColor, 0, info.mipLevels, 0, info.arrayLayers};
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    vk::ImageMemoryBarrier preBarrier{};
+    preBarrier.setImage(image)
+        .setOldLayout(vk::ImageLayout::eUndefined)
+        .setNewLayout(vk::ImageLayout::eTransferDstOptimal)
+        .setSrcAccessMask(vk::AccessFlagBits::eNoneKHR)
+        .setDstAccessMask(vk::AccessFlagBits::eTransferWrite)
+        .setSrcQueueFamilyIndex(vk::QueueFamilyIgnored)
+        .setDstQueueFamilyIndex(vk::QueueFamilyIgnored)
+        .setSubresourceRange(range);
+    mPendingCommands.push_back([preBarrier](vk::CommandBuffer commandBuffer) {
+        commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTopOfPipe, vk::PipelineStageFlagBits::eTransfer, {},
+                                      {}, {}, preBarrier);
+    });
+    // 按行切分：每段是同一 mip、同一层、同一深度切片中连续的若干（块）行
+    for (uint32_t level = 0; level < dataMipLevels; level++)
+    {
+        auto source = static_cast<const uint8_t *>(mips[level].data);
+        vk::DeviceSize sourceOffset = 0;
+        auto extent = mipExtent(level);
+        uint32_t rows = blocksHigh(extent.height);
+        vk::DeviceSize rowSize = static_cast<vk::DeviceSize>(blocksWide(extent.width)) * info.texelSize;
+        uint32_t rowsPerChunk = static_cast<uint32_t>(std::min<vk::DeviceSize>(mMaxChunkSize / rowSize, rows));
+        for (uint32_t layer = 0; layer < info.arrayLayers; layer++)
+        {
+            for (uint32_t z = 0; z < extent.depth; z++)
+            {
+                for (uint32_t row = 0; row < rows; row += rowsPerChunk)
+                {
+                    uint32_t rowCount = std::min(rowsPerChunk, rows - row);
+                    // 拷贝区域以纹素为单位，最后一段可以止于图像边缘而不是块边界
+                    uint32_t texelRow = row * info.blockHeight;
+                    uint32_t texelRowCount = std::min(rowCount * info.blockHeight, extent.height - texelRow);
+                    vk::DeviceSize chunkSize = rowSize * rowCount;
+                    vk::DeviceSize stagingOffset = AllocateStagingLocked(chunkSize, alignment);
+                    std::memcpy(mStagingData + stagingOffset, source + sourceOffset, chunkSize);
+                    sourceOffset += chunkSize;
+                    vk::BufferImageCopy region{};
+                    region.setBufferOffset(stagingOffset)
+                        .setBufferRowLength(0)
+                        .setBufferImageHeight(0)
+                        .setImageOffset(vk::Offset3D(0, static_cast<int32_t>(texelRow), static_cast<int32_t>(z)))
+                        .setImageExtent(vk::Extent3D(extent.width, texelRowCount, 1))
+                        .setImageSubresource({vk::ImageAspectFlagBits::eColor, level, layer, 1});
+                    mPendingCommands.push_back([stagingBuffer, image, region](vk::CommandBuffer commandBuffer) {
+                        commandBuffer.copyBufferToImage(stagingBuffer, image, vk::ImageLayout::eTransferDstOptimal,
+                                                        region);
+                    });
+                    mPendingBytes += chunkSize;
+                }
+            }
+        }
+    }
+    // 其余级别逐级由上一级 blit 生成，源级别转换到 TransferSrc 后保持在该布局
+    for (uint32_t level = dataMipLevels; generateMipmaps && level < info.mipLevels; level++)
+    {
+        vk::ImageMemoryBarrier toSource{};
+        toSource.setImage(image)
+            .setOldLayout(vk::ImageLayout::eTransferDstOptimal)
+            .setNewLayout(vk::ImageLayout::eTransferSrcOptimal)
+            .setSrcAccessMask(vk::AccessFlagBits::eTransferWrite)
+            .setDstAccessMask(vk::AccessFlagBits::eTransferRead)
+            .setSrcQueueFamilyIndex(vk::QueueFamilyIgnored)
+            .setDstQueueFamilyIndex(vk::QueueFamilyIgnored)
+            .setSubresourceRange({vk::ImageAspectFlagBits::eColor, level - 1, 1, 0, info.arrayLayers});
+        auto srcExtent = mipExtent(level - 1);
+        auto dstExtent = mipExtent(level);
+        vk::ImageBlit blit{};
+        blit.setSrcSubresource({vk::ImageAspectFlagBits::eColor, level - 1, 0, info.arrayLayers})
+            .setSrcOffsets({vk::Offset3D(0, 0, 0),
+                            vk::Offset3D(static_cast<int32_t>(srcExtent.width), static_cast<int32_t>(srcExtent.height),
+                                         static_cast<int32_t>(srcExtent.depth))})
+            .setDstSubresource({vk::ImageAspectFlagBits::eColor, level, 0, info.arrayLayers})
+            .setDstOffsets({vk::Offset3D(0, 0, 0),
+                            vk::Offset3D(static_cast<int32_t>(dstExtent.width), static_cast<int32_t>(dstExtent.height),
+                                         static_cast<int32_t>(dstExtent.depth))});
+        mPendingCommands.push_back([toSource, blit, image](vk::CommandBuffer commandBuffer) {
+            commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eTransfer,
+                                          {}, {}, {}, toSource);
+            commandBuffer.blitImage(image, vk::ImageLayout::eTransferSrcOptimal, image,
+                                    vk::ImageLayout::eTransferDstOptimal, blit, vk::Filter::eLinear);
+        });
+    }
+    if (mSrcQueueFamily)
+    {
+        // 布局转换随所有权转移一起完成，图形队列获取后即可采样
+        auto transfer = MakeImageOwnershipTransfer(image, range, vk::ImageLayout::eTransferDstOptimal,
+                                                   info.finalLayout, vk::AccessFlagBits::eTransferWrite,
+                                                   info.finalAccess, *mSrcQueueFamily, mDstQueueFamily);
+        mPendingCommands.push_back([release = transfer.release](vk::CommandBuffer commandBuffer) {
+            commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eBottomOfPipe,
+                                          {}, {}, {}, release);
+        });
+        mPendingAcquires.imageBarriers.push_back(transfer.acquire);
+        mPendingAcquires.dstStage |= info.finalStage;
+    }
+    else
+    {
+        vk::ImageMemoryBarrier postBarrier{};
+        postBarrier.setImage(image)
+            .setOldLayout(vk::ImageLayout::eTransferDstOptimal)
+            .setNewLayout(info.finalLayout)
+            .setSrcAccessMask(vk::AccessFlagBits::eTransferWrite)
+            .setDstAccessMask(info.finalAccess)
+            .setSrcQueueFamilyIndex(vk::QueueFamilyIgnored)
+            .setDstQueueFamilyIndex(vk::QueueFamilyIgnored)
+            .setSubresourceRange(range);
+        std::vector<vk::ImageMemoryBarrier> postBarriers;
+        if (generateMipmaps)
+        {
+            // blit 源级别 [dataMipLevels - 1, mipLevels - 1) 处于 TransferSrc，其余仍为 TransferDst
+            uint32_t sourceBase = dataMipLevels - 1;
+            uint32_t sourceCount = info.mipLevels - 1 - sourceBase;
+            if (sourceBase > 0)
+            {
+                postBarriers.push_back(postBarrier);
+                postBarriers.back().subresourceRange.setBaseMipLevel(0).setLevelCount(sourceBase);
+            }
+            postBarriers.push_back(postBarrier);
+            postBarriers.back()
+                .setOldLayout(vk::ImageLayout::eTransferSrcOptimal)
+                .setSrcAccessMask(vk::AccessFlagBits::eTransferRead)
+                .subresourceRange.setBaseMipLevel(sourceBase)
+                .setLevelCount(sourceCount);
+            postBarriers.push_back(postBarrier);
+            postBarriers.back().subresourceRange.setBaseMipLevel(info.mipLevels - 1).setLevelCount(1);
+        }
+        else
+        {
+            postBarriers.push_back(postBarrier);
+        }
+        vk::PipelineStageFlags finalStage = info.finalStage;
+        mPendingCommands.push_back([postBarriers, finalStage](vk::CommandBuffer commandBuffer) {
+            commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, finalStage, {}, {}, {}, postBarriers);
+        });
+    }
+    return mSubmittedTicket + 1;
+}
+UploadTicket UploadQueue::Flush()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return FlushLocked();
+}
+UploadTicket UploadQueue::FlushLocked()
+{
+    if (mPendingCommands.empty())
+    {
+        return mSubmittedTicket;
+    }
+    CollectLocked();
+    vk::UniqueCommandBuffer commandBuffer;
+    if (!mFreeCommandBuffers.empty())
+    {
+        commandBuffer = std::move(mFreeCommandBuffers.back());
+        mFreeCommandBuffers.pop_back();
+        commandBuffer->reset();
+    }
+    else
+    {
+        vk::CommandBufferAllocateInfo allocateInfo{};
+        allocateInfo.setCommandPool(mCommandPool.get())
+            .setLevel(vk::CommandBufferLevel::ePrimary)
+            .setCommandBufferCount(1);
+        commandBuffer = std::move(mContext->GetDevice().allocateCommandBuffersUnique(allocateInfo)[0]);
+    }
+    // 所有排队的命令录制到同一个命令缓冲区
+    InFlightBatch batch{};
+    batch.ticket = mSubmittedTicket + 1;
+    batch.ringMarker = mStagingRing.GetHead();
+    vk::CommandBufferBeginInfo beginInfo{};
+    beginInfo.setFlags(vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
+    commandBuffer->begin(beginInfo);
+    for (auto &record : mPendingCommands)
+    {
+        record(commandBuffer.get());
+    }
+    commandBuffer->end();
+
+    vk::TimelineSemaphoreSubmitInfo timelineSubmitInfo{};
+    timelineSubmitInfo.setSignalSemaphoreValues(batch.ticket);
+    vk::SubmitInfo submitInfo{};
+    submitInfo.setCommandBuffers(commandBuffer.get())
+        .setSignalSemaphores(mTimelineSemaphore.get())
+        .setPNext(&timelineSubmitInfo);
+    mContext->SubmitToTransferQueue({submitInfo}, nullptr);
+    mLogger->Trace("Upload batch {} submitted: {} commands, {} bytes", batch.ticket, mPendingCommands.size(),
+                   mPendingBytes);
+
+    if (!mPendingAcquires.imageBarriers.empty() || !mPendingAcquires.bufferBarriers.empty())
+    {
+        mPendingAcquires.ticket = batch.ticket;
+        mFlushedAcquires.push_back(std::move(mPendingAcquires));
+        mPendingAcquires = AcquireBarriers{};
+    }
+    batch.commandBuffer = std::move(commandBuffer);
+    mInFlightBatches.push_back(std::move(batch));
+    mPendingCommands.clear();
+    mPendingBytes = 0;
+    mSubmittedTicket++;
+    return mSubmittedTicket;
+}
+bool UploadQueue::IsComplete(UploadTicket ticket) const
+{
+    return mContext->GetDevice().getSemaphoreCounterValue(mTimelineSemaphore.get()) >= ticket;
+}
+void UploadQueue::Wait(UploadTicket ticket, uint64_t timeout)
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (ticket > mSubmittedTicket)
+        {
+            FlushLocked();
+        }
+    }
+    vk::SemaphoreWaitInfo waitInfo{};
+    waitInfo.setSemaphores(mTimelineSemaphore.get()).setValues(ticket);
+    auto result = mContext->GetDevice().waitSemaphores(waitInfo, timeout);
+    if (result != vk::Result::eSuccess)
+    {
+        mLogger->Error("Wait for upload {} failed", ticket);
+        throw std::runtime_error("Wait for upload failed");
+    }
+    Collect();
+}
+bool UploadQueue::RecordOwnershipAcquire(vk::CommandBuffer commandBuffer, UploadTicket ticket)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    bool recorded = false;
+    while (!mFlushedAcquires.empty() && mFlushedAcquires.front().ticket <= ticket)
+    {
+        auto &acquire = mFlushedAcquires.front();
+        // 源阶段与提交时等待时间线信号量的阶段一致，保证获取发生在释放之后
+        commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eAllCommands, acquire.dstStage, {}, {},
+                                      acquire.bufferBarriers, acquire.imageBarriers);
+        mFlushedAcquires.pop_front();
+        recorded = true;
+    }
+    return recorded;
+}
+void UploadQueue::Collect()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    CollectLocked();
+}
+void UploadQueue::CollectLocked()
+{
+    uint64_t completed = mContext->GetDevice().getSemaphoreCounterValue(mTimelineSemaphore.get());
+    while (!mInFlightBatches.empty() && mInFlightBatches.front().ticket <= completed)
+    {
+        mStagingRing.Release(mInFlightBatches.front().ringMarker);
+        mFreeCommandBuffers.push_back(std::move(mInFlightBatches.front().commandBuffer));
+        mInFlightBatches.pop_front();
+    }
+}
+} // namespace MEngine
@@ -3,9 +3,29 @@
 namespace MEngine
 {
 
-std::array<vk::VertexInputAttributeDescription, 3> Vertex::GetVertexInputAttributeDescription()
+std::array<vk::VertexInputAttributeDescription, 3> Vertex::GetVertexInputAttributeDescription(VertexFormat format)
 {
     std::array<vk::VertexInputAttributeDescription, 3> attributeDescriptions;
+    if (format == VertexFormat::Quantized)
+    {
+        // 位置为 vec4 snorm，着色器只读取 xyz；法线为八面体编码的 vec2
+        attributeDescriptions[0]
+            .setBinding(0)
+            .setLocation(0)
+            .setFormat(vk::Format::eR16G16B16A16Snorm)
+            .setOffset(offsetof(QuantizedVertex, position));
+        attributeDescriptions[1]
+            .setBinding(0)
+            .setLocation(1)
+            .setFormat(vk::Format::eR16G16Snorm)
+            .setOffset(offsetof(QuantizedVertex, normal));
+        attributeDescriptions[2]
+            .setBinding(0)
+            .setLocation(2)
+            .setFormat(vk::Format::eR16G16Sfloat)
+            .setOffset(offsetof(QuantizedVertex, texCoords));
+        return attributeDescriptions;
+    }
     attributeDescriptions[0].setBinding(0).setLocation(0).setFormat(vk::Format::eR32G32B32Sfloat).setOffset(0);
     attributeDescriptions[1]
         .setBinding(0)
@@ -19,10 +39,34 @@ std::array<vk::VertexInputAttributeDescription, 3> Vertex::GetVertexInputAttribu
         .setOffset(offsetof(Vertex, texCoords));
     return attributeDescriptions;
 }
-vk::VertexInputBindingDescription Vertex::GetVertexInputBindingDescription()
+vk::VertexInputBindingDescription Vertex::GetVertexInputBindingDescription(VertexFormat format)
 {
     vk::VertexInputBindingDescription bindingDescription;
-    bindingDescription.setBinding(0).setStride(sizeof(Vertex)).setInputRate(vk::VertexInputRate::eVertex);
+    bindingDescription.setBinding(0).setStride(GetStride(format)).setInputRate(vk::VertexInputRate::eVertex);
+    return bindingDescription;
+}
+uint32_t Vertex::GetStride(VertexFormat format)
+{
+    return format == VertexFormat::Quantized ? sizeof(QuantizedVertex) : sizeof(Vertex);
+}
+std::array<vk::VertexInputAttributeDescription, 4> Vertex::GetInstanceInputAttributeDescription()
+{
+    // mat4 按列拆成 4 个 vec4 属性
+    std::array<vk::VertexInputAttributeDescription, 4> attributeDescriptions;
+    for (uint32_t column = 0; column < attributeDescriptions.size(); column++)
+    {
+        attributeDescriptions[column]
+            .setBinding(1)
+            .setLocation(3 + column)
+            .setFormat(vk::Format::eR32G32B32A32Sfloat)
+            .setOffset(static_cast<uint32_t>(offsetof(InstanceData, modelMatrix) + column * sizeof(glm::vec4)));
+    }
+    return attributeDescriptions;
+}
+vk::VertexInputBindingDescription Vertex::GetInstanceInputBindingDescription()
+{
+    vk::VertexInputBindingDescription bindingDescription;
+    bindingDescription.setBinding(1).setStride(sizeof(InstanceData)).setInputRate(vk::VertexInputRate::eInstance);
     return bindingDescription;
 }
 } // namespace MEngine
\ No newline at end of file
@@ -0,0 +1,218 @@
+#include "VertexQuantization.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MENGINE_VERTEX_SSE 1
+#include <emmintrin.h>
+#endif
+#if defined(MENGINE_VERTEX_SSE) && (defined(__F16C__) || defined(__AVX2__))
+#define MENGINE_VERTEX_F16C 1
+#include <immintrin.h>
+#endif
+
+namespace MEngine
+{
+namespace
+{
+constexpr float Snorm16Max = 32767.0f;
+constexpr float HalfMax = 65504.0f;
+
+int16_t ToSnorm16(float value)
+{
+    return static_cast<int16_t>(std::lrint(std::clamp(value, -1.0f, 1.0f) * Snorm16Max));
+}
+float FromSnorm16(int16_t value)
+{
+    // 与 Vulkan 的 snorm 解码一致：-32768 与 -32767 都解码为 -1
+    return std::max(static_cast<float>(value) / Snorm16Max, -1.0f);
+}
+float SignNotZero(float value)
+{
+    return value >= 0.0f ? 1.0f : -1.0f;
+}
+} // namespace
+
+glm::mat4 VertexQuantization::GetDequantizeMatrix() const
+{
+    glm::mat4 matrix(scale);
+    matrix[3] = glm::vec4(center, 1.0f);
+    return matrix;
+}
+VertexQuantization ComputeVertexQuantization(const Vertex *vertices, size_t count)
+{
+    VertexQuantization quantization{};
+    if (count == 0)
+    {
+        return quantization;
+    }
+    glm::vec3 minPosition(std::numeric_limits<float>::max());
+    glm::vec3 maxPosition(std::numeric_limits<float>::lowest());
+    for (size_t i = 0; i < count; i++)
+    {
+        minPosition = glm::min(minPosition, vertices[i].position);
+        maxPosition = glm::max(maxPosition, vertices[i].position);
+    }
+    glm::vec3 halfExtents = (maxPosition - minPosition) * 0.5f;
+    quantization.center = (minPosition + maxPosition) * 0.5f;
+    quantization.scale = std::max({halfExtents.x, halfExtents.y, halfExtents.z});
+    // 所有顶点重合时缩放取 1，量化结果全为 0
+    if (!(quantization.scale > 0.0f))
+    {
+        quantization.scale = 1.0f;
+    }
+    return quantization;
+}
+void QuantizeVertices(const Vertex *vertices, size_t count, const VertexQuantization &quantization,
+                      QuantizedVertex *output)
+{
+    float factor = Snorm16Max / quantization.scale;
+#if defined(MENGINE_VERTEX_SSE)
+    const __m128 center = _mm_setr_ps(quantization.center.x, quantization.center.y, quantization.center.z, 0.0f);
+    const __m128 scale = _mm_set1_ps(factor);
+    const __m128 xyzMask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+    const __m128 lower = _mm_set1_ps(-Snorm16Max);
+    const __m128 upper = _mm_set1_ps(Snorm16Max);
+#endif
+#if defined(MENGINE_VERTEX_F16C)
+    const __m128 halfLower = _mm_set1_ps(-HalfMax);
+    const __m128 halfUpper = _mm_set1_ps(HalfMax);
+#endif
+    for (size_t i = 0; i < count; i++)
+    {
+        const auto &vertex = vertices[i];
+        auto &packed = output[i];
+#if defined(MENGINE_VERTEX_SSE)
+        // position 后紧跟 normal，一次读取 4 个 float 不会越界，第 4 个分量被掩码清零
+        __m128 position = _mm_loadu_ps(&vertex.position.x);
+        position = _mm_and_ps(_mm_mul_ps(_mm_sub_ps(position, center), scale), xyzMask);
+        position = _mm_min_ps(_mm_max_ps(position, lower), upper);
+        // cvtps 使用默认的就近舍入，与标量路径的 lrint 一致
+        __m128i position16 = _mm_packs_epi32(_mm_cvtps_epi32(position), _mm_setzero_si128());
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(packed.position), position16);
+#else
+        for (int axis = 0; axis < 3; axis++)
+        {
+            float position = (vertex.position[axis] - quantization.center[axis]) * factor;
+            packed.position[axis] = static_cast<int16_t>(std::lrint(std::clamp(position, -Snorm16Max, Snorm16Max)));
+        }
+        packed.position[3] = 0;
+#endif
+        glm::vec2 octahedral = EncodeOctahedral(vertex.normal);
+        packed.normal[0] = ToSnorm16(octahedral.x);
+        packed.normal[1] = ToSnorm16(octahedral.y);
+#if defined(MENGINE_VERTEX_F16C)
+        __m128 texCoords = _mm_setr_ps(vertex.texCoords.x, vertex.texCoords.y, 0.0f, 0.0f);
+        texCoords = _mm_min_ps(_mm_max_ps(texCoords, halfLower), halfUpper);
+        uint32_t texCoords16 =
+            static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_cvtps_ph(texCoords, _MM_FROUND_TO_NEAREST_INT)));
+        std::memcpy(packed.texCoords, &texCoords16, sizeof(texCoords16));
+#else
+        packed.texCoords[0] = FloatToHalf(vertex.texCoords.x);
+        packed.texCoords[1] = FloatToHalf(vertex.texCoords.y);
+#endif
+    }
+}
+Vertex DequantizeVertex(const QuantizedVertex &vertex, const VertexQuantization &quantization)
+{
+    Vertex result{};
+    for (int axis = 0; axis < 3; axis++)
+    {
+        result.position[axis] = quantization.center[axis] + FromSnorm16(vertex.position[axis]) * quantization.scale;
+    }
+    result.normal = DecodeOctahedral(glm::vec2(FromSnorm16(vertex.normal[0]), FromSnorm16(vertex.normal[1])));
+    result.texCoords = glm::vec2(HalfToFloat(vertex.texCoords[0]), HalfToFloat(vertex.texCoords[1]));
+    return result;
+}
+glm::vec2 EncodeOctahedral(const glm::vec3 &normal)
+{
+    float sum = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+    if (!(sum > 0.0f))
+    {
+        return glm::vec2(0.0f);
+    }
+    glm::vec3 n = normal / sum;
+    if (n.z < 0.0f)
+    {
+        // 下半球沿对角线折叠到外侧三角形
+        return glm::vec2((1.0f - std::abs(n.y)) * SignNotZero(n.x), (1.0f - std::abs(n.x)) * SignNotZero(n.y));
+    }
+    return glm::vec2(n.x, n.y);
+}
+glm::vec3 DecodeOctahedral(const glm::vec2 &encoded)
+{
+    // 与 forwardOpaquePBRQuantized.vert 中的解码相同
+    glm::vec3 n(encoded.x, encoded.y, 1.0f - std::abs(encoded.x) - std::abs(encoded.y));
+    float t = std::max(-n.z, 0.0f);
+    n.x += n.x >= 0.0f ? -t : t;
+    n.y += n.y >= 0.0f ? -t : t;
+    return glm::normalize(n);
+}
+uint16_t FloatToHalf(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    uint32_t sign = (bits >> 16) & 0x8000u;
+    uint32_t magnitude = bits & 0x7FFFFFFFu;
+    if (magnitude > 0x7F800000u)
+    {
+        return static_cast<uint16_t>(sign | 0x7E00u); // NaN
+    }
+    if (magnitude >= 0x477FE000u)
+    {
+        return static_cast<uint16_t>(sign | 0x7BFFu); // >= 65504，饱和
+    }
+    if (magnitude < 0x38800000u)
+    {
+        // 小于 2^-14：half 的非规格化数，低于 2^-25 舍入为 0
+        if (magnitude < 0x33000000u)
+        {
+            return static_cast<uint16_t>(sign);
+        }
+        uint32_t exponent = magnitude >> 23;
+        uint32_t mantissa = (magnitude & 0x7FFFFFu) | 0x800000u;
+        uint32_t shift = 126 - exponent;
+        uint32_t half = mantissa >> shift;
+        uint32_t remainder = mantissa & ((1u << shift) - 1);
+        uint32_t halfway = 1u << (shift - 1);
+        if (remainder > halfway || (remainder == halfway && (half & 1u)))
+        {
+            half++;
+        }
+        return static_cast<uint16_t>(sign | half);
+    }
+    // 指数偏置 127 -> 15，尾数截去 13 位后就近舍入到偶数，进位可以自然进入指数
+    uint32_t half = (magnitude - 0x38000000u) >> 13;
+    uint32_t remainder = magnitude & 0x1FFFu;
+    if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u)))
+    {
+        half++;
+    }
+    return static_cast<uint16_t>(sign | half);
+}
+float HalfToFloat(uint16_t value)
+{
+    uint32_t sign = static_cast<uint32_t>(value & 0x8000u) << 16;
+    uint32_t exponent = (value >> 10) & 0x1Fu;
+    uint32_t mantissa = value & 0x3FFu;
+    uint32_t bits;
+    if (exponent == 0x1F)
+    {
+        bits = sign | 0x7F800000u | (mantissa << 13);
+    }
+    else if (exponent != 0)
+    {
+        bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    }
+    else
+    {
+        float result = std::ldexp(static_cast<float>(mantissa), -24);
+        return sign ? -result : result;
+    }
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+} // namespace MEngine
@@ -0,0 +1,38 @@
+#version 450
+// input vertex data (QuantizedVertex)
+// position 为 snorm，反量化矩阵已由 CPU 并入模型矩阵；texCoords 为 half float，由顶点输入自动转换
+layout(location = 0) in vec3 inPosition;  // Location 0
+layout(location = 1) in vec2 inNormal;    // Location 1, octahedral snorm
+layout(location = 2) in vec2 inTexCoords; // Location 2
+// input instance data
+layout(location = 3) in mat4 inModelMatrix; // Location 3-6
+layout(std140,set = 0, binding = 0) uniform CameraParam
+{
+    mat4 viewMatrix;
+    mat4 projectionMatrix;
+    vec3 cameraPosition; // Camera position in world space
+}
+cameraParam;
+
+// output fragments data
+layout(location = 0) out vec3 outPosition; // Position in clip space
+layout(location = 1) out vec3 outNormal; 
+layout(location = 2) out vec2 outTexCoords;
+
+
+// 八面体解码，与 VertexQuantization.cpp 中的 DecodeOctahedral 相同
+vec3 DecodeOctahedral(vec2 encoded)
+{
+    vec3 n = vec3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+    float t = max(-n.z, 0.0);
+    n.xy += mix(vec2(t), vec2(-t), greaterThanEqual(n.xy, vec2(0.0)));
+    return normalize(n);
+}
+
+void main()
+{
+    gl_Position = cameraParam.projectionMatrix * cameraParam.viewMatrix * inModelMatrix * vec4(inPosition, 1.0);
+    outNormal = normalize(mat3(inModelMatrix) * DecodeOctahedral(inNormal)); // Transform normal to world space
+    outTexCoords = inTexCoords;
+    outPosition = (inModelMatrix * vec4(inPosition, 1.0)).rgb; // Position in world space
+}
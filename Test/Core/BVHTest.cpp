@@ -0,0 +1,171 @@
+#include "BVH.hpp"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace MEngine;
+
+class BVHTest : public ::testing::Test
+{
+  protected:
+    std::vector<AABB> mBounds;
+    std::vector<uint32_t> mIds;
+
+    void SetUp() override
+    {
+        TaskScheduler::Instance().Initialize(4, 1024);
+        std::mt19937 random(42);
+        std::uniform_real_distribution<float> position(-200.0f, 200.0f);
+        std::uniform_real_distribution<float> size(0.1f, 3.0f);
+        const uint32_t count = 20000; // 超过并行构建阈值
+        for (uint32_t i = 0; i < count; i++)
+        {
+            glm::vec3 center(position(random), position(random), position(random));
+            glm::vec3 extents(size(random), size(random), size(random));
+            mBounds.push_back(AABB{center - extents, center + extents});
+            mIds.push_back(i * 3 + 1);
+        }
+    }
+    static std::vector<uint32_t> Sorted(std::vector<uint32_t> ids)
+    {
+        std::sort(ids.begin(), ids.end());
+        return ids;
+    }
+};
+
+// 每个节点包含其子节点/图元，所有图元恰好出现一次
+TEST_F(BVHTest, BuildProducesValidTree)
+{
+    BVH bvh;
+    bvh.Build(mBounds, mIds);
+    ASSERT_FALSE(bvh.Empty());
+    EXPECT_EQ(bvh.GetPrimitiveCount(), mIds.size());
+    EXPECT_LE(bvh.GetNodeCount(), 2 * mIds.size() - 1);
+    std::vector<uint32_t> all;
+    bvh.QueryOverlap(bvh.GetNodes()[0].bounds, all);
+    EXPECT_EQ(Sorted(all), Sorted(mIds));
+    const auto &nodes = bvh.GetNodes();
+    for (uint32_t i = 0; i < nodes.size(); i++)
+    {
+        if (nodes[i].IsLeaf())
+        {
+            continue;
+        }
+        for (uint32_t child : {nodes[i].leftFirst, nodes[i].leftFirst + 1})
+        {
+            EXPECT_GT(child, i);
+            EXPECT_EQ(nodes[child].parent, i);
+            EXPECT_LE(nodes[i].bounds.min.x, nodes[child].bounds.min.x);
+            EXPECT_GE(nodes[i].bounds.max.y, nodes[child].bounds.max.y);
+        }
+    }
+}
+
+TEST_F(BVHTest, FrustumQueryMatchesBruteForce)
+{
+    BVH bvh;
+    bvh.Build(mBounds, mIds);
+    glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 150.0f);
+    glm::mat4 view = glm::lookAt(glm::vec3(10.0f, 20.0f, 30.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    Frustum frustum(projection * view);
+    std::vector<uint32_t> result;
+    bvh.QueryFrustum(frustum, result);
+    std::vector<uint32_t> expected;
+    for (size_t i = 0; i < mBounds.size(); i++)
+    {
+        if (frustum.IsVisible(mBounds[i]))
+        {
+            expected.push_back(mIds[i]);
+        }
+    }
+    EXPECT_FALSE(expected.empty());
+    EXPECT_EQ(Sorted(result), Sorted(expected));
+}
+
+TEST_F(BVHTest, RaycastFindsClosest)
+{
+    BVH bvh;
+    bvh.Build(mBounds, mIds);
+    Ray ray{glm::vec3(-250.0f, 1.0f, 2.0f), glm::vec3(1.0f, 0.0f, 0.0f)};
+    glm::vec3 inverseDirection = 1.0f / ray.direction;
+    float best = std::numeric_limits<float>::max();
+    uint32_t bestId = BVH::InvalidIndex;
+    for (size_t i = 0; i < mBounds.size(); i++)
+    {
+        float distance = mBounds[i].IntersectRay(ray, inverseDirection, best);
+        if (distance >= 0.0f && distance < best)
+        {
+            best = distance;
+            bestId = mIds[i];
+        }
+    }
+    auto hit = bvh.Raycast(ray);
+    ASSERT_EQ(hit.has_value(), bestId != BVH::InvalidIndex);
+    if (hit)
+    {
+        EXPECT_EQ(hit->id, bestId);
+        EXPECT_FLOAT_EQ(hit->distance, best);
+    }
+    EXPECT_FALSE(bvh.Raycast(Ray{glm::vec3(0.0f, 1000.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f)}).has_value());
+}
+
+// 方向分量为 0 且起点落在 slab 平面上时不能因 0 * inf 产生的 NaN 漏掉命中
+TEST(BVHRayTest, ParallelRayOnSlabPlane)
+{
+    AABB ground{glm::vec3(-10.0f, 0.0f, -10.0f), glm::vec3(10.0f, 0.0f, 10.0f)};
+    AABB box{glm::vec3(0.0f), glm::vec3(1.0f)};
+    Ray down{glm::vec3(0.0f, 5.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f)};
+    glm::vec3 inverseDown = 1.0f / down.direction;
+    EXPECT_FLOAT_EQ(ground.IntersectRay(down, inverseDown, 100.0f), 5.0f);
+    EXPECT_FLOAT_EQ(box.IntersectRay(down, inverseDown, 100.0f), 4.0f);
+    // 射线在零厚度平面内穿过
+    Ray along{glm::vec3(-20.0f, 0.0f, 0.0f), glm::vec3(1.0f, 0.0f, 0.0f)};
+    EXPECT_FLOAT_EQ(ground.IntersectRay(along, 1.0f / along.direction, 100.0f), 10.0f);
+    // 平行于 slab 且在其外部时仍然不命中
+    Ray outside{glm::vec3(2.0f, 5.0f, 0.5f), glm::vec3(0.0f, -1.0f, 0.0f)};
+    EXPECT_LT(box.IntersectRay(outside, 1.0f / outside.direction, 100.0f), 0.0f);
+
+    BVH bvh;
+    bvh.Build({ground, box}, {7, 9});
+    auto hit = bvh.Raycast(Ray{glm::vec3(5.0f, 3.0f, -10.0f), glm::vec3(0.0f, -1.0f, 0.0f)});
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_EQ(hit->id, 7u);
+    EXPECT_FLOAT_EQ(hit->distance, 3.0f);
+}
+
+TEST_F(BVHTest, RefitAfterUpdate)
+{
+    BVH bvh;
+    bvh.Build(mBounds, mIds);
+    // 移动一个图元到远处
+    AABB moved{glm::vec3(1000.0f), glm::vec3(1001.0f)};
+    bvh.Update(5, moved);
+    bvh.Refit();
+    std::vector<uint32_t> result;
+    bvh.QueryOverlap(AABB{glm::vec3(999.0f), glm::vec3(1002.0f)}, result);
+    EXPECT_EQ(result, std::vector<uint32_t>{mIds[5]});
+    EXPECT_GT(bvh.GetDegradation(), 1.0f);
+    result.clear();
+    bvh.QueryOverlap(mBounds[5], result);
+    EXPECT_EQ(std::count(result.begin(), result.end(), mIds[5]), 0);
+}
+
+TEST_F(BVHTest, EmptyAndCoincident)
+{
+    BVH bvh;
+    bvh.Build({}, {});
+    EXPECT_TRUE(bvh.Empty());
+    EXPECT_FALSE(bvh.Raycast(Ray{}).has_value());
+    // 质心完全重合时按数量对半划分
+    std::vector<AABB> bounds(100, AABB{glm::vec3(-1.0f), glm::vec3(1.0f)});
+    std::vector<uint32_t> ids(100);
+    for (uint32_t i = 0; i < ids.size(); i++)
+    {
+        ids[i] = i;
+    }
+    bvh.Build(bounds, ids);
+    std::vector<uint32_t> result;
+    bvh.QueryOverlap(AABB{glm::vec3(0.0f), glm::vec3(0.5f)}, result);
+    EXPECT_EQ(result.size(), 100u);
+}
@@ -0,0 +1,95 @@
+#include "DrawList.hpp"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <random>
+
+using namespace MEngine;
+
+TEST(DrawListTest, RadixSortMatchesStdSort)
+{
+    std::mt19937_64 random(3);
+    DrawList drawList;
+    std::vector<DrawPacket> expected;
+    for (uint32_t i = 0; i < 10000; i++)
+    {
+        uint64_t key = random();
+        drawList.Add(key, i);
+        expected.push_back(DrawPacket{key, i});
+    }
+    drawList.Sort();
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](const DrawPacket &lhs, const DrawPacket &rhs) { return lhs.key < rhs.key; });
+    ASSERT_EQ(drawList.Size(), expected.size());
+    for (size_t i = 0; i < expected.size(); i++)
+    {
+        EXPECT_EQ(drawList.GetPackets()[i].key, expected[i].key);
+        EXPECT_EQ(drawList.GetPackets()[i].index, expected[i].index);
+    }
+}
+
+// 相同的键保持插入顺序
+TEST(DrawListTest, SortIsStable)
+{
+    DrawList drawList;
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        drawList.Add(i % 3, i);
+    }
+    drawList.Sort();
+    for (size_t i = 1; i < drawList.Size(); i++)
+    {
+        const auto &packet = drawList.GetPackets()[i];
+        const auto &last = drawList.GetPackets()[i - 1];
+        if (packet.key == last.key)
+        {
+            EXPECT_GT(packet.index, last.index);
+        }
+    }
+}
+
+TEST(DrawListTest, OpaqueGroupsStateThenFrontToBack)
+{
+    DrawList drawList;
+    drawList.Add(SortKey::MakeOpaque(0, 2, 1, 0.1f), 0);
+    drawList.Add(SortKey::MakeOpaque(0, 1, 1, 0.9f), 1);
+    drawList.Add(SortKey::MakeOpaque(0, 1, 1, 0.2f), 2);
+    drawList.Add(SortKey::MakeOpaque(0, 1, 0, 0.5f), 3);
+    drawList.Sort();
+    std::vector<uint32_t> order;
+    for (const auto &packet : drawList.GetPackets())
+    {
+        order.push_back(packet.index);
+    }
+    EXPECT_EQ(order, (std::vector<uint32_t>{3, 2, 1, 0}));
+}
+
+TEST(DrawListTest, OpaqueStateIgnoresDepth)
+{
+    EXPECT_EQ(SortKey::GetOpaqueState(SortKey::MakeOpaque(0, 3, 7, 0.1f)),
+              SortKey::GetOpaqueState(SortKey::MakeOpaque(0, 3, 7, 0.9f)));
+    EXPECT_NE(SortKey::GetOpaqueState(SortKey::MakeOpaque(0, 3, 7, 0.1f)),
+              SortKey::GetOpaqueState(SortKey::MakeOpaque(0, 3, 8, 0.1f)));
+}
+
+TEST(DrawListTest, TransparentBackToFront)
+{
+    DrawList drawList;
+    drawList.Add(SortKey::MakeTransparent(1, 0, 0, 0.2f), 0);
+    drawList.Add(SortKey::MakeTransparent(1, 5, 5, 0.8f), 1);
+    drawList.Add(SortKey::MakeTransparent(1, 2, 2, 0.5f), 2);
+    drawList.Sort();
+    std::vector<uint32_t> order;
+    for (const auto &packet : drawList.GetPackets())
+    {
+        order.push_back(packet.index);
+        EXPECT_EQ(SortKey::GetPipeline(packet.key), 1);
+    }
+    EXPECT_EQ(order, (std::vector<uint32_t>{1, 2, 0}));
+}
+
+TEST(DrawListTest, QuantizeDepthClamps)
+{
+    EXPECT_EQ(SortKey::QuantizeDepth(-1.0f), 0u);
+    EXPECT_EQ(SortKey::QuantizeDepth(2.0f), SortKey::DepthMax);
+    EXPECT_LT(SortKey::QuantizeDepth(0.25f), SortKey::QuantizeDepth(0.5f));
+}
@@ -0,0 +1,83 @@
+#include "Frustum.hpp"
+#include "gtest/gtest.h"
+#include <random>
+#include <vector>
+
+using namespace MEngine;
+
+static Frustum MakeFrustum()
+{
+    glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+    glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    return Frustum(projection * view);
+}
+
+TEST(FrustumTest, SphereInsideAndOutside)
+{
+    Frustum frustum = MakeFrustum();
+    EXPECT_TRUE(frustum.IsVisible(BoundingSphere{glm::vec3(0.0f, 0.0f, -10.0f), 1.0f}));
+    // 相机后方
+    EXPECT_FALSE(frustum.IsVisible(BoundingSphere{glm::vec3(0.0f, 0.0f, 10.0f), 1.0f}));
+    // 远平面之外
+    EXPECT_FALSE(frustum.IsVisible(BoundingSphere{glm::vec3(0.0f, 0.0f, -200.0f), 1.0f}));
+    // 跨越远平面
+    EXPECT_TRUE(frustum.IsVisible(BoundingSphere{glm::vec3(0.0f, 0.0f, -100.5f), 1.0f}));
+    // 左侧之外
+    EXPECT_FALSE(frustum.IsVisible(BoundingSphere{glm::vec3(-100.0f, 0.0f, -10.0f), 1.0f}));
+}
+
+TEST(FrustumTest, BoxInsideAndOutside)
+{
+    Frustum frustum = MakeFrustum();
+    EXPECT_TRUE(frustum.IsVisible(AABB{glm::vec3(-1.0f, -1.0f, -11.0f), glm::vec3(1.0f, 1.0f, -9.0f)}));
+    EXPECT_FALSE(frustum.IsVisible(AABB{glm::vec3(-1.0f, -1.0f, 9.0f), glm::vec3(1.0f, 1.0f, 11.0f)}));
+    // 包含相机的大盒子
+    EXPECT_TRUE(frustum.IsVisible(AABB{glm::vec3(-50.0f), glm::vec3(50.0f)}));
+    EXPECT_FALSE(frustum.IsVisible(AABB{glm::vec3(0.0f, 50.0f, -11.0f), glm::vec3(1.0f, 51.0f, -9.0f)}));
+}
+
+TEST(FrustumTest, TransformedBoxContainsCorners)
+{
+    AABB box{glm::vec3(-1.0f, -2.0f, -3.0f), glm::vec3(1.0f, 2.0f, 3.0f)};
+    glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(5.0f, 0.0f, -2.0f));
+    model = glm::scale(model, glm::vec3(2.0f, 1.0f, 0.5f));
+    AABB world = box.Transform(model);
+    EXPECT_NEAR(world.min.x, 3.0f, 1e-5f);
+    EXPECT_NEAR(world.max.x, 7.0f, 1e-5f);
+    EXPECT_NEAR(world.min.z, -3.5f, 1e-5f);
+    EXPECT_NEAR(world.max.z, -0.5f, 1e-5f);
+    BoundingSphere sphere = BoundingSphere{glm::vec3(0.0f), 1.0f}.Transform(model);
+    EXPECT_NEAR(sphere.radius, 2.0f, 1e-5f);
+}
+
+TEST(FrustumTest, BatchMatchesScalar)
+{
+    Frustum frustum = MakeFrustum();
+    std::mt19937 random(7);
+    std::uniform_real_distribution<float> position(-120.0f, 120.0f);
+    std::uniform_real_distribution<float> size(0.1f, 5.0f);
+    const size_t count = 1027; // 覆盖 SIMD 尾部
+    BoundsSoA bounds;
+    bounds.Resize(count);
+    std::vector<AABB> boxes(count);
+    std::vector<BoundingSphere> spheres(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        glm::vec3 center(position(random), position(random), position(random));
+        glm::vec3 extents(size(random), size(random), size(random));
+        boxes[i] = AABB{center - extents, center + extents};
+        spheres[i] = BoundingSphere{center, glm::length(extents)};
+        bounds.Set(i, boxes[i], spheres[i]);
+    }
+    std::vector<uint8_t> visible(count, 2);
+    frustum.Cull(bounds, 0, count, visible.data());
+    size_t visibleCount = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        bool expected = frustum.IsVisible(spheres[i]) && frustum.IsVisible(boxes[i]);
+        EXPECT_EQ(visible[i], expected ? 1 : 0) << "index " << i;
+        visibleCount += visible[i];
+    }
+    EXPECT_GT(visibleCount, 0u);
+    EXPECT_LT(visibleCount, count);
+}
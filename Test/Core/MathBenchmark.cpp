@@ -0,0 +1,75 @@
+#include "Math.hpp"
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace MEngine;
+
+// 对比 TransformSystem/CameraSystem 原来的 glm 标量路径与 Math.hpp 批量路径，只输出耗时，不加入 ctest
+namespace
+{
+constexpr size_t Count = 100000;
+constexpr int Iterations = 20;
+
+template <typename TFunc> double Measure(TFunc &&func)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < Iterations; ++i)
+    {
+        func();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::milli>(elapsed).count() / Iterations;
+}
+void Report(const char *name, double glmTime, double batchTime)
+{
+    std::printf("%s x%zu: glm %.3f ms, batch %.3f ms, speedup %.2fx\n", name, Count, glmTime, batchTime,
+                glmTime / batchTime);
+}
+} // namespace
+
+int main()
+{
+    std::mt19937 random(1);
+    std::uniform_real_distribution<float> distribution(-10.0f, 10.0f);
+    std::vector<glm::vec3> translations;
+    std::vector<glm::quat> rotations;
+    std::vector<glm::vec3> scales;
+    for (size_t i = 0; i < Count; ++i)
+    {
+        translations.emplace_back(distribution(random), distribution(random), distribution(random));
+        rotations.push_back(glm::normalize(
+            glm::quat(distribution(random), distribution(random), distribution(random), distribution(random))));
+        scales.emplace_back(distribution(random), distribution(random), distribution(random));
+    }
+    std::vector<glm::mat4> matrices(Count);
+
+    double glmTime = Measure([&]() {
+        for (size_t i = 0; i < Count; ++i)
+        {
+            glm::mat4 modelMatrix = glm::mat4(1.0f);
+            modelMatrix = glm::translate(modelMatrix, translations[i]);
+            modelMatrix = modelMatrix * glm::mat4_cast(rotations[i]);
+            modelMatrix = glm::scale(modelMatrix, scales[i]);
+            matrices[i] = modelMatrix;
+        }
+    });
+    double batchTime = Measure([&]() {
+        Math::ComposeTRSBatch(translations.data(), rotations.data(), scales.data(), matrices.data(), Count);
+    });
+    Report("ComposeTRS", glmTime, batchTime);
+
+    glm::mat4 viewProjection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 100.0f) *
+                               glm::lookAtRH(glm::vec3(0.0f, 2.0f, 5.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    std::vector<glm::mat4> result(Count);
+    glmTime = Measure([&]() {
+        for (size_t i = 0; i < Count; ++i)
+        {
+            result[i] = viewProjection * matrices[i];
+        }
+    });
+    batchTime = Measure([&]() { Math::PremultiplyBatch(viewProjection, matrices.data(), result.data(), Count); });
+    Report("Premultiply", glmTime, batchTime);
+    return 0;
+}
@@ -0,0 +1,117 @@
+#include "Math.hpp"
+#include "gtest/gtest.h"
+#include <random>
+#include <vector>
+
+using namespace MEngine;
+
+static void ExpectMatrixNear(const glm::mat4 &actual, const glm::mat4 &expected, float tolerance = 1e-5f)
+{
+    for (int column = 0; column < 4; ++column)
+    {
+        for (int row = 0; row < 4; ++row)
+        {
+            EXPECT_NEAR(actual[column][row], expected[column][row], tolerance)
+                << "column " << column << " row " << row;
+        }
+    }
+}
+
+static glm::mat4 ReferenceTRS(const glm::vec3 &translation, const glm::quat &rotation, const glm::vec3 &scale)
+{
+    glm::mat4 modelMatrix = glm::mat4(1.0f);
+    modelMatrix = glm::translate(modelMatrix, translation);
+    modelMatrix = modelMatrix * glm::mat4_cast(rotation);
+    modelMatrix = glm::scale(modelMatrix, scale);
+    return modelMatrix;
+}
+
+struct RandomTransforms
+{
+    std::vector<glm::vec3> translations;
+    std::vector<glm::quat> rotations;
+    std::vector<glm::vec3> scales;
+    RandomTransforms(size_t count, uint32_t seed)
+    {
+        std::mt19937 random(seed);
+        std::uniform_real_distribution<float> distribution(-10.0f, 10.0f);
+        for (size_t i = 0; i < count; ++i)
+        {
+            translations.emplace_back(distribution(random), distribution(random), distribution(random));
+            rotations.push_back(glm::normalize(
+                glm::quat(distribution(random), distribution(random), distribution(random), distribution(random))));
+            scales.emplace_back(distribution(random), distribution(random), distribution(random));
+        }
+    }
+};
+
+TEST(MathTest, ComposeTRSIdentity)
+{
+    ExpectMatrixNear(Math::ComposeTRS(glm::vec3(0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f), glm::vec3(1.0f)),
+                     glm::mat4(1.0f));
+}
+
+TEST(MathTest, ComposeTRSMatchesGlm)
+{
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> distribution(-10.0f, 10.0f);
+    for (int i = 0; i < 1000; ++i)
+    {
+        glm::vec3 translation(distribution(random), distribution(random), distribution(random));
+        glm::quat rotation = glm::normalize(
+            glm::quat(distribution(random), distribution(random), distribution(random), distribution(random)));
+        glm::vec3 scale(distribution(random), distribution(random), distribution(random));
+        ExpectMatrixNear(Math::ComposeTRS(translation, rotation, scale), ReferenceTRS(translation, rotation, scale),
+                         1e-4f);
+    }
+}
+
+TEST(MathTest, ComposeTRSBatchMatchesScalar)
+{
+    // 非 8 的倍数，覆盖 SIMD 主循环和尾部
+    const size_t count = 1003;
+    RandomTransforms transforms(count, 7);
+    std::vector<glm::mat4> matrices(count);
+    Math::ComposeTRSBatch(transforms.translations.data(), transforms.rotations.data(), transforms.scales.data(),
+                          matrices.data(), count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        ExpectMatrixNear(matrices[i],
+                         Math::ComposeTRSScalar(transforms.translations[i], transforms.rotations[i],
+                                                transforms.scales[i]),
+                         1e-4f);
+    }
+}
+
+TEST(MathTest, PremultiplyBatchMatchesGlm)
+{
+    const size_t count = 257;
+    RandomTransforms transforms(count, 11);
+    std::vector<glm::mat4> models(count);
+    Math::ComposeTRSBatch(transforms.translations.data(), transforms.rotations.data(), transforms.scales.data(),
+                          models.data(), count);
+    glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+    glm::mat4 view = glm::lookAtRH(glm::vec3(0.0f, 2.0f, 5.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    glm::mat4 viewProjection = projection * view;
+
+    std::vector<glm::mat4> result(count);
+    Math::PremultiplyBatch(viewProjection, models.data(), result.data(), count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        ExpectMatrixNear(result[i], viewProjection * models[i], 1e-3f);
+    }
+    // 原地计算
+    Math::PremultiplyBatch(viewProjection, models.data(), models.data(), count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        ExpectMatrixNear(models[i], result[i], 0.0f);
+    }
+}
+
+TEST(MathTest, MultiplyMatchesGlm)
+{
+    RandomTransforms transforms(2, 13);
+    glm::mat4 lhs = ReferenceTRS(transforms.translations[0], transforms.rotations[0], transforms.scales[0]);
+    glm::mat4 rhs = ReferenceTRS(transforms.translations[1], transforms.rotations[1], transforms.scales[1]);
+    ExpectMatrixNear(Math::Multiply(lhs, rhs), lhs * rhs, 1e-3f);
+}
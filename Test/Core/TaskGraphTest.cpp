@@ -0,0 +1,128 @@
+#include "TaskGraph.hpp"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+using namespace MEngine;
+
+struct ComponentA
+{
+};
+struct ComponentB
+{
+};
+
+class TaskGraphTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        TaskScheduler::Instance().Initialize(4, 64);
+    }
+};
+
+// 测试读写冲突推导出的依赖
+TEST_F(TaskGraphTest, BuildEdgesFromAccess)
+{
+    TaskGraph graph;
+    auto writeA = graph.AddNode("WriteA", []() {}, TaskAccess().Write<ComponentA>());
+    auto writeB = graph.AddNode("WriteB", []() {}, TaskAccess().Write<ComponentB>());
+    auto readA = graph.AddNode("ReadA", []() {}, TaskAccess().Read<ComponentA>());
+    auto readAB = graph.AddNode("ReadAB", []() {}, TaskAccess().Read<ComponentA, ComponentB>());
+    auto writeA2 = graph.AddNode("WriteA2", []() {}, TaskAccess().Write<ComponentA>());
+    graph.Build();
+
+    EXPECT_EQ(graph.GetSuccessors(writeA), (std::vector<TaskGraph::NodeHandle>{readA, readAB, writeA2}));
+    EXPECT_EQ(graph.GetSuccessors(writeB), (std::vector<TaskGraph::NodeHandle>{readAB}));
+    // 两个只读节点之间没有依赖，写节点要等待之前的读节点
+    EXPECT_EQ(graph.GetSuccessors(readA), (std::vector<TaskGraph::NodeHandle>{writeA2}));
+    EXPECT_EQ(graph.GetSuccessors(readAB), (std::vector<TaskGraph::NodeHandle>{writeA2}));
+}
+
+// 测试无冲突节点并行执行
+TEST_F(TaskGraphTest, IndependentNodesRunInParallel)
+{
+    TaskGraph graph;
+    std::atomic<int> arrived{0};
+    std::atomic<bool> overlapped{true};
+    auto rendezvous = [&]() {
+        arrived++;
+        auto deadline = std::chrono::steady_clock::now() + 2s;
+        while (arrived.load() < 2)
+        {
+            if (std::chrono::steady_clock::now() > deadline)
+            {
+                overlapped = false;
+                return;
+            }
+            std::this_thread::yield();
+        }
+    };
+    graph.AddNode("A", rendezvous, TaskAccess().Write<ComponentA>());
+    graph.AddNode("B", rendezvous, TaskAccess().Write<ComponentB>());
+    graph.Execute();
+
+    EXPECT_TRUE(overlapped.load());
+}
+
+// 测试依赖顺序以及主线程节点
+TEST_F(TaskGraphTest, OrderingAndMainThread)
+{
+    TaskGraph graph;
+    std::mutex mutex;
+    std::vector<std::string> order;
+    std::thread::id mainThreadId;
+    auto record = [&](const std::string &name) {
+        std::lock_guard<std::mutex> lock(mutex);
+        order.push_back(name);
+    };
+    graph.AddNode("Input", [&]() { record("Input"); }, TaskAccess().Write<ComponentA>().MainThread());
+    graph.AddNode("Camera", [&]() { record("Camera"); }, TaskAccess().Read<ComponentA>().Write<ComponentB>());
+    graph.AddNode(
+        "Render",
+        [&]() {
+            record("Render");
+            mainThreadId = std::this_thread::get_id();
+        },
+        TaskAccess().Read<ComponentA, ComponentB>().MainThread());
+
+    for (int frame = 0; frame < 10; ++frame)
+    {
+        order.clear();
+        graph.Execute();
+        EXPECT_EQ(order, (std::vector<std::string>{"Input", "Camera", "Render"}));
+        EXPECT_EQ(mainThreadId, std::this_thread::get_id());
+    }
+}
+
+// 测试节点异常在 Execute 中抛出且不影响其他节点
+TEST_F(TaskGraphTest, ExceptionPropagates)
+{
+    TaskGraph graph;
+    std::atomic<int> counter{0};
+    graph.AddNode("Throw", []() { throw std::runtime_error("Oops!"); }, TaskAccess().Write<ComponentA>());
+    graph.AddNode("After", [&]() { counter++; }, TaskAccess().Read<ComponentA>());
+
+    EXPECT_THROW(graph.Execute(), std::runtime_error);
+    EXPECT_EQ(counter.load(), 1);
+}
+
+// 测试 Execute 返回后立即销毁图：工作线程不能再访问图的成员
+TEST_F(TaskGraphTest, DestroyRightAfterExecute)
+{
+    std::atomic<int> counter{0};
+    for (int i = 0; i < 1000; ++i)
+    {
+        auto graph = std::make_unique<TaskGraph>();
+        graph->AddNode("A", [&]() { counter++; }, TaskAccess().Write<ComponentA>());
+        graph->AddNode("B", [&]() { counter++; }, TaskAccess().Write<ComponentB>());
+        graph->Execute();
+    }
+    EXPECT_EQ(counter.load(), 2000);
+}
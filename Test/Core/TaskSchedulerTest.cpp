@@ -181,3 +181,45 @@ TEST(Task, Run)
     task->Wait();
     EXPECT_EQ(counter.load(), 1);
 }
+
+// 测试工作线程内提交的任务进入本地队列并可被窃取
+TEST(TaskSchedulerTest, WorkerLocalSubmissionIsStolen)
+{
+    auto &scheduler = TaskScheduler::Instance();
+    TaskScheduler::Instance().Initialize(4, 10);
+    std::atomic<int> counter{0};
+    const int childTasks = 64;
+    uint64_t stealsBefore = scheduler.GetStealCount();
+
+    auto parent = Task::Run([&counter]() {
+        std::vector<std::shared_ptr<Task>> children;
+        for (int i = 0; i < childTasks; ++i)
+        {
+            children.push_back(Task::Run([&counter]() {
+                std::this_thread::sleep_for(1ms);
+                counter++;
+            }));
+        }
+        // 工作线程内等待不会阻塞线程
+        Task::WhenAll(children);
+    });
+    parent->Wait();
+
+    EXPECT_EQ(counter.load(), childTasks);
+    EXPECT_GT(scheduler.GetStealCount(), stealsBefore);
+    EXPECT_EQ(scheduler.GetPendingTasks(), 0);
+}
+
+// 测试单线程下嵌套等待不会死锁
+TEST(TaskSchedulerTest, NestedWaitSingleThread)
+{
+    TaskScheduler::Instance().Initialize(1, 10);
+    std::atomic<int> counter{0};
+    auto parent = Task::Run([&counter]() {
+        auto child = Task::Run([&counter]() { counter++; });
+        child->Wait();
+        counter++;
+    });
+    parent->Wait();
+    EXPECT_EQ(counter.load(), 2);
+}
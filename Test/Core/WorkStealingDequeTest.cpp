@@ -0,0 +1,102 @@
+#include "WorkStealingDeque.hpp"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace MEngine;
+
+TEST(WorkStealingDequeTest, Constructor)
+{
+    WorkStealingDeque<int> deque(8);
+    EXPECT_EQ(deque.Capacity(), 8);
+    EXPECT_TRUE(deque.Empty());
+
+    // 容量必须是2的幂
+    EXPECT_THROW(WorkStealingDeque<int>(6), std::invalid_argument);
+    EXPECT_THROW(WorkStealingDeque<int>(0), std::invalid_argument);
+}
+
+TEST(WorkStealingDequeTest, PopIsLifoStealIsFifo)
+{
+    WorkStealingDeque<int> deque(8);
+    deque.Push(1);
+    deque.Push(2);
+    deque.Push(3);
+    EXPECT_EQ(deque.Size(), 3);
+
+    EXPECT_EQ(deque.Pop().value(), 3);
+    EXPECT_EQ(deque.Steal().value(), 1);
+    EXPECT_EQ(deque.Pop().value(), 2);
+    EXPECT_FALSE(deque.Pop().has_value());
+    EXPECT_FALSE(deque.Steal().has_value());
+}
+
+TEST(WorkStealingDequeTest, Grow)
+{
+    WorkStealingDeque<int> deque(2);
+    for (int i = 0; i < 100; ++i)
+    {
+        deque.Push(i);
+    }
+    EXPECT_GE(deque.Capacity(), 100);
+    for (int i = 99; i >= 0; --i)
+    {
+        EXPECT_EQ(deque.Pop().value(), i);
+    }
+}
+
+// 所有者与多个窃取者并发，每个元素恰好被取出一次
+TEST(WorkStealingDequeTest, ConcurrentSteal)
+{
+    const int itemCount = 100000;
+    const int thiefCount = 4;
+    WorkStealingDeque<int> deque(64);
+    std::vector<std::atomic<int>> taken(itemCount);
+    std::atomic<int> total{0};
+    std::atomic<bool> done{false};
+
+    std::vector<std::thread> thieves;
+    for (int i = 0; i < thiefCount; ++i)
+    {
+        thieves.emplace_back([&]() {
+            while (!done.load() || !deque.Empty())
+            {
+                if (auto item = deque.Steal())
+                {
+                    taken[*item]++;
+                    total++;
+                }
+            }
+        });
+    }
+    for (int i = 0; i < itemCount; ++i)
+    {
+        deque.Push(i);
+        if (i % 3 == 0)
+        {
+            if (auto item = deque.Pop())
+            {
+                taken[*item]++;
+                total++;
+            }
+        }
+    }
+    while (auto item = deque.Pop())
+    {
+        taken[*item]++;
+        total++;
+    }
+    done = true;
+    for (auto &thief : thieves)
+    {
+        thief.join();
+    }
+
+    EXPECT_EQ(total.load(), itemCount);
+    for (int i = 0; i < itemCount; ++i)
+    {
+        EXPECT_EQ(taken[i].load(), 1);
+    }
+}
@@ -0,0 +1,155 @@
+#include "Component/TransformComponent.hpp"
+#include "Interface/IConfigure.hpp"
+#include "SpdLogger.hpp"
+#include "System/TransformSystem.hpp"
+#include "gtest/gtest.h"
+#include <memory>
+#include <stdexcept>
+
+using namespace MEngine;
+
+namespace
+{
+class TestConfigure final : public IConfigure
+{
+  private:
+    Json mJson = {{"Logger", {{"Level", "warn"}}}};
+
+  public:
+    void SetJsonSettingFile(const fs::path &) override
+    {
+    }
+    const Json &GetJson() const override
+    {
+        return mJson;
+    }
+};
+void ExpectTranslation(const glm::mat4 &matrix, const glm::vec3 &expected)
+{
+    EXPECT_NEAR(matrix[3][0], expected.x, 1e-4f);
+    EXPECT_NEAR(matrix[3][1], expected.y, 1e-4f);
+    EXPECT_NEAR(matrix[3][2], expected.z, 1e-4f);
+}
+} // namespace
+
+/**
+ * 编辑器的层级面板通过 SetParent(child, parent, true) 修改父节点，这里按同样的调用检查层级与世界矩阵
+ */
+class TransformSystemTest : public ::testing::Test
+{
+  protected:
+    std::shared_ptr<IConfigure> mConfigure = std::make_shared<TestConfigure>();
+    std::shared_ptr<ILogger> mLogger = std::make_shared<SpdLogger>(mConfigure);
+    std::shared_ptr<entt::registry> mRegistry = std::make_shared<entt::registry>();
+    std::shared_ptr<TransformSystem> mTransformSystem;
+
+    void SetUp() override
+    {
+        mTransformSystem = std::make_shared<TransformSystem>(mLogger, nullptr, mConfigure, mRegistry);
+        mTransformSystem->Init();
+    }
+    void TearDown() override
+    {
+        mTransformSystem->Shutdown();
+    }
+    entt::entity CreateEntity(const glm::vec3 &position, const glm::vec3 &scale = glm::vec3(1.0f))
+    {
+        auto entity = mRegistry->create();
+        mRegistry->emplace<TransformComponent>(entity, TransformComponent(position, glm::quat(1, 0, 0, 0), scale));
+        return entity;
+    }
+    const TransformComponent &Get(entt::entity entity) const
+    {
+        return mRegistry->get<TransformComponent>(entity);
+    }
+};
+
+TEST_F(TransformSystemTest, ChildWorldMatrixFollowsParent)
+{
+    auto parent = CreateEntity({1.0f, 0.0f, 0.0f});
+    auto child = CreateEntity({0.0f, 2.0f, 0.0f});
+    mTransformSystem->SetParent(child, parent);
+    mTransformSystem->Tick(0.0f);
+    ExpectTranslation(Get(child).modelMatrix, {1.0f, 2.0f, 0.0f});
+    EXPECT_EQ(Get(child).depth, 1u);
+
+    // 只移动父节点，子节点随之更新
+    mRegistry->get<TransformComponent>(parent).position = {3.0f, 0.0f, 0.0f};
+    mRegistry->get<TransformComponent>(parent).isDirty = true;
+    mTransformSystem->Tick(0.0f);
+    ExpectTranslation(Get(child).modelMatrix, {3.0f, 2.0f, 0.0f});
+}
+
+TEST_F(TransformSystemTest, ReparentKeepsWorldTransform)
+{
+    auto parent = CreateEntity({1.0f, 0.0f, 0.0f}, glm::vec3(2.0f));
+    auto child = CreateEntity({5.0f, 0.0f, 0.0f});
+    mTransformSystem->Tick(0.0f);
+
+    // 编辑器拖放：世界位置保持不变，局部变换相对新父节点改写
+    mTransformSystem->SetParent(child, parent, true);
+    mTransformSystem->Tick(0.0f);
+    ExpectTranslation(Get(child).modelMatrix, {5.0f, 0.0f, 0.0f});
+    EXPECT_NEAR(Get(child).position.x, 2.0f, 1e-4f);
+    EXPECT_NEAR(Get(child).scale.x, 0.5f, 1e-4f);
+
+    // 清除父节点同样保持世界变换
+    mTransformSystem->SetParent(child, entt::null, true);
+    mTransformSystem->Tick(0.0f);
+    EXPECT_EQ(Get(child).parent, entt::null);
+    EXPECT_EQ(Get(child).depth, 0u);
+    ExpectTranslation(Get(child).modelMatrix, {5.0f, 0.0f, 0.0f});
+    EXPECT_NEAR(Get(child).scale.x, 1.0f, 1e-4f);
+}
+
+TEST_F(TransformSystemTest, MovingBetweenParentsRebuildsHierarchy)
+{
+    auto first = CreateEntity({1.0f, 0.0f, 0.0f});
+    auto second = CreateEntity({0.0f, 0.0f, 4.0f});
+    auto child = CreateEntity({0.0f, 1.0f, 0.0f});
+    mTransformSystem->SetParent(child, first);
+    mTransformSystem->Tick(0.0f);
+    ExpectTranslation(Get(child).modelMatrix, {1.0f, 1.0f, 0.0f});
+
+    mTransformSystem->SetParent(second, first);
+    mTransformSystem->SetParent(child, second);
+    mTransformSystem->Tick(0.0f);
+    EXPECT_EQ(Get(child).depth, 2u);
+    ExpectTranslation(Get(child).modelMatrix, {1.0f, 1.0f, 4.0f});
+}
+
+TEST_F(TransformSystemTest, RejectsCyclesAndMissingTransforms)
+{
+    auto root = CreateEntity({0.0f, 0.0f, 0.0f});
+    auto child = CreateEntity({0.0f, 0.0f, 0.0f});
+    mTransformSystem->SetParent(child, root);
+    EXPECT_THROW(mTransformSystem->SetParent(root, child), std::runtime_error);
+    EXPECT_THROW(mTransformSystem->SetParent(root, root), std::runtime_error);
+    EXPECT_EQ(Get(root).parent, entt::null);
+
+    auto bare = mRegistry->create();
+    EXPECT_THROW(mTransformSystem->SetParent(bare, root), std::runtime_error);
+    EXPECT_THROW(mTransformSystem->SetParent(child, bare), std::runtime_error);
+    EXPECT_EQ(Get(child).parent, root);
+}
+
+TEST_F(TransformSystemTest, DestroyedParentMakesChildRoot)
+{
+    auto parent = CreateEntity({1.0f, 0.0f, 0.0f}, glm::vec3(2.0f));
+    auto child = CreateEntity({0.0f, 2.0f, 0.0f});
+    auto grandchild = CreateEntity({1.0f, 0.0f, 0.0f});
+    mTransformSystem->SetParent(child, parent);
+    mTransformSystem->SetParent(grandchild, child);
+    mTransformSystem->Tick(0.0f);
+    ExpectTranslation(Get(child).modelMatrix, {1.0f, 4.0f, 0.0f});
+    ExpectTranslation(Get(grandchild).modelMatrix, {3.0f, 4.0f, 0.0f});
+
+    // 父节点的世界变换并入子节点的局部变换，世界位置保持不变
+    mRegistry->destroy(parent);
+    mTransformSystem->Tick(0.0f);
+    EXPECT_EQ(Get(child).parent, entt::null);
+    EXPECT_EQ(Get(grandchild).parent, child);
+    EXPECT_NEAR(Get(child).scale.x, 2.0f, 1e-4f);
+    ExpectTranslation(Get(child).modelMatrix, {1.0f, 4.0f, 0.0f});
+    ExpectTranslation(Get(grandchild).modelMatrix, {3.0f, 4.0f, 0.0f});
+}
@@ -0,0 +1,60 @@
+#include "FreeListAllocator.hpp"
+#include <gtest/gtest.h>
+
+using namespace MEngine;
+
+TEST(FreeListAllocatorTest, AllocatesSequentially)
+{
+    FreeListAllocator allocator(100);
+    EXPECT_EQ(allocator.Allocate(10).value(), 0u);
+    EXPECT_EQ(allocator.Allocate(20).value(), 10u);
+    EXPECT_EQ(allocator.GetUsed(), 30u);
+    EXPECT_EQ(allocator.GetLargestFreeBlock(), 70u);
+}
+
+TEST(FreeListAllocatorTest, FailsWhenNoBlockIsLargeEnough)
+{
+    FreeListAllocator allocator(100);
+    EXPECT_FALSE(allocator.Allocate(0).has_value());
+    EXPECT_FALSE(allocator.Allocate(101).has_value());
+    auto a = allocator.Allocate(40).value();
+    ASSERT_TRUE(allocator.Allocate(20).has_value());
+    ASSERT_TRUE(allocator.Allocate(40).has_value());
+    allocator.Free(a, 40);
+    // 空闲 40 个单位，但只有一块
+    EXPECT_FALSE(allocator.Allocate(41).has_value());
+    EXPECT_EQ(allocator.Allocate(40).value(), 0u);
+}
+
+TEST(FreeListAllocatorTest, PicksBestFit)
+{
+    FreeListAllocator allocator(100);
+    auto a = allocator.Allocate(30).value();
+    allocator.Allocate(10);
+    auto b = allocator.Allocate(8).value();
+    allocator.Allocate(10);
+    allocator.Free(a, 30);
+    allocator.Free(b, 8);
+    // 8 个单位的空洞比 30 个的更合适
+    EXPECT_EQ(allocator.Allocate(6).value(), b);
+    EXPECT_EQ(allocator.Allocate(20).value(), a);
+}
+
+TEST(FreeListAllocatorTest, CoalescesNeighbours)
+{
+    FreeListAllocator allocator(100);
+    auto a = allocator.Allocate(25).value();
+    auto b = allocator.Allocate(25).value();
+    auto c = allocator.Allocate(25).value();
+    auto d = allocator.Allocate(25).value();
+    allocator.Free(a, 25);
+    allocator.Free(c, 25);
+    EXPECT_EQ(allocator.GetFreeBlockCount(), 2u);
+    allocator.Free(b, 25);
+    EXPECT_EQ(allocator.GetFreeBlockCount(), 1u);
+    EXPECT_EQ(allocator.GetLargestFreeBlock(), 75u);
+    allocator.Free(d, 25);
+    EXPECT_EQ(allocator.GetUsed(), 0u);
+    EXPECT_EQ(allocator.GetLargestFreeBlock(), 100u);
+    EXPECT_EQ(allocator.Allocate(100).value(), 0u);
+}
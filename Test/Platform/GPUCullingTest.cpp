@@ -0,0 +1,336 @@
+#include "Bounds.hpp"
+#include "Frustum.hpp"
+#include "IndirectDraw.hpp"
+#include "Vertex.hpp"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <random>
+#include <tuple>
+#include <vector>
+#include <vulkan/vulkan.hpp>
+
+using namespace MEngine;
+
+/**
+ * 不创建窗口与交换链，直接在任意可用设备（包括 lavapipe/SwiftShader 等软件实现）上运行 gpuCulling.comp，
+ * 并与 CPU 端 Frustum::Cull 的结果逐批次比较。没有可用设备或着色器未编译时跳过。
+ */
+class GPUCullingTest : public ::testing::Test
+{
+  protected:
+    struct HostBuffer
+    {
+        vk::UniqueBuffer buffer;
+        vk::UniqueDeviceMemory memory;
+        void *mapped = nullptr;
+        vk::DeviceSize size = 0;
+    };
+
+    vk::UniqueInstance mInstance;
+    vk::PhysicalDevice mPhysicalDevice;
+    vk::UniqueDevice mDevice;
+    uint32_t mQueueFamily = 0;
+    vk::Queue mQueue;
+
+    void SetUp() override
+    {
+        try
+        {
+            vk::ApplicationInfo appInfo;
+            appInfo.setPApplicationName("GPUCullingTest").setApiVersion(VK_API_VERSION_1_1);
+            vk::InstanceCreateInfo instanceCreateInfo;
+            instanceCreateInfo.setPApplicationInfo(&appInfo);
+            mInstance = vk::createInstanceUnique(instanceCreateInfo);
+            std::optional<uint32_t> queueFamily;
+            for (auto physicalDevice : mInstance->enumeratePhysicalDevices())
+            {
+                auto families = physicalDevice.getQueueFamilyProperties();
+                for (uint32_t i = 0; i < families.size(); i++)
+                {
+                    if (families[i].queueFlags & vk::QueueFlagBits::eCompute)
+                    {
+                        queueFamily = i;
+                        break;
+                    }
+                }
+                if (queueFamily)
+                {
+                    mPhysicalDevice = physicalDevice;
+                    break;
+                }
+            }
+            if (!queueFamily)
+            {
+                GTEST_SKIP() << "No Vulkan device with a compute queue";
+            }
+            mQueueFamily = queueFamily.value();
+            const float queuePriority = 1.0f;
+            vk::DeviceQueueCreateInfo queueCreateInfo;
+            queueCreateInfo.setQueueFamilyIndex(mQueueFamily).setQueueCount(1).setPQueuePriorities(&queuePriority);
+            vk::DeviceCreateInfo deviceCreateInfo;
+            deviceCreateInfo.setQueueCreateInfos(queueCreateInfo);
+            mDevice = mPhysicalDevice.createDeviceUnique(deviceCreateInfo);
+            mQueue = mDevice->getQueue(mQueueFamily, 0);
+        }
+        catch (const vk::SystemError &error)
+        {
+            GTEST_SKIP() << "Vulkan is not available: " << error.what();
+        }
+    }
+
+    HostBuffer CreateHostBuffer(vk::DeviceSize size)
+    {
+        HostBuffer result;
+        result.size = size;
+        vk::BufferCreateInfo bufferCreateInfo;
+        bufferCreateInfo.setSize(size)
+            .setUsage(vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eIndirectBuffer)
+            .setSharingMode(vk::SharingMode::eExclusive);
+        result.buffer = mDevice->createBufferUnique(bufferCreateInfo);
+        auto requirements = mDevice->getBufferMemoryRequirements(result.buffer.get());
+        auto properties = mPhysicalDevice.getMemoryProperties();
+        auto flags = vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent;
+        std::optional<uint32_t> memoryType;
+        for (uint32_t i = 0; i < properties.memoryTypeCount; i++)
+        {
+            if ((requirements.memoryTypeBits & (1u << i)) && (properties.memoryTypes[i].propertyFlags & flags) == flags)
+            {
+                memoryType = i;
+                break;
+            }
+        }
+        if (!memoryType)
+        {
+            throw std::runtime_error("No host visible coherent memory type");
+        }
+        vk::MemoryAllocateInfo allocateInfo;
+        allocateInfo.setAllocationSize(requirements.size).setMemoryTypeIndex(memoryType.value());
+        result.memory = mDevice->allocateMemoryUnique(allocateInfo);
+        mDevice->bindBufferMemory(result.buffer.get(), result.memory.get(), 0);
+        result.mapped = mDevice->mapMemory(result.memory.get(), 0, size);
+        return result;
+    }
+
+    static std::optional<std::vector<uint32_t>> LoadShaderCode()
+    {
+        std::filesystem::path path = std::filesystem::path(MENGINE_SHADER_DIR) / "gpuCulling.comp.spv";
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file.is_open())
+        {
+            return std::nullopt;
+        }
+        size_t size = static_cast<size_t>(file.tellg());
+        std::vector<uint32_t> code(size / sizeof(uint32_t));
+        file.seekg(0);
+        file.read(reinterpret_cast<char *>(code.data()), static_cast<std::streamsize>(code.size() * sizeof(uint32_t)));
+        return code;
+    }
+};
+
+TEST_F(GPUCullingTest, MatchesCPUCulledDrawList)
+{
+    auto shaderCode = LoadShaderCode();
+    if (!shaderCode)
+    {
+        GTEST_SKIP() << "gpuCulling.comp.spv not found, build the shader target first";
+    }
+    // 场景：与 RenderSystem 相同，每个批次对应一个 (材质, 网格)，连续的批次组成绘制组，物体记录所属批次与组
+    glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+    glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    Frustum frustum(projection * view);
+    const uint32_t objectCount = 2000;
+    const uint32_t batchCount = 7;
+    const uint32_t groupSize = 3;
+    const uint32_t groupCount = (batchCount + groupSize - 1) / groupSize;
+    AABB localBox{glm::vec3(-1.0f, -0.5f, -2.0f), glm::vec3(1.0f, 0.5f, 2.0f)};
+    BoundingSphere localSphere{localBox.GetCenter(), glm::length(localBox.GetExtents())};
+
+    std::mt19937 random(11);
+    std::uniform_real_distribution<float> position(-120.0f, 120.0f);
+    std::uniform_real_distribution<float> scale(0.5f, 3.0f);
+    std::uniform_int_distribution<uint32_t> batchDistribution(0, batchCount - 1);
+    // 浮点误差可能让恰好贴着平面的物体在两端结果不同，生成时避开这些物体
+    auto isNearPlane = [&frustum](const AABB &box, const BoundingSphere &sphere) {
+        for (const auto &plane : frustum.GetPlanes())
+        {
+            glm::vec3 normal(plane);
+            float sphereMargin = glm::dot(normal, sphere.center) + plane.w + sphere.radius;
+            float boxMargin = glm::dot(normal, box.GetCenter()) + plane.w + glm::dot(glm::abs(normal), box.GetExtents());
+            if (std::abs(sphereMargin) < 1e-2f || std::abs(boxMargin) < 1e-2f)
+            {
+                return true;
+            }
+        }
+        return false;
+    };
+    std::vector<GPUObjectData> objects;
+    std::vector<uint32_t> batchSizes(batchCount, 0);
+    BoundsSoA bounds;
+    bounds.Resize(objectCount);
+    while (objects.size() < objectCount)
+    {
+        glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(position(random), position(random), position(random)));
+        model = glm::scale(model, glm::vec3(scale(random), scale(random), scale(random)));
+        AABB box = localBox.Transform(model);
+        BoundingSphere sphere = localSphere.Transform(model);
+        if (isNearPlane(box, sphere))
+        {
+            continue;
+        }
+        bounds.Set(objects.size(), box, sphere);
+        GPUObjectData object{};
+        object.modelMatrix = model;
+        object.boundingSphere = glm::vec4(localSphere.center, localSphere.radius);
+        object.boxCenter = glm::vec4(localBox.GetCenter(), 0.0f);
+        object.boxExtents = glm::vec4(localBox.GetExtents(), 0.0f);
+        object.batchIndex = batchDistribution(random);
+        object.groupIndex = object.batchIndex / groupSize;
+        object.groupDrawCount = object.batchIndex % groupSize + 1;
+        batchSizes[object.batchIndex]++;
+        objects.push_back(object);
+    }
+    std::vector<DrawIndexedIndirectCommand> commands(batchCount);
+    uint32_t firstInstance = 0;
+    for (uint32_t batch = 0; batch < batchCount; batch++)
+    {
+        commands[batch] = DrawIndexedIndirectCommand{36u + batch, 0, 0, 0, firstInstance};
+        firstInstance += batchSizes[batch];
+    }
+    // CPU 参考结果
+    std::vector<uint8_t> visible(objectCount, 0);
+    frustum.Cull(bounds, 0, objectCount, visible.data());
+    std::vector<std::vector<glm::vec3>> expected(batchCount);
+    std::vector<uint32_t> expectedDrawCounts(groupCount, 0);
+    for (uint32_t i = 0; i < objectCount; i++)
+    {
+        if (visible[i])
+        {
+            expected[objects[i].batchIndex].push_back(glm::vec3(objects[i].modelMatrix[3]));
+            auto &drawCount = expectedDrawCounts[objects[i].groupIndex];
+            drawCount = std::max(drawCount, objects[i].groupDrawCount);
+        }
+    }
+
+    // GPU 资源
+    auto objectBuffer = CreateHostBuffer(sizeof(GPUObjectData) * objectCount);
+    auto commandBuffer = CreateHostBuffer(sizeof(DrawIndexedIndirectCommand) * batchCount);
+    auto drawCountBuffer = CreateHostBuffer(sizeof(uint32_t) * groupCount);
+    auto instanceBuffer = CreateHostBuffer(sizeof(InstanceData) * objectCount);
+    std::memcpy(objectBuffer.mapped, objects.data(), objectBuffer.size);
+    std::memcpy(commandBuffer.mapped, commands.data(), commandBuffer.size);
+    std::memset(drawCountBuffer.mapped, 0, drawCountBuffer.size);
+    std::memset(instanceBuffer.mapped, 0, instanceBuffer.size);
+
+    // 与 PipelineLayoutManager::CreateGPUCullingDescriptorSetLayout 一致
+    std::vector<vk::DescriptorSetLayoutBinding> bindings;
+    for (uint32_t binding = 0; binding < 4; binding++)
+    {
+        bindings.emplace_back(binding, vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eCompute);
+    }
+    vk::DescriptorSetLayoutCreateInfo setLayoutCreateInfo;
+    setLayoutCreateInfo.setBindings(bindings);
+    auto setLayout = mDevice->createDescriptorSetLayoutUnique(setLayoutCreateInfo);
+    vk::PushConstantRange pushConstantRange(vk::ShaderStageFlagBits::eCompute, 0, sizeof(GPUCullingParams));
+    vk::PipelineLayoutCreateInfo pipelineLayoutCreateInfo;
+    pipelineLayoutCreateInfo.setSetLayouts(setLayout.get()).setPushConstantRanges(pushConstantRange);
+    auto pipelineLayout = mDevice->createPipelineLayoutUnique(pipelineLayoutCreateInfo);
+    vk::ShaderModuleCreateInfo shaderModuleCreateInfo;
+    shaderModuleCreateInfo.setCode(shaderCode.value());
+    auto shaderModule = mDevice->createShaderModuleUnique(shaderModuleCreateInfo);
+    vk::PipelineShaderStageCreateInfo shaderStage;
+    shaderStage.setStage(vk::ShaderStageFlagBits::eCompute).setModule(shaderModule.get()).setPName("main");
+    vk::ComputePipelineCreateInfo pipelineCreateInfo;
+    pipelineCreateInfo.setStage(shaderStage).setLayout(pipelineLayout.get());
+    auto pipeline = mDevice->createComputePipelineUnique(nullptr, pipelineCreateInfo);
+    ASSERT_EQ(pipeline.result, vk::Result::eSuccess);
+
+    vk::DescriptorPoolSize poolSize(vk::DescriptorType::eStorageBuffer, 4);
+    vk::DescriptorPoolCreateInfo poolCreateInfo;
+    poolCreateInfo.setMaxSets(1).setPoolSizes(poolSize);
+    auto descriptorPool = mDevice->createDescriptorPoolUnique(poolCreateInfo);
+    vk::DescriptorSetAllocateInfo setAllocateInfo;
+    setAllocateInfo.setDescriptorPool(descriptorPool.get()).setSetLayouts(setLayout.get());
+    auto descriptorSet = mDevice->allocateDescriptorSets(setAllocateInfo)[0];
+    std::array<vk::DescriptorBufferInfo, 4> bufferInfos{
+        vk::DescriptorBufferInfo(objectBuffer.buffer.get(), 0, objectBuffer.size),
+        vk::DescriptorBufferInfo(commandBuffer.buffer.get(), 0, commandBuffer.size),
+        vk::DescriptorBufferInfo(drawCountBuffer.buffer.get(), 0, drawCountBuffer.size),
+        vk::DescriptorBufferInfo(instanceBuffer.buffer.get(), 0, instanceBuffer.size)};
+    std::vector<vk::WriteDescriptorSet> writes;
+    for (uint32_t binding = 0; binding < bufferInfos.size(); binding++)
+    {
+        vk::WriteDescriptorSet write;
+        write.setDstSet(descriptorSet)
+            .setDstBinding(binding)
+            .setDescriptorType(vk::DescriptorType::eStorageBuffer)
+            .setBufferInfo(bufferInfos[binding]);
+        writes.push_back(write);
+    }
+    mDevice->updateDescriptorSets(writes, {});
+
+    // 录制并提交
+    vk::CommandPoolCreateInfo commandPoolCreateInfo;
+    commandPoolCreateInfo.setQueueFamilyIndex(mQueueFamily);
+    auto commandPool = mDevice->createCommandPoolUnique(commandPoolCreateInfo);
+    vk::CommandBufferAllocateInfo commandBufferAllocateInfo;
+    commandBufferAllocateInfo.setCommandPool(commandPool.get())
+        .setLevel(vk::CommandBufferLevel::ePrimary)
+        .setCommandBufferCount(1);
+    auto commandBuffers = mDevice->allocateCommandBuffersUnique(commandBufferAllocateInfo);
+    auto &cmd = commandBuffers[0];
+    GPUCullingParams params{};
+    params.planes = frustum.GetPlanes();
+    params.objectCount = objectCount;
+    cmd->begin(vk::CommandBufferBeginInfo(vk::CommandBufferUsageFlagBits::eOneTimeSubmit));
+    cmd->bindPipeline(vk::PipelineBindPoint::eCompute, pipeline.value.get());
+    cmd->bindDescriptorSets(vk::PipelineBindPoint::eCompute, pipelineLayout.get(), 0, descriptorSet, {});
+    cmd->pushConstants(pipelineLayout.get(), vk::ShaderStageFlagBits::eCompute, 0, sizeof(GPUCullingParams), &params);
+    cmd->dispatch((objectCount + 63) / 64, 1, 1);
+    vk::MemoryBarrier barrier(vk::AccessFlagBits::eShaderWrite, vk::AccessFlagBits::eHostRead);
+    cmd->pipelineBarrier(vk::PipelineStageFlagBits::eComputeShader, vk::PipelineStageFlagBits::eHost, {}, barrier, {},
+                         {});
+    cmd->end();
+    auto fence = mDevice->createFenceUnique({});
+    vk::SubmitInfo submitInfo;
+    submitInfo.setCommandBuffers(cmd.get());
+    mQueue.submit(submitInfo, fence.get());
+    ASSERT_EQ(mDevice->waitForFences(fence.get(), vk::True, 10'000'000'000), vk::Result::eSuccess);
+
+    // 比较：每批次的实例数量、写入区间内的模型矩阵集合以及每组的 drawCount
+    auto *gpuCommands = static_cast<const DrawIndexedIndirectCommand *>(commandBuffer.mapped);
+    auto *gpuDrawCounts = static_cast<const uint32_t *>(drawCountBuffer.mapped);
+    auto *gpuInstances = static_cast<const InstanceData *>(instanceBuffer.mapped);
+    auto less = [](const glm::vec3 &a, const glm::vec3 &b) {
+        return std::tie(a.x, a.y, a.z) < std::tie(b.x, b.y, b.z);
+    };
+    uint32_t totalVisible = 0;
+    for (uint32_t batch = 0; batch < batchCount; batch++)
+    {
+        const auto &command = gpuCommands[batch];
+        EXPECT_EQ(command.indexCount, commands[batch].indexCount);
+        EXPECT_EQ(command.firstInstance, commands[batch].firstInstance);
+        ASSERT_EQ(command.instanceCount, expected[batch].size()) << "batch " << batch;
+        std::vector<glm::vec3> actual;
+        for (uint32_t i = 0; i < command.instanceCount; i++)
+        {
+            actual.push_back(glm::vec3(gpuInstances[command.firstInstance + i].modelMatrix[3]));
+        }
+        std::sort(actual.begin(), actual.end(), less);
+        std::sort(expected[batch].begin(), expected[batch].end(), less);
+        EXPECT_TRUE(actual == expected[batch]) << "batch " << batch;
+        totalVisible += command.instanceCount;
+    }
+    for (uint32_t group = 0; group < groupCount; group++)
+    {
+        EXPECT_EQ(gpuDrawCounts[group], expectedDrawCounts[group]) << "group " << group;
+    }
+    // 场景需要同时包含可见与被剔除的物体
+    EXPECT_GT(totalVisible, 0u);
+    EXPECT_LT(totalVisible, objectCount);
+}
@@ -0,0 +1,58 @@
+#include "MappedFile.hpp"
+#include "TextureContainer.hpp"
+#include <cstring>
+#include <fstream>
+#include <gtest/gtest.h>
+
+using namespace MEngine;
+
+class MappedFileTest : public ::testing::Test
+{
+  protected:
+    std::filesystem::path mPath = std::filesystem::temp_directory_path() / "MappedFileTest.mtex";
+
+    void TearDown() override
+    {
+        std::filesystem::remove(mPath);
+    }
+    void WriteFile(const std::vector<uint8_t> &bytes)
+    {
+        std::ofstream stream(mPath, std::ios::binary);
+        stream.write(reinterpret_cast<const char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    }
+};
+
+TEST_F(MappedFileTest, MapsCookedContainer)
+{
+    std::vector<uint8_t> pixels(32 * 32 * 4);
+    for (size_t i = 0; i < pixels.size(); i++)
+    {
+        pixels[i] = static_cast<uint8_t>(i * 7);
+    }
+    TextureCookOptions options{};
+    options.compression = BlockCompression::BC1;
+    auto file = CookTexture(pixels.data(), 32, 32, options);
+    WriteFile(file);
+
+    MappedFile mapping;
+    ASSERT_TRUE(mapping.Open(mPath));
+    mapping.Prefetch();
+    ASSERT_EQ(mapping.GetSize(), file.size());
+    EXPECT_EQ(std::memcmp(mapping.GetData(), file.data(), file.size()), 0);
+    auto view = ParseTextureContainer(mapping.GetData(), mapping.GetSize());
+    ASSERT_TRUE(view.has_value());
+    EXPECT_EQ(view->header.compression, BlockCompression::BC1);
+    // mip 数据直接指向映射内存
+    EXPECT_EQ(view->GetMipData(0), mapping.GetData() + view->mips[0].offset);
+    mapping.Close();
+    EXPECT_FALSE(mapping.IsOpen());
+}
+
+TEST_F(MappedFileTest, FailsForMissingOrEmptyFile)
+{
+    MappedFile mapping;
+    EXPECT_FALSE(mapping.Open(mPath));
+    WriteFile({});
+    EXPECT_FALSE(mapping.Open(mPath));
+    EXPECT_FALSE(mapping.IsOpen());
+}
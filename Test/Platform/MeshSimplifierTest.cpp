@@ -0,0 +1,175 @@
+#include "MeshSimplifier.hpp"
+#include "TestMesh.hpp"
+#include <algorithm>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <limits>
+
+using namespace MEngine;
+
+namespace
+{
+// z = 0 平面上的 n x n 网格，法线朝 +z
+void MakeGrid(uint32_t n, std::vector<Vertex> &vertices, std::vector<uint32_t> &indices)
+{
+    for (uint32_t y = 0; y <= n; y++)
+    {
+        for (uint32_t x = 0; x <= n; x++)
+        {
+            glm::vec3 position(float(x) / n, float(y) / n, 0.0f);
+            vertices.push_back({position, glm::vec3(0.0f, 0.0f, 1.0f), glm::vec2(position.x, position.y)});
+        }
+    }
+    for (uint32_t y = 0; y < n; y++)
+    {
+        for (uint32_t x = 0; x < n; x++)
+        {
+            uint32_t current = y * (n + 1) + x;
+            uint32_t up = current + n + 1;
+            indices.insert(indices.end(), {current, current + 1, up + 1, current, up + 1, up});
+        }
+    }
+}
+glm::vec3 GetNormal(const std::vector<Vertex> &vertices, const uint32_t *triangle)
+{
+    const auto &p0 = vertices[triangle[0]].position;
+    return glm::cross(vertices[triangle[1]].position - p0, vertices[triangle[2]].position - p0);
+}
+float SegmentDistance(const glm::vec3 &point, const glm::vec3 &a, const glm::vec3 &b)
+{
+    glm::vec3 ab = b - a;
+    float t = std::clamp(glm::dot(point - a, ab) / glm::dot(ab, ab), 0.0f, 1.0f);
+    return glm::length(point - (a + ab * t));
+}
+// 点到网格表面的最近距离，逐个三角形暴力计算：投影在三角形内取平面距离，否则取到三条边的距离
+float SurfaceDistance(const glm::vec3 &point, const std::vector<Vertex> &vertices,
+                      const std::vector<uint32_t> &indices)
+{
+    float best = std::numeric_limits<float>::max();
+    for (size_t t = 0; t < indices.size() / 3; t++)
+    {
+        const glm::vec3 &a = vertices[indices[t * 3 + 0]].position;
+        const glm::vec3 &b = vertices[indices[t * 3 + 1]].position;
+        const glm::vec3 &c = vertices[indices[t * 3 + 2]].position;
+        // 包围球已经比当前最近距离更远时跳过
+        glm::vec3 center = (a + b + c) / 3.0f;
+        float radius = std::max({glm::length(a - center), glm::length(b - center), glm::length(c - center)});
+        if (glm::length(point - center) - radius > best)
+        {
+            continue;
+        }
+        glm::vec3 normal = glm::normalize(glm::cross(b - a, c - a));
+        float height = glm::dot(point - a, normal);
+        glm::vec3 projected = point - normal * height;
+        if (glm::dot(glm::cross(b - a, projected - a), normal) >= 0.0f &&
+            glm::dot(glm::cross(c - b, projected - b), normal) >= 0.0f &&
+            glm::dot(glm::cross(a - c, projected - c), normal) >= 0.0f)
+        {
+            best = std::min(best, std::fabs(height));
+            continue;
+        }
+        best = std::min(
+            {best, SegmentDistance(point, a, b), SegmentDistance(point, b, c), SegmentDistance(point, c, a)});
+    }
+    return best;
+}
+// 原始顶点到简化网格、简化三角形重心到原始网格的最大距离，与简化器的实现无关
+float MeasureDeviation(const std::vector<Vertex> &vertices, const std::vector<uint32_t> &original,
+                       const std::vector<uint32_t> &simplified)
+{
+    float deviation = 0.0f;
+    for (auto index : original)
+    {
+        deviation = std::max(deviation, SurfaceDistance(vertices[index].position, vertices, simplified));
+    }
+    for (size_t t = 0; t < simplified.size() / 3; t++)
+    {
+        glm::vec3 centroid = (vertices[simplified[t * 3]].position + vertices[simplified[t * 3 + 1]].position +
+                              vertices[simplified[t * 3 + 2]].position) /
+                             3.0f;
+        deviation = std::max(deviation, SurfaceDistance(centroid, vertices, original));
+    }
+    return deviation;
+}
+} // namespace
+
+TEST(MeshSimplifierTest, PlanarGridKeepsShape)
+{
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    MakeGrid(16, vertices, indices);
+    float error = -1.0f;
+    auto simplified = SimplifyMesh(vertices.data(), vertices.size(), indices.data(), indices.size(),
+                                   indices.size() / 4, 0.01f, &error);
+    EXPECT_LE(simplified.size(), indices.size() / 2);
+    EXPECT_EQ(simplified.size() % 3, 0u);
+    // 平面上的折叠没有几何误差；边界锁定，总面积不变且没有翻转
+    EXPECT_NEAR(error, 0.0f, 1e-4f);
+    float area = 0.0f;
+    for (size_t t = 0; t < simplified.size() / 3; t++)
+    {
+        glm::vec3 normal = GetNormal(vertices, &simplified[t * 3]);
+        EXPECT_GT(normal.z, 0.0f);
+        area += glm::length(normal) * 0.5f;
+    }
+    EXPECT_NEAR(area, 1.0f, 1e-4f);
+}
+// 报告的误差不超过 maxError，且不低于独立测得的实际几何偏差
+TEST(MeshSimplifierTest, ErrorBoundIsRespected)
+{
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    MakeSphere(24, 48, 1.0f, vertices, indices);
+    for (float maxError : {0.02f, 0.05f})
+    {
+        float error = -1.0f;
+        auto simplified =
+            SimplifyMesh(vertices.data(), vertices.size(), indices.data(), indices.size(), 0, maxError, &error);
+        EXPECT_LT(simplified.size(), indices.size() / 2);
+        EXPECT_GE(error, 0.0f);
+        EXPECT_LE(error, maxError);
+        EXPECT_LE(MeasureDeviation(vertices, indices, simplified), error + 1e-5f) << "maxError " << maxError;
+        // 单位球的三角形都应保持朝外
+        for (size_t t = 0; t < simplified.size() / 3; t++)
+        {
+            ASSERT_LT(simplified[t * 3], vertices.size());
+            glm::vec3 normal = GetNormal(vertices, &simplified[t * 3]);
+            glm::vec3 centroid = (vertices[simplified[t * 3]].position + vertices[simplified[t * 3 + 1]].position +
+                                  vertices[simplified[t * 3 + 2]].position) /
+                                 3.0f;
+            if (glm::length(normal) > 1e-6f)
+            {
+                EXPECT_GT(glm::dot(normal, centroid), 0.0f);
+            }
+        }
+    }
+}
+TEST(MeshSimplifierTest, LODChainIsMonotonic)
+{
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    MakeSphere(16, 32, 1.0f, vertices, indices);
+    MeshLODOptions options{};
+    options.maxError = 0.2f;
+    auto chain = GenerateLODChain(vertices.data(), vertices.size(), indices.data(), indices.size(), options);
+    ASSERT_GE(chain.size(), 2u);
+    EXPECT_LE(chain.size(), options.maxLevels);
+    // maxError 相对包围盒对角线的一半，单位球为 sqrt(3)
+    const float maxError = options.maxError * std::sqrt(3.0f);
+    size_t previousCount = indices.size();
+    float previousError = 0.0f;
+    for (const auto &level : chain)
+    {
+        EXPECT_LT(level.indices.size(), previousCount);
+        EXPECT_GE(level.error, previousError);
+        EXPECT_LE(level.error, maxError);
+        // 各级误差都相对原始网格，而不是上一级
+        EXPECT_LE(MeasureDeviation(vertices, indices, level.indices), level.error + 1e-5f);
+        for (auto index : level.indices)
+        {
+            ASSERT_LT(index, vertices.size());
+        }
+        previousCount = level.indices.size();
+        previousError = level.error;
+    }
+}
@@ -0,0 +1,71 @@
+#include "Mipmap.hpp"
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace MEngine;
+
+// 模拟缩小 8 倍显示一张 2048x2048 纹理：每个屏幕像素取一个纹素，只输出耗时，不加入 ctest
+// 没有 mip 时从 mip 0 跨步读取，每次访问都落在新的缓存行上；有 mip 时从 mip 3 连续读取
+namespace
+{
+constexpr uint32_t Size = 2048;
+constexpr uint32_t ScreenSize = Size / 8;
+constexpr int Iterations = 50;
+
+template <typename TFunc> double Measure(TFunc &&func)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < Iterations; ++i)
+    {
+        func();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::milli>(elapsed).count() / Iterations;
+}
+uint64_t Sample(const std::vector<uint8_t> &chain, uint32_t level)
+{
+    size_t offset = GetMipChainSize(Size, Size, level, 4);
+    uint32_t extent = GetMipExtent(Size, level);
+    uint32_t step = extent / ScreenSize;
+    const uint8_t *texels = chain.data() + offset;
+    uint64_t sum = 0;
+    for (uint32_t y = 0; y < ScreenSize; y++)
+    {
+        for (uint32_t x = 0; x < ScreenSize; x++)
+        {
+            sum += texels[(static_cast<size_t>(y * step) * extent + x * step) * 4];
+        }
+    }
+    return sum;
+}
+} // namespace
+
+int main()
+{
+    std::mt19937 random(1);
+    std::vector<uint8_t> pixels(static_cast<size_t>(Size) * Size * 4);
+    for (auto &value : pixels)
+    {
+        value = static_cast<uint8_t>(random());
+    }
+    uint32_t mipLevels = CalculateMipLevels(Size, Size);
+    std::vector<uint8_t> chain = GenerateMipChainRGBA8(pixels.data(), Size, Size, mipLevels, true);
+
+    volatile uint64_t sink = 0;
+    double baseTime = Measure([&]() { sink = sink + Sample(chain, 0); });
+    double mipTime = Measure([&]() { sink = sink + Sample(chain, 3); });
+    // 每个纹素读取实际搬运一整条 64 字节缓存行，连续读取时 16 个纹素共享一条
+    double baseBytes = static_cast<double>(ScreenSize) * ScreenSize * 64;
+    double mipBytes = static_cast<double>(ScreenSize) * ScreenSize * 4;
+    std::printf("Sample %ux%u from %ux%u: mip 0 %.3f ms (~%.2f MB touched), mip 3 %.3f ms (~%.2f MB touched), "
+                "speedup %.2fx\n",
+                ScreenSize, ScreenSize, Size, Size, baseTime, baseBytes / (1 << 20), mipTime, mipBytes / (1 << 20),
+                baseTime / mipTime);
+
+    double unormTime = Measure([&]() { GenerateMipChainRGBA8(pixels.data(), Size, Size, mipLevels, false); });
+    double srgbTime = Measure([&]() { GenerateMipChainRGBA8(pixels.data(), Size, Size, mipLevels, true); });
+    std::printf("GenerateMipChain %ux%u: unorm %.3f ms, srgb %.3f ms\n", Size, Size, unormTime, srgbTime);
+    return 0;
+}
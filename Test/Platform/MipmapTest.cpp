@@ -0,0 +1,204 @@
+#include "Mipmap.hpp"
+#include <algorithm>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+using namespace MEngine;
+
+namespace
+{
+double SrgbToLinear(double value)
+{
+    return value <= 0.04045 ? value / 12.92 : std::pow((value + 0.055) / 1.055, 2.4);
+}
+double LinearToSrgb(double value)
+{
+    return value <= 0.0031308 ? value * 12.92 : 1.055 * std::pow(value, 1.0 / 2.4) - 0.055;
+}
+/**
+ * @brief 双精度参考实现：目标纹素覆盖 [x * src / dst, (x + 1) * src / dst) 的源区域，按覆盖面积加权
+ */
+std::vector<double> ReferenceWeights(uint32_t srcExtent, uint32_t dstExtent, uint32_t x)
+{
+    std::vector<double> weights(srcExtent, 0.0);
+    double begin = static_cast<double>(x) * srcExtent / dstExtent;
+    double end = static_cast<double>(x + 1) * srcExtent / dstExtent;
+    for (uint32_t i = 0; i < srcExtent; i++)
+    {
+        double overlap = std::min<double>(end, i + 1) - std::max<double>(begin, i);
+        weights[i] = std::max(overlap, 0.0) / (end - begin);
+    }
+    return weights;
+}
+std::vector<uint8_t> ReferenceDownsample(const std::vector<uint8_t> &src, uint32_t srcWidth, uint32_t srcHeight,
+                                         uint32_t dstWidth, uint32_t dstHeight, bool srgb)
+{
+    std::vector<uint8_t> dst(static_cast<size_t>(dstWidth) * dstHeight * 4);
+    for (uint32_t y = 0; y < dstHeight; y++)
+    {
+        auto rowWeights = ReferenceWeights(srcHeight, dstHeight, y);
+        for (uint32_t x = 0; x < dstWidth; x++)
+        {
+            auto columnWeights = ReferenceWeights(srcWidth, dstWidth, x);
+            for (uint32_t c = 0; c < 4; c++)
+            {
+                bool linearize = srgb && c < 3;
+                double sum = 0.0;
+                for (uint32_t j = 0; j < srcHeight; j++)
+                {
+                    for (uint32_t i = 0; i < srcWidth; i++)
+                    {
+                        double value = src[(static_cast<size_t>(j) * srcWidth + i) * 4 + c] / 255.0;
+                        sum += rowWeights[j] * columnWeights[i] * (linearize ? SrgbToLinear(value) : value);
+                    }
+                }
+                double encoded = linearize ? LinearToSrgb(sum) : sum;
+                dst[(static_cast<size_t>(y) * dstWidth + x) * 4 + c] =
+                    static_cast<uint8_t>(std::clamp(encoded * 255.0 + 0.5, 0.0, 255.0));
+            }
+        }
+    }
+    return dst;
+}
+/**
+ * @brief 逐级与参考实现比较，参考实现以上一级的实际结果为输入，避免误差逐级累积
+ */
+void ExpectChainMatchesReference(uint32_t width, uint32_t height, bool srgb)
+{
+    std::mt19937 random(width * 131 + height);
+    std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * 4);
+    for (auto &value : pixels)
+    {
+        value = static_cast<uint8_t>(random());
+    }
+    uint32_t levels = CalculateMipLevels(width, height);
+    auto chain = GenerateMipChainRGBA8(pixels.data(), width, height, levels, srgb);
+    ASSERT_EQ(chain.size(), GetMipChainSize(width, height, levels, 4));
+    size_t offset = 0;
+    for (uint32_t level = 1; level < levels; level++)
+    {
+        uint32_t srcWidth = GetMipExtent(width, level - 1);
+        uint32_t srcHeight = GetMipExtent(height, level - 1);
+        uint32_t dstWidth = GetMipExtent(width, level);
+        uint32_t dstHeight = GetMipExtent(height, level);
+        size_t srcSize = static_cast<size_t>(srcWidth) * srcHeight * 4;
+        std::vector<uint8_t> src(chain.begin() + offset, chain.begin() + offset + srcSize);
+        offset += srcSize;
+        auto expected = ReferenceDownsample(src, srcWidth, srcHeight, dstWidth, dstHeight, srgb);
+        for (size_t i = 0; i < expected.size(); i++)
+        {
+            ASSERT_NEAR(chain[offset + i], expected[i], 1) << "level " << level << " byte " << i;
+        }
+    }
+}
+} // namespace
+
+TEST(MipmapTest, CalculatesFullChainLength)
+{
+    EXPECT_EQ(CalculateMipLevels(1, 1), 1u);
+    EXPECT_EQ(CalculateMipLevels(4096, 4096), 13u);
+    EXPECT_EQ(CalculateMipLevels(300, 17), 9u);
+    EXPECT_EQ(CalculateMipLevels(1, 1, 64), 7u);
+    EXPECT_EQ(GetMipExtent(5, 1), 2u);
+    EXPECT_EQ(GetMipExtent(5, 4), 1u);
+}
+
+TEST(MipmapTest, ChainSizeCoversAllLevels)
+{
+    // 4x2 -> 2x1 -> 1x1
+    EXPECT_EQ(GetMipChainSize(4, 2, 3, 4), (8u + 2u + 1u) * 4u);
+}
+
+TEST(MipmapTest, BoxFilterAveragesUnorm)
+{
+    std::vector<uint8_t> pixels = {
+        0,  0,  0,  0,  100, 100, 100, 100, //
+        20, 20, 20, 20, 255, 255, 255, 255,
+    };
+    auto chain = GenerateMipChainRGBA8(pixels.data(), 2, 2, 2, false);
+    ASSERT_EQ(chain.size(), 20u);
+    EXPECT_TRUE(std::equal(pixels.begin(), pixels.end(), chain.begin()));
+    // (0 + 100 + 20 + 255 + 2) / 4 = 94
+    for (int c = 0; c < 4; c++)
+    {
+        EXPECT_EQ(chain[16 + c], 94);
+    }
+}
+
+TEST(MipmapTest, SrgbAveragesInLinearSpace)
+{
+    // 黑白各半在线性空间平均为 0.5，编码回 sRGB 约为 188，alpha 仍线性平均
+    std::vector<uint8_t> pixels = {
+        0,   0,   0,   0,   255, 255, 255, 255, //
+        255, 255, 255, 255, 0,   0,   0,   0,
+    };
+    auto chain = GenerateMipChainRGBA8(pixels.data(), 2, 2, 2, true);
+    EXPECT_NEAR(chain[16], 188, 1);
+    EXPECT_NEAR(chain[18], 188, 1);
+    EXPECT_EQ(chain[19], 128);
+}
+
+TEST(MipmapTest, OddExtentsReachOnePixel)
+{
+    std::vector<uint8_t> pixels(5 * 3 * 4, 200);
+    uint32_t levels = CalculateMipLevels(5, 3);
+    auto chain = GenerateMipChainRGBA8(pixels.data(), 5, 3, levels, false);
+    ASSERT_EQ(chain.size(), GetMipChainSize(5, 3, levels, 4));
+    // 常量图像的每一级都保持原值
+    for (auto value : chain)
+    {
+        EXPECT_EQ(value, 200);
+    }
+}
+
+TEST(MipmapTest, OddExtentsKeepLastColumnAndRow)
+{
+    // 3x3 -> 1x1：只有右下角的纹素非零，整体平均为 255 / 9
+    std::vector<uint8_t> pixels(3 * 3 * 4, 0);
+    for (int c = 0; c < 4; c++)
+    {
+        pixels[(2 * 3 + 2) * 4 + c] = 255;
+    }
+    auto chain = GenerateMipChainRGBA8(pixels.data(), 3, 3, 2, false);
+    for (int c = 0; c < 4; c++)
+    {
+        EXPECT_EQ(chain[36 + c], 28);
+    }
+
+    // 5x1 -> 2x1：每个源纹素的总权重都是 2/5
+    std::vector<uint8_t> row = {
+        0,   0,   0,   0,   50,  50,  50,  50,  100, 100, 100, 100, //
+        150, 150, 150, 150, 250, 250, 250, 250,
+    };
+    chain = GenerateMipChainRGBA8(row.data(), 5, 1, 2, false);
+    // (0 * 2 + 50 * 2 + 100) / 5 = 40，(100 + 150 * 2 + 250 * 2) / 5 = 180
+    EXPECT_EQ(chain[20], 40);
+    EXPECT_EQ(chain[24], 180);
+}
+
+TEST(MipmapTest, SrgbOddExtentAveragesInLinearSpace)
+{
+    // 3x1 黑白黑：线性空间平均为 1/3，编码回 sRGB 约为 156；直接平均编码值会得到 85
+    std::vector<uint8_t> pixels = {
+        0, 0, 0, 255, 255, 255, 255, 255, 0, 0, 0, 0,
+    };
+    auto chain = GenerateMipChainRGBA8(pixels.data(), 3, 1, 2, true);
+    EXPECT_NEAR(chain[12], 156, 1);
+    EXPECT_NEAR(chain[14], 156, 1);
+    // alpha 不做 gamma 转换：(255 + 255 + 0) / 3 = 170
+    EXPECT_EQ(chain[15], 170);
+}
+
+TEST(MipmapTest, ChainMatchesReferenceFilter)
+{
+    for (bool srgb : {false, true})
+    {
+        SCOPED_TRACE(srgb ? "srgb" : "unorm");
+        ExpectChainMatchesReference(16, 16, srgb);
+        ExpectChainMatchesReference(7, 5, srgb);
+        ExpectChainMatchesReference(33, 1, srgb);
+        ExpectChainMatchesReference(12, 9, srgb);
+    }
+}
@@ -0,0 +1,295 @@
+#include "Buffer.hpp"
+#include "Context.hpp"
+#include "Image.hpp"
+#include "Interface/IConfigure.hpp"
+#include "QueueOwnership.hpp"
+#include "SpdLogger.hpp"
+#include "SyncPrimitiveManager.hpp"
+#include "UploadQueue.hpp"
+#include "gtest/gtest.h"
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <vulkan/vulkan.hpp>
+
+using namespace MEngine;
+
+namespace
+{
+vk::QueueFamilyProperties Family(vk::QueueFlags flags, uint32_t count = 1)
+{
+    vk::QueueFamilyProperties properties;
+    properties.setQueueFlags(flags).setQueueCount(count);
+    return properties;
+}
+// 不依赖配置文件，暂存环只有 1 MB，使测试中的上传需要切分并等待环形缓冲区回收
+class TestConfigure final : public IConfigure
+{
+  private:
+    Json mJson = {{"Logger", {{"Level", "warn"}}}, {"UploadSetting", {{"StagingRingSizeMB", 1}}}};
+
+  public:
+    void SetJsonSettingFile(const fs::path &) override
+    {
+    }
+    const Json &GetJson() const override
+    {
+        return mJson;
+    }
+};
+} // namespace
+
+TEST(QueueFamilySelectionTest, PrefersDedicatedTransferAndComputeFamilies)
+{
+    using Flag = vk::QueueFlagBits;
+    // 常见独显布局：0 图形+计算+传输，1 计算+传输，2 仅传输
+    std::vector<vk::QueueFamilyProperties> families = {Family(Flag::eGraphics | Flag::eCompute | Flag::eTransfer, 16),
+                                                       Family(Flag::eCompute | Flag::eTransfer, 8),
+                                                       Family(Flag::eTransfer, 2)};
+    EXPECT_EQ(FindQueueFamily(families, Flag::eGraphics), 0u);
+    EXPECT_EQ(FindQueueFamily(families, Flag::eTransfer, Flag::eGraphics | Flag::eCompute), 2u);
+    EXPECT_EQ(FindQueueFamily(families, Flag::eCompute, Flag::eGraphics), 1u);
+}
+
+TEST(QueueFamilySelectionTest, FallsBackWhenOnlyOneFamilyExists)
+{
+    using Flag = vk::QueueFlagBits;
+    // 软件实现（lavapipe 等）通常只有一个全能力族
+    std::vector<vk::QueueFamilyProperties> families = {Family(Flag::eGraphics | Flag::eCompute | Flag::eTransfer)};
+    EXPECT_FALSE(FindQueueFamily(families, Flag::eTransfer, Flag::eGraphics | Flag::eCompute).has_value());
+    EXPECT_FALSE(FindQueueFamily(families, Flag::eCompute, Flag::eGraphics).has_value());
+    EXPECT_EQ(FindQueueFamily(families, Flag::eTransfer), 0u);
+}
+
+TEST(QueueOwnershipTest, ReleaseAndAcquireBarriersMatch)
+{
+    vk::ImageSubresourceRange range{vk::ImageAspectFlagBits::eColor, 0, 3, 0, 6};
+    auto transfer = MakeImageOwnershipTransfer(vk::Image{}, range, vk::ImageLayout::eTransferDstOptimal,
+                                               vk::ImageLayout::eShaderReadOnlyOptimal,
+                                               vk::AccessFlagBits::eTransferWrite, vk::AccessFlagBits::eShaderRead, 2, 0);
+    EXPECT_EQ(transfer.release.oldLayout, transfer.acquire.oldLayout);
+    EXPECT_EQ(transfer.release.newLayout, transfer.acquire.newLayout);
+    EXPECT_EQ(transfer.release.subresourceRange, transfer.acquire.subresourceRange);
+    EXPECT_EQ(transfer.release.srcQueueFamilyIndex, 2u);
+    EXPECT_EQ(transfer.acquire.srcQueueFamilyIndex, 2u);
+    EXPECT_EQ(transfer.release.dstQueueFamilyIndex, 0u);
+    EXPECT_EQ(transfer.acquire.dstQueueFamilyIndex, 0u);
+    // 释放侧的 dstAccess 与获取侧的 srcAccess 没有意义，应为空
+    EXPECT_EQ(transfer.release.srcAccessMask, vk::AccessFlags(vk::AccessFlagBits::eTransferWrite));
+    EXPECT_FALSE(transfer.release.dstAccessMask);
+    EXPECT_FALSE(transfer.acquire.srcAccessMask);
+    EXPECT_EQ(transfer.acquire.dstAccessMask, vk::AccessFlags(vk::AccessFlagBits::eShaderRead));
+
+    auto bufferTransfer = MakeBufferOwnershipTransfer(vk::Buffer{}, 256, 1024, vk::AccessFlagBits::eTransferWrite,
+                                                      vk::AccessFlagBits::eVertexAttributeRead, 2, 0);
+    EXPECT_EQ(bufferTransfer.release.offset, bufferTransfer.acquire.offset);
+    EXPECT_EQ(bufferTransfer.release.size, bufferTransfer.acquire.size);
+    EXPECT_FALSE(bufferTransfer.release.dstAccessMask);
+    EXPECT_FALSE(bufferTransfer.acquire.srcAccessMask);
+}
+
+/**
+ * 通过 UploadQueue 的实际路径上传缓冲区与图像，再在图形队列上按 RecordOwnershipAcquire 获取并读回比较。
+ * 使用无窗口 Context，队列族选择与引擎一致：设备有独立传输族时覆盖跨族释放/获取，否则覆盖同族路径。
+ * 有验证层时统计验证错误；没有可用设备或不支持时间线信号量时跳过。
+ */
+class UploadQueueDeviceTest : public ::testing::Test
+{
+  protected:
+    std::shared_ptr<IConfigure> mConfigure;
+    std::shared_ptr<ILogger> mLogger;
+    std::shared_ptr<Context> mContext;
+    std::shared_ptr<SyncPrimitiveManager> mSyncPrimitiveManager;
+    std::shared_ptr<UploadQueue> mUploadQueue;
+    VkDebugUtilsMessengerEXT mMessenger = VK_NULL_HANDLE;
+    static inline std::vector<std::string> sValidationErrors;
+
+    static VKAPI_ATTR VkBool32 VKAPI_CALL OnValidationMessage(VkDebugUtilsMessageSeverityFlagBitsEXT severity,
+                                                             VkDebugUtilsMessageTypeFlagsEXT,
+                                                             const VkDebugUtilsMessengerCallbackDataEXT *data, void *)
+    {
+        if (severity & VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT)
+        {
+            sValidationErrors.emplace_back(data->pMessage);
+        }
+        return VK_FALSE;
+    }
+
+    void SetUp() override
+    {
+        sValidationErrors.clear();
+        mConfigure = std::make_shared<TestConfigure>();
+        mLogger = std::make_shared<SpdLogger>(mConfigure);
+        try
+        {
+            mContext = std::make_shared<Context>(mLogger, nullptr);
+        }
+        catch (const std::exception &error)
+        {
+            GTEST_SKIP() << "Vulkan is not available: " << error.what();
+        }
+        if (!mContext->GetEnabledFeatures().timelineSemaphore)
+        {
+            GTEST_SKIP() << "Device does not support timeline semaphores";
+        }
+        // 只有启用了验证层（及调试扩展）时才能取到函数
+        auto create = reinterpret_cast<PFN_vkCreateDebugUtilsMessengerEXT>(
+            mContext->GetInstance().getProcAddr("vkCreateDebugUtilsMessengerEXT"));
+        if (create)
+        {
+            VkDebugUtilsMessengerCreateInfoEXT messengerInfo{};
+            messengerInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT;
+            messengerInfo.messageSeverity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
+            messengerInfo.messageType =
+                VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT;
+            messengerInfo.pfnUserCallback = &OnValidationMessage;
+            create(mContext->GetInstance(), &messengerInfo, nullptr, &mMessenger);
+        }
+        mSyncPrimitiveManager = std::make_shared<SyncPrimitiveManager>(mLogger, mContext);
+        mUploadQueue = std::make_shared<UploadQueue>(mLogger, mContext, mSyncPrimitiveManager, mConfigure);
+    }
+
+    void TearDown() override
+    {
+        mUploadQueue.reset();
+        mSyncPrimitiveManager.reset();
+        if (mMessenger != VK_NULL_HANDLE)
+        {
+            auto destroy = reinterpret_cast<PFN_vkDestroyDebugUtilsMessengerEXT>(
+                mContext->GetInstance().getProcAddr("vkDestroyDebugUtilsMessengerEXT"));
+            destroy(mContext->GetInstance(), mMessenger, nullptr);
+        }
+        mContext.reset();
+    }
+
+    static std::vector<uint8_t> Pattern(size_t size, uint8_t seed)
+    {
+        std::vector<uint8_t> data(size);
+        for (size_t i = 0; i < data.size(); i++)
+        {
+            data[i] = static_cast<uint8_t>(i * 7 + seed);
+        }
+        return data;
+    }
+};
+
+TEST_F(UploadQueueDeviceTest, UploadsAreAcquiredOnTheGraphicsQueue)
+{
+    const bool ownershipTransfer = mContext->HasDedicatedTransferFamily();
+    const auto &families = mContext->GetQueueFamilyIndicates();
+    EXPECT_EQ(mUploadQueue->CanGenerateMipmaps(), !ownershipTransfer);
+
+    // 缓冲区上传超过单段上限（环的一半），会被切分
+    constexpr vk::DeviceSize bufferSize = 768 * 1024;
+    auto bufferData = Pattern(bufferSize, 3);
+    Buffer buffer(mContext, bufferSize, vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eTransferSrc,
+                  VMA_MEMORY_USAGE_GPU_ONLY);
+    mUploadQueue->EnqueueBufferUpload(buffer, bufferData.data(), bufferSize);
+
+    // 两级 mip 的图像，两次上传合计超过环形缓冲区容量，需要先提交并等待前一批次回收空间
+    constexpr uint32_t width = 256;
+    constexpr uint32_t height = 256;
+    vk::ImageCreateInfo imageCreateInfo;
+    imageCreateInfo.setImageType(vk::ImageType::e2D)
+        .setFormat(vk::Format::eR8G8B8A8Unorm)
+        .setExtent({width, height, 1})
+        .setMipLevels(2)
+        .setArrayLayers(1)
+        .setSamples(vk::SampleCountFlagBits::e1)
+        .setTiling(vk::ImageTiling::eOptimal)
+        .setUsage(vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eTransferSrc |
+                  vk::ImageUsageFlagBits::eSampled)
+        .setSharingMode(vk::SharingMode::eExclusive)
+        .setInitialLayout(vk::ImageLayout::eUndefined);
+    Image image(mContext, imageCreateInfo, VMA_MEMORY_USAGE_GPU_ONLY);
+    ImageUploadInfo uploadInfo;
+    uploadInfo.image = image.GetHandle();
+    uploadInfo.extent = vk::Extent3D{width, height, 1};
+    uploadInfo.mipLevels = 2;
+    uploadInfo.dataMipLevels = 2;
+    vk::DeviceSize imageSize =
+        UploadQueue::GetMipUploadSize(uploadInfo, 0) + UploadQueue::GetMipUploadSize(uploadInfo, 1);
+    auto imageData = Pattern(imageSize, 11);
+    mUploadQueue->EnqueueImageUpload(uploadInfo, imageData.data(), imageSize);
+    UploadTicket ticket = mUploadQueue->Flush();
+    ASSERT_GT(ticket, 1u);
+
+    // 读回缓冲区：前半部分放缓冲区内容，后半部分放图像两级 mip
+    Buffer readback(mContext, bufferSize + imageSize, vk::BufferUsageFlagBits::eTransferDst, VMA_MEMORY_USAGE_CPU_ONLY,
+                    VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT);
+
+    vk::Device device = mContext->GetDevice();
+    auto commandPool = device.createCommandPoolUnique(vk::CommandPoolCreateInfo{{}, families.graphicsFamily.value()});
+    vk::CommandBufferAllocateInfo allocateInfo{commandPool.get(), vk::CommandBufferLevel::ePrimary, 1};
+    auto commandBuffer = std::move(device.allocateCommandBuffersUnique(allocateInfo)[0]);
+    commandBuffer->begin(vk::CommandBufferBeginInfo{vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
+    // 与 RenderSystem 提交时相同：先录制获取屏障，只有跨族上传才有内容
+    EXPECT_EQ(mUploadQueue->RecordOwnershipAcquire(commandBuffer.get(), ticket), ownershipTransfer);
+    vk::BufferMemoryBarrier bufferBarrier;
+    bufferBarrier.setBuffer(buffer.GetHandle())
+        .setSize(VK_WHOLE_SIZE)
+        .setSrcAccessMask(vk::AccessFlagBits::eTransferWrite)
+        .setDstAccessMask(vk::AccessFlagBits::eTransferRead)
+        .setSrcQueueFamilyIndex(vk::QueueFamilyIgnored)
+        .setDstQueueFamilyIndex(vk::QueueFamilyIgnored);
+    vk::ImageMemoryBarrier imageBarrier;
+    imageBarrier.setImage(image.GetHandle())
+        .setOldLayout(vk::ImageLayout::eShaderReadOnlyOptimal)
+        .setNewLayout(vk::ImageLayout::eTransferSrcOptimal)
+        .setSrcAccessMask(vk::AccessFlagBits::eShaderRead)
+        .setDstAccessMask(vk::AccessFlagBits::eTransferRead)
+        .setSrcQueueFamilyIndex(vk::QueueFamilyIgnored)
+        .setDstQueueFamilyIndex(vk::QueueFamilyIgnored)
+        .setSubresourceRange({vk::ImageAspectFlagBits::eColor, 0, 2, 0, 1});
+    commandBuffer->pipelineBarrier(vk::PipelineStageFlagBits::eAllCommands, vk::PipelineStageFlagBits::eTransfer, {},
+                                   {}, bufferBarrier, imageBarrier);
+    commandBuffer->copyBuffer(buffer.GetHandle(), readback.GetHandle(), vk::BufferCopy{0, 0, bufferSize});
+    std::vector<vk::BufferImageCopy> regions(2);
+    vk::DeviceSize offset = bufferSize;
+    for (uint32_t level = 0; level < 2; level++)
+    {
+        regions[level]
+            .setBufferOffset(offset)
+            .setImageSubresource({vk::ImageAspectFlagBits::eColor, level, 0, 1})
+            .setImageExtent({width >> level, height >> level, 1});
+        offset += UploadQueue::GetMipUploadSize(uploadInfo, level);
+    }
+    commandBuffer->copyImageToBuffer(image.GetHandle(), vk::ImageLayout::eTransferSrcOptimal, readback.GetHandle(),
+                                     regions);
+    vk::BufferMemoryBarrier hostBarrier;
+    hostBarrier.setBuffer(readback.GetHandle())
+        .setSize(VK_WHOLE_SIZE)
+        .setSrcAccessMask(vk::AccessFlagBits::eTransferWrite)
+        .setDstAccessMask(vk::AccessFlagBits::eHostRead)
+        .setSrcQueueFamilyIndex(vk::QueueFamilyIgnored)
+        .setDstQueueFamilyIndex(vk::QueueFamilyIgnored);
+    commandBuffer->pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eHost, {}, {},
+                                   hostBarrier, {});
+    commandBuffer->end();
+
+    // 与 RenderSystem 提交时相同：在 eAllCommands 阶段等待时间线信号量达到 ticket
+    vk::Semaphore timeline = mUploadQueue->GetTimelineSemaphore();
+    vk::PipelineStageFlags waitStage = vk::PipelineStageFlagBits::eAllCommands;
+    vk::TimelineSemaphoreSubmitInfo timelineSubmitInfo;
+    timelineSubmitInfo.setWaitSemaphoreValues(ticket);
+    vk::SubmitInfo submitInfo;
+    submitInfo.setCommandBuffers(commandBuffer.get())
+        .setWaitSemaphores(timeline)
+        .setWaitDstStageMask(waitStage)
+        .setPNext(&timelineSubmitInfo);
+    auto fence = mSyncPrimitiveManager->CreateFence();
+    mContext->SubmitToGraphicQueue({submitInfo}, fence.get());
+    ASSERT_EQ(device.waitForFences(fence.get(), vk::True, 5'000'000'000ull), vk::Result::eSuccess);
+    EXPECT_TRUE(mUploadQueue->IsComplete(ticket));
+
+    auto mapped = static_cast<const uint8_t *>(readback.GetAllocationInfo().pMappedData);
+    EXPECT_EQ(std::vector<uint8_t>(mapped, mapped + bufferSize), bufferData);
+    EXPECT_EQ(std::vector<uint8_t>(mapped + bufferSize, mapped + bufferSize + imageSize), imageData);
+    EXPECT_TRUE(sValidationErrors.empty()) << sValidationErrors.front();
+    if (!ownershipTransfer)
+    {
+        std::cout << "[          ] device has no dedicated transfer family, same-family path only" << std::endl;
+    }
+}
@@ -0,0 +1,43 @@
+#include "RingAllocator.hpp"
+#include <gtest/gtest.h>
+
+using namespace MEngine;
+
+TEST(RingAllocatorTest, AllocatesLinearlyWithAlignment)
+{
+    RingAllocator ring(256);
+    EXPECT_EQ(ring.Allocate(10).value(), 0u);
+    EXPECT_EQ(ring.Allocate(16, 16).value(), 16u);
+    EXPECT_EQ(ring.GetUsed(), 32u);
+}
+
+TEST(RingAllocatorTest, FailsWhenFullAndRecoversAfterRelease)
+{
+    RingAllocator ring(256);
+    ASSERT_TRUE(ring.Allocate(128).has_value());
+    auto marker = ring.GetHead();
+    ASSERT_TRUE(ring.Allocate(128).has_value());
+    EXPECT_FALSE(ring.Allocate(1).has_value());
+    ring.Release(marker);
+    EXPECT_EQ(ring.Allocate(64).value(), 0u);
+}
+
+TEST(RingAllocatorTest, WrapsToStartWhenTailIsTooSmall)
+{
+    RingAllocator ring(256);
+    ASSERT_TRUE(ring.Allocate(200).has_value());
+    ring.Release(ring.GetHead());
+    // 尾部只剩 56 字节，100 字节的分配跳回开头，跳过的空间也计入占用
+    EXPECT_EQ(ring.Allocate(100).value(), 0u);
+    EXPECT_EQ(ring.GetUsed(), 156u);
+    EXPECT_FALSE(ring.Allocate(101).has_value());
+    EXPECT_EQ(ring.Allocate(100).value(), 100u);
+}
+
+TEST(RingAllocatorTest, RejectsOversizedAllocations)
+{
+    RingAllocator ring(256);
+    EXPECT_FALSE(ring.Allocate(257).has_value());
+    EXPECT_FALSE(ring.Allocate(0).has_value());
+    EXPECT_EQ(ring.Allocate(256).value(), 0u);
+}
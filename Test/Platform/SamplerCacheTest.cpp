@@ -0,0 +1,157 @@
+#include "Context.hpp"
+#include "Interface/IConfigure.hpp"
+#include "SamplerManager.hpp"
+#include "SpdLogger.hpp"
+#include "gtest/gtest.h"
+#include <memory>
+#include <unordered_set>
+#include <vulkan/vulkan.hpp>
+
+using namespace MEngine;
+
+namespace
+{
+vk::SamplerCreateInfo TextureSamplerInfo(float maxLod)
+{
+    vk::SamplerCreateInfo info;
+    info.setMagFilter(vk::Filter::eLinear)
+        .setMinFilter(vk::Filter::eLinear)
+        .setMipmapMode(vk::SamplerMipmapMode::eLinear)
+        .setAddressModeU(vk::SamplerAddressMode::eRepeat)
+        .setAddressModeV(vk::SamplerAddressMode::eRepeat)
+        .setAddressModeW(vk::SamplerAddressMode::eRepeat)
+        .setMaxLod(maxLod);
+    return info;
+}
+class TestConfigure final : public IConfigure
+{
+  private:
+    Json mJson = {{"Logger", {{"Level", "warn"}}}};
+
+  public:
+    void SetJsonSettingFile(const fs::path &) override
+    {
+    }
+    const Json &GetJson() const override
+    {
+        return mJson;
+    }
+};
+} // namespace
+
+/**
+ * 在无窗口 Context 上创建真实的采样器，没有可用设备时跳过
+ */
+class SamplerManagerTest : public ::testing::Test
+{
+  protected:
+    std::shared_ptr<ILogger> mLogger;
+    std::shared_ptr<Context> mContext;
+    std::shared_ptr<SamplerManager> mSamplerManager;
+
+    void SetUp() override
+    {
+        mLogger = std::make_shared<SpdLogger>(std::make_shared<TestConfigure>());
+        try
+        {
+            mContext = std::make_shared<Context>(mLogger, nullptr);
+        }
+        catch (const std::exception &error)
+        {
+            GTEST_SKIP() << "Vulkan is not available: " << error.what();
+        }
+        mSamplerManager = std::make_shared<SamplerManager>(mLogger, mContext);
+    }
+    void TearDown() override
+    {
+        mSamplerManager.reset();
+        mContext.reset();
+    }
+};
+
+TEST(SamplerCacheTest, IdenticalInfoHashesEqual)
+{
+    SamplerCreateInfoHash hash;
+    auto a = TextureSamplerInfo(10.0f);
+    auto b = TextureSamplerInfo(10.0f);
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(hash(a), hash(b));
+}
+TEST(SamplerCacheTest, EveryFieldParticipatesInKey)
+{
+    std::unordered_set<vk::SamplerCreateInfo, SamplerCreateInfoHash> keys;
+    auto base = TextureSamplerInfo(10.0f);
+    keys.insert(base);
+    keys.insert(TextureSamplerInfo(9.0f));
+    keys.insert(vk::SamplerCreateInfo(base).setMagFilter(vk::Filter::eNearest));
+    keys.insert(vk::SamplerCreateInfo(base).setAddressModeW(vk::SamplerAddressMode::eClampToEdge));
+    keys.insert(vk::SamplerCreateInfo(base).setMipLodBias(-0.5f));
+    keys.insert(vk::SamplerCreateInfo(base).setAnisotropyEnable(vk::True).setMaxAnisotropy(16.0f));
+    keys.insert(vk::SamplerCreateInfo(base).setCompareEnable(vk::True).setCompareOp(vk::CompareOp::eLess));
+    keys.insert(vk::SamplerCreateInfo(base).setBorderColor(vk::BorderColor::eFloatOpaqueWhite));
+    EXPECT_EQ(keys.size(), 8u);
+    // 重复插入相同参数不会产生新键
+    keys.insert(TextureSamplerInfo(10.0f));
+    EXPECT_EQ(keys.size(), 8u);
+}
+TEST(SamplerCacheTest, HitRate)
+{
+    SamplerCacheStats stats;
+    EXPECT_EQ(stats.GetHitRate(), 0.0);
+    stats.requests = 4;
+    stats.hits = 3;
+    EXPECT_DOUBLE_EQ(stats.GetHitRate(), 0.75);
+}
+
+TEST_F(SamplerManagerTest, IdenticalRequestsShareOneSampler)
+{
+    auto first = mSamplerManager->GetSampler(TextureSamplerInfo(10.0f));
+    auto stats = mSamplerManager->GetStats();
+    EXPECT_EQ(stats.requests, 1u);
+    EXPECT_EQ(stats.hits, 0u);
+
+    auto second = mSamplerManager->GetSampler(TextureSamplerInfo(10.0f));
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(first->get(), second->get());
+    stats = mSamplerManager->GetStats();
+    EXPECT_EQ(stats.requests, 2u);
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.liveSamplers, 1u);
+
+    // 参数不同时创建新的采样器
+    auto other = mSamplerManager->GetSampler(TextureSamplerInfo(4.0f));
+    EXPECT_NE(first->get(), other->get());
+    // 相同 mip 数的纹理采样器命中同一项
+    auto texture = mSamplerManager->GetTextureSampler(11);
+    EXPECT_EQ(texture->get(), mSamplerManager->GetTextureSampler(11)->get());
+    stats = mSamplerManager->GetStats();
+    EXPECT_EQ(stats.requests, 5u);
+    EXPECT_EQ(stats.hits, 2u);
+    EXPECT_EQ(stats.liveSamplers, 3u);
+}
+TEST_F(SamplerManagerTest, ReleasedSamplersExpire)
+{
+    auto sampler = mSamplerManager->GetSampler(TextureSamplerInfo(10.0f));
+    auto copy = sampler;
+    sampler.reset();
+    // 仍有持有者时缓存项有效
+    EXPECT_EQ(mSamplerManager->GetStats().liveSamplers, 1u);
+    copy.reset();
+    // 最后一个持有者释放后缓存项过期并被清理
+    EXPECT_EQ(mSamplerManager->GetStats().liveSamplers, 0u);
+
+    // 过期后的同参数请求重新创建，不计为命中
+    auto recreated = mSamplerManager->GetSampler(TextureSamplerInfo(10.0f));
+    ASSERT_TRUE(recreated && recreated->get());
+    auto stats = mSamplerManager->GetStats();
+    EXPECT_EQ(stats.requests, 2u);
+    EXPECT_EQ(stats.hits, 0u);
+    EXPECT_EQ(stats.liveSamplers, 1u);
+}
+TEST_F(SamplerManagerTest, RejectsPNextChains)
+{
+    vk::SamplerReductionModeCreateInfo reduction;
+    auto info = TextureSamplerInfo(1.0f);
+    info.setPNext(&reduction);
+    EXPECT_THROW(mSamplerManager->GetSampler(info), std::invalid_argument);
+}
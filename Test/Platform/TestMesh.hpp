@@ -0,0 +1,36 @@
+#pragma once
+#include "Vertex.hpp"
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace MEngine
+{
+/**
+ * @brief 经纬球：顶点共享，三角形按行输出，与 BasicGeometryFactory 的生成方式相同
+ * 经线接缝与两极有位置重复的顶点。MeshOptimizerTest 与 MeshSimplifierTest 共用。
+ */
+inline void MakeSphere(uint32_t rings, uint32_t segments, float radius, std::vector<Vertex> &vertices,
+                       std::vector<uint32_t> &indices)
+{
+    for (uint32_t r = 0; r <= rings; r++)
+    {
+        float phi = 3.14159265f * r / rings;
+        for (uint32_t s = 0; s <= segments; s++)
+        {
+            float theta = 6.28318531f * s / segments;
+            glm::vec3 normal(std::sin(phi) * std::cos(theta), std::cos(phi), std::sin(phi) * std::sin(theta));
+            vertices.push_back({normal * radius, normal, glm::vec2(float(s) / segments, float(r) / rings)});
+        }
+    }
+    for (uint32_t r = 0; r < rings; r++)
+    {
+        for (uint32_t s = 0; s < segments; s++)
+        {
+            uint32_t current = r * (segments + 1) + s;
+            uint32_t next = current + segments + 1;
+            indices.insert(indices.end(), {current, current + 1, next, current + 1, next + 1, next});
+        }
+    }
+}
+} // namespace MEngine
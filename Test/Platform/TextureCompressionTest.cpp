@@ -0,0 +1,300 @@
+#include "Mipmap.hpp"
+#include "TextureCompression.hpp"
+#include "TextureContainer.hpp"
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace MEngine;
+
+namespace
+{
+// 参考解码器，按规范独立实现，用来检查编码结果
+uint32_t GetBits(const uint8_t *block, uint32_t &position, uint32_t count)
+{
+    uint32_t value = 0;
+    for (uint32_t i = 0; i < count; i++, position++)
+    {
+        value |= ((block[position / 8] >> (position % 8)) & 1u) << i;
+    }
+    return value;
+}
+void DecodeBC1(const uint8_t *block, uint8_t pixels[16][4])
+{
+    uint16_t color0 = static_cast<uint16_t>(block[0] | (block[1] << 8));
+    uint16_t color1 = static_cast<uint16_t>(block[2] | (block[3] << 8));
+    auto expand = [](uint16_t color) {
+        int r = (color >> 11) & 31, g = (color >> 5) & 63, b = color & 31;
+        return std::array<int, 3>{(r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2)};
+    };
+    auto c0 = expand(color0), c1 = expand(color1);
+    std::array<std::array<int, 4>, 4> palette{};
+    for (int c = 0; c < 3; c++)
+    {
+        palette[0][c] = c0[c];
+        palette[1][c] = c1[c];
+        palette[2][c] = color0 > color1 ? (2 * c0[c] + c1[c]) / 3 : (c0[c] + c1[c]) / 2;
+        palette[3][c] = color0 > color1 ? (c0[c] + 2 * c1[c]) / 3 : 0;
+    }
+    palette[0][3] = palette[1][3] = palette[2][3] = 255;
+    palette[3][3] = color0 > color1 ? 255 : 0;
+    uint32_t indices = block[4] | (block[5] << 8) | (block[6] << 16) | (static_cast<uint32_t>(block[7]) << 24);
+    for (int i = 0; i < 16; i++)
+    {
+        for (int c = 0; c < 4; c++)
+        {
+            pixels[i][c] = static_cast<uint8_t>(palette[(indices >> (2 * i)) & 3][c]);
+        }
+    }
+}
+void DecodeBC4(const uint8_t *block, uint8_t values[16])
+{
+    int red0 = block[0], red1 = block[1];
+    int palette[8] = {red0, red1};
+    for (int i = 2; i < 8; i++)
+    {
+        palette[i] = red0 > red1 ? ((8 - i) * red0 + (i - 1) * red1) / 7 : ((6 - i) * red0 + (i - 1) * red1) / 5;
+    }
+    if (red0 <= red1)
+    {
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+    uint64_t indices = 0;
+    for (int i = 0; i < 6; i++)
+    {
+        indices |= static_cast<uint64_t>(block[2 + i]) << (8 * i);
+    }
+    for (int i = 0; i < 16; i++)
+    {
+        values[i] = static_cast<uint8_t>(palette[(indices >> (3 * i)) & 7]);
+    }
+}
+void DecodeBC7Mode6(const uint8_t *block, uint8_t pixels[16][4])
+{
+    static constexpr int weights[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+    uint32_t position = 0;
+    ASSERT_EQ(GetBits(block, position, 7), 1u << 6);
+    uint32_t endpoints[2][4];
+    for (int c = 0; c < 4; c++)
+    {
+        endpoints[0][c] = GetBits(block, position, 7);
+        endpoints[1][c] = GetBits(block, position, 7);
+    }
+    uint32_t p0 = GetBits(block, position, 1);
+    uint32_t p1 = GetBits(block, position, 1);
+    for (int c = 0; c < 4; c++)
+    {
+        endpoints[0][c] = endpoints[0][c] << 1 | p0;
+        endpoints[1][c] = endpoints[1][c] << 1 | p1;
+    }
+    for (int i = 0; i < 16; i++)
+    {
+        uint32_t index = GetBits(block, position, i == 0 ? 3 : 4);
+        for (int c = 0; c < 4; c++)
+        {
+            pixels[i][c] = static_cast<uint8_t>(
+                ((64 - weights[index]) * endpoints[0][c] + weights[index] * endpoints[1][c] + 32) >> 6);
+        }
+    }
+}
+std::vector<uint8_t> MakeGradient(uint32_t width, uint32_t height)
+{
+    std::vector<uint8_t> pixels(width * height * 4);
+    for (uint32_t y = 0; y < height; y++)
+    {
+        for (uint32_t x = 0; x < width; x++)
+        {
+            uint8_t *pixel = &pixels[(y * width + x) * 4];
+            pixel[0] = static_cast<uint8_t>(x * 255 / (width - 1));
+            pixel[1] = static_cast<uint8_t>(y * 255 / (height - 1));
+            pixel[2] = static_cast<uint8_t>((x + y) * 255 / (width + height - 2));
+            pixel[3] = static_cast<uint8_t>(255 - x * 128 / (width - 1));
+        }
+    }
+    return pixels;
+}
+double RootMeanSquareError(const std::vector<uint8_t> &a, const std::vector<uint8_t> &b, uint32_t channels)
+{
+    double sum = 0.0;
+    size_t count = 0;
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        if (i % 4 < channels)
+        {
+            double delta = static_cast<double>(a[i]) - b[i];
+            sum += delta * delta;
+            count++;
+        }
+    }
+    return std::sqrt(sum / count);
+}
+/**
+ * @brief 解码整张图，decode 把一个块写成 16 个 RGBA 像素
+ */
+template <typename TDecode>
+std::vector<uint8_t> DecodeImage(const std::vector<uint8_t> &blocks, uint32_t width, uint32_t height,
+                                 uint32_t blockSize, TDecode &&decode)
+{
+    std::vector<uint8_t> pixels(width * height * 4);
+    uint32_t blocksX = (width + 3) / 4;
+    for (uint32_t by = 0; by < (height + 3) / 4; by++)
+    {
+        for (uint32_t bx = 0; bx < blocksX; bx++)
+        {
+            uint8_t decoded[16][4]{};
+            decode(&blocks[(by * blocksX + bx) * blockSize], decoded);
+            for (uint32_t i = 0; i < 16; i++)
+            {
+                uint32_t x = bx * 4 + i % 4, y = by * 4 + i / 4;
+                if (x < width && y < height)
+                {
+                    std::memcpy(&pixels[(y * width + x) * 4], decoded[i], 4);
+                }
+            }
+        }
+    }
+    return pixels;
+}
+} // namespace
+
+TEST(TextureCompressionTest, CompressedSizesUseWholeBlocks)
+{
+    EXPECT_EQ(GetCompressedSize(BlockCompression::BC1, 4096, 4096), 4096ull * 4096 / 2);
+    EXPECT_EQ(GetCompressedSize(BlockCompression::BC7, 4096, 4096), 4096ull * 4096);
+    EXPECT_EQ(GetCompressedSize(BlockCompression::BC5, 1, 1), 16u);
+    EXPECT_EQ(GetCompressedSize(BlockCompression::BC1, 5, 3), 2u * 1u * 8u);
+    EXPECT_EQ(GetCompressedSize(BlockCompression::None, 5, 3), 60u);
+}
+
+TEST(TextureCompressionTest, BC1RoundTripsGradient)
+{
+    auto source = MakeGradient(64, 64);
+    auto blocks = CompressImage(BlockCompression::BC1, source.data(), 64, 64);
+    ASSERT_EQ(blocks.size(), GetCompressedSize(BlockCompression::BC1, 64, 64));
+    auto decoded = DecodeImage(blocks, 64, 64, 8, [](const uint8_t *block, uint8_t pixels[16][4]) {
+        DecodeBC1(block, pixels);
+    });
+    EXPECT_LT(RootMeanSquareError(source, decoded, 3), 6.0);
+}
+
+TEST(TextureCompressionTest, BC1SolidBlockIsExact)
+{
+    std::vector<uint8_t> source(16 * 4);
+    for (size_t i = 0; i < source.size(); i += 4)
+    {
+        source[i] = 255;
+        source[i + 1] = 0;
+        source[i + 2] = 0;
+        source[i + 3] = 255;
+    }
+    auto blocks = CompressImage(BlockCompression::BC1, source.data(), 4, 4);
+    uint8_t pixels[16][4];
+    DecodeBC1(blocks.data(), pixels);
+    for (auto &pixel : pixels)
+    {
+        EXPECT_EQ(pixel[0], 255);
+        EXPECT_EQ(pixel[1], 0);
+        EXPECT_EQ(pixel[3], 255);
+    }
+}
+
+TEST(TextureCompressionTest, BC5KeepsRedAndGreen)
+{
+    auto source = MakeGradient(32, 32);
+    auto blocks = CompressImage(BlockCompression::BC5, source.data(), 32, 32);
+    auto decoded = DecodeImage(blocks, 32, 32, 16, [](const uint8_t *block, uint8_t pixels[16][4]) {
+        uint8_t red[16], green[16];
+        DecodeBC4(block, red);
+        DecodeBC4(block + 8, green);
+        for (int i = 0; i < 16; i++)
+        {
+            pixels[i][0] = red[i];
+            pixels[i][1] = green[i];
+        }
+    });
+    EXPECT_LT(RootMeanSquareError(source, decoded, 2), 2.0);
+}
+
+TEST(TextureCompressionTest, BC7RoundTripsNoiseWithAlpha)
+{
+    std::mt19937 random(7);
+    std::vector<uint8_t> source(16 * 16 * 4);
+    for (auto &value : source)
+    {
+        value = static_cast<uint8_t>(random());
+    }
+    auto gradient = MakeGradient(64, 64);
+    auto blocks = CompressImage(BlockCompression::BC7, gradient.data(), 64, 64);
+    auto decoded = DecodeImage(blocks, 64, 64, 16, [](const uint8_t *block, uint8_t pixels[16][4]) {
+        DecodeBC7Mode6(block, pixels);
+    });
+    // BC7 与 BC1 在同一张图上比较，4 位索引与更高的端点精度应更准确
+    auto bc1 = DecodeImage(CompressImage(BlockCompression::BC1, gradient.data(), 64, 64), 64, 64, 8,
+                           [](const uint8_t *block, uint8_t pixels[16][4]) { DecodeBC1(block, pixels); });
+    double bc7Error = RootMeanSquareError(gradient, decoded, 3);
+    EXPECT_LT(bc7Error, RootMeanSquareError(gradient, bc1, 3));
+    EXPECT_LT(RootMeanSquareError(gradient, decoded, 4), 4.0);
+    // 随机噪声只要求解码结果合法且误差有限
+    auto noiseBlocks = CompressImage(BlockCompression::BC7, source.data(), 16, 16);
+    auto noise = DecodeImage(noiseBlocks, 16, 16, 16, [](const uint8_t *block, uint8_t pixels[16][4]) {
+        DecodeBC7Mode6(block, pixels);
+    });
+    EXPECT_LT(RootMeanSquareError(source, noise, 4), 80.0);
+}
+
+TEST(TextureCompressionTest, ContainerRoundTrip)
+{
+    auto source = MakeGradient(20, 12);
+    TextureCookOptions options{};
+    options.compression = BlockCompression::BC7;
+    auto file = CookTexture(source.data(), 20, 12, options);
+    auto view = ParseTextureContainer(file.data(), file.size());
+    ASSERT_TRUE(view.has_value());
+    EXPECT_EQ(view->header.width, 20u);
+    EXPECT_EQ(view->header.height, 12u);
+    EXPECT_EQ(view->header.mipLevels, CalculateMipLevels(20, 12));
+    EXPECT_TRUE(view->header.flags & TextureContainerSrgb);
+    for (uint32_t level = 0; level < view->header.mipLevels; level++)
+    {
+        const auto &mip = view->mips[level];
+        EXPECT_EQ(mip.offset % TextureContainerAlignment, 0u);
+        EXPECT_EQ(mip.width, GetMipExtent(20, level));
+        EXPECT_EQ(mip.size, GetCompressedSize(BlockCompression::BC7, mip.width, mip.height));
+    }
+    // mip 0 与直接压缩结果一致
+    auto blocks = CompressImage(BlockCompression::BC7, source.data(), 20, 12);
+    EXPECT_EQ(std::memcmp(view->GetMipData(0), blocks.data(), blocks.size()), 0);
+}
+
+TEST(TextureCompressionTest, ContainerRejectsCorruptData)
+{
+    auto source = MakeGradient(8, 8);
+    auto file = CookTexture(source.data(), 8, 8, TextureCookOptions{});
+    EXPECT_FALSE(ParseTextureContainer(file.data(), 16).has_value());
+    auto truncated = file;
+    truncated.resize(truncated.size() - 32);
+    EXPECT_FALSE(ParseTextureContainer(truncated.data(), truncated.size()).has_value());
+    auto badMagic = file;
+    badMagic[0] ^= 0xFF;
+    EXPECT_FALSE(ParseTextureContainer(badMagic.data(), badMagic.size()).has_value());
+    // 修改文件头或 mip 表中的单个字段
+    auto patch = [&file](size_t offset, auto value) {
+        auto patched = file;
+        std::memcpy(patched.data() + offset, &value, sizeof(value));
+        return ParseTextureContainer(patched.data(), patched.size()).has_value();
+    };
+    const size_t mip1 = sizeof(TextureContainerHeader) + sizeof(TextureContainerMip);
+    // 8x8 最多 4 级
+    EXPECT_FALSE(patch(offsetof(TextureContainerHeader, mipLevels), uint32_t{5}));
+    // 尺寸与文件头不一致，即使数据大小自洽
+    EXPECT_FALSE(patch(offsetof(TextureContainerHeader, width), uint32_t{16}));
+    EXPECT_FALSE(patch(mip1 + offsetof(TextureContainerMip, width), uint32_t{8}));
+    // 数据偏移未对齐
+    auto offset = reinterpret_cast<const TextureContainerMip *>(file.data() + mip1)->offset;
+    EXPECT_FALSE(patch(mip1 + offsetof(TextureContainerMip, offset), uint64_t{offset + 4}));
+    EXPECT_TRUE(patch(mip1 + offsetof(TextureContainerMip, offset), uint64_t{offset}));
+}
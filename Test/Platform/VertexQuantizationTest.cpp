@@ -0,0 +1,100 @@
+#include "VertexQuantization.hpp"
+#include "gtest/gtest.h"
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace MEngine;
+
+TEST(VertexQuantizationTest, HalfFloatRoundTrip)
+{
+    for (float value : {0.0f, 1.0f, -2.5f, 0.5f, 1024.0f, 65504.0f, 6.103515625e-05f, 5.9604645e-08f})
+    {
+        EXPECT_EQ(HalfToFloat(FloatToHalf(value)), value) << value;
+    }
+    // 超出范围饱和到最大有限值，而不是无穷大
+    EXPECT_EQ(HalfToFloat(FloatToHalf(1.0e6f)), 65504.0f);
+    EXPECT_EQ(HalfToFloat(FloatToHalf(-1.0e6f)), -65504.0f);
+    // 就近舍入到偶数：1 + 2^-11 恰好位于 1 与 1 + 2^-10 中间
+    EXPECT_EQ(HalfToFloat(FloatToHalf(1.0f + std::ldexp(1.0f, -11))), 1.0f);
+    EXPECT_EQ(HalfToFloat(FloatToHalf(1.0f + 3.0f * std::ldexp(1.0f, -11))), 1.0f + std::ldexp(1.0f, -9));
+    EXPECT_TRUE(std::isnan(HalfToFloat(FloatToHalf(std::nanf("")))));
+}
+TEST(VertexQuantizationTest, OctahedralNormalError)
+{
+    std::mt19937 rng(7);
+    std::normal_distribution<float> dist;
+    float maxAngle = 0.0f;
+    std::vector<glm::vec3> normals = {{0, 0, 1}, {0, 0, -1}, {1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}};
+    for (int i = 0; i < 10000; i++)
+    {
+        normals.push_back(glm::normalize(glm::vec3(dist(rng), dist(rng), dist(rng))));
+    }
+    std::vector<Vertex> vertices(normals.size());
+    for (size_t i = 0; i < normals.size(); i++)
+    {
+        vertices[i].normal = normals[i];
+    }
+    std::vector<QuantizedVertex> packed(vertices.size());
+    auto quantization = ComputeVertexQuantization(vertices.data(), vertices.size());
+    QuantizeVertices(vertices.data(), vertices.size(), quantization, packed.data());
+    for (size_t i = 0; i < vertices.size(); i++)
+    {
+        auto decoded = DequantizeVertex(packed[i], quantization).normal;
+        // 小角度下 acos 精度不足，用 atan2(|a x b|, a . b)
+        float angle = std::atan2(glm::length(glm::cross(decoded, normals[i])), glm::dot(decoded, normals[i]));
+        maxAngle = std::max(maxAngle, angle);
+    }
+    // 16 位八面体编码的理论误差约 3e-5 弧度
+    EXPECT_LT(maxAngle, 1.0e-4f);
+}
+TEST(VertexQuantizationTest, PositionAndTexCoordErrorBounds)
+{
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> position(-3.0f, 5.0f);
+    std::uniform_real_distribution<float> flat(-0.01f, 0.01f);
+    std::uniform_real_distribution<float> uv(0.0f, 1.0f);
+    std::vector<Vertex> vertices(4096);
+    for (auto &vertex : vertices)
+    {
+        vertex.position = glm::vec3(position(rng), flat(rng), position(rng) + 100.0f);
+        vertex.normal = glm::vec3(0.0f, 1.0f, 0.0f);
+        vertex.texCoords = glm::vec2(uv(rng), uv(rng));
+    }
+    auto quantization = ComputeVertexQuantization(vertices.data(), vertices.size());
+    std::vector<QuantizedVertex> packed(vertices.size());
+    QuantizeVertices(vertices.data(), vertices.size(), quantization, packed.data());
+    float positionTolerance = quantization.GetPositionTolerance() * 1.01f;
+    // [0.5, 1) 内 half 的间距为 2^-11
+    float texCoordTolerance = std::ldexp(1.0f, -12);
+    for (size_t i = 0; i < vertices.size(); i++)
+    {
+        auto decoded = DequantizeVertex(packed[i], quantization);
+        EXPECT_EQ(packed[i].position[3], 0);
+        for (int axis = 0; axis < 3; axis++)
+        {
+            ASSERT_LE(std::abs(decoded.position[axis] - vertices[i].position[axis]), positionTolerance);
+        }
+        ASSERT_LE(std::abs(decoded.texCoords.x - vertices[i].texCoords.x), texCoordTolerance);
+        ASSERT_LE(std::abs(decoded.texCoords.y - vertices[i].texCoords.y), texCoordTolerance);
+        // 反量化矩阵与逐分量解码结果一致
+        glm::vec4 snorm(packed[i].position[0] / 32767.0f, packed[i].position[1] / 32767.0f,
+                        packed[i].position[2] / 32767.0f, 1.0f);
+        glm::vec3 transformed(quantization.GetDequantizeMatrix() * snorm);
+        ASSERT_NEAR(transformed.x, decoded.position.x, 1.0e-4f);
+        ASSERT_NEAR(transformed.z, decoded.position.z, 1.0e-4f);
+    }
+}
+TEST(VertexQuantizationTest, DegenerateMesh)
+{
+    std::vector<Vertex> vertices(3);
+    for (auto &vertex : vertices)
+    {
+        vertex.position = glm::vec3(1.0f, 2.0f, 3.0f);
+    }
+    auto quantization = ComputeVertexQuantization(vertices.data(), vertices.size());
+    std::vector<QuantizedVertex> packed(vertices.size());
+    QuantizeVertices(vertices.data(), vertices.size(), quantization, packed.data());
+    auto decoded = DequantizeVertex(packed[0], quantization);
+    EXPECT_EQ(decoded.position, vertices[0].position);
+}
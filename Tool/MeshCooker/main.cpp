@@ -0,0 +1,46 @@
+#include "BasicGeometry/BasicGeometryFactory.hpp"
+#include "MeshContainer.hpp"
+#include "magic_enum/magic_enum.hpp"
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using namespace MEngine;
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        std::cout << "Usage: MeshCooker <output directory>\n"
+                     "  Cooks every basic geometry into <output directory>/<Type>.mmesh (optimized, with LODs)\n";
+        return 1;
+    }
+    std::filesystem::path directory = argv[1];
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error)
+    {
+        std::cerr << "Failed to create " << directory.string() << ": " << error.message() << std::endl;
+        return 1;
+    }
+    for (auto type : magic_enum::enum_values<PrimitiveType>())
+    {
+        auto geometry = BasicGeometryFactory::Generate(type);
+        MeshOptimizeReport report{};
+        auto file = CookMesh(std::move(geometry.vertices), std::move(geometry.indices), {}, &report);
+        auto output = directory / (std::string(magic_enum::enum_name(type)) + ".mmesh");
+        std::ofstream stream(output, std::ios::binary);
+        if (!stream.write(reinterpret_cast<const char *>(file.data()), static_cast<std::streamsize>(file.size())))
+        {
+            std::cerr << "Failed to write " << output.string() << std::endl;
+            return 1;
+        }
+        auto container = ParseMeshContainer(file.data(), file.size());
+        std::cout << output.string() << ": " << report.verticesBefore << " -> " << report.verticesAfter
+                  << " vertices, ACMR " << report.before.acmr << " -> " << report.after.acmr << ", ATVR "
+                  << report.before.atvr << " -> " << report.after.atvr << ", "
+                  << (container ? container->header.lodCount : 0) << " LODs" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,92 @@
+#include "TextureContainer.hpp"
+#include "stb_image.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+
+using namespace MEngine;
+
+namespace
+{
+void PrintUsage()
+{
+    std::cout << "Usage: TextureCooker <input> <output.mtex> [--normal | --bc1 | --bc7 | --uncompressed] [--linear] "
+                 "[--no-mips]\n"
+                 "  --normal        BC5, linear; tangent-space normal maps (blue is reconstructed in the shader)\n"
+                 "  --bc1           BC1, opaque colour textures\n"
+                 "  --bc7           BC7 (default), colour textures with alpha\n"
+                 "  --uncompressed  RGBA8\n"
+                 "  --linear        store as UNORM instead of sRGB\n"
+                 "  --no-mips       only store mip 0\n";
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+    if (argc < 3)
+    {
+        PrintUsage();
+        return 1;
+    }
+    std::filesystem::path input = argv[1];
+    std::filesystem::path output = argv[2];
+    TextureCookOptions options{};
+    for (int i = 3; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--normal") == 0)
+        {
+            options.compression = BlockCompression::BC5;
+            options.srgb = false;
+        }
+        else if (std::strcmp(argv[i], "--bc1") == 0)
+        {
+            options.compression = BlockCompression::BC1;
+        }
+        else if (std::strcmp(argv[i], "--bc7") == 0)
+        {
+            options.compression = BlockCompression::BC7;
+        }
+        else if (std::strcmp(argv[i], "--uncompressed") == 0)
+        {
+            options.compression = BlockCompression::None;
+        }
+        else if (std::strcmp(argv[i], "--linear") == 0)
+        {
+            options.srgb = false;
+        }
+        else if (std::strcmp(argv[i], "--no-mips") == 0)
+        {
+            options.generateMipmaps = false;
+        }
+        else
+        {
+            std::cerr << "Unknown option: " << argv[i] << std::endl;
+            PrintUsage();
+            return 1;
+        }
+    }
+    // 与运行时 PNG 加载保持相同的朝向
+    stbi_set_flip_vertically_on_load(true);
+    int width, height, channels;
+    std::unique_ptr<stbi_uc, decltype(&stbi_image_free)> pixels(
+        stbi_load(input.string().c_str(), &width, &height, &channels, STBI_rgb_alpha), &stbi_image_free);
+    if (!pixels)
+    {
+        std::cerr << "Failed to load " << input.string() << ": " << stbi_failure_reason() << std::endl;
+        return 1;
+    }
+    auto file = CookTexture(pixels.get(), static_cast<uint32_t>(width), static_cast<uint32_t>(height), options);
+    std::ofstream stream(output, std::ios::binary);
+    if (!stream.write(reinterpret_cast<const char *>(file.data()), static_cast<std::streamsize>(file.size())))
+    {
+        std::cerr << "Failed to write " << output.string() << std::endl;
+        return 1;
+    }
+    uint64_t sourceSize = static_cast<uint64_t>(width) * height * 4;
+    std::cout << input.string() << " -> " << output.string() << ": " << width << "x" << height << ", "
+              << file.size() << " bytes (" << static_cast<double>(sourceSize) / file.size()
+              << "x smaller than RGBA8 mip 0)" << std::endl;
+    return 0;
+}
@@ -12,6 +12,7 @@
 #include "Entity/Interface/ITexture.hpp"
 #include "Entity/PBRMaterial.hpp"
 #include "Entity/Texture2D.hpp"
+#include "GeometryArena.hpp"
 #include "ImageFactory.hpp"
 #include "Interface/ILogger.hpp"
 #include "Interface/IWindow.hpp"
@@ -32,12 +33,16 @@
 #include "Configure.hpp"
 #include "Repository/Texture2DRepository.hpp"
 #include "SyncPrimitiveManager.hpp"
+#include "TaskGraph.hpp"
+#include "TaskScheduler.hpp"
 #include "System/CameraSystem.hpp"
 #include "System/EditorRenderSystem.hpp"
 #include "System/ISystem.hpp"
 #include "System/InputSystem.hpp"
 #include "System/RenderSystem.hpp"
+#include "System/SpatialSystem.hpp"
 #include "System/TransformSystem.hpp"
+#include "UploadQueue.hpp"
 
 
 #define BOOST_DI_CFG_CTOR_LIMIT_SIZE 50 // 定义构造函数参数的最大数量
@@ -64,8 +69,12 @@ class Application final : public NoCopyable
     std::shared_ptr<ISystem> mRenderSystem;
     std::shared_ptr<ISystem> mCameraSystem;
     std::shared_ptr<ISystem> mTransformSystem;
+    std::shared_ptr<ISystem> mSpatialSystem;
     std::shared_ptr<ISystem> mInputSystem;
 
+    // 帧任务图
+    TaskGraph mFrameGraph;
+
     // time
     uint32_t mTargetFPS = 120;
     std::chrono::high_resolution_clock::time_point mStartTime;
@@ -76,6 +85,8 @@ class Application final : public NoCopyable
   private:
     void InitSystem();
     void ShutdownSystem();
+    void BuildFrameGraph();
+    void AddSystemNode(const std::string &name, std::shared_ptr<ISystem> system);
 
   public:
     Application();
@@ -1,5 +1,4 @@
 #include "BasicGeometry/BasicGeometryFactory.hpp"
-#include "BufferFactory.hpp"
 #include "Component/MaterialComponent.hpp"
 #include "Component/MeshComponent.hpp"
 #include "Component/TransformComponent.hpp"
@@ -9,6 +8,7 @@
 #include "Entity/Interface/ITexture.hpp"
 #include "Entity/PBRMaterial.hpp"
 #include "Entity/Texture2D.hpp"
+#include "GeometryArena.hpp"
 #include "NoCopyable.hpp"
 #include "PipelineLayoutManager.hpp"
 #include "PipelineManager.hpp"
@@ -26,7 +26,7 @@ class BasicGeometryEntityManager : public NoCopyable
     std::shared_ptr<ILogger> mLogger;
     std::shared_ptr<Context> mContext;
 
-    std::shared_ptr<BufferFactory> mBufferFactory;
+    std::shared_ptr<GeometryArena> mGeometryArena;
     std::shared_ptr<BasicGeometryFactory> mBasicGeometryFactory;
     std::shared_ptr<IRepository<Texture2D>> mTexture2DRepository;
     std::shared_ptr<IRepository<PBRMaterial>> mPBRMaterialRepository;
@@ -35,7 +35,7 @@ class BasicGeometryEntityManager : public NoCopyable
   public:
     BasicGeometryEntityManager(std::shared_ptr<ILogger> mLogger, std::shared_ptr<Context> context,
                                std::shared_ptr<IRepository<PBRMaterial>> pbrMaterialRepository,
-                               std::shared_ptr<BufferFactory> bufferFactory,
+                               std::shared_ptr<GeometryArena> geometryArena,
                                std::shared_ptr<BasicGeometryFactory> basicGeometryFactory,
                                std::shared_ptr<IRepository<Texture2D>> texture2DRepository);
     entt::entity CreateCube(std::shared_ptr<entt::registry> registry);
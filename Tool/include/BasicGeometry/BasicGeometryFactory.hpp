@@ -1,11 +1,15 @@
 
+#include "Interface/ILogger.hpp"
 #include "MEngine.hpp"
+#include "MappedFile.hpp"
 #include "Mesh.hpp"
 #include "NoCopyable.hpp"
 #include "Vertex.hpp"
 #include "glm/glm.hpp"
 #include <cstdint>
 #include <glm/gtc/constants.hpp>
+#include <memory>
+#include <span>
 #include <unordered_map>
 #include <vector>
 
@@ -23,18 +27,48 @@ struct Geometry
     std::vector<Vertex> vertices;
     std::vector<uint32_t> indices;
 };
+/**
+ * @brief 运行时使用的几何体数据，可能指向映射的 .mmesh 文件，在工厂的生命周期内有效
+ */
+struct GeometryView
+{
+    std::span<const Vertex> vertices;
+    std::span<const uint32_t> indices;
+    std::vector<MeshLODSource> lods; // 不含 LOD0，索引指向 vertices
+};
+/**
+ * @brief 基础几何体由 MeshCooker 在构建时烘焙为 Resource/Mesh/<Type>.mmesh（已优化并含 LOD 链），
+ * 构造时只映射并校验文件；文件缺失或无效时退回未优化、无 LOD 的生成结果
+ */
 class BasicGeometryFactory : public NoCopyable
 {
+  private:
+    // DI
+    std::shared_ptr<ILogger> mLogger;
+
+  private:
+    struct Entry
+    {
+        std::unique_ptr<MappedFile> mapping; // 烘焙数据
+        Geometry generated;                  // 烘焙数据不可用时的回退
+        GeometryView view;
+    };
+    std::unordered_map<PrimitiveType, Entry> mGeometries;
+
   public:
-    BasicGeometryFactory();
+    BasicGeometryFactory(std::shared_ptr<ILogger> logger);
 
-    Geometry GetGeometry(PrimitiveType type);
+    GeometryView GetGeometry(PrimitiveType type);
+    /**
+     * @brief 生成原始的几何体数据，供 MeshCooker 烘焙
+     */
+    static Geometry Generate(PrimitiveType type);
 
   private:
-    Geometry GetCube();
-    Geometry GetCylinder();
-    Geometry GetSphere();
-    Geometry GetQuad();
+    static Geometry GetCube();
+    static Geometry GetCylinder();
+    static Geometry GetSphere();
+    static Geometry GetQuad();
 };
 
 } // namespace MEngine
\ No newline at end of file
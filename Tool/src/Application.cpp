@@ -8,12 +8,14 @@ auto injector = make_injector(
     DI::bind<entt::registry>().to<entt::registry>().in(DI::singleton),
     DI::bind<CommandBufferManager>().to<CommandBufferManager>().in(DI::singleton),
     DI::bind<SyncPrimitiveManager>().to<SyncPrimitiveManager>().in(DI::singleton),
+    DI::bind<UploadQueue>().to<UploadQueue>().in(DI::singleton),
     DI::bind<PipelineManager>().to<PipelineManager>().in(DI::singleton),
     DI::bind<PipelineLayoutManager>().to<PipelineLayoutManager>().in(DI::singleton),
     DI::bind<ShaderManager>().to<ShaderManager>().in(DI::singleton),
     DI::bind<DescriptorManager>().to<DescriptorManager>().in(DI::singleton),
     DI::bind<SamplerManager>().to<SamplerManager>().in(DI::singleton),
     DI::bind<BufferFactory>().to<BufferFactory>().in(DI::singleton),
+    DI::bind<GeometryArena>().to<GeometryArena>().in(DI::singleton),
     DI::bind<ImageFactory>().to<ImageFactory>().in(DI::singleton),
     DI::bind<RenderPassManager>().to<RenderPassManager>().in(DI::singleton),
     DI::bind<IRepository<Texture2D>>().to<Texture2DRepository>().in(DI::singleton),
@@ -23,6 +25,7 @@ auto injector = make_injector(
     DI::bind<CameraSystem>().to<CameraSystem>().in(DI::singleton),
     DI::bind<RenderSystem>().to<EditorRenderSystem>().in(DI::singleton),
     DI::bind<TransformSystem>().to<TransformSystem>().in(DI::singleton),
+    DI::bind<SpatialSystem>().to<SpatialSystem>().in(DI::singleton),
     DI::bind<InputSystem>().to<InputSystem>().in(DI::singleton));
 
 Application::Application()
@@ -31,6 +34,10 @@ Application::Application()
     // mConfigure = injector.create<std::shared_ptr<IConfigure>>();
     mLogger = injector.create<std::shared_ptr<ILogger>>();
     mLogger->Info("Application Started");
+    // 主线程负责 Input/Render 节点，其余核心作为工作线程
+    // hardware_concurrency 可能返回 0，先取下限再减一
+    uint32_t workerCount = std::max(2u, std::thread::hardware_concurrency()) - 1;
+    TaskScheduler::Instance().Initialize(workerCount, 1024);
     mWindow = injector.create<std::shared_ptr<IWindow>>();
     mContext = injector.create<std::shared_ptr<Context>>();
     mRegistry = injector.create<std::shared_ptr<entt::registry>>();
@@ -61,15 +68,42 @@ void Application::InitSystem()
     mRenderSystem = injector.create<std::shared_ptr<RenderSystem>>();
     mCameraSystem = injector.create<std::shared_ptr<CameraSystem>>();
     mTransformSystem = injector.create<std::shared_ptr<TransformSystem>>();
+    mSpatialSystem = injector.create<std::shared_ptr<SpatialSystem>>();
     mInputSystem = injector.create<std::shared_ptr<InputSystem>>();
     mRenderSystem->Init();
     mCameraSystem->Init();
     mTransformSystem->Init();
+    mSpatialSystem->Init();
     mInputSystem->Init();
+    BuildFrameGraph();
+}
+void Application::BuildFrameGraph()
+{
+    // 添加顺序即存在读写冲突时的执行顺序
+    mFrameGraph.Clear();
+    AddSystemNode("InputSystem", mInputSystem);
+    AddSystemNode("CameraSystem", mCameraSystem);
+    AddSystemNode("TransformSystem", mTransformSystem);
+    AddSystemNode("SpatialSystem", mSpatialSystem);
+    AddSystemNode("RenderSystem", mRenderSystem);
+    mFrameGraph.Build();
+    for (TaskGraph::NodeHandle handle = 0; handle < mFrameGraph.GetNodeCount(); handle++)
+    {
+        for (auto successor : mFrameGraph.GetSuccessors(handle))
+        {
+            mLogger->Debug("Frame graph: {} -> {}", mFrameGraph.GetNodeName(handle),
+                           mFrameGraph.GetNodeName(successor));
+        }
+    }
+}
+void Application::AddSystemNode(const std::string &name, std::shared_ptr<ISystem> system)
+{
+    mFrameGraph.AddNode(name, [this, system]() { system->Tick(mDeltaTime); }, system->GetAccess());
 }
 void Application::ShutdownSystem()
 {
     mInputSystem->Shutdown();
+    mSpatialSystem->Shutdown();
     mTransformSystem->Shutdown();
     mCameraSystem->Shutdown();
     mRenderSystem->Shutdown();
@@ -90,10 +124,7 @@ void Application::Run()
         mLastTime = mCurrentTime;
 
         mWindow->PollEvents();
-        mInputSystem->Tick(mDeltaTime);
-        mCameraSystem->Tick(mDeltaTime);
-        mTransformSystem->Tick(mDeltaTime);
-        mRenderSystem->Tick(mDeltaTime);
+        mFrameGraph.Execute();
         if (mDeltaTime < 1.0f / mTargetFPS)
         {
             auto sleepTime = (1.0f / mTargetFPS - mDeltaTime);
@@ -5,10 +5,10 @@ namespace MEngine
 BasicGeometryEntityManager::BasicGeometryEntityManager(std::shared_ptr<ILogger> mLogger,
                                                        std::shared_ptr<Context> context,
                                                        std::shared_ptr<IRepository<PBRMaterial>> pbrMaterialRepository,
-                                                       std::shared_ptr<BufferFactory> bufferFactory,
+                                                       std::shared_ptr<GeometryArena> geometryArena,
                                                        std::shared_ptr<BasicGeometryFactory> basicGeometryFactory,
                                                        std::shared_ptr<IRepository<Texture2D>> texture2DRepository)
-    : mLogger(mLogger), mContext(context), mBufferFactory(bufferFactory), mBasicGeometryFactory(basicGeometryFactory),
+    : mLogger(mLogger), mContext(context), mGeometryArena(geometryArena), mBasicGeometryFactory(basicGeometryFactory),
       mPBRMaterialRepository(pbrMaterialRepository), mTexture2DRepository(texture2DRepository)
 
 {
@@ -25,7 +25,8 @@ entt::entity BasicGeometryEntityManager::CreateCube(std::shared_ptr<entt::regist
 
     mPBRMaterialRepository->Update(material->GetID(), material);
     // 3. 创建网格
-    auto mesh = std::make_shared<Mesh>(mBufferFactory, geometry.vertices, geometry.indices);
+    auto mesh = std::make_shared<Mesh>(mGeometryArena, geometry.vertices, geometry.indices, MeshResidency::GPUOnly,
+                                       mGeometryArena->GetPreferredVertexFormat(), geometry.lods);
     // 4. 创建组件对象
     TransformComponent transformComponent;
     transformComponent.position = glm::vec3(0.0f, 0.0f, 0.0f);
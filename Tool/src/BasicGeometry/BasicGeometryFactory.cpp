@@ -1,12 +1,58 @@
 #include "BasicGeometry/BasicGeometryFactory.hpp"
+#include "MeshContainer.hpp"
+#include "magic_enum/magic_enum.hpp"
+#include <filesystem>
+#include <optional>
+#include <string>
+
 namespace MEngine
 {
-BasicGeometryFactory::BasicGeometryFactory()
+BasicGeometryFactory::BasicGeometryFactory(std::shared_ptr<ILogger> logger) : mLogger(logger)
+{
+    // 优化与 LOD 简化已经在构建时由 MeshCooker 完成，这里只映射文件，顶点与索引在创建网格时直接从映射内存上传
+    std::filesystem::path directory = std::filesystem::current_path() / "Resource" / "Mesh";
+    for (auto type : magic_enum::enum_values<PrimitiveType>())
+    {
+        auto &entry = mGeometries[type];
+        auto path = directory / (std::string(magic_enum::enum_name(type)) + ".mmesh");
+        auto mapping = std::make_unique<MappedFile>();
+        std::optional<MeshContainerView> container;
+        if (mapping->Open(path))
+        {
+            container = ParseMeshContainer(mapping->GetData(), mapping->GetSize());
+        }
+        if (!container)
+        {
+            mLogger->Warn("Cooked mesh " + path.string() + " is missing or invalid, using unoptimized geometry");
+            entry.generated = Generate(type);
+            entry.view.vertices = entry.generated.vertices;
+            entry.view.indices = entry.generated.indices;
+            continue;
+        }
+        const auto &header = container->header;
+        entry.view.vertices = {container->vertices, header.vertexCount};
+        entry.view.indices = {container->indices + container->lods[0].firstIndex, container->lods[0].indexCount};
+        for (uint32_t level = 1; level < header.lodCount; level++)
+        {
+            const auto &lod = container->lods[level];
+            entry.view.lods.push_back({{container->indices + lod.firstIndex, lod.indexCount}, lod.error});
+        }
+        entry.mapping = std::move(mapping);
+        mLogger->Debug("{} loaded: {} vertices, {} LODs, ACMR {:.3f}, ATVR {:.3f}", magic_enum::enum_name(type),
+                       header.vertexCount, header.lodCount, header.acmr, header.atvr);
+    }
+}
+GeometryView BasicGeometryFactory::GetGeometry(PrimitiveType type)
 {
+    auto it = mGeometries.find(type);
+    if (it == mGeometries.end())
+    {
+        throw std::invalid_argument("Invalid primitive type");
+    }
+    return it->second.view;
 }
-Geometry BasicGeometryFactory::GetGeometry(PrimitiveType type)
+Geometry BasicGeometryFactory::Generate(PrimitiveType type)
 {
-    Geometry geometry;
     switch (type)
     {
     case PrimitiveType::Cube: